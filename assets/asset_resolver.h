@@ -17,6 +17,7 @@ namespace flutter {
 class AssetManager;
 class APKAssetProvider;
 class DirectoryAssetBundle;
+class PackedAssetBundle;
 
 class AssetResolver {
  public:
@@ -30,7 +31,8 @@ class AssetResolver {
   enum AssetResolverType {
     kAssetManager,
     kApkAssetProvider,
-    kDirectoryAssetBundle
+    kDirectoryAssetBundle,
+    kPackedAssetBundle,
   };
 
   virtual const AssetManager* as_asset_manager() const { return nullptr; }
@@ -40,6 +42,9 @@ class AssetResolver {
   virtual const DirectoryAssetBundle* as_directory_asset_bundle() const {
     return nullptr;
   }
+  virtual const PackedAssetBundle* as_packed_asset_bundle() const {
+    return nullptr;
+  }
 
   virtual bool IsValid() const = 0;
 
@@ -0,0 +1,315 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+
+// The index is read in place, so the host byte order must match the
+// little-endian byte order of the format.
+#if !defined(FML_ARCH_CPU_LITTLE_ENDIAN)
+#error "Packed asset bundles are only supported on little-endian CPUs."
+#endif
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4b504c46;  // "FLPK"
+constexpr uint32_t kVersion = 1u;
+constexpr size_t kDataAlignment = 16u;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t entry_count;
+};
+
+// FNV-1a, which is stable across hosts unlike std::hash.
+uint64_t HashName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+size_t AlignUp(size_t offset) {
+  return (offset + kDataAlignment - 1u) & ~(kDataAlignment - 1u);
+}
+
+bool IsInBounds(uint64_t offset, uint64_t size, uint64_t total_size) {
+  return offset <= total_size && size <= total_size - offset;
+}
+
+bool CollectFiles(const fml::UniqueFD& directory,
+                  const std::string& prefix,
+                  PackedAssetBundle::Assets& assets) {
+  return fml::VisitFiles(directory, [&](const fml::UniqueFD& directory,
+                                        const std::string& filename) {
+    if (prefix.empty() && filename == PackedAssetBundle::kFileName) {
+      return true;
+    }
+    fml::UniqueFD fd = fml::OpenFileReadOnly(directory, filename.c_str());
+    if (fml::IsDirectory(fd)) {
+      return CollectFiles(fd, prefix + filename + "/", assets);
+    }
+    auto mapping = std::make_unique<fml::FileMapping>(fd);
+    if (!mapping->IsValid()) {
+      FML_LOG(ERROR) << "Could not map asset " << prefix << filename;
+      return false;
+    }
+    assets[prefix + filename] = std::move(mapping);
+    return true;
+  });
+}
+
+}  // namespace
+
+struct PackedAssetBundle::Entry {
+  uint64_t hash;
+  uint64_t name_offset;
+  uint64_t name_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::Create(
+    const fml::UniqueFD& directory,
+    bool is_valid_after_asset_manager_change,
+    std::unique_ptr<AssetResolver> fallback) {
+  if (!fml::FileExists(directory, kFileName)) {
+    return nullptr;
+  }
+  std::shared_ptr<const fml::Mapping> data =
+      fml::FileMapping::CreateReadOnly(directory, kFileName);
+  if (!data) {
+    return nullptr;
+  }
+  auto bundle = std::make_unique<PackedAssetBundle>(
+      std::move(data), is_valid_after_asset_manager_change,
+      std::move(fallback));
+  if (!bundle->IsValid()) {
+    FML_LOG(ERROR) << "The packed asset bundle was malformed.";
+    return nullptr;
+  }
+  return bundle;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::Pack(const Assets& assets) {
+  std::vector<Entry> entries;
+  entries.reserve(assets.size());
+  size_t offset = sizeof(Header) + assets.size() * sizeof(Entry);
+  for (const auto& [name, contents] : assets) {
+    Entry entry = {};
+    entry.hash = HashName(name);
+    entry.name_offset = offset;
+    entry.name_size = name.size();
+    offset += name.size();
+    entries.push_back(entry);
+  }
+  size_t index = 0u;
+  for (const auto& [name, contents] : assets) {
+    offset = AlignUp(offset);
+    entries[index].data_offset = offset;
+    entries[index].data_size = contents ? contents->GetSize() : 0u;
+    offset += entries[index].data_size;
+    index++;
+  }
+
+  std::vector<uint8_t> data(offset, 0u);
+  index = 0u;
+  for (const auto& [name, contents] : assets) {
+    const Entry& entry = entries[index++];
+    std::memcpy(data.data() + entry.name_offset, name.data(), name.size());
+    if (entry.data_size > 0u) {
+      std::memcpy(data.data() + entry.data_offset, contents->GetMapping(),
+                  entry.data_size);
+    }
+  }
+
+  // Equal hashes are ordered by name so that the order of the bundle does not
+  // depend on the iteration order of |assets|.
+  std::sort(entries.begin(), entries.end(),
+            [&data](const Entry& a, const Entry& b) {
+              if (a.hash != b.hash) {
+                return a.hash < b.hash;
+              }
+              return std::string_view(
+                         reinterpret_cast<const char*>(&data[a.name_offset]),
+                         a.name_size) <
+                     std::string_view(
+                         reinterpret_cast<const char*>(&data[b.name_offset]),
+                         b.name_size);
+            });
+
+  Header header = {};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.entry_count = entries.size();
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), entries.data(),
+              entries.size() * sizeof(Entry));
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+bool PackedAssetBundle::PackDirectory(const fml::UniqueFD& directory) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::PackDirectory");
+  Assets assets;
+  if (!CollectFiles(directory, "", assets)) {
+    return false;
+  }
+  auto data = Pack(assets);
+  // Release the asset mappings before writing in case the bundle replaces one
+  // of them.
+  assets.clear();
+  return fml::WriteAtomically(directory, kFileName, *data);
+}
+
+PackedAssetBundle::PackedAssetBundle(
+    std::shared_ptr<const fml::Mapping> data,
+    bool is_valid_after_asset_manager_change,
+    std::unique_ptr<AssetResolver> fallback)
+    : data_(std::move(data)), fallback_(std::move(fallback)) {
+  if (!data_ || data_->GetSize() < sizeof(Header)) {
+    return;
+  }
+  const uint8_t* bytes = data_->GetMapping();
+  const size_t size = data_->GetSize();
+
+  Header header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.entry_count > (size - sizeof(Header)) / sizeof(Entry)) {
+    return;
+  }
+
+  const Entry* entries = reinterpret_cast<const Entry*>(bytes + sizeof(Header));
+  for (size_t i = 0; i < header.entry_count; i++) {
+    const Entry& entry = entries[i];
+    if (!IsInBounds(entry.name_offset, entry.name_size, size) ||
+        !IsInBounds(entry.data_offset, entry.data_size, size)) {
+      return;
+    }
+    if (i > 0u && entries[i - 1].hash > entry.hash) {
+      return;
+    }
+  }
+
+  entries_ = entries;
+  entry_count_ = header.entry_count;
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(
+      reinterpret_cast<const char*>(data_->GetMapping() + entry.name_offset),
+      entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetContents(
+    const Entry& entry) const {
+  // The returned mapping keeps the packed bundle mapped.
+  return std::make_unique<fml::NonOwnedMapping>(
+      data_->GetMapping() + entry.data_offset, entry.data_size,
+      [bundle = data_](const uint8_t* data, size_t size) {});
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  const uint64_t hash = HashName(asset_name);
+  const Entry* end = entries_ + entry_count_;
+  for (auto entry = std::lower_bound(entries_, end, hash,
+                                     [](const Entry& entry, uint64_t hash) {
+                                       return entry.hash < hash;
+                                     });
+       entry != end && entry->hash == hash; entry++) {
+    if (GetName(*entry) == asset_name) {
+      return GetContents(*entry);
+    }
+  }
+  // The asset may have been added after the bundle was packed.
+  if (fallback_ && fallback_->IsValid()) {
+    return fallback_->GetAsMapping(asset_name);
+  }
+  return nullptr;
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Matches the file names like |DirectoryAssetBundle| does: any file when no
+  // subdirectory is given, or only the files directly within it otherwise.
+  const std::string prefix = subdir ? subdir.value() + "/" : "";
+  std::regex asset_regex(asset_pattern);
+  for (size_t i = 0; i < entry_count_; i++) {
+    std::string_view name = GetName(entries_[i]);
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    std::string_view filename = name.substr(prefix.size());
+    if (subdir && filename.find('/') != std::string_view::npos) {
+      continue;
+    }
+    if (!subdir && filename.find('/') != std::string_view::npos) {
+      filename = filename.substr(filename.rfind('/') + 1);
+    }
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(GetContents(entries_[i]));
+    }
+  }
+  return mappings;
+}
+
+bool PackedAssetBundle::operator==(const AssetResolver& other) const {
+  auto other_bundle = other.as_packed_asset_bundle();
+  if (!other_bundle) {
+    return false;
+  }
+  return is_valid_after_asset_manager_change_ ==
+             other_bundle->is_valid_after_asset_manager_change_ &&
+         data_ == other_bundle->data_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for a single file that packs every asset of
+///             a bundle along with an index of their paths.
+///
+///             The file is mapped once and assets are returned as views into
+///             that mapping, so resolving an asset never touches the
+///             filesystem. Lookups binary search a table of path hashes that
+///             is sorted when the bundle is packed.
+///
+///             A bundle can fall back to another resolver, usually the asset
+///             directory it was packed from, for assets it does not contain.
+///             This keeps assets that were added after the bundle was packed
+///             resolvable. Only |GetAsMapping| falls back; pattern lookups
+///             only search the bundle.
+///
+///             The file starts with a header and the index, followed by the
+///             asset names and the asset contents. All integers are
+///             little-endian, which is the byte order of every CPU the engine
+///             supports, so the index is used in place. Bundles are created
+///             with the `pack-assets` tool or |PackDirectory|.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the packed bundle within an asset directory.
+  static constexpr char kFileName[] = "assets.flutterpack";
+
+  using Assets = std::map<std::string, std::unique_ptr<const fml::Mapping>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps the packed bundle in the given asset directory.
+  ///
+  /// @param[in]  fallback  The resolver of the assets that are not in the
+  ///                       bundle. May be null.
+  ///
+  /// @return     The bundle, or null if the directory has no packed bundle or
+  ///             its packed bundle is malformed.
+  ///
+  static std::unique_ptr<PackedAssetBundle> Create(
+      const fml::UniqueFD& directory,
+      bool is_valid_after_asset_manager_change,
+      std::unique_ptr<AssetResolver> fallback = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs the given assets, keyed by their path relative to the
+  ///             root of the bundle using '/' as the separator.
+  ///
+  static std::unique_ptr<fml::Mapping> Pack(const Assets& assets);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs every file below the given asset directory and writes
+  ///             the bundle into that directory as |kFileName|.
+  ///
+  /// @return     If the bundle was written.
+  ///
+  static bool PackDirectory(const fml::UniqueFD& directory);
+
+  PackedAssetBundle(std::shared_ptr<const fml::Mapping> data,
+                    bool is_valid_after_asset_manager_change,
+                    std::unique_ptr<AssetResolver> fallback = nullptr);
+
+  ~PackedAssetBundle() override;
+
+ private:
+  struct Entry;
+
+  const std::shared_ptr<const fml::Mapping> data_;
+  const std::unique_ptr<AssetResolver> fallback_;
+  const Entry* entries_ = nullptr;
+  size_t entry_count_ = 0u;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetContents(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  // |AssetResolver|
+  bool operator==(const AssetResolver& other) const override;
+
+  // |AssetResolver|
+  const PackedAssetBundle* as_packed_asset_bundle() const override {
+    return this;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
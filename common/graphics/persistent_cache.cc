@@ -4,11 +4,16 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
 #include <future>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
@@ -33,6 +38,79 @@ std::shared_ptr<AssetManager> PersistentCache::asset_manager_;
 std::mutex PersistentCache::instance_mutex_;
 std::unique_ptr<PersistentCache> PersistentCache::gPersistentCache;
 
+// The use counts of kSkSLUsageFileName, keyed by the cache file name of the
+// shaders. The file holds a "<count> <file name>" line per shader.
+class PersistentCache::SkSLUsage {
+ public:
+  explicit SkSLUsage(const fml::UniqueFD& cache_directory) {
+    if (!cache_directory.is_valid() ||
+        !fml::FileExists(cache_directory, kSkSLUsageFileName)) {
+      return;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(cache_directory,
+                                                    kSkSLUsageFileName);
+    if (!mapping) {
+      return;
+    }
+    std::istringstream stream(
+        std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                    mapping->GetSize()));
+    uint32_t count = 0;
+    std::string file_name;
+    while (stream >> count >> file_name) {
+      use_counts_[file_name] = count;
+    }
+  }
+
+  uint32_t GetUseCount(const std::string& file_name) const {
+    std::scoped_lock lock(mutex_);
+    auto found = use_counts_.find(file_name);
+    return found == use_counts_.end() ? 0 : found->second;
+  }
+
+  // Counts a use of the shader, once per run. Returns whether the use counts
+  // changed.
+  bool RecordUse(const std::string& file_name) {
+    std::scoped_lock lock(mutex_);
+    if (!used_in_this_run_.insert(file_name).second) {
+      return false;
+    }
+    use_counts_[file_name]++;
+    return true;
+  }
+
+  // Returns false if a store is already pending, which will include the uses
+  // recorded until it runs.
+  bool BeginStore() {
+    std::scoped_lock lock(mutex_);
+    if (is_store_pending_) {
+      return false;
+    }
+    is_store_pending_ = true;
+    return true;
+  }
+
+  std::unique_ptr<fml::Mapping> EndStore() {
+    std::scoped_lock lock(mutex_);
+    is_store_pending_ = false;
+    std::ostringstream stream;
+    for (const auto& [file_name, count] : use_counts_) {
+      stream << count << " " << file_name << "\n";
+    }
+    std::string data = stream.str();
+    return std::make_unique<fml::DataMapping>(
+        std::vector<uint8_t>{data.begin(), data.end()});
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, uint32_t> use_counts_;
+  std::set<std::string> used_in_this_run_;
+  bool is_store_pending_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SkSLUsage);
+};
+
 std::string PersistentCache::SkKeyToFilePath(const SkData& key) {
   if (key.data() == nullptr || key.size() == 0) {
     return "";
@@ -129,10 +207,10 @@ static void FreeOldCacheDirectory(const fml::UniqueFD& cache_base_dir) {
   });
 }
 
-static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
+static fml::UniqueFD MakeCacheDirectory(
     const std::string& global_cache_base_path,
-    bool read_only,
-    bool cache_sksl) {
+    const std::vector<std::string>& subdirectories,
+    bool read_only) {
   fml::UniqueFD cache_base_dir;
   if (global_cache_base_path.length()) {
     cache_base_dir = fml::OpenDirectory(global_cache_base_path.c_str(), false,
@@ -143,21 +221,37 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
 
   if (cache_base_dir.is_valid()) {
     FreeOldCacheDirectory(cache_base_dir);
-    std::vector<std::string> components = {
-        kEngineComponent, GetFlutterEngineVersion(), "skia", GetSkiaVersion()};
-    if (cache_sksl) {
-      components.push_back(PersistentCache::kSkSLSubdirName);
-    }
-    return std::make_shared<fml::UniqueFD>(
-        CreateDirectory(cache_base_dir, components,
-                        read_only ? fml::FilePermission::kRead
-                                  : fml::FilePermission::kReadWrite));
+    std::vector<std::string> components = {kEngineComponent,
+                                           GetFlutterEngineVersion()};
+    components.insert(components.end(), subdirectories.begin(),
+                      subdirectories.end());
+    return CreateDirectory(cache_base_dir, components,
+                           read_only ? fml::FilePermission::kRead
+                                     : fml::FilePermission::kReadWrite);
   } else {
-    return std::make_shared<fml::UniqueFD>();
+    return fml::UniqueFD();
+  }
+}
+
+static std::shared_ptr<fml::UniqueFD> MakeSkiaCacheDirectory(
+    const std::string& global_cache_base_path,
+    bool read_only,
+    bool cache_sksl) {
+  std::vector<std::string> subdirectories = {"skia", GetSkiaVersion()};
+  if (cache_sksl) {
+    subdirectories.push_back(PersistentCache::kSkSLSubdirName);
   }
+  return std::make_shared<fml::UniqueFD>(
+      MakeCacheDirectory(global_cache_base_path, subdirectories, read_only));
 }
 }  // namespace
 
+fml::UniqueFD PersistentCache::MakeImpellerCacheDirectory(
+    const std::string& backend_name) {
+  return MakeCacheDirectory(cache_base_path_, {"impeller", backend_name},
+                            gIsReadOnly);
+}
+
 sk_sp<SkData> ParseBase32(const std::string& input) {
   std::pair<bool, std::string> decode_result = fml::Base32Decode(input);
   if (!decode_result.first) {
@@ -218,6 +312,113 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   return precompiled_count;
 }
 
+PersistentCache::SkSLWarmUp::SkSLWarmUp(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    Precompiler precompile)
+    : task_runner_(std::move(task_runner)),
+      precompile_(std::move(precompile)) {}
+
+PersistentCache::SkSLWarmUp::~SkSLWarmUp() = default;
+
+void PersistentCache::SkSLWarmUp::ReportFirstUse() {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  if (is_first_use_reported_) {
+    return;
+  }
+  is_first_use_reported_ = true;
+  FML_TRACE_COUNTER("flutter", "PersistentCache::SkSLsWarmedBeforeFirstUse",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Warmed", warmed_count_, "Pending",
+                    sksls_.size() - next_index_);
+}
+
+void PersistentCache::SkSLWarmUp::Cancel() {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  if (IsDone()) {
+    return;
+  }
+  is_cancelled_ = true;
+  TraceWarmedCount();
+}
+
+bool PersistentCache::SkSLWarmUp::IsDone() const {
+  return is_cancelled_ || (is_loaded_ && next_index_ == sksls_.size());
+}
+
+void PersistentCache::SkSLWarmUp::TraceWarmedCount() const {
+  FML_TRACE_COUNTER("flutter", "PersistentCache::WarmedUpSkSLs",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Warmed", warmed_count_, "Skipped",
+                    sksls_.size() - next_index_);
+}
+
+void PersistentCache::SkSLWarmUp::PrecompileNext(
+    const std::weak_ptr<SkSLWarmUp>& weak_warm_up) {
+  auto warm_up = weak_warm_up.lock();
+  if (!warm_up || warm_up->IsDone()) {
+    return;
+  }
+
+  {
+    TRACE_EVENT0("flutter", "PrecompilingSkSL");
+    SkSLCache& sksl = warm_up->sksls_[warm_up->next_index_++];
+    if (warm_up->precompile_(sksl)) {
+      warm_up->warmed_count_++;
+    }
+    // Warm-ups can be kept for as long as their context, so the SkSL is
+    // released as soon as it is not needed anymore.
+    sksl = {};
+  }
+
+  if (warm_up->is_cancelled_) {
+    return;
+  }
+  if (warm_up->IsDone()) {
+    warm_up->TraceWarmedCount();
+    return;
+  }
+  // Frames posted meanwhile run before the next SkSL is precompiled.
+  warm_up->task_runner_->PostTask(
+      [weak_warm_up]() { PrecompileNext(weak_warm_up); });
+}
+
+std::shared_ptr<PersistentCache::SkSLWarmUp> PersistentCache::StartSkSLWarmUp(
+    const fml::RefPtr<fml::TaskRunner>& context_task_runner,
+    SkSLWarmUp::Precompiler precompile) {
+  std::shared_ptr<SkSLWarmUp> warm_up(
+      new SkSLWarmUp(context_task_runner, std::move(precompile)));
+
+  auto load = [weak_warm_up = std::weak_ptr<SkSLWarmUp>(warm_up),
+               context_task_runner]() {
+    auto known_sksls = GetCacheForProcess()->LoadSkSLs();
+    // A trace must be present even if no precompilations have been completed.
+    FML_TRACE_EVENT("flutter", "PersistentCache::StartSkSLWarmUp", "count",
+                    known_sksls.size());
+    context_task_runner->PostTask(fml::MakeCopyable(
+        [weak_warm_up, known_sksls = std::move(known_sksls)]() mutable {
+          auto warm_up = weak_warm_up.lock();
+          if (!warm_up || warm_up->is_cancelled_) {
+            return;
+          }
+          warm_up->sksls_ = std::move(known_sksls);
+          warm_up->is_loaded_ = true;
+          if (warm_up->IsDone()) {
+            warm_up->TraceWarmedCount();
+            return;
+          }
+          PrecompileNext(weak_warm_up);
+        }));
+  };
+
+  auto worker = GetCacheForProcess()->GetWorkerTaskRunner();
+  if (worker) {
+    worker->PostTask(std::move(load));
+  } else {
+    load();
+  }
+  return warm_up;
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
@@ -272,14 +473,34 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     }
   }
 
-  return result;
+  // The shaders used in most runs are the likeliest to be needed by the first
+  // frames, so they are precompiled first.
+  std::vector<uint32_t> use_counts;
+  use_counts.reserve(result.size());
+  for (const auto& sksl : result) {
+    use_counts.push_back(sksl_usage_->GetUseCount(SkKeyToFilePath(*sksl.key)));
+  }
+  std::vector<size_t> order(result.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&use_counts](size_t a, size_t b) {
+                     return use_counts[a] > use_counts[b];
+                   });
+  std::vector<PersistentCache::SkSLCache> ordered_result;
+  ordered_result.reserve(result.size());
+  for (size_t index : order) {
+    ordered_result.push_back(std::move(result[index]));
+  }
+  return ordered_result;
 }
 
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
-      cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
+      cache_directory_(
+          MakeSkiaCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeSkiaCacheDirectory(cache_base_path_, read_only, true)),
+      sksl_usage_(std::make_shared<SkSLUsage>(*cache_directory_)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -336,6 +557,7 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (file_name.empty()) {
     return nullptr;
   }
+  RecordSkSLUse(file_name);
   auto result =
       PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
@@ -467,6 +689,24 @@ fml::RefPtr<fml::TaskRunner> PersistentCache::GetWorkerTaskRunner() const {
   return worker;
 }
 
+void PersistentCache::RecordSkSLUse(const std::string& file_name) {
+  if (is_read_only_ || !sksl_usage_->RecordUse(file_name)) {
+    return;
+  }
+  // Without a worker, the use is written along with a later one.
+  auto worker = GetWorkerTaskRunner();
+  if (!worker || !sksl_usage_->BeginStore()) {
+    return;
+  }
+  worker->PostTask([usage = sksl_usage_, cache_directory = cache_directory_]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStoreSkSLUsage");
+    if (!fml::WriteAtomically(*cache_directory, kSkSLUsageFileName,
+                              *usage->EndStore())) {
+      FML_LOG(WARNING) << "Could not write the SkSL usage to persistent store.";
+    }
+  });
+}
+
 void PersistentCache::SetAssetManager(std::shared_ptr<AssetManager> value) {
   TRACE_EVENT_INSTANT0("flutter", "PersistentCache::SetAssetManager");
   asset_manager_ = std::move(value);
@@ -5,9 +5,12 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
@@ -43,6 +46,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // affect the cache directory returned by |GetCacheForProcess|.
   static void SetCacheDirectoryPath(std::string path);
 
+  // Open the directory in which the Impeller backend with the given name
+  // persists its caches. Like the Skia caches, it is specific to the engine
+  // version, and the caches of other engine versions are removed.
+  static fml::UniqueFD MakeImpellerCacheDirectory(
+      const std::string& backend_name);
+
   // Convert a binary SkData key into a Base32 encoded string.
   //
   // This is used to specify persistent cache filenames and service protocol
@@ -95,7 +104,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
     sk_sp<SkData> value;
   };
 
-  /// Load all the SkSL shader caches in the right directory.
+  /// Load all the SkSL shader caches in the right directory, ordered by how
+  /// often they were used in previous runs, most used first.
   std::vector<SkSLCache> LoadSkSLs() const;
 
   //----------------------------------------------------------------------------
@@ -113,6 +123,96 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      A warm-up of the known SkSLs started by |StartSkSLWarmUp|.
+  ///             It is cancelled when the last reference to it is dropped,
+  ///             so it should be owned by the owner of the rendering context.
+  ///
+  class SkSLWarmUp {
+   public:
+    /// Precompiles an SkSL in the rendering context and returns whether it
+    /// succeeded.
+    using Precompiler = std::function<bool(const SkSLCache& sksl)>;
+
+    ~SkSLWarmUp();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Reports in the trace how many SkSLs were warmed up before
+    ///             the first frame used the rendering context. Only the first
+    ///             call reports. The warm-up goes on between the frames.
+    ///
+    ///             This must be called on the thread of the rendering context.
+    ///
+    void ReportFirstUse();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Stops the warm-up. The number of SkSLs that were warmed up
+    ///             before then is reported in the trace.
+    ///
+    ///             This must be called on the thread of the rendering context.
+    ///
+    void Cancel();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Whether every SkSL was precompiled or the warm-up was
+    ///             cancelled. This must be called on the thread of the
+    ///             rendering context.
+    ///
+    bool IsDone() const;
+
+    //--------------------------------------------------------------------------
+    /// @brief      The number of SkSLs precompiled so far. This must be called
+    ///             on the thread of the rendering context.
+    ///
+    size_t GetWarmedCount() const { return warmed_count_; }
+
+   private:
+    friend PersistentCache;
+
+    const fml::RefPtr<fml::TaskRunner> task_runner_;
+    const Precompiler precompile_;
+    std::vector<SkSLCache> sksls_;
+    bool is_loaded_ = false;
+    bool is_cancelled_ = false;
+    bool is_first_use_reported_ = false;
+    size_t next_index_ = 0;
+    size_t warmed_count_ = 0;
+
+    SkSLWarmUp(fml::RefPtr<fml::TaskRunner> task_runner,
+               Precompiler precompile);
+
+    static void PrecompileNext(const std::weak_ptr<SkSLWarmUp>& weak_warm_up);
+
+    void TraceWarmedCount() const;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(SkSLWarmUp);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts precompiling the known SkSLs without blocking the
+  ///             thread of the rendering context until all of them are.
+  ///
+  ///             The SkSLs of the cache for the process are loaded on one of
+  ///             its workers, in the order of |LoadSkSLs|. Each of them is
+  ///             then precompiled in its own task on |context_task_runner|,
+  ///             so that a frame that needs the rendering context waits for
+  ///             at most one of them, and the warm-up goes on between frames.
+  ///
+  ///             Skia keeps the programs it compiles per context, so the
+  ///             SkSLs cannot be precompiled on other threads with contexts
+  ///             of their own.
+  ///
+  /// @param[in]  context_task_runner  The task runner of the thread of the
+  ///                                  rendering context.
+  /// @param[in]  precompile           Precompiles an SkSL in the rendering
+  ///                                  context.
+  ///
+  /// @return     The warm-up, which must be kept alive until it is done.
+  ///
+  static std::shared_ptr<SkSLWarmUp> StartSkSLWarmUp(
+      const fml::RefPtr<fml::TaskRunner>& context_task_runner,
+      SkSLWarmUp::Precompiler precompile);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -131,8 +231,13 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  // The number of runs in which Skia loaded each shader from the cache, which
+  // orders the SkSLs to warm up. Stored next to the Skia cache.
+  static constexpr char kSkSLUsageFileName[] = "io.flutter.sksl_usage";
 
  private:
+  class SkSLUsage;
+
   static std::string cache_base_path_;
 
   static std::shared_ptr<AssetManager> asset_manager_;
@@ -153,6 +258,7 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<SkSLUsage> sksl_usage_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
@@ -172,6 +278,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  void RecordSkSLUse(const std::string& file_name);
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
@@ -143,6 +143,12 @@ struct Settings {
   // the VM service isolate.
   std::vector<std::string> vmservice_snapshot_library_path;
 
+  // Path to a file recording which pages of the snapshots were resident after
+  // the application launched. If the file exists, those pages are read ahead
+  // before the VM starts. Otherwise, or if the snapshots changed, the file is
+  // written after the first frame. See `SnapshotPageProfile`.
+  std::string snapshot_page_profile_path;
+
   std::string application_kernel_asset;       // deprecated
   std::string application_kernel_list_asset;  // deprecated
   MappingsCallback application_kernels;
@@ -158,6 +164,8 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // Record trace events into per-thread ring buffers instead of the timeline.
+  bool trace_to_ring_buffer = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -250,6 +258,12 @@ struct Settings {
   // Enable GPU tracing in Vulkan backends.
   bool enable_vulkan_gpu_tracing = false;
 
+  // Coalesce move and hover events of the same pointer that arrive while a
+  // previous pointer data packet is still being handled by the framework. The
+  // replaced samples are delivered as the historical samples of the event
+  // they were coalesced into. See `PointerDataCoalescer`.
+  bool enable_pointer_event_coalescing = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 namespace fml {
 namespace tracing {
@@ -27,7 +28,18 @@ AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
-inline void FlutterTimelineEvent(const char* label,
+// The timestamp of an event that does not come with its own. The ring buffer
+// records every event against |TimePoint|, which the events that do come with
+// a timestamp use, so that the begin and end of an event share one clock.
+int64_t GetTimelineMicros() {
+  if (TraceRingBufferIsEnabled()) {
+    return TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  }
+  return gTimelineMicrosSource.load()();
+}
+
+inline void FlutterTimelineEvent(const char* category_group,
+                                 const char* label,
                                  int64_t timestamp0,
                                  int64_t timestamp1_or_async_id,
                                  intptr_t flow_id_count,
@@ -36,6 +48,17 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  if (TraceRingBufferIsEnabled()) {
+    TraceRecordArg args[kTraceRecordMaxArgs];
+    const size_t arg_count =
+        std::min(static_cast<size_t>(argument_count), kTraceRecordMaxArgs);
+    for (size_t i = 0; i < arg_count; i++) {
+      args[i] = TraceRecordArg(argument_names[i], argument_values[i]);
+    }
+    TraceRingBufferRecord(category_group, label, timestamp0,
+                          timestamp1_or_async_id, type, args, arg_count);
+    return;
+  }
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
   if (handler && gAllowlist.Query(label)) {
@@ -90,6 +113,7 @@ void TraceTimelineEvent(TraceArg category_group,
   }
 
   FlutterTimelineEvent(
+      category_group,                              // category_group
       name,                                        // label
       timestamp_micros,                            // timestamp0
       identifier,                                  // timestamp1_or_async_id
@@ -112,7 +136,7 @@ void TraceTimelineEvent(TraceArg category_group,
                         const std::vector<std::string>& values) {
   TraceTimelineEvent(category_group,                  // group
                      name,                            // name
-                     gTimelineMicrosSource.load()(),  // timestamp_micros
+                     GetTimelineMicros(),             // timestamp_micros
                      identifier,                      // identifier
                      flow_id_count,                   // flow_id_count
                      flow_ids,                        // flow_ids
@@ -126,8 +150,9 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -146,8 +171,9 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -168,8 +194,9 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -181,8 +208,9 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(nullptr,                         // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,                        // timestamp1_or_async_id
                        0,                        // flow_id_count
                        nullptr,                  // flow_ids
@@ -198,8 +226,9 @@ void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceIDArg id,
                            size_t flow_id_count,
                            const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -213,8 +242,9 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -234,8 +264,9 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,             // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -253,8 +284,9 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -269,8 +301,9 @@ void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -289,8 +322,9 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -311,8 +345,9 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        0,              // timestamp1_or_async_id
                        flow_id_count,  // flow_id_count
                        reinterpret_cast<const int64_t*>(flow_ids),  // flow_ids
@@ -326,8 +361,9 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,       // timestamp1_or_async_id
                        0,        // flow_id_count
                        nullptr,  // flow_ids
@@ -341,8 +377,9 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,                             // timestamp1_or_async_id
                        0,                              // flow_id_count
                        nullptr,                        // flow_ids
@@ -354,8 +391,9 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
-  FlutterTimelineEvent(name,                            // label
-                       gTimelineMicrosSource.load()(),  // timestamp0
+  FlutterTimelineEvent(category_group,                  // category_group
+                       name,                            // label
+                       GetTimelineMicros(),             // timestamp0
                        id,                            // timestamp1_or_async_id
                        0,                             // flow_id_count
                        nullptr,                       // flow_ids
@@ -61,6 +61,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -306,6 +307,12 @@ void TraceCounter(TraceArg category,
                   TraceIDArg identifier,
                   Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecordWithArgs(
+        category, name, TimePoint::Now().ToEpochDelta().ToMicroseconds(),
+        identifier, Dart_Timeline_Event_Counter, args...);
+    return;
+  }
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, identifier, /*flow_id_count=*/0,
                      /*flow_ids=*/nullptr, Dart_Timeline_Event_Counter,
@@ -328,6 +335,12 @@ void TraceEvent(TraceArg category,
                 const uint64_t* flow_ids,
                 Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecordWithArgs(
+        category, name, TimePoint::Now().ToEpochDelta().ToMicroseconds(), 0,
+        Dart_Timeline_Event_Begin, args...);
+    return;
+  }
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
                      Dart_Timeline_Event_Begin, split.first, split.second);
@@ -365,7 +378,6 @@ void TraceEventAsyncComplete(TraceArg category_group,
                              Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
   auto identifier = TraceNonce();
-  const auto split = SplitArguments(args...);
 
   if (begin > end) {
     std::swap(begin, end);
@@ -374,6 +386,17 @@ void TraceEventAsyncComplete(TraceArg category_group,
   const int64_t begin_micros = begin.ToEpochDelta().ToMicroseconds();
   const int64_t end_micros = end.ToEpochDelta().ToMicroseconds();
 
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecordWithArgs(category_group, name, begin_micros,
+                                  identifier, Dart_Timeline_Event_Async_Begin,
+                                  args...);
+    TraceRingBufferRecordWithArgs(category_group, name, end_micros, identifier,
+                                  Dart_Timeline_Event_Async_End, args...);
+    return;
+  }
+
+  const auto split = SplitArguments(args...);
+
   TraceTimelineEvent(category_group,                   // group
                      name,                             // name
                      begin_micros,                     // timestamp_micros
@@ -0,0 +1,475 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+namespace tracing {
+
+static_assert((kTraceRingBufferCapacity & (kTraceRingBufferCapacity - 1)) == 0,
+              "The capacity must be a power of two.");
+
+namespace {
+
+std::atomic_bool gRingBufferEnabled = false;
+
+// Stands in for the strings that did not fit into the table.
+constexpr std::string_view kDroppedString = "(dropped)";
+constexpr uint32_t kDroppedStringId = 1u;
+
+class StringTable {
+ public:
+  StringTable() { Intern(kDroppedString); }
+
+  // Returns |kDroppedStringId| once the table is full.
+  uint32_t Intern(std::string_view string) {
+    std::scoped_lock lock(mutex_);
+    auto found = ids_.find(string);
+    if (found != ids_.end()) {
+      return found->second;
+    }
+    if (strings_.size() >= kTraceMaxInternedStrings) {
+      return kDroppedStringId;
+    }
+    const auto& stored = strings_.emplace_back(string);
+    const auto id = static_cast<uint32_t>(strings_.size());
+    ids_[stored] = id;
+    return id;
+  }
+
+  // The interned strings, indexed by id - 1.
+  std::vector<std::string> GetStrings() const {
+    std::scoped_lock lock(mutex_);
+    return {strings_.begin(), strings_.end()};
+  }
+
+  // The storage of the string with the given id, which remains valid for the
+  // lifetime of the process.
+  std::string_view GetStorage(uint32_t id) const {
+    std::scoped_lock lock(mutex_);
+    return strings_[id - 1];
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  // A deque so that interned strings never move.
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+StringTable& GetStringTable() {
+  static auto* table = new StringTable();
+  return *table;
+}
+
+// A record guarded by a sequence lock. The record is stored as atomic words so
+// that a reader racing with the writer copies torn words, which it detects and
+// discards, instead of racing on the record itself.
+struct RecordSlot {
+  static constexpr size_t kWordCount =
+      (sizeof(TraceRecord) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  // Twice the number of records written to the slot, plus one while a record
+  // is being written.
+  std::atomic<uint64_t> sequence = 0u;
+  std::array<std::atomic<uint64_t>, kWordCount> words = {};
+};
+
+static_assert(std::is_trivially_copyable_v<TraceRecord>,
+              "Records are copied word by word.");
+
+// The ring buffer of a single thread. Only the owning thread writes records.
+class ThreadRingBuffer {
+ public:
+  explicit ThreadRingBuffer(uint32_t thread_index)
+      : thread_index_(thread_index),
+        slots_(std::make_unique<RecordSlot[]>(kTraceRingBufferCapacity)) {}
+
+  uint32_t GetThreadIndex() const {
+    return thread_index_.load(std::memory_order_relaxed);
+  }
+
+  // Hands the buffer to a new thread. The records of the previous thread are
+  // discarded, but the slot sequences carry on so that concurrent exports
+  // still detect overwritten records.
+  void Reuse(uint32_t thread_index) {
+    Clear();
+    thread_index_.store(thread_index, std::memory_order_relaxed);
+  }
+
+  void Write(const TraceRecord& record) {
+    const uint64_t index = write_index_.load(std::memory_order_relaxed);
+    RecordSlot& slot = slots_[index & (kTraceRingBufferCapacity - 1)];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[RecordSlot::kWordCount] = {};
+    std::memcpy(words, &record, sizeof(TraceRecord));
+    for (size_t i = 0; i < RecordSlot::kWordCount; i++) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    write_index_.store(index + 1, std::memory_order_release);
+  }
+
+  std::vector<TraceRecord> Snapshot() const {
+    const uint64_t end = write_index_.load(std::memory_order_acquire);
+    uint64_t begin = std::max(first_index_.load(std::memory_order_acquire),
+                              end > kTraceRingBufferCapacity
+                                  ? end - kTraceRingBufferCapacity
+                                  : 0u);
+    std::vector<TraceRecord> records;
+    records.reserve(end - begin);
+    for (auto index = begin; index < end; index++) {
+      TraceRecord record;
+      if (Read(index, record)) {
+        records.push_back(record);
+      }
+    }
+    return records;
+  }
+
+  void Clear() {
+    first_index_.store(write_index_.load(std::memory_order_acquire),
+                       std::memory_order_release);
+  }
+
+ private:
+  std::atomic<uint32_t> thread_index_;
+  std::unique_ptr<RecordSlot[]> slots_;
+  std::atomic<uint64_t> write_index_ = 0u;
+  std::atomic<uint64_t> first_index_ = 0u;
+
+  // Copies the record with the given index, unless it has been overwritten
+  // or is being overwritten.
+  bool Read(uint64_t index, TraceRecord& record) const {
+    const RecordSlot& slot = slots_[index & (kTraceRingBufferCapacity - 1)];
+    const uint64_t expected = 2u * (index / kTraceRingBufferCapacity + 1u);
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+      return false;
+    }
+
+    uint64_t words[RecordSlot::kWordCount];
+    for (size_t i = 0; i < RecordSlot::kWordCount; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+      return false;
+    }
+    std::memcpy(&record, words, sizeof(TraceRecord));
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadRingBuffer);
+};
+
+class RingBufferRegistry {
+ public:
+  std::shared_ptr<ThreadRingBuffer> AcquireBuffer() {
+    std::scoped_lock lock(mutex_);
+    const auto thread_index = ++last_thread_index_;
+    std::shared_ptr<ThreadRingBuffer> buffer;
+    if (!free_buffers_.empty()) {
+      buffer = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+      buffer->Reuse(thread_index);
+    } else {
+      buffer = std::make_shared<ThreadRingBuffer>(thread_index);
+    }
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  // Called when the thread that owns the buffer exits. The records of the
+  // most recently exited threads are kept for export. Older buffers are
+  // recycled for new threads, or released if enough are already waiting.
+  void RetireBuffer(std::shared_ptr<ThreadRingBuffer> buffer) {
+    std::scoped_lock lock(mutex_);
+    retired_buffers_.push_back(std::move(buffer));
+    if (retired_buffers_.size() <= kTraceMaxRetiredThreadBuffers) {
+      return;
+    }
+    auto oldest = std::move(retired_buffers_.front());
+    retired_buffers_.pop_front();
+    buffers_.erase(std::find(buffers_.begin(), buffers_.end(), oldest));
+    if (free_buffers_.size() < kTraceMaxRetiredThreadBuffers) {
+      free_buffers_.push_back(std::move(oldest));
+    }
+  }
+
+  std::vector<std::shared_ptr<ThreadRingBuffer>> GetBuffers() const {
+    std::scoped_lock lock(mutex_);
+    return buffers_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  uint32_t last_thread_index_ = 0u;
+  // The buffers of live threads and of recently exited threads, which are
+  // kept so that their records can be exported.
+  std::vector<std::shared_ptr<ThreadRingBuffer>> buffers_;
+  // The buffers of exited threads that are still exported, oldest first.
+  std::deque<std::shared_ptr<ThreadRingBuffer>> retired_buffers_;
+  // Buffers that are no longer exported, waiting for a new thread.
+  std::vector<std::shared_ptr<ThreadRingBuffer>> free_buffers_;
+};
+
+RingBufferRegistry& GetRegistry() {
+  static auto* registry = new RingBufferRegistry();
+  return *registry;
+}
+
+// Owns the ring buffer of a thread and retires it when the thread exits.
+class ThreadRingBufferOwner {
+ public:
+  ThreadRingBufferOwner() : buffer_(GetRegistry().AcquireBuffer()) {}
+
+  ~ThreadRingBufferOwner() { GetRegistry().RetireBuffer(std::move(buffer_)); }
+
+  ThreadRingBuffer& Get() const { return *buffer_; }
+
+ private:
+  std::shared_ptr<ThreadRingBuffer> buffer_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadRingBufferOwner);
+};
+
+ThreadRingBuffer& GetThreadRingBuffer() {
+  thread_local ThreadRingBufferOwner owner;
+  return owner.Get();
+}
+
+uint32_t InternString(const char* string) {
+  return string ? TraceRingBufferInternString(string) : 0u;
+}
+
+const char* GetPhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return "i";
+  }
+}
+
+bool HasId(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void WriteJSONString(std::ostream& stream, std::string_view string) {
+  stream << '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          stream << escaped;
+        } else {
+          stream << c;
+        }
+    }
+  }
+  stream << '"';
+}
+
+void WriteJSONArgValue(std::ostream& stream, const TraceRecordArg& arg) {
+  switch (arg.kind) {
+    case TraceRecordArg::Kind::kInt:
+      stream << arg.int_value;
+      break;
+    case TraceRecordArg::Kind::kUint:
+      stream << arg.uint_value;
+      break;
+    case TraceRecordArg::Kind::kDouble:
+      stream << arg.double_value;
+      break;
+    case TraceRecordArg::Kind::kString:
+      WriteJSONString(stream,
+                      std::string_view(arg.string_value,
+                                       strnlen(arg.string_value,
+                                               kTraceRecordMaxStringLength)));
+      break;
+  }
+}
+
+}  // namespace
+
+TraceRecordArg::TraceRecordArg(const char* arg_name, const char* value)
+    : TraceRecordArg() {
+  name = InternString(arg_name);
+  kind = Kind::kString;
+  std::memset(string_value, 0, sizeof(string_value));
+  if (value) {
+    std::strncpy(string_value, value, kTraceRecordMaxStringLength - 1);
+  }
+}
+
+void TraceRingBufferSetEnabled(bool enabled) {
+  gRingBufferEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRingBufferIsEnabled() {
+  return gRingBufferEnabled.load(std::memory_order_relaxed);
+}
+
+uint32_t TraceRingBufferInternString(std::string_view string) {
+  // Keys point into the storage of the shared table, which never moves.
+  thread_local std::unordered_map<std::string_view, uint32_t> cache;
+  auto found = cache.find(string);
+  if (found != cache.end()) {
+    return found->second;
+  }
+  auto& table = GetStringTable();
+  const auto id = table.Intern(string);
+  // The cache keys must point into the table, so strings that did not fit are
+  // not cached.
+  if (id != kDroppedStringId) {
+    cache[table.GetStorage(id)] = id;
+  }
+  return id;
+}
+
+void TraceRingBufferRecord(const char* category,
+                           const char* name,
+                           int64_t timestamp_micros,
+                           int64_t id,
+                           Dart_Timeline_Event_Type type,
+                           const TraceRecordArg* args,
+                           size_t arg_count) {
+  TraceRecord record;
+  record.timestamp_micros = timestamp_micros;
+  record.id = id;
+  record.category = InternString(category);
+  record.name = InternString(name);
+  record.type = type;
+  record.arg_count = std::min(arg_count, kTraceRecordMaxArgs);
+  std::copy(args, args + record.arg_count, record.args.begin());
+  GetThreadRingBuffer().Write(record);
+}
+
+std::string TraceRingBufferExportJSON() {
+  std::vector<std::pair<uint32_t, std::vector<TraceRecord>>> threads;
+  for (const auto& buffer : GetRegistry().GetBuffers()) {
+    threads.emplace_back(buffer->GetThreadIndex(), buffer->Snapshot());
+  }
+  // Records may reference strings interned after they were copied, so fetch
+  // the table last.
+  const auto strings = GetStringTable().GetStrings();
+  auto get_string = [&strings](uint32_t id) -> std::string_view {
+    if (id == 0u || id > strings.size()) {
+      return {};
+    }
+    return strings[id - 1];
+  };
+
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& [thread_index, records] : threads) {
+    for (const auto& record : records) {
+      if (!first) {
+        stream << ",";
+      }
+      first = false;
+      stream << "{\"name\":";
+      WriteJSONString(stream, get_string(record.name));
+      stream << ",\"cat\":";
+      WriteJSONString(stream, get_string(record.category));
+      stream << ",\"ph\":\"" << GetPhase(record.type) << "\"";
+      stream << ",\"ts\":" << record.timestamp_micros;
+      stream << ",\"pid\":1,\"tid\":" << thread_index;
+      if (HasId(record.type)) {
+        stream << ",\"id\":" << record.id;
+      }
+      if (record.type == Dart_Timeline_Event_Instant) {
+        stream << ",\"s\":\"t\"";
+      }
+      if (record.arg_count > 0) {
+        stream << ",\"args\":{";
+        for (auto i = 0u; i < record.arg_count; i++) {
+          if (i > 0) {
+            stream << ",";
+          }
+          WriteJSONString(stream, get_string(record.args[i].name));
+          stream << ":";
+          WriteJSONArgValue(stream, record.args[i]);
+        }
+        stream << "}";
+      }
+      stream << "}";
+    }
+  }
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+  return stream.str();
+}
+
+void TraceRingBufferClear() {
+  for (const auto& buffer : GetRegistry().GetBuffers()) {
+    buffer->Clear();
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
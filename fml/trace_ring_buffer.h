@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "flutter/fml/time/time_point.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+// A low overhead alternative to forwarding trace events to the Dart timeline.
+//
+// While enabled, trace events are written as fixed size binary records into a
+// ring buffer owned by the recording thread. Names are interned and numeric
+// arguments are stored as-is, so recording an event neither allocates nor
+// formats strings, nor takes a lock once the thread has seen the names
+// before. The most recent events of every thread can be exported as Chrome
+// JSON, which Perfetto's trace viewer can open.
+//
+// The allowlist set with |TraceSetAllowlist| does not apply to the ring
+// buffer, and flow ids are not recorded.
+
+namespace fml {
+namespace tracing {
+
+/// The number of records kept per thread. Older records are overwritten.
+/// Records overwritten while they are being exported are left out.
+constexpr size_t kTraceRingBufferCapacity = 4096u;
+
+/// The number of arguments stored per record. Further arguments are dropped.
+constexpr size_t kTraceRecordMaxArgs = 4u;
+
+/// The length of string argument values stored per record, including the
+/// terminator. Longer values are truncated.
+constexpr size_t kTraceRecordMaxStringLength = 16u;
+
+/// The number of distinct names, categories and argument names that are
+/// interned. Further strings are recorded as "(dropped)".
+constexpr size_t kTraceMaxInternedStrings = 8192u;
+
+/// The number of exited threads whose records are kept for export. The ring
+/// buffers of threads that exited before them are reused by new threads or
+/// released.
+constexpr size_t kTraceMaxRetiredThreadBuffers = 8u;
+
+struct TraceRecordArg {
+  enum class Kind : uint8_t {
+    kInt,
+    kUint,
+    kDouble,
+    kString,
+  };
+
+  /// Interned with |TraceRingBufferInternString|.
+  uint32_t name = 0u;
+  Kind kind = Kind::kInt;
+  union {
+    int64_t int_value;
+    uint64_t uint_value;
+    double double_value;
+    char string_value[kTraceRecordMaxStringLength];
+  };
+
+  TraceRecordArg() : int_value(0) {}
+
+  TraceRecordArg(const char* arg_name, const char* value);
+
+  TraceRecordArg(const char* arg_name, const std::string& value)
+      : TraceRecordArg(arg_name, value.c_str()) {}
+
+  TraceRecordArg(const char* arg_name, TimePoint value)
+      : TraceRecordArg(arg_name, value.ToEpochDelta().ToNanoseconds()) {}
+
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+  TraceRecordArg(const char* arg_name, T value);
+};
+
+struct TraceRecord {
+  int64_t timestamp_micros = 0;
+  /// The async, flow or counter id of the event.
+  int64_t id = 0;
+  uint32_t category = 0u;
+  uint32_t name = 0u;
+  Dart_Timeline_Event_Type type = Dart_Timeline_Event_Begin;
+  uint32_t arg_count = 0u;
+  std::array<TraceRecordArg, kTraceRecordMaxArgs> args;
+};
+
+void TraceRingBufferSetEnabled(bool enabled);
+
+bool TraceRingBufferIsEnabled();
+
+//------------------------------------------------------------------------------
+/// @brief      Get the id of a string, adding it to the table of interned
+///             strings if this is the first time it is seen. Lock free if the
+///             calling thread has interned the string before.
+///
+uint32_t TraceRingBufferInternString(std::string_view string);
+
+//------------------------------------------------------------------------------
+/// @brief      Append a record to the ring buffer of the calling thread.
+///
+/// @param[in]  timestamp_micros  The time of the event, in the time base of
+///                               |TimePoint|.
+///
+void TraceRingBufferRecord(const char* category,
+                           const char* name,
+                           int64_t timestamp_micros,
+                           int64_t id,
+                           Dart_Timeline_Event_Type type,
+                           const TraceRecordArg* args,
+                           size_t arg_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Export the records of all threads in the Chrome JSON trace
+///             event format. Safe to call while other threads are recording.
+///
+std::string TraceRingBufferExportJSON();
+
+//------------------------------------------------------------------------------
+/// @brief      Discard the records of all threads.
+///
+void TraceRingBufferClear();
+
+template <typename T, typename>
+TraceRecordArg::TraceRecordArg(const char* arg_name, T value)
+    : TraceRecordArg() {
+  name = TraceRingBufferInternString(arg_name);
+  if constexpr (std::is_floating_point_v<T>) {
+    kind = Kind::kDouble;
+    double_value = value;
+  } else if constexpr (std::is_signed_v<T>) {
+    kind = Kind::kInt;
+    int_value = value;
+  } else {
+    kind = Kind::kUint;
+    uint_value = value;
+  }
+}
+
+inline void TraceRecordArgsCollect(TraceRecordArg* args, size_t& count) {}
+
+template <typename Key, typename Value, typename... Args>
+void TraceRecordArgsCollect(TraceRecordArg* args,
+                            size_t& count,
+                            Key key,
+                            Value value,
+                            Args... rest) {
+  if (count == kTraceRecordMaxArgs) {
+    return;
+  }
+  args[count++] = TraceRecordArg(key, value);
+  TraceRecordArgsCollect(args, count, rest...);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Record an event with arguments given as alternating names and
+///             values, like |SplitArguments|, without formatting them.
+///
+template <typename... Args>
+void TraceRingBufferRecordWithArgs(const char* category,
+                                   const char* name,
+                                   int64_t timestamp_micros,
+                                   int64_t id,
+                                   Dart_Timeline_Event_Type type,
+                                   Args... args) {
+  std::array<TraceRecordArg, kTraceRecordMaxArgs> record_args;
+  size_t count = 0u;
+  TraceRecordArgsCollect(record_args.data(), count, args...);
+  TraceRingBufferRecord(category, name, timestamp_micros, id, type,
+                        record_args.data(), count);
+}
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
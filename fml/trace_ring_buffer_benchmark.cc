@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+void NopTimelineEventHandler(const char*,
+                             int64_t,
+                             int64_t,
+                             intptr_t,
+                             const int64_t*,
+                             Dart_Timeline_Event_Type,
+                             intptr_t,
+                             const char**,
+                             const char**) {}
+
+int64_t NopMicrosSource() {
+  return 0;
+}
+
+}  // namespace
+
+// The cost of a counter with numeric arguments when it is forwarded to a
+// timeline event handler, which formats every argument as a string.
+static void BM_TraceCounterToHandler(benchmark::State& state) {  // NOLINT
+  tracing::TraceSetTimelineMicrosSource(NopMicrosSource);
+  tracing::TraceSetTimelineEventHandler(NopTimelineEventHandler);
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    FML_TRACE_COUNTER("flutter", "BenchmarkCounter", 0, "frame", i++, "ratio",
+                      0.5);
+  }
+  tracing::TraceSetTimelineEventHandler(nullptr);
+}
+BENCHMARK(BM_TraceCounterToHandler);
+
+static void BM_TraceCounterToRingBuffer(benchmark::State& state) {  // NOLINT
+  tracing::TraceRingBufferSetEnabled(true);
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    FML_TRACE_COUNTER("flutter", "BenchmarkCounter", 0, "frame", i++, "ratio",
+                      0.5);
+  }
+  tracing::TraceRingBufferSetEnabled(false);
+}
+BENCHMARK(BM_TraceCounterToRingBuffer);
+
+static void BM_TraceEventToHandler(benchmark::State& state) {  // NOLINT
+  tracing::TraceSetTimelineMicrosSource(NopMicrosSource);
+  tracing::TraceSetTimelineEventHandler(NopTimelineEventHandler);
+  while (state.KeepRunning()) {
+    TRACE_EVENT0("flutter", "BenchmarkEvent");
+  }
+  tracing::TraceSetTimelineEventHandler(nullptr);
+}
+BENCHMARK(BM_TraceEventToHandler);
+
+static void BM_TraceEventToRingBuffer(benchmark::State& state) {  // NOLINT
+  tracing::TraceRingBufferSetEnabled(true);
+  while (state.KeepRunning()) {
+    TRACE_EVENT0("flutter", "BenchmarkEvent");
+  }
+  tracing::TraceRingBufferSetEnabled(false);
+}
+BENCHMARK(BM_TraceEventToRingBuffer);
+
+static void BM_TraceRingBufferExportJSON(benchmark::State& state) {  // NOLINT
+  tracing::TraceRingBufferSetEnabled(true);
+  for (size_t i = 0; i < tracing::kTraceRingBufferCapacity; i++) {
+    FML_TRACE_COUNTER("flutter", "BenchmarkCounter", 0, "frame", i);
+  }
+  tracing::TraceRingBufferSetEnabled(false);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(tracing::TraceRingBufferExportJSON());
+  }
+  tracing::TraceRingBufferClear();
+}
+BENCHMARK(BM_TraceRingBufferExportJSON)->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
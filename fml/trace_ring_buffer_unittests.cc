@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+size_t CountOccurrences(const std::string& string, const std::string& part) {
+  size_t count = 0u;
+  for (auto pos = string.find(part); pos != std::string::npos;
+       pos = string.find(part, pos + part.size())) {
+    count++;
+  }
+  return count;
+}
+
+class TraceRingBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TraceRingBufferClear();
+    TraceRingBufferSetEnabled(true);
+  }
+
+  void TearDown() override {
+    TraceRingBufferSetEnabled(false);
+    TraceRingBufferClear();
+  }
+};
+
+}  // namespace
+
+TEST_F(TraceRingBufferTest, InternsStrings) {
+  std::string name = "TraceRingBufferTest";
+  const auto id = TraceRingBufferInternString(name);
+  EXPECT_NE(id, 0u);
+  EXPECT_EQ(TraceRingBufferInternString("TraceRingBufferTest"), id);
+  EXPECT_NE(TraceRingBufferInternString("TraceRingBufferTest2"), id);
+
+  uint32_t other_thread_id = 0u;
+  std::thread([&other_thread_id]() {
+    other_thread_id = TraceRingBufferInternString("TraceRingBufferTest");
+  }).join();
+  EXPECT_EQ(other_thread_id, id);
+}
+
+TEST_F(TraceRingBufferTest, RecordsTraceEvents) {
+  {
+    TRACE_EVENT0("flutter", "RingBufferEvent");
+    FML_TRACE_COUNTER("flutter", "RingBufferCounter", 1234, "frames", 42,
+                      "ratio", 0.5);
+  }
+  const auto json = TraceRingBufferExportJSON();
+  EXPECT_NE(json.find("{\"name\":\"RingBufferEvent\",\"cat\":\"flutter\","
+                      "\"ph\":\"B\""),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("{\"name\":\"RingBufferEvent\",\"cat\":\"\","
+                      "\"ph\":\"E\""),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos) << json;
+  EXPECT_NE(json.find("\"args\":{\"frames\":42,\"ratio\":0.5}"),
+            std::string::npos)
+      << json;
+}
+
+TEST_F(TraceRingBufferTest, TruncatesStringArguments) {
+  TRACE_EVENT_INSTANT1("flutter", "RingBufferInstant", "label",
+                       "a \"long\" label that does not fit");
+  const auto json = TraceRingBufferExportJSON();
+  EXPECT_NE(json.find("\"args\":{\"label\":\"a \\\"long\\\" label \"}"),
+            std::string::npos)
+      << json;
+}
+
+TEST_F(TraceRingBufferTest, KeepsMostRecentRecords) {
+  for (size_t i = 0; i < kTraceRingBufferCapacity + 10; i++) {
+    FML_TRACE_COUNTER("flutter", "RingBufferOverflow", 0, "i", i);
+  }
+  const auto json = TraceRingBufferExportJSON();
+  EXPECT_EQ(CountOccurrences(json, "RingBufferOverflow"),
+            kTraceRingBufferCapacity);
+  EXPECT_EQ(json.find("{\"i\":9}"), std::string::npos);
+  EXPECT_NE(json.find("{\"i\":10}"), std::string::npos);
+  EXPECT_NE(json.find("{\"i\":" + std::to_string(kTraceRingBufferCapacity + 9) +
+                      "}"),
+            std::string::npos);
+
+  TraceRingBufferClear();
+  EXPECT_EQ(TraceRingBufferExportJSON().find("RingBufferOverflow"),
+            std::string::npos);
+}
+
+TEST_F(TraceRingBufferTest, ExportsRecordsOfExitedThreads) {
+  std::thread([]() {
+    TRACE_EVENT_INSTANT0("flutter", "RingBufferOtherThread");
+  }).join();
+  TRACE_EVENT_INSTANT0("flutter", "RingBufferThisThread");
+
+  const auto json = TraceRingBufferExportJSON();
+  const auto other_thread = json.find("RingBufferOtherThread");
+  const auto this_thread = json.find("RingBufferThisThread");
+  ASSERT_NE(other_thread, std::string::npos) << json;
+  ASSERT_NE(this_thread, std::string::npos) << json;
+  const auto tid = [&json](size_t pos) {
+    auto start = json.find("\"tid\":", pos);
+    return json.substr(start, json.find(',', start) - start);
+  };
+  EXPECT_NE(tid(other_thread), tid(this_thread));
+}
+
+TEST_F(TraceRingBufferTest, KeepsRecordsOfRecentlyExitedThreads) {
+  for (size_t i = 0; i < kTraceMaxRetiredThreadBuffers + 2; i++) {
+    std::thread([i]() {
+      FML_TRACE_COUNTER("flutter", "RingBufferExited", 0, "thread", i);
+    }).join();
+  }
+
+  const auto json = TraceRingBufferExportJSON();
+  EXPECT_EQ(CountOccurrences(json, "RingBufferExited"),
+            kTraceMaxRetiredThreadBuffers)
+      << json;
+  EXPECT_EQ(json.find("{\"thread\":1}"), std::string::npos) << json;
+  EXPECT_NE(json.find("{\"thread\":2}"), std::string::npos) << json;
+}
+
+TEST_F(TraceRingBufferTest, ExportsWhileRecording) {
+  std::atomic_bool done = false;
+  std::thread writer([&done]() {
+    for (size_t i = 0; !done.load(); i++) {
+      FML_TRACE_COUNTER("flutter", "RingBufferConcurrent", 0, "i", i);
+    }
+  });
+  for (size_t i = 0; i < 20; i++) {
+    const auto json = TraceRingBufferExportJSON();
+    // Records are either exported whole or not at all.
+    EXPECT_EQ(CountOccurrences(json, "RingBufferConcurrent"),
+              CountOccurrences(json, "{\"i\":"));
+  }
+  done = true;
+  writer.join();
+}
+
+TEST_F(TraceRingBufferTest, DisabledRecordsNothing) {
+  TraceRingBufferSetEnabled(false);
+  TRACE_EVENT_INSTANT0("flutter", "RingBufferDisabled");
+  EXPECT_EQ(TraceRingBufferExportJSON().find("RingBufferDisabled"),
+            std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
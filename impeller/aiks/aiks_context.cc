@@ -6,6 +6,7 @@
 
 #include "fml/closure.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/renderer/command_queue.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
@@ -45,6 +46,33 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
+/// Submits an empty command buffer after the work of the frame so that the
+/// transients buffer knows when the GPU is done reading the frame's data.
+/// Submissions to the queue complete in order.
+///
+/// On OpenGL ES, completion callbacks are invoked as soon as the reactor has
+/// run, which says nothing about the GPU. The transients buffer keeps using a
+/// fixed rotation of arenas there.
+static void TrackTransientsBufferSubmission(Context& context,
+                                            HostBuffer& host_buffer) {
+  if (context.GetBackendType() == Context::BackendType::kOpenGLES) {
+    return;
+  }
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return;
+  }
+  command_buffer->SetLabel("Transients Buffer Fence");
+  auto signal = host_buffer.TrackSubmission();
+  if (!context.GetCommandQueue()
+           ->Submit({command_buffer},
+                    [signal](CommandBuffer::Status status) { signal(); })
+           .ok()) {
+    // Nothing will be waiting on this submission.
+    signal();
+  }
+}
+
 bool AiksContext::Render(const Picture& picture,
                          RenderTarget& render_target,
                          bool reset_host_buffer) {
@@ -54,7 +82,10 @@ bool AiksContext::Render(const Picture& picture,
 
   fml::ScopedCleanupClosure closure([&]() {
     if (reset_host_buffer) {
+      TrackTransientsBufferSubmission(*context_,
+                                      content_context_->GetTransientsBuffer());
       content_context_->GetTransientsBuffer().Reset();
+      content_context_->GetUploadArena().AdvanceFrame();
     }
   });
   if (picture.pass) {
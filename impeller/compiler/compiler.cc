@@ -145,9 +145,14 @@ static CompilerBackend CreateGLSLCompiler(const spirv_cross::ParsedIR& ir,
   // use `samplerExternalOES` directly because compiling to spirv requires the
   // source language profile to be at least 310 ES, but this extension is
   // incompatible with ES 310+.
+  //
+  // GLSL ES 300 and above need the ESSL 3 version of the extension instead.
   for (auto& id : ir.ids_for_constant_or_variable) {
     if (StringStartsWith(ir.get_name(id), kExternalTexturePrefix)) {
-      gl_compiler->require_extension("GL_OES_EGL_image_external");
+      gl_compiler->require_extension(
+          source_options.gles_language_version >= 300
+              ? "GL_OES_EGL_image_external_essl3"
+              : "GL_OES_EGL_image_external");
       break;
     }
   }
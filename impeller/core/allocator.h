@@ -36,6 +36,14 @@ class Allocator {
   ///
   virtual uint16_t MinimumBytesPerRow(PixelFormat format) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a buffer holding a copy of the data.
+  ///
+  ///             Data that outlives a frame but is small or frequently
+  ///             replaced (cached tessellations, glyph quads) should instead
+  ///             be placed in a |DeviceBufferArena| to avoid creating a device
+  ///             buffer for each allocation.
+  ///
   std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(const uint8_t* buffer,
                                                      size_t length);
 
@@ -2,9 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
 #include <memory>
 #include "flutter/testing/testing.h"
 #include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer_arena.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/geometry/size.h"
@@ -79,5 +81,89 @@ TEST(AllocatorTest, TextureDescriptorCompatibility) {
   }
 }
 
+static std::shared_ptr<MockAllocator> CreateArenaAllocator(
+    size_t* buffer_count) {
+  auto allocator = std::make_shared<MockAllocator>();
+  EXPECT_CALL(*allocator, OnCreateBuffer)
+      .WillRepeatedly([buffer_count](const DeviceBufferDescriptor& desc) {
+        (*buffer_count)++;
+        auto buffer =
+            std::make_shared<::testing::NiceMock<MockDeviceBuffer>>(desc);
+        ON_CALL(*buffer, OnCopyHostBuffer)
+            .WillByDefault(::testing::Return(true));
+        return buffer;
+      });
+  return allocator;
+}
+
+TEST(AllocatorTest, DeviceBufferArenaSubAllocatesFromBlocks) {
+  size_t buffer_count = 0u;
+  auto arena = DeviceBufferArena::Create(CreateArenaAllocator(&buffer_count),
+                                         /*block_size=*/1024u);
+  std::array<uint8_t, 100> data = {};
+
+  auto a = arena->Emplace(data.data(), 100u, 16u);
+  auto b = arena->Emplace(data.data(), 100u, 16u);
+  ASSERT_TRUE(a && b);
+  EXPECT_EQ(a->GetBufferView().buffer, b->GetBufferView().buffer);
+  EXPECT_EQ(a->GetBufferView().range, Range(0u, 100u));
+  EXPECT_EQ(b->GetBufferView().range, Range(112u, 100u));
+
+  // Larger than a block: gets a dedicated block.
+  std::array<uint8_t, 2048> large = {};
+  auto c = arena->Emplace(large.data(), large.size(), 16u);
+  ASSERT_TRUE(c);
+  EXPECT_NE(c->GetBufferView().buffer, a->GetBufferView().buffer);
+  EXPECT_EQ(buffer_count, 2u);
+
+  auto stats = arena->GetStats();
+  EXPECT_EQ(stats.block_count, 2u);
+  EXPECT_EQ(stats.reserved_bytes, 1024u + 2048u);
+  EXPECT_EQ(stats.allocated_bytes, 100u + 100u + 2048u);
+  EXPECT_EQ(stats.bytes_uploaded_this_frame, 100u + 100u + 2048u);
+
+  arena->AdvanceFrame();
+  EXPECT_EQ(arena->GetStats().bytes_uploaded_this_frame, 0u);
+}
+
+TEST(AllocatorTest, DeviceBufferArenaReusesRangesAfterFramesInFlight) {
+  size_t buffer_count = 0u;
+  auto arena = DeviceBufferArena::Create(CreateArenaAllocator(&buffer_count),
+                                         /*block_size=*/1024u);
+  std::array<uint8_t, 256> data = {};
+
+  auto a = arena->Emplace(data.data(), 256u, 1u);
+  auto b = arena->Emplace(data.data(), 256u, 1u);
+  auto c = arena->Emplace(data.data(), 256u, 1u);
+  a.reset();
+  c.reset();
+
+  // Released ranges may still be read by frames in flight.
+  for (auto i = 0u; i < kHostBufferArenaSize - 1; i++) {
+    arena->AdvanceFrame();
+    EXPECT_EQ(arena->GetStats().allocated_bytes, 768u);
+  }
+  arena->AdvanceFrame();
+
+  auto stats = arena->GetStats();
+  EXPECT_EQ(stats.allocated_bytes, 256u);
+  EXPECT_EQ(stats.largest_free_range, 512u);
+  // 256 bytes free in front of b, and 512 coalesced bytes after it.
+  EXPECT_DOUBLE_EQ(stats.fragmentation, 1.0 - 512.0 / 768.0);
+
+  // First fit places new data in the hole in front of b.
+  auto d = arena->Emplace(data.data(), 256u, 1u);
+  EXPECT_EQ(d->GetBufferView().range, Range(0u, 256u));
+
+  // Empty blocks are returned to the allocator.
+  b.reset();
+  d.reset();
+  for (auto i = 0u; i < kHostBufferArenaSize; i++) {
+    arena->AdvanceFrame();
+  }
+  EXPECT_EQ(arena->GetStats().block_count, 0u);
+  EXPECT_EQ(buffer_count, 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
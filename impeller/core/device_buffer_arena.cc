@@ -0,0 +1,229 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/device_buffer_arena.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+DeviceBufferArena::Allocation::Allocation(
+    std::weak_ptr<DeviceBufferArena> arena,
+    BufferView view)
+    : arena_(std::move(arena)), view_(std::move(view)) {}
+
+DeviceBufferArena::Allocation::~Allocation() {
+  if (auto arena = arena_.lock()) {
+    arena->Release(view_);
+  }
+}
+
+const BufferView& DeviceBufferArena::Allocation::GetBufferView() const {
+  return view_;
+}
+
+std::shared_ptr<DeviceBufferArena> DeviceBufferArena::Create(
+    std::shared_ptr<Allocator> allocator,
+    size_t block_size) {
+  return std::shared_ptr<DeviceBufferArena>(
+      new DeviceBufferArena(std::move(allocator), block_size));
+}
+
+DeviceBufferArena::DeviceBufferArena(std::shared_ptr<Allocator> allocator,
+                                     size_t block_size)
+    : allocator_(std::move(allocator)), block_size_(block_size) {
+  FML_DCHECK(allocator_);
+  FML_DCHECK(block_size_ > 0u);
+}
+
+DeviceBufferArena::~DeviceBufferArena() = default;
+
+void DeviceBufferArena::SetLabel(std::string label) {
+  Lock lock(mutex_);
+  label_ = std::move(label);
+  for (const auto& block : blocks_) {
+    block.buffer->SetLabel(label_);
+  }
+}
+
+static std::optional<size_t> FindAlignedOffset(
+    const std::map<size_t, size_t>& free_ranges,
+    size_t length,
+    size_t align) {
+  for (const auto& [offset, free_length] : free_ranges) {
+    const size_t aligned = (offset + align - 1u) / align * align;
+    if (aligned + length <= offset + free_length) {
+      return aligned;
+    }
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<DeviceBufferArena::Allocation> DeviceBufferArena::Emplace(
+    const void* buffer,
+    size_t length,
+    size_t align) {
+  if (length == 0u) {
+    return nullptr;
+  }
+  align = std::max<size_t>(align, 1u);
+
+  Lock lock(mutex_);
+  Block* block = nullptr;
+  std::optional<size_t> offset;
+  for (auto& candidate : blocks_) {
+    offset = FindAlignedOffset(candidate.free_ranges, length, align);
+    if (offset.has_value()) {
+      block = &candidate;
+      break;
+    }
+  }
+  if (!block) {
+    block = CreateBlock(length);
+    if (!block) {
+      return nullptr;
+    }
+    offset = 0u;
+  }
+
+  // Carve the allocation out of the free range that contains it, keeping the
+  // padding in front of it and the remainder after it free.
+  auto range = std::prev(block->free_ranges.upper_bound(offset.value()));
+  const size_t range_offset = range->first;
+  const size_t range_end = range->first + range->second;
+  block->free_ranges.erase(range);
+  if (offset.value() > range_offset) {
+    block->free_ranges[range_offset] = offset.value() - range_offset;
+  }
+  if (offset.value() + length < range_end) {
+    block->free_ranges[offset.value() + length] =
+        range_end - (offset.value() + length);
+  }
+  block->allocated_bytes += length;
+
+  if (buffer) {
+    if (!block->buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(buffer),
+                                       Range{0, length}, offset.value())) {
+      FreeRange(*block, Range{offset.value(), length});
+      return nullptr;
+    }
+    bytes_uploaded_this_frame_ += length;
+  }
+
+  return std::unique_ptr<Allocation>(new Allocation(
+      weak_from_this(),
+      BufferView{block->buffer, Range{offset.value(), length}}));
+}
+
+void DeviceBufferArena::Release(const BufferView& view) {
+  Lock lock(mutex_);
+  pending_releases_[frame_index_].push_back({view.buffer, view.range});
+}
+
+void DeviceBufferArena::AdvanceFrame() {
+  Lock lock(mutex_);
+  const Stats stats = GetStatsLocked();
+  FML_TRACE_COUNTER("impeller",                               //
+                    "DeviceBufferArena",                      //
+                    reinterpret_cast<int64_t>(this),          //
+                    "ReservedBytes", stats.reserved_bytes,    //
+                    "AllocatedBytes", stats.allocated_bytes,  //
+                    "UploadedBytes", stats.bytes_uploaded_this_frame);
+
+  frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+  bytes_uploaded_this_frame_ = 0u;
+
+  // Ranges released kHostBufferArenaSize frames ago are no longer referenced
+  // by any frame in flight.
+  for (const auto& release : pending_releases_[frame_index_]) {
+    auto block = std::find_if(blocks_.begin(), blocks_.end(),
+                              [&release](const Block& block) {
+                                return block.buffer == release.buffer;
+                              });
+    FML_DCHECK(block != blocks_.end());
+    if (block != blocks_.end()) {
+      FreeRange(*block, release.range);
+    }
+  }
+  pending_releases_[frame_index_].clear();
+
+  blocks_.erase(std::remove_if(blocks_.begin(), blocks_.end(),
+                               [](const Block& block) {
+                                 return block.allocated_bytes == 0u;
+                               }),
+                blocks_.end());
+}
+
+void DeviceBufferArena::FreeRange(Block& block, Range range) {
+  FML_DCHECK(block.allocated_bytes >= range.length);
+  block.allocated_bytes -= range.length;
+
+  size_t offset = range.offset;
+  size_t length = range.length;
+  auto next = block.free_ranges.lower_bound(offset);
+  if (next != block.free_ranges.end() && offset + length == next->first) {
+    length += next->second;
+    next = block.free_ranges.erase(next);
+  }
+  if (next != block.free_ranges.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      length += previous->second;
+      block.free_ranges.erase(previous);
+    }
+  }
+  block.free_ranges[offset] = length;
+}
+
+DeviceBufferArena::Block* DeviceBufferArena::CreateBlock(size_t minimum_size) {
+  DeviceBufferDescriptor desc;
+  desc.size = std::max(minimum_size, block_size_);
+  desc.storage_mode = StorageMode::kHostVisible;
+  auto buffer = allocator_->CreateBuffer(desc);
+  if (!buffer) {
+    return nullptr;
+  }
+  if (!label_.empty()) {
+    buffer->SetLabel(label_);
+  }
+  Block& block = blocks_.emplace_back();
+  block.buffer = std::move(buffer);
+  block.free_ranges[0u] = desc.size;
+  return &block;
+}
+
+DeviceBufferArena::Stats DeviceBufferArena::GetStats() const {
+  Lock lock(mutex_);
+  return GetStatsLocked();
+}
+
+DeviceBufferArena::Stats DeviceBufferArena::GetStatsLocked() const {
+  Stats stats;
+  size_t free_bytes = 0u;
+  for (const auto& block : blocks_) {
+    stats.block_count++;
+    stats.reserved_bytes += block.buffer->GetDeviceBufferDescriptor().size;
+    stats.allocated_bytes += block.allocated_bytes;
+    for (const auto& [offset, length] : block.free_ranges) {
+      free_bytes += length;
+      stats.largest_free_range = std::max(stats.largest_free_range, length);
+    }
+  }
+  if (free_bytes > 0u) {
+    stats.fragmentation =
+        1.0 - static_cast<double>(stats.largest_free_range) / free_bytes;
+  }
+  stats.bytes_uploaded_this_frame = bytes_uploaded_this_frame_;
+  return stats;
+}
+
+}  // namespace impeller
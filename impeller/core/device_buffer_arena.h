@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_CORE_DEVICE_BUFFER_ARENA_H_
+#define FLUTTER_IMPELLER_CORE_DEVICE_BUFFER_ARENA_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "impeller/base/thread.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/host_buffer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Sub-allocates long-lived buffer data (cached tessellations,
+///             glyph quads, meshes) from a small number of large device
+///             buffers instead of creating a device buffer per allocation.
+///
+///             Unlike the |HostBuffer|, which is reset every frame, ranges of
+///             the arena are owned by an |Allocation| and returned to the
+///             arena when it is destroyed. Because the GPU may still be
+///             reading from a range in one of the frames in flight, released
+///             ranges only become available for reuse after |AdvanceFrame|
+///             has been called |kHostBufferArenaSize| times.
+///
+///             New data is placed in the first block with a large enough free
+///             range so that allocations stay packed in the oldest blocks,
+///             and blocks that no longer hold any allocation are given back
+///             to the allocator.
+///
+class DeviceBufferArena
+    : public std::enable_shared_from_this<DeviceBufferArena> {
+ public:
+  /// The size of the blocks data is sub-allocated from. Allocations larger
+  /// than a block get a dedicated block.
+  static constexpr size_t kDefaultBlockSize = 4u * 1024u * 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A range of the arena. The range is returned to the arena when
+  ///             the allocation is destroyed.
+  ///
+  class Allocation {
+   public:
+    ~Allocation();
+
+    const BufferView& GetBufferView() const;
+
+   private:
+    friend DeviceBufferArena;
+
+    std::weak_ptr<DeviceBufferArena> arena_;
+    BufferView view_;
+
+    Allocation(std::weak_ptr<DeviceBufferArena> arena, BufferView view);
+
+    Allocation(const Allocation&) = delete;
+
+    Allocation& operator=(const Allocation&) = delete;
+  };
+
+  struct Stats {
+    /// The number of device buffers the arena holds on to.
+    size_t block_count = 0u;
+    /// The total size of all blocks.
+    size_t reserved_bytes = 0u;
+    /// The bytes owned by live allocations, or released less than
+    /// |kHostBufferArenaSize| frames ago.
+    size_t allocated_bytes = 0u;
+    /// The size of the largest range that can be allocated without creating
+    /// a new block.
+    size_t largest_free_range = 0u;
+    /// One minus the ratio of the largest free range to all free bytes. Zero
+    /// if all free bytes are contiguous, approaching one as they are split up
+    /// into many small ranges.
+    double fragmentation = 0.0;
+    /// The bytes copied into the arena since the last call to |AdvanceFrame|.
+    size_t bytes_uploaded_this_frame = 0u;
+  };
+
+  static std::shared_ptr<DeviceBufferArena> Create(
+      std::shared_ptr<Allocator> allocator,
+      size_t block_size = kDefaultBlockSize);
+
+  ~DeviceBufferArena();
+
+  void SetLabel(std::string label);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy data into the arena.
+  ///
+  /// @param[in]  buffer  The data to copy, or nullptr to only reserve the
+  ///                     range.
+  /// @param[in]  length  The length of the data.
+  /// @param[in]  align   The required alignment of the start of the range.
+  ///
+  /// @return     The allocation, or nullptr if no block could be created.
+  ///
+  [[nodiscard]] std::unique_ptr<Allocation> Emplace(const void* buffer,
+                                                    size_t length,
+                                                    size_t align);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. Ranges released
+  ///             |kHostBufferArenaSize| frames ago become available and empty
+  ///             blocks are released. The stats of the frame are written to
+  ///             the timeline as a counter.
+  ///
+  void AdvanceFrame();
+
+  Stats GetStats() const;
+
+ private:
+  struct Block {
+    std::shared_ptr<DeviceBuffer> buffer;
+    // Free ranges of the buffer, keyed by offset.
+    std::map<size_t, size_t> free_ranges;
+    size_t allocated_bytes = 0u;
+  };
+
+  struct PendingRelease {
+    std::shared_ptr<const DeviceBuffer> buffer;
+    Range range;
+  };
+
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t block_size_;
+  mutable Mutex mutex_;
+  std::vector<Block> blocks_ IPLR_GUARDED_BY(mutex_);
+  std::array<std::vector<PendingRelease>, kHostBufferArenaSize>
+      pending_releases_ IPLR_GUARDED_BY(mutex_);
+  size_t frame_index_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t bytes_uploaded_this_frame_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::string label_ IPLR_GUARDED_BY(mutex_);
+
+  DeviceBufferArena(std::shared_ptr<Allocator> allocator, size_t block_size);
+
+  void Release(const BufferView& view);
+
+  void FreeRange(Block& block, Range range) IPLR_REQUIRES(mutex_);
+
+  Block* CreateBlock(size_t minimum_size) IPLR_REQUIRES(mutex_);
+
+  Stats GetStatsLocked() const IPLR_REQUIRES(mutex_);
+
+  DeviceBufferArena(const DeviceBufferArena&) = delete;
+
+  DeviceBufferArena& operator=(const DeviceBufferArena&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_CORE_DEVICE_BUFFER_ARENA_H_
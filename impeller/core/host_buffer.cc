@@ -4,6 +4,7 @@
 
 #include "impeller/core/host_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
@@ -17,6 +18,10 @@ namespace impeller {
 
 constexpr size_t kAllocatorBlockSize = 1024000;  // 1024 Kb.
 
+// The number of consecutive frames with more idle arenas than needed before
+// an arena that was added for a deeper pipeline is released again.
+constexpr size_t kArenaShrinkFrameCount = 120u;
+
 std::shared_ptr<HostBuffer> HostBuffer::Create(
     const std::shared_ptr<Allocator>& allocator) {
   return std::shared_ptr<HostBuffer>(new HostBuffer(allocator));
@@ -24,23 +29,24 @@ std::shared_ptr<HostBuffer> HostBuffer::Create(
 
 HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator)
     : allocator_(allocator) {
-  DeviceBufferDescriptor desc;
-  desc.size = kAllocatorBlockSize;
-  desc.storage_mode = StorageMode::kHostVisible;
-  for (auto i = 0u; i < kHostBufferArenaSize; i++) {
-    device_buffers_[i].push_back(allocator->CreateBuffer(desc));
+  Lock lock(mutex_);
+  arenas_.resize(kHostBufferArenaSize);
+  for (auto& arena : arenas_) {
+    arena.device_buffers.push_back(CreateBlock());
   }
 }
 
 HostBuffer::~HostBuffer() = default;
 
 void HostBuffer::SetLabel(std::string label) {
+  Lock lock(mutex_);
   label_ = std::move(label);
 }
 
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  Lock lock(mutex_);
   auto [range, device_buffer] = EmplaceInternal(buffer, length, align);
   if (!device_buffer) {
     return {};
@@ -49,6 +55,7 @@ BufferView HostBuffer::Emplace(const void* buffer,
 }
 
 BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
+  Lock lock(mutex_);
   auto [range, device_buffer] = EmplaceInternal(buffer, length);
   if (!device_buffer) {
     return {};
@@ -59,6 +66,7 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
 BufferView HostBuffer::Emplace(size_t length,
                                size_t align,
                                const EmplaceProc& cb) {
+  Lock lock(mutex_);
   auto [range, device_buffer] = EmplaceInternal(length, align, cb);
   if (!device_buffer) {
     return {};
@@ -67,20 +75,35 @@ BufferView HostBuffer::Emplace(size_t length,
 }
 
 HostBuffer::TestStateQuery HostBuffer::GetStateForTest() {
+  Lock lock(mutex_);
   return HostBuffer::TestStateQuery{
       .current_frame = frame_index_,
       .current_buffer = current_buffer_,
-      .total_buffer_count = device_buffers_[frame_index_].size(),
+      .total_buffer_count = arenas_[frame_index_].device_buffers.size(),
   };
 }
 
+HostBuffer::Stats HostBuffer::GetStats() const {
+  Lock lock(mutex_);
+  Stats stats = stats_;
+  stats.arena_count = arenas_.size();
+  for (const auto& arena : arenas_) {
+    stats.block_count += arena.device_buffers.size();
+  }
+  return stats;
+}
+
+std::shared_ptr<DeviceBuffer> HostBuffer::CreateBlock() const {
+  DeviceBufferDescriptor desc;
+  desc.size = kAllocatorBlockSize;
+  desc.storage_mode = StorageMode::kHostVisible;
+  return allocator_->CreateBuffer(desc);
+}
+
 void HostBuffer::MaybeCreateNewBuffer() {
   current_buffer_++;
-  if (current_buffer_ >= device_buffers_[frame_index_].size()) {
-    DeviceBufferDescriptor desc;
-    desc.size = kAllocatorBlockSize;
-    desc.storage_mode = StorageMode::kHostVisible;
-    device_buffers_[frame_index_].push_back(allocator_->CreateBuffer(desc));
+  if (current_buffer_ >= arenas_[frame_index_].device_buffers.size()) {
+    arenas_[frame_index_].device_buffers.push_back(CreateBlock());
   }
   offset_ = 0;
 }
@@ -104,6 +127,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     if (!device_buffer) {
       return {};
     }
+    oversized_bytes_ += length;
     if (cb) {
       cb(device_buffer->OnGetContents());
       device_buffer->Flush(Range{0, length});
@@ -145,6 +169,7 @@ std::tuple<Range, std::shared_ptr<DeviceBuffer>> HostBuffer::EmplaceInternal(
     if (!device_buffer) {
       return {};
     }
+    oversized_bytes_ += length;
     if (buffer) {
       if (!device_buffer->CopyHostBuffer(static_cast<const uint8_t*>(buffer),
                                          Range{0, length})) {
@@ -189,19 +214,76 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length, size_t align) {
 }
 
 const std::shared_ptr<DeviceBuffer>& HostBuffer::GetCurrentBuffer() const {
-  return device_buffers_[frame_index_][current_buffer_];
+  return arenas_[frame_index_].device_buffers[current_buffer_];
+}
+
+std::function<void()> HostBuffer::TrackSubmission() {
+  Lock lock(mutex_);
+  tracks_submissions_ = true;
+  std::shared_ptr<std::atomic<size_t>> pending =
+      arenas_[frame_index_].pending_submissions;
+  pending->fetch_add(1u);
+  return [pending, signaled = std::make_shared<std::atomic_bool>(false)]() {
+    if (!signaled->exchange(true)) {
+      pending->fetch_sub(1u);
+    }
+  };
 }
 
 void HostBuffer::Reset() {
+  Lock lock(mutex_);
+  auto& device_buffers = arenas_[frame_index_].device_buffers;
   // When resetting the host buffer state at the end of the frame, check if
   // there are any unused buffers and remove them.
-  while (device_buffers_[frame_index_].size() > current_buffer_ + 1) {
-    device_buffers_[frame_index_].pop_back();
+  while (device_buffers.size() > current_buffer_ + 1) {
+    device_buffers.pop_back();
   }
 
+  stats_.last_frame_bytes =
+      device_buffers.size() * kAllocatorBlockSize + oversized_bytes_;
+  stats_.max_frame_bytes =
+      std::max(stats_.max_frame_bytes, stats_.last_frame_bytes);
+
   offset_ = 0u;
   current_buffer_ = 0u;
-  frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+  oversized_bytes_ = 0u;
+  AdvanceFrameArena();
+}
+
+void HostBuffer::AdvanceFrameArena() {
+  size_t next = (frame_index_ + 1) % arenas_.size();
+  if (!tracks_submissions_) {
+    frame_index_ = next;
+    return;
+  }
+
+  if (!arenas_[next].IsIdle()) {
+    // The GPU is more frames behind than there are arenas. Add an arena in
+    // front of the one still in use instead of waiting for it.
+    FrameArena arena;
+    arena.device_buffers.push_back(CreateBlock());
+    arenas_.insert(arenas_.begin() + frame_index_ + 1, std::move(arena));
+    frame_index_++;
+    slack_frames_ = 0u;
+    return;
+  }
+
+  // If the arena after the next one is idle as well, there are more arenas
+  // than frames in flight. Release arenas added for an earlier spike once
+  // this has been the case for a while.
+  const size_t after_next = (next + 1) % arenas_.size();
+  if (arenas_.size() <= kHostBufferArenaSize ||
+      !arenas_[after_next].IsIdle()) {
+    slack_frames_ = 0u;
+  } else if (++slack_frames_ >= kArenaShrinkFrameCount) {
+    arenas_.erase(arenas_.begin() + next);
+    if (next < frame_index_) {
+      frame_index_--;
+    }
+    next = (frame_index_ + 1) % arenas_.size();
+    slack_frames_ = 0u;
+  }
+  frame_index_ = next;
 }
 
 }  // namespace impeller
@@ -6,12 +6,14 @@
 #define FLUTTER_IMPELLER_CORE_HOST_BUFFER_H_
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "impeller/base/thread.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/platform.h"
@@ -24,7 +26,14 @@ static const constexpr size_t kHostBufferArenaSize = 3u;
 /// The host buffer class manages one more 1024 Kb blocks of device buffer
 /// allocations.
 ///
-/// These are reset per-frame.
+/// These are reset per-frame. Each frame writes to its own arena of blocks.
+/// By default, the arenas are reused in a fixed rotation of
+/// |kHostBufferArenaSize| frames. Once submissions are tracked with
+/// |TrackSubmission|, an arena is only reused after the GPU has finished
+/// reading from it and the number of arenas follows the frames in flight.
+///
+/// Data may be emplaced from several threads at once, for instance while
+/// render passes of the same frame are recorded concurrently.
 class HostBuffer {
  public:
   static std::shared_ptr<HostBuffer> Create(
@@ -109,7 +118,9 @@ class HostBuffer {
   ///             caller a chance to update it using the specified callback. The
   ///             buffer is guaranteed to have enough space for length bytes. It
   ///             is the responsibility of the caller to not exceed the bounds
-  ///             of the buffer returned in the EmplaceProc.
+  ///             of the buffer returned in the EmplaceProc. The host buffer
+  ///             is locked while the callback runs, so the callback must not
+  ///             emplace data itself.
   ///
   /// @param[in]  cb            A callback that will be passed a ptr to the
   ///                           underlying host buffer.
@@ -118,11 +129,37 @@ class HostBuffer {
   ///
   BufferView Emplace(size_t length, size_t align, const EmplaceProc& cb);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the data emplaced in the current frame as in use by a
+  ///             submission the GPU has not finished executing yet.
+  ///
+  ///             Because submissions to a queue complete in order, it is
+  ///             sufficient to track the last submission of each frame.
+  ///
+  /// @return     A closure to invoke once the submission has completed, for
+  ///             instance from the |CommandQueue| completion callback. Calls
+  ///             after the first are ignored.
+  ///
+  [[nodiscard]] std::function<void()> TrackSubmission();
+
   //----------------------------------------------------------------------------
   /// @brief Resets the contents of the HostBuffer to nothing so it can be
   ///        reused.
   void Reset();
 
+  struct Stats {
+    /// The size of the blocks used by the last frame that was reset.
+    size_t last_frame_bytes = 0u;
+    /// The largest size of the blocks used by any single frame.
+    size_t max_frame_bytes = 0u;
+    /// The number of frames whose data may be in use at the same time.
+    size_t arena_count = 0u;
+    /// The number of blocks held on to across all arenas.
+    size_t block_count = 0u;
+  };
+
+  Stats GetStats() const;
+
   /// Test only internal state.
   struct TestStateQuery {
     size_t current_frame;
@@ -135,19 +172,24 @@ class HostBuffer {
 
  private:
   [[nodiscard]] std::tuple<Range, std::shared_ptr<DeviceBuffer>>
-  EmplaceInternal(const void* buffer, size_t length);
+  EmplaceInternal(const void* buffer, size_t length) IPLR_REQUIRES(mutex_);
 
-  std::tuple<Range, std::shared_ptr<DeviceBuffer>>
-  EmplaceInternal(size_t length, size_t align, const EmplaceProc& cb);
+  std::tuple<Range, std::shared_ptr<DeviceBuffer>> EmplaceInternal(
+      size_t length,
+      size_t align,
+      const EmplaceProc& cb) IPLR_REQUIRES(mutex_);
 
-  std::tuple<Range, std::shared_ptr<DeviceBuffer>>
-  EmplaceInternal(const void* buffer, size_t length, size_t align);
+  std::tuple<Range, std::shared_ptr<DeviceBuffer>> EmplaceInternal(
+      const void* buffer,
+      size_t length,
+      size_t align) IPLR_REQUIRES(mutex_);
 
-  size_t GetLength() const { return offset_; }
+  size_t GetLength() const IPLR_REQUIRES(mutex_) { return offset_; }
 
-  void MaybeCreateNewBuffer();
+  void MaybeCreateNewBuffer() IPLR_REQUIRES(mutex_);
 
-  const std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() const;
+  const std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() const
+      IPLR_REQUIRES(mutex_);
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
@@ -157,13 +199,31 @@ class HostBuffer {
 
   HostBuffer& operator=(const HostBuffer&) = delete;
 
+  struct FrameArena {
+    std::vector<std::shared_ptr<DeviceBuffer>> device_buffers;
+    // The number of tracked submissions reading from the arena that have not
+    // completed yet.
+    std::shared_ptr<std::atomic<size_t>> pending_submissions =
+        std::make_shared<std::atomic<size_t>>(0u);
+
+    bool IsIdle() const { return pending_submissions->load() == 0u; }
+  };
+
   std::shared_ptr<Allocator> allocator_;
-  std::array<std::vector<std::shared_ptr<DeviceBuffer>>, kHostBufferArenaSize>
-      device_buffers_;
-  size_t current_buffer_ = 0u;
-  size_t offset_ = 0u;
-  size_t frame_index_ = 0u;
-  std::string label_;
+  mutable Mutex mutex_;
+  std::vector<FrameArena> arenas_ IPLR_GUARDED_BY(mutex_);
+  size_t current_buffer_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t offset_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t frame_index_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t oversized_bytes_ IPLR_GUARDED_BY(mutex_) = 0u;
+  bool tracks_submissions_ IPLR_GUARDED_BY(mutex_) = false;
+  size_t slack_frames_ IPLR_GUARDED_BY(mutex_) = 0u;
+  Stats stats_ IPLR_GUARDED_BY(mutex_);
+  std::string label_ IPLR_GUARDED_BY(mutex_);
+
+  std::shared_ptr<DeviceBuffer> CreateBlock() const;
+
+  void AdvanceFrameArena() IPLR_REQUIRES(mutex_);
 };
 
 }  // namespace impeller
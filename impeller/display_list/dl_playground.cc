@@ -58,6 +58,7 @@ bool DlPlayground::OpenPlaygroundHere(DisplayListPlaygroundCallback callback) {
         list->Dispatch(impeller_dispatcher);
         impeller_dispatcher.FinishRecording();
         context.GetContentContext().GetTransientsBuffer().Reset();
+        context.GetContentContext().GetUploadArena().AdvanceFrame();
         context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
         return true;
 #else
@@ -219,4 +219,8 @@ bool AtlasContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+std::string_view AtlasContents::GetTypeName() const {
+  return "AtlasContents";
+}
+
 }  // namespace impeller
@@ -50,6 +50,9 @@ class AtlasContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -23,6 +23,33 @@ static Scalar GetShaderClipDepth(const Entity& entity) {
                          0.0f);
 }
 
+bool DrawCoverageMaskStencil(const ContentContext& renderer,
+                             GeometryResult geometry_result,
+                             ContentContextOptions options,
+                             Scalar depth,
+                             RenderPass& pass) {
+  using VS = CoverageMaskClipPipeline::VertexShader;
+  using FS = CoverageMaskClipPipeline::FragmentShader;
+  FML_DCHECK(geometry_result.mode == GeometryResult::Mode::kCoverageMask);
+
+  pass.SetCommandLabel("Stencil preparation (CoverageMask)");
+  options.primitive_type = geometry_result.type;
+  options.stencil_mode =
+      ContentContextOptions::StencilMode::kStencilNonZeroFill;
+  pass.SetVertexBuffer(std::move(geometry_result.vertex_buffer));
+  pass.SetPipeline(renderer.GetCoverageMaskClipPipeline(options));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = geometry_result.transform;
+  frame_info.depth = depth;
+  VS::BindFrameInfo(
+      pass, renderer.GetTransientsBuffer().EmplaceUniform(frame_info));
+  FS::BindMask(pass, std::move(geometry_result.coverage_mask),
+               renderer.GetContext()->GetSamplerLibrary()->GetSampler({}));
+
+  return pass.Draw().ok();
+}
+
 /*******************************************************************************
  ******* ClipContents
  ******************************************************************************/
@@ -116,33 +143,43 @@ bool ClipContents::Render(const ContentContext& renderer,
   /// Stencil preparation draw.
 
   options.depth_write_enabled = false;
-  options.primitive_type = geometry_result.type;
-  pass.SetVertexBuffer(std::move(geometry_result.vertex_buffer));
-  switch (geometry_result.mode) {
-    case GeometryResult::Mode::kNonZero:
-      pass.SetCommandLabel("Clip stencil preparation (NonZero)");
-      options.stencil_mode =
-          ContentContextOptions::StencilMode::kStencilNonZeroFill;
-      break;
-    case GeometryResult::Mode::kEvenOdd:
-      pass.SetCommandLabel("Clip stencil preparation (EvenOdd)");
-      options.stencil_mode =
-          ContentContextOptions::StencilMode::kStencilEvenOddFill;
-      break;
-    case GeometryResult::Mode::kNormal:
-    case GeometryResult::Mode::kPreventOverdraw:
-      pass.SetCommandLabel("Clip stencil preparation (Increment)");
-      options.stencil_mode =
-          ContentContextOptions::StencilMode::kOverdrawPreventionIncrement;
-      break;
-  }
-  pass.SetPipeline(renderer.GetClipPipeline(options));
+  if (geometry_result.mode == GeometryResult::Mode::kCoverageMask) {
+    if (!DrawCoverageMaskStencil(renderer, std::move(geometry_result), options,
+                                 info.depth, pass)) {
+      return false;
+    }
+  } else {
+    options.primitive_type = geometry_result.type;
+    pass.SetVertexBuffer(std::move(geometry_result.vertex_buffer));
+    switch (geometry_result.mode) {
+      case GeometryResult::Mode::kNonZero:
+        pass.SetCommandLabel("Clip stencil preparation (NonZero)");
+        options.stencil_mode =
+            ContentContextOptions::StencilMode::kStencilNonZeroFill;
+        break;
+      case GeometryResult::Mode::kEvenOdd:
+        pass.SetCommandLabel("Clip stencil preparation (EvenOdd)");
+        options.stencil_mode =
+            ContentContextOptions::StencilMode::kStencilEvenOddFill;
+        break;
+      case GeometryResult::Mode::kNormal:
+      case GeometryResult::Mode::kPreventOverdraw:
+        pass.SetCommandLabel("Clip stencil preparation (Increment)");
+        options.stencil_mode =
+            ContentContextOptions::StencilMode::kOverdrawPreventionIncrement;
+        break;
+      case GeometryResult::Mode::kCoverageMask:
+        FML_UNREACHABLE();
+    }
+    pass.SetPipeline(renderer.GetClipPipeline(options));
 
-  info.mvp = geometry_result.transform;
-  VS::BindFrameInfo(pass, renderer.GetTransientsBuffer().EmplaceUniform(info));
+    info.mvp = geometry_result.transform;
+    VS::BindFrameInfo(pass,
+                      renderer.GetTransientsBuffer().EmplaceUniform(info));
 
-  if (!pass.Draw().ok()) {
-    return false;
+    if (!pass.Draw().ok()) {
+      return false;
+    }
   }
 
   /// Write depth.
@@ -264,4 +301,12 @@ bool ClipRestoreContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+std::string_view ClipContents::GetTypeName() const {
+  return "ClipContents";
+}
+
+std::string_view ClipRestoreContents::GetTypeName() const {
+  return "ClipRestoreContents";
+}
+
 }  // namespace impeller
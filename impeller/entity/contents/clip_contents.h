@@ -15,6 +15,15 @@
 
 namespace impeller {
 
+/// @brief  Draws the stencil preparation for a geometry result in
+///         |GeometryResult::Mode::kCoverageMask|, incrementing the stencil of
+///         every pixel that its coverage mask covers.
+bool DrawCoverageMaskStencil(const ContentContext& renderer,
+                             GeometryResult geometry_result,
+                             ContentContextOptions options,
+                             Scalar depth,
+                             RenderPass& pass);
+
 class ClipContents final : public Contents {
  public:
   ClipContents();
@@ -37,6 +46,9 @@ class ClipContents final : public Contents {
   bool ShouldRender(const Entity& entity,
                     const std::optional<Rect> clip_coverage) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -84,6 +96,9 @@ class ClipRestoreContents final : public Contents {
   bool ShouldRender(const Entity& entity,
                     const std::optional<Rect> clip_coverage) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -137,33 +137,45 @@ class ColorSourceContents : public Contents {
       if (stencil_geometry_result.vertex_buffer.vertex_count == 0u) {
         return true;
       }
-      pass.SetVertexBuffer(std::move(stencil_geometry_result.vertex_buffer));
-      options.primitive_type = stencil_geometry_result.type;
-
       options.blend_mode = BlendMode::kDestination;
-      switch (stencil_geometry_result.mode) {
-        case GeometryResult::Mode::kNonZero:
-          pass.SetCommandLabel("Stencil preparation (NonZero)");
-          options.stencil_mode =
-              ContentContextOptions::StencilMode::kStencilNonZeroFill;
-          break;
-        case GeometryResult::Mode::kEvenOdd:
-          pass.SetCommandLabel("Stencil preparation (EvenOdd)");
-          options.stencil_mode =
-              ContentContextOptions::StencilMode::kStencilEvenOddFill;
-          break;
-        default:
-          FML_UNREACHABLE();
-      }
-      pass.SetPipeline(renderer.GetClipPipeline(options));
-      ClipPipeline::VertexShader::FrameInfo clip_frame_info;
-      clip_frame_info.depth = entity.GetShaderClipDepth();
-      clip_frame_info.mvp = stencil_geometry_result.transform;
-      ClipPipeline::VertexShader::BindFrameInfo(
-          pass, renderer.GetTransientsBuffer().EmplaceUniform(clip_frame_info));
-
-      if (!pass.Draw().ok()) {
-        return false;
+      if (stencil_geometry_result.mode ==
+          GeometryResult::Mode::kCoverageMask) {
+        if (!DrawCoverageMaskStencil(renderer,
+                                     std::move(stencil_geometry_result),
+                                     options, entity.GetShaderClipDepth(),
+                                     pass)) {
+          return false;
+        }
+      } else {
+        pass.SetVertexBuffer(
+            std::move(stencil_geometry_result.vertex_buffer));
+        options.primitive_type = stencil_geometry_result.type;
+
+        switch (stencil_geometry_result.mode) {
+          case GeometryResult::Mode::kNonZero:
+            pass.SetCommandLabel("Stencil preparation (NonZero)");
+            options.stencil_mode =
+                ContentContextOptions::StencilMode::kStencilNonZeroFill;
+            break;
+          case GeometryResult::Mode::kEvenOdd:
+            pass.SetCommandLabel("Stencil preparation (EvenOdd)");
+            options.stencil_mode =
+                ContentContextOptions::StencilMode::kStencilEvenOddFill;
+            break;
+          default:
+            FML_UNREACHABLE();
+        }
+        pass.SetPipeline(renderer.GetClipPipeline(options));
+        ClipPipeline::VertexShader::FrameInfo clip_frame_info;
+        clip_frame_info.depth = entity.GetShaderClipDepth();
+        clip_frame_info.mvp = stencil_geometry_result.transform;
+        ClipPipeline::VertexShader::BindFrameInfo(
+            pass,
+            renderer.GetTransientsBuffer().EmplaceUniform(clip_frame_info));
+
+        if (!pass.Draw().ok()) {
+          return false;
+        }
       }
 
       /// Cover draw.
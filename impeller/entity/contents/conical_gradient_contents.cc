@@ -113,7 +113,8 @@ bool ConicalGradientContents::RenderTexture(const ContentContext& renderer,
 
   auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      CreateGradientTexture(gradient_data, renderer.GetContext(),
+                            renderer.GetUploadArena());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -172,4 +173,8 @@ bool ConicalGradientContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view ConicalGradientContents::GetTypeName() const {
+  return "ConicalGradientContents";
+}
+
 }  // namespace impeller
@@ -20,6 +20,9 @@ class ConicalGradientContents final : public ColorSourceContents {
 
   ~ConicalGradientContents() override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
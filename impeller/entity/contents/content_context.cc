@@ -5,8 +5,10 @@
 #include "impeller/entity/contents/content_context.h"
 
 #include <memory>
+#include <sstream>
 #include <utility>
 
+#include "fml/closure.h"
 #include "fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -16,6 +18,9 @@
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
+#if IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
@@ -219,6 +224,36 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPolygonMode(wireframe ? PolygonMode::kLine : PolygonMode::kFill);
 }
 
+std::optional<ContentContextOptions> ContentContextOptions::FromHash(
+    uint64_t key) {
+  auto field = [key](int shift) -> uint8_t { return (key >> shift) & 0xff; };
+  // Reject keys with bits outside of the fields written by |Hash|.
+  if ((key & 0xf0u) != 0u || (key >> 56) != 0u) {
+    return std::nullopt;
+  }
+  ContentContextOptions options;
+  options.is_for_rrect_blur_clear = (key & (1u << 0)) != 0u;
+  options.wireframe = (key & (1u << 1)) != 0u;
+  options.has_depth_stencil_attachments = (key & (1u << 2)) != 0u;
+  options.depth_write_enabled = (key & (1u << 3)) != 0u;
+  options.color_attachment_pixel_format = static_cast<PixelFormat>(field(8));
+  options.primitive_type = static_cast<PrimitiveType>(field(16));
+  options.stencil_mode = static_cast<StencilMode>(field(24));
+  options.depth_compare = static_cast<CompareFunction>(field(32));
+  options.blend_mode = static_cast<BlendMode>(field(40));
+  options.sample_count = static_cast<SampleCount>(field(48));
+  if (options.color_attachment_pixel_format > PixelFormat::kD32FloatS8UInt ||
+      options.primitive_type > PrimitiveType::kPoint ||
+      options.stencil_mode > StencilMode::kOverdrawPreventionRestore ||
+      options.depth_compare > CompareFunction::kGreaterEqual ||
+      options.blend_mode > Entity::kLastPipelineBlendMode ||
+      (options.sample_count != SampleCount::kCount1 &&
+       options.sample_count != SampleCount::kCount4)) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 template <typename PipelineT>
 static std::unique_ptr<PipelineT> CreateDefaultPipeline(
     const Context& context) {
@@ -251,10 +286,13 @@ ContentContext::ContentContext(
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
                                : std::move(render_target_allocator)),
-      host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())) {
+      host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())),
+      upload_arena_(
+          DeviceBufferArena::Create(context_->GetResourceAllocator())) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  upload_arena_->SetLabel("ContentContext Uploads");
 
   {
     TextureDescriptor desc;
@@ -331,6 +369,32 @@ ContentContext::ContentContext(
         std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor));
   }
 
+#if IMPELLER_ENABLE_COMPUTE
+  if (context_->GetCapabilities()->SupportsCompute()) {
+    compute_path_rasterizer_ =
+        std::make_unique<ComputePathRasterizer>(*context_);
+
+    auto mask_pipeline_descriptor =
+        CoverageMaskClipPipeline::Builder::MakeDefaultPipelineDescriptor(
+            *context_);
+    if (!mask_pipeline_descriptor.has_value()) {
+      return;
+    }
+    options_trianglestrip.ApplyToPipelineDescriptor(*mask_pipeline_descriptor);
+    // Like the clip pipeline, only the stencil is written.
+    auto mask_color_attachments =
+        mask_pipeline_descriptor->GetColorAttachmentDescriptors();
+    for (auto& color_attachment : mask_color_attachments) {
+      color_attachment.second.write_mask = ColorWriteMaskBits::kNone;
+    }
+    mask_pipeline_descriptor->SetColorAttachmentDescriptors(
+        std::move(mask_color_attachments));
+    coverage_mask_clip_pipelines_.SetDefault(
+        options_trianglestrip, std::make_unique<CoverageMaskClipPipeline>(
+                                   *context_, mask_pipeline_descriptor));
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   if (context_->GetCapabilities()->SupportsFramebufferFetch()) {
     framebuffer_blend_color_pipelines_.CreateDefault(
         *context_, options_trianglestrip,
@@ -516,8 +580,14 @@ fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
   }
   sub_renderpass->SetLabel(SPrintF("%s RenderPass", label.data()));
 
-  if (!subpass_callback(*this, *sub_renderpass)) {
-    return fml::Status(fml::StatusCode::kUnknown, "");
+  {
+    sub_renderpass->PushGPUTimingScope(label);
+    fml::ScopedCleanupClosure pop_gpu_timing_scope(
+        [&sub_renderpass]() { sub_renderpass->PopGPUTimingScope(); });
+
+    if (!subpass_callback(*this, *sub_renderpass)) {
+      return fml::Status(fml::StatusCode::kUnknown, "");
+    }
   }
 
   if (!sub_renderpass->EncodeCommands()) {
@@ -543,7 +613,28 @@ std::shared_ptr<scene::SceneContext> ContentContext::GetSceneContext() const {
 }
 #endif  // IMPELLER_ENABLE_3D
 
+namespace {
+// The tessellator of the worker thread recording render passes, if any. See
+// |ContentContext::WorkerScope|.
+thread_local std::shared_ptr<Tessellator> tWorkerTessellator;
+thread_local size_t tWorkerScopeDepth = 0u;
+}  // namespace
+
+ContentContext::WorkerScope::WorkerScope() {
+  if (tWorkerScopeDepth++ == 0u && !tWorkerTessellator) {
+    tWorkerTessellator = std::make_shared<Tessellator>();
+  }
+}
+
+ContentContext::WorkerScope::~WorkerScope() {
+  FML_DCHECK(tWorkerScopeDepth > 0u);
+  tWorkerScopeDepth--;
+}
+
 std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
+  if (tWorkerScopeDepth > 0u) {
+    return tWorkerTessellator;
+  }
   return tessellator_;
 }
 
@@ -559,6 +650,20 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetComputePathRasterization(bool enabled) {
+  compute_path_rasterization_ = enabled;
+}
+
+const ComputePathRasterizer* ContentContext::GetComputePathRasterizer() const {
+#if IMPELLER_ENABLE_COMPUTE
+  if (compute_path_rasterization_ && compute_path_rasterizer_ &&
+      compute_path_rasterizer_->IsValid()) {
+    return compute_path_rasterizer_.get();
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+  return nullptr;
+}
+
 std::shared_ptr<Pipeline<PipelineDescriptor>>
 ContentContext::GetCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name,
@@ -566,6 +671,7 @@ ContentContext::GetCachedRuntimeEffectPipeline(
     const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
         create_callback) const {
   RuntimeEffectPipelineKey key{unique_entrypoint_name, options};
+  Lock lock(runtime_effect_pipelines_mutex_);
   auto it = runtime_effect_pipelines_.find(key);
   if (it == runtime_effect_pipelines_.end()) {
     it = runtime_effect_pipelines_.insert(it, {key, create_callback()});
@@ -575,6 +681,7 @@ ContentContext::GetCachedRuntimeEffectPipeline(
 
 void ContentContext::ClearCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name) const {
+  Lock lock(runtime_effect_pipelines_mutex_);
   for (auto it = runtime_effect_pipelines_.begin();
        it != runtime_effect_pipelines_.end();) {
     if (it->first.unique_entrypoint_name == unique_entrypoint_name) {
@@ -585,6 +692,16 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+std::string ContentContext::GetRecordedVariantsLabel(
+    const PipelineDescriptor& desc) {
+  std::stringstream stream;
+  stream << desc.GetLabel();
+  for (Scalar constant : desc.GetSpecializationConstants()) {
+    stream << " " << constant;
+  }
+  return stream.str();
+}
+
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
   TRACE_EVENT0("flutter", "InitializeCommonlyUsedShadersIfNeeded");
   GetContext()->InitializeCommonlyUsedShadersIfNeeded();
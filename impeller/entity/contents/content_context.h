@@ -5,20 +5,26 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_CONTENT_CONTEXT_H_
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_CONTENT_CONTEXT_H_
 
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/status_or.h"
+#include "impeller/base/thread.h"
 #include "impeller/base/validation.h"
+#include "impeller/core/device_buffer_arena.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/typographer_context.h"
@@ -28,6 +34,8 @@
 #include "impeller/entity/clip.vert.h"
 #include "impeller/entity/color_matrix_color_filter.frag.h"
 #include "impeller/entity/conical_gradient_fill.frag.h"
+#include "impeller/entity/coverage_mask_clip.frag.h"
+#include "impeller/entity/coverage_mask_clip.vert.h"
 #include "impeller/entity/filter_position.vert.h"
 #include "impeller/entity/filter_position_uv.vert.h"
 #include "impeller/entity/gaussian.frag.h"
@@ -140,6 +148,9 @@ using PorterDuffBlendPipeline =
     RenderPipelineHandle<PorterDuffBlendVertexShader,
                          PorterDuffBlendFragmentShader>;
 using ClipPipeline = RenderPipelineHandle<ClipVertexShader, ClipFragmentShader>;
+using CoverageMaskClipPipeline =
+    RenderPipelineHandle<CoverageMaskClipVertexShader,
+                         CoverageMaskClipFragmentShader>;
 
 // Advanced blends
 using BlendColorPipeline = RenderPipelineHandle<AdvancedBlendVertexShader,
@@ -354,10 +365,16 @@ struct ContentContextOptions {
   };
 
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
+
+  /// The inverse of |Hash|. Used to restore the options of pipeline variants
+  /// recorded by previous launches. Returns std::nullopt if the key does not
+  /// describe a valid set of options.
+  static std::optional<ContentContextOptions> FromHash(uint64_t key);
 };
 
 class Tessellator;
 class RenderTargetCache;
+class ComputePathRasterizer;
 
 class ContentContext {
  public:
@@ -374,8 +391,31 @@ class ContentContext {
   std::shared_ptr<scene::SceneContext> GetSceneContext() const;
 #endif  // IMPELLER_ENABLE_3D
 
+  /// @brief Retrieve the tessellator for the calling thread.
+  ///
+  /// Within a |WorkerScope| this is a tessellator owned by the worker thread,
+  /// otherwise the one shared by the raster thread.
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the calling thread as recording render passes on behalf
+  ///             of the raster thread for the lifetime of the scope.
+  ///
+  ///             The tessellator keeps scratch buffers and cannot be shared
+  ///             between threads. Workers get their own instead.
+  ///
+  class WorkerScope {
+   public:
+    WorkerScope();
+
+    ~WorkerScope();
+
+   private:
+    WorkerScope(const WorkerScope&) = delete;
+
+    WorkerScope& operator=(const WorkerScope&) = delete;
+  };
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetLinearGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(linear_gradient_fill_pipelines_, opts);
@@ -489,6 +529,12 @@ class ContentContext {
     return GetPipeline(clip_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetCoverageMaskClipPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsCompute());
+    return GetPipeline(coverage_mask_clip_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(glyph_atlas_pipelines_, opts);
@@ -687,6 +733,20 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the fills of paths that need stencil-then-cover may
+  ///             be rasterized into a coverage mask with a compute shader
+  ///             instead of being tessellated. Off by default. Has no effect
+  ///             if the device does not support compute.
+  ///
+  void SetComputePathRasterization(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The rasterizer to fill paths with, or nullptr if compute path
+  ///             rasterization is disabled or not supported.
+  ///
+  const ComputePathRasterizer* GetComputePathRasterizer() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -738,10 +798,17 @@ class ContentContext {
 
   /// @brief Retrieve the currnent host buffer for transient storage.
   ///
-  /// This is only safe to use from the raster threads. Other threads should
+  /// This is safe to use from the raster thread and from threads recording
+  /// render passes for it within a |WorkerScope|. Other threads should
   /// allocate their own device buffers.
   HostBuffer& GetTransientsBuffer() const { return *host_buffer_; }
 
+  /// @brief Retrieve the arena for data uploaded to textures.
+  ///
+  /// Uploads are sub-allocated from a few device buffers instead of creating
+  /// one buffer per upload. The arena must be advanced once per frame.
+  DeviceBufferArena& GetUploadArena() const { return *upload_arena_; }
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
@@ -774,11 +841,13 @@ class ContentContext {
     };
   };
 
+  mutable Mutex runtime_effect_pipelines_mutex_;
   mutable std::unordered_map<RuntimeEffectPipelineKey,
                              std::shared_ptr<Pipeline<PipelineDescriptor>>,
                              RuntimeEffectPipelineKey::Hash,
                              RuntimeEffectPipelineKey::Equal>
-      runtime_effect_pipelines_;
+      runtime_effect_pipelines_
+          IPLR_GUARDED_BY(runtime_effect_pipelines_mutex_);
 
   /// Holds multiple Pipelines associated with the same PipelineHandle types.
   ///
@@ -820,6 +889,7 @@ class ContentContext {
       }
       options.ApplyToPipelineDescriptor(*desc);
       SetDefault(options, std::make_unique<PipelineHandleT>(context, desc));
+      PrecompileRecordedVariants(context, desc.value());
     }
 
     PipelineHandleT* Get(const ContentContextOptions& options) const {
@@ -839,6 +909,30 @@ class ContentContext {
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
    private:
+    // Start compiling the variants used by previous launches on the
+    // concurrent workers of the pipeline library, so that they are likely
+    // ready by the time they are first used instead of being compiled
+    // synchronously on the raster thread.
+    void PrecompileRecordedVariants(const Context& context,
+                                    const PipelineDescriptor& default_desc) {
+      const std::vector<uint64_t> variant_keys =
+          context.GetPipelineLibrary()->GetRecordedPipelineVariants(
+              GetRecordedVariantsLabel(default_desc));
+      for (uint64_t variant_key : variant_keys) {
+        std::optional<ContentContextOptions> variant_options =
+            ContentContextOptions::FromHash(variant_key);
+        if (!variant_options.has_value() || Get(variant_options.value())) {
+          continue;
+        }
+        PipelineDescriptor desc = default_desc;
+        variant_options->ApplyToPipelineDescriptor(desc);
+        desc.SetLabel(SPrintF("%s V#%zu", default_desc.GetLabel().c_str(),
+                              GetPipelineCount()));
+        Set(variant_options.value(),
+            std::make_unique<PipelineHandleT>(context, desc));
+      }
+    }
+
     std::optional<ContentContextOptions> default_options_;
     std::unordered_map<ContentContextOptions,
                        std::unique_ptr<PipelineHandleT>,
@@ -885,6 +979,7 @@ class ContentContext {
   mutable Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter_pipelines_;
   mutable Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter_pipelines_;
   mutable Variants<ClipPipeline> clip_pipelines_;
+  mutable Variants<CoverageMaskClipPipeline> coverage_mask_clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -941,13 +1036,24 @@ class ContentContext {
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
       Variants<TypedPipeline>& container,
       ContentContextOptions opts) const {
-    TypedPipeline* pipeline = CreateIfNeeded(container, opts);
+    TypedPipeline* pipeline = nullptr;
+    {
+      // Variants are created lazily and subpasses may be recorded on several
+      // threads at once.
+      Lock lock(pipelines_mutex_);
+      pipeline = CreateIfNeeded(container, opts);
+    }
     if (!pipeline) {
       return nullptr;
     }
     return pipeline->WaitAndGet();
   }
 
+  // Identifies the pipeline that recorded variants belong to. Several
+  // pipelines share the same shaders and only differ in their specialization
+  // constants.
+  static std::string GetRecordedVariantsLabel(const PipelineDescriptor& desc);
+
   template <class RenderPipelineHandleT>
   RenderPipelineHandleT* CreateIfNeeded(
       Variants<RenderPipelineHandleT>& container,
@@ -985,18 +1091,28 @@ class ContentContext {
     std::unique_ptr<RenderPipelineHandleT> variant =
         std::make_unique<RenderPipelineHandleT>(std::move(variant_future));
     container.Set(opts, std::move(variant));
+    // Wireframe variants are a debugging aid and not worth warming up.
+    if (!wireframe_) {
+      context_->GetPipelineLibrary()->RecordPipelineVariant(
+          GetRecordedVariantsLabel(pipeline->GetDescriptor()),
+          ContentContextOptions::Hash{}(opts));
+    }
     return container.Get(opts);
   }
 
   bool is_valid_ = false;
+  mutable Mutex pipelines_mutex_;
   std::shared_ptr<Tessellator> tessellator_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
+  std::shared_ptr<DeviceBufferArena> upload_arena_;
   std::shared_ptr<Texture> empty_texture_;
   bool wireframe_ = false;
+  std::unique_ptr<ComputePathRasterizer> compute_path_rasterizer_;
+  bool compute_path_rasterization_ = false;
 
   ContentContext(const ContentContext&) = delete;
 
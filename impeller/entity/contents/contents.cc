@@ -142,6 +142,10 @@ std::optional<Color> Contents::AsBackgroundColor(const Entity& entity,
   return {};
 }
 
+std::string_view Contents::GetTypeName() const {
+  return "Contents";
+}
+
 const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
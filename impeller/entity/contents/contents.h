@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <memory>
+#include <string_view>
 
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/geometry/color.h"
@@ -63,6 +64,12 @@ class Contents {
                       const Entity& entity,
                       RenderPass& pass) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief   The name of the type of contents. Used to attribute GPU time to
+  ///          the contents in GPU timing scopes.
+  ///
+  virtual std::string_view GetTypeName() const;
+
   //----------------------------------------------------------------------------
   /// @brief   Get the area of the render pass that will be affected when this
   ///          contents is rendered.
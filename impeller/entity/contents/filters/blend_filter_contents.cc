@@ -1004,4 +1004,8 @@ std::optional<Entity> BlendFilterContents::RenderFilter(
   FML_UNREACHABLE();
 }
 
+std::string_view BlendFilterContents::GetTypeName() const {
+  return "BlendFilterContents";
+}
+
 }  // namespace impeller
@@ -54,6 +54,9 @@ class BlendFilterContents : public ColorFilterContents {
   ///         been blended.
   void SetForegroundColor(std::optional<Color> color);
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -172,4 +172,8 @@ std::optional<Rect> BorderMaskBlurFilterContents::GetFilterSourceCoverage(
   return output_limit.Expand(transformed_blur_vector);
 }
 
+std::string_view BorderMaskBlurFilterContents::GetTypeName() const {
+  return "BorderMaskBlurFilterContents";
+}
+
 }  // namespace impeller
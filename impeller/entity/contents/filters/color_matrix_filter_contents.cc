@@ -119,4 +119,8 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
   return sub_entity;
 }
 
+std::string_view ColorMatrixFilterContents::GetTypeName() const {
+  return "ColorMatrixFilterContents";
+}
+
 }  // namespace impeller
@@ -23,6 +23,9 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
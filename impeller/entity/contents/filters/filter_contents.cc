@@ -310,4 +310,8 @@ void FilterContents::SetRenderingMode(Entity::RenderingMode rendering_mode) {
   }
 }
 
+std::string_view FilterContents::GetTypeName() const {
+  return "FilterContents";
+}
+
 }  // namespace impeller
@@ -102,6 +102,9 @@ class FilterContents : public Contents {
       const Entity& entity,
       const std::optional<Rect>& coverage_hint) const;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
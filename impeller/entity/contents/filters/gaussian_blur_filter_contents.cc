@@ -653,4 +653,8 @@ GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
   return result;
 }
 
+std::string_view GaussianBlurFilterContents::GetTypeName() const {
+  return "GaussianBlurFilterContents";
+}
+
 }  // namespace impeller
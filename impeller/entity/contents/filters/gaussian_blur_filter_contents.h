@@ -46,6 +46,9 @@ class GaussianBlurFilterContents final : public FilterContents {
   Scalar GetSigmaX() const { return sigma_x_; }
   Scalar GetSigmaY() const { return sigma_y_; }
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |FilterContents|
   std::optional<Rect> GetFilterSourceCoverage(
       const Matrix& effect_transform,
@@ -99,4 +99,8 @@ std::optional<Entity> LinearToSrgbFilterContents::RenderFilter(
   return sub_entity;
 }
 
+std::string_view LinearToSrgbFilterContents::GetTypeName() const {
+  return "LinearToSrgbFilterContents";
+}
+
 }  // namespace impeller
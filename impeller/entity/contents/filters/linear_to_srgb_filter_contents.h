@@ -16,6 +16,9 @@ class LinearToSrgbFilterContents final : public ColorFilterContents {
 
   ~LinearToSrgbFilterContents() override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
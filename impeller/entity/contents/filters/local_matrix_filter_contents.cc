@@ -45,4 +45,8 @@ std::optional<Entity> LocalMatrixFilterContents::RenderFilter(
   return Entity::FromSnapshot(snapshot.value(), entity.GetBlendMode());
 }
 
+std::string_view LocalMatrixFilterContents::GetTypeName() const {
+  return "LocalMatrixFilterContents";
+}
+
 }  // namespace impeller
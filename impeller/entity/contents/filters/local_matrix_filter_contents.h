@@ -26,6 +26,9 @@ class LocalMatrixFilterContents final : public FilterContents {
       const Matrix& effect_transform,
       const Rect& output_limit) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -104,4 +104,8 @@ std::optional<Rect> MatrixFilterContents::GetFilterCoverage(
   return coverage->TransformBounds(transform);
 }
 
+std::string_view MatrixFilterContents::GetTypeName() const {
+  return "MatrixFilterContents";
+}
+
 }  // namespace impeller
@@ -212,4 +212,8 @@ DirectionalMorphologyFilterContents::GetFilterSourceCoverage(
   }
 }
 
+std::string_view DirectionalMorphologyFilterContents::GetTypeName() const {
+  return "DirectionalMorphologyFilterContents";
+}
+
 }  // namespace impeller
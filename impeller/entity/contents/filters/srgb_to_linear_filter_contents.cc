@@ -99,4 +99,8 @@ std::optional<Entity> SrgbToLinearFilterContents::RenderFilter(
   return sub_entity;
 }
 
+std::string_view SrgbToLinearFilterContents::GetTypeName() const {
+  return "SrgbToLinearFilterContents";
+}
+
 }  // namespace impeller
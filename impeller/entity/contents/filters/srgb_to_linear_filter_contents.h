@@ -16,6 +16,9 @@ class SrgbToLinearFilterContents final : public ColorFilterContents {
 
   ~SrgbToLinearFilterContents() override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -141,4 +141,8 @@ std::optional<Rect> YUVToRGBFilterContents::GetFilterSourceCoverage(
   return output_limit;
 }
 
+std::string_view YUVToRGBFilterContents::GetTypeName() const {
+  return "YUVToRGBFilterContents";
+}
+
 }  // namespace impeller
@@ -17,6 +17,9 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -148,4 +148,8 @@ bool FramebufferBlendContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+std::string_view FramebufferBlendContents::GetTypeName() const {
+  return "FramebufferBlendContents";
+}
+
 }  // namespace impeller
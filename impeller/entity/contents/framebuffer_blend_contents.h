@@ -44,6 +44,9 @@ class FramebufferBlendContents final : public ColorSourceContents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -7,7 +7,9 @@
 #include "flutter/fml/logging.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_arena.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/platform.h"
 #include "impeller/core/texture.h"
 #include "impeller/renderer/context.h"
 
@@ -15,7 +17,8 @@ namespace impeller {
 
 std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
-    const std::shared_ptr<impeller::Context>& context) {
+    const std::shared_ptr<impeller::Context>& context,
+    DeviceBufferArena& upload_arena) {
   if (gradient_data.texture_size == 0) {
     FML_DLOG(ERROR) << "Invalid gradient data.";
     return nullptr;
@@ -32,14 +35,19 @@ std::shared_ptr<Texture> CreateGradientTexture(
     return nullptr;
   }
 
-  auto data_mapping =
-      std::make_shared<fml::DataMapping>(gradient_data.color_bytes);
-  auto buffer =
-      context->GetResourceAllocator()->CreateBufferWithCopy(*data_mapping);
+  // The range is only reused once the frames in flight have completed, so
+  // the upload can be released as soon as the copy is submitted.
+  auto upload = upload_arena.Emplace(gradient_data.color_bytes.data(),
+                                     gradient_data.color_bytes.size(),
+                                     DefaultUniformAlignment());
+  if (!upload) {
+    FML_DLOG(ERROR) << "Could not upload gradient data.";
+    return nullptr;
+  }
 
   auto cmd_buffer = context->CreateCommandBuffer();
   auto blit_pass = cmd_buffer->CreateBlitPass();
-  blit_pass->AddCopy(DeviceBuffer::AsBufferView(std::move(buffer)), texture);
+  blit_pass->AddCopy(upload->GetBufferView(), texture);
 
   if (!blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
       !context->GetCommandQueue()->Submit({std::move(cmd_buffer)}).ok()) {
@@ -16,14 +16,17 @@
 namespace impeller {
 
 class Context;
+class DeviceBufferArena;
 
 /**
  * @brief Create a host visible texture that contains the gradient defined
- * by the provided gradient data.
+ * by the provided gradient data. The colors are uploaded through the given
+ * arena.
  */
 std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
-    const std::shared_ptr<impeller::Context>& context);
+    const std::shared_ptr<impeller::Context>& context,
+    DeviceBufferArena& upload_arena);
 
 struct StopData {
   Color color;
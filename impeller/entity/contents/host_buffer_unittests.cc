@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
+#include <thread>
+
 #include "flutter/testing/testing.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/entity/entity_playground.h"
@@ -156,5 +160,104 @@ TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
   EXPECT_EQ(view.range, Range(32, 64));
 }
 
+TEST_P(HostBufferTest, ArenasAreAddedWhileSubmissionsArePending) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  std::vector<std::function<void()>> signals;
+  for (auto i = 0u; i < 5u; i++) {
+    signals.push_back(buffer->TrackSubmission());
+    buffer->Reset();
+  }
+  // Every arena is still in use by the GPU, so none could be reused.
+  EXPECT_EQ(buffer->GetStats().arena_count, 6u);
+  EXPECT_EQ(buffer->GetStateForTest().current_frame, 5u);
+
+  for (const auto& signal : signals) {
+    signal();
+    // Signaling more than once must not release other submissions.
+    signal();
+  }
+  signals.clear();
+
+  // Completed arenas are reused in order, and the arenas that are no longer
+  // needed are released after a while.
+  for (auto i = 0u; i < 1000u; i++) {
+    auto signal = buffer->TrackSubmission();
+    signal();
+    buffer->Reset();
+  }
+  EXPECT_EQ(buffer->GetStats().arena_count, kHostBufferArenaSize);
+}
+
+TEST_P(HostBufferTest, ArenaInUseIsNotReused) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  auto signal = buffer->TrackSubmission();
+  auto view = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+  buffer->Reset();
+  for (auto i = 0u; i < kHostBufferArenaSize - 1; i++) {
+    buffer->TrackSubmission()();
+    buffer->Reset();
+  }
+
+  // The first frame is still pending. Its buffer must not be handed out.
+  EXPECT_NE(buffer->Emplace(1020000, 0, [](uint8_t* data) {}).buffer,
+            view.buffer);
+  EXPECT_EQ(buffer->GetStats().arena_count, kHostBufferArenaSize + 1);
+  signal();
+}
+
+TEST_P(HostBufferTest, ReportsPerFrameHighWaterMark) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  auto view_a = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+  auto view_b = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetStats().last_frame_bytes, 2u * 1024000u);
+
+  auto view_c = buffer->Emplace(16, 0, [](uint8_t* data) {});
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetStats().last_frame_bytes, 1024000u);
+  EXPECT_EQ(buffer->GetStats().max_frame_bytes, 2u * 1024000u);
+}
+
+TEST_P(HostBufferTest, CanEmplaceFromSeveralThreads) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  constexpr size_t kThreadCount = 4u;
+  constexpr size_t kEmplaceCount = 1000u;
+  std::vector<std::vector<BufferView>> views(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&buffer, &views = views[i]]() {
+      std::array<char, 256> data = {};
+      for (size_t j = 0; j < kEmplaceCount; j++) {
+        views.push_back(buffer->Emplace(data.data(), data.size(), 16u));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // No two views overlap.
+  std::map<const DeviceBuffer*, std::vector<Range>> ranges;
+  for (const auto& thread_views : views) {
+    for (const auto& view : thread_views) {
+      ASSERT_TRUE(view);
+      ranges[view.buffer.get()].push_back(view.range);
+    }
+  }
+  for (auto& [_, buffer_ranges] : ranges) {
+    std::sort(
+        buffer_ranges.begin(), buffer_ranges.end(),
+        [](const Range& a, const Range& b) { return a.offset < b.offset; });
+    for (size_t i = 1; i < buffer_ranges.size(); i++) {
+      EXPECT_GE(buffer_ranges[i].offset,
+                buffer_ranges[i - 1].offset + buffer_ranges[i - 1].length);
+    }
+  }
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -80,7 +80,8 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
       [this, &renderer](RenderPass& pass) {
         auto gradient_data = CreateGradientBuffer(colors_, stops_);
         auto gradient_texture =
-            CreateGradientTexture(gradient_data, renderer.GetContext());
+            CreateGradientTexture(gradient_data, renderer.GetContext(),
+                                  renderer.GetUploadArena());
         if (gradient_texture == nullptr) {
           return false;
         }
@@ -163,4 +164,8 @@ bool LinearGradientContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view LinearGradientContents::GetTypeName() const {
+  return "LinearGradientContents";
+}
+
 }  // namespace impeller
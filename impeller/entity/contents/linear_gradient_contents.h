@@ -23,6 +23,9 @@ class LinearGradientContents final : public ColorSourceContents {
   // |Contents|
   bool IsOpaque() const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -112,7 +112,8 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
 
   auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      CreateGradientTexture(gradient_data, renderer.GetContext(),
+                            renderer.GetUploadArena());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -165,4 +166,8 @@ bool RadialGradientContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view RadialGradientContents::GetTypeName() const {
+  return "RadialGradientContents";
+}
+
 }  // namespace impeller
@@ -332,4 +332,8 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
                                                VS::FrameInfo{}, bind_callback);
 }
 
+std::string_view RuntimeEffectContents::GetTypeName() const {
+  return "RuntimeEffectContents";
+}
+
 }  // namespace impeller
@@ -30,6 +30,9 @@ class RuntimeEffectContents final : public ColorSourceContents {
   // | Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -88,4 +88,8 @@ bool SolidColorContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view SolidColorContents::GetTypeName() const {
+  return "SolidColorContents";
+}
+
 }  // namespace impeller
@@ -134,4 +134,8 @@ bool SolidRRectBlurContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view SolidRRectBlurContents::GetTypeName() const {
+  return "SolidRRectBlurContents";
+}
+
 }  // namespace impeller
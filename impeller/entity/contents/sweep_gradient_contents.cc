@@ -122,7 +122,8 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
 
   auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      CreateGradientTexture(gradient_data, renderer.GetContext(),
+                            renderer.GetUploadArena());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -176,4 +177,8 @@ bool SweepGradientContents::ApplyColorFilter(
   return true;
 }
 
+std::string_view SweepGradientContents::GetTypeName() const {
+  return "SweepGradientContents";
+}
+
 }  // namespace impeller
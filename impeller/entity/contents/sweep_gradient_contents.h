@@ -24,6 +24,9 @@ class SweepGradientContents final : public ColorSourceContents {
   // |Contents|
   bool IsOpaque() const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
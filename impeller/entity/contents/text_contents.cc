@@ -201,4 +201,8 @@ bool TextContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+std::string_view TextContents::GetTypeName() const {
+  return "TextContents";
+}
+
 }  // namespace impeller
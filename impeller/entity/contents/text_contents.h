@@ -55,6 +55,9 @@ class TextContents final : public Contents {
 
   void SetScale(Scalar scale) { scale_ = scale; }
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
@@ -215,4 +215,8 @@ void TextureContents::SetDeferApplyingOpacity(bool defer_applying_opacity) {
   defer_applying_opacity_ = defer_applying_opacity;
 }
 
+std::string_view TextureContents::GetTypeName() const {
+  return "TextureContents";
+}
+
 }  // namespace impeller
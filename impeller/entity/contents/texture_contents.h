@@ -64,6 +64,9 @@ class TextureContents final : public Contents {
       int32_t mip_count = 1,
       const std::string& label = "Texture Snapshot") const override;
 
+  // |Contents|
+  std::string_view GetTypeName() const override;
+
   // |Contents|
   bool Render(const ContentContext& renderer,
               const Entity& entity,
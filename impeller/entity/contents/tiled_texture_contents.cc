@@ -247,4 +247,8 @@ std::optional<Snapshot> TiledTextureContents::RenderToSnapshot(
       label);  // label
 }
 
+std::string_view TiledTextureContents::GetTypeName() const {
+  return "TiledTextureContents";
+}
+
 }  // namespace impeller
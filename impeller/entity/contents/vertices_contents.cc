@@ -211,4 +211,8 @@ bool VerticesSimpleBlendContents::Render(const ContentContext& renderer,
   return pass.Draw().ok();
 }
 
+std::string_view VerticesSimpleBlendContents::GetTypeName() const {
+  return "VerticesSimpleBlendContents";
+}
+
 }  // namespace impeller
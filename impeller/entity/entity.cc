@@ -181,6 +181,17 @@ bool Entity::Render(const ContentContext& renderer,
         Rect::MakeSize(parent_pass.GetRenderTargetSize()));
   }
 
+#ifdef IMPELLER_DEBUG
+  // Every entity is rendered through here, so only open a timing scope when
+  // the pass is actually recording them.
+  if (parent_pass.IsRecordingGPUTimingScopes()) {
+    parent_pass.PushGPUTimingScope(contents_->GetTypeName());
+    bool result = contents_->Render(renderer, *this, parent_pass);
+    parent_pass.PopGPUTimingScope();
+    return result;
+  }
+#endif  // IMPELLER_DEBUG
+
   return contents_->Render(renderer, *this, parent_pass);
 }
 
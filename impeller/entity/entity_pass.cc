@@ -4,6 +4,7 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -11,6 +12,7 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -507,6 +509,190 @@ bool EntityPass::Render(ContentContext& renderer,
       clip_stack);                               // clip_coverage_stack
 }
 
+struct EntityPass::PendingSubpass {
+  /// The area of the parent pass covered by the subpass texture.
+  Rect coverage;
+  /// Set by the first thread to start recording the subpass, which is either
+  /// a worker or the raster thread once the parent pass reaches it.
+  std::atomic_bool claimed = false;
+  /// Signaled once the thread that claimed the subpass is done recording it.
+  fml::ManualResetWaitableEvent recorded;
+  /// The subpass texture, or `std::nullopt` if recording failed.
+  std::optional<EntityPassTarget> target;
+};
+
+std::optional<Rect> EntityPass::GetSubpassTargetCoverage(
+    const EntityPass& subpass,
+    ISize pass_target_size,
+    ISize root_pass_size,
+    Point global_pass_position,
+    const EntityPassClipStack& clip_coverage_stack,
+    bool has_backdrop_filter) const {
+  if (!clip_coverage_stack.HasCoverage()) {
+    // The current clip is empty. This means the pass texture won't be
+    // visible, so skip it.
+    return std::nullopt;
+  }
+  auto clip_coverage_back = clip_coverage_stack.CurrentClipCoverage();
+  if (!clip_coverage_back.has_value()) {
+    return std::nullopt;
+  }
+
+  // The maximum coverage of the subpass. Subpasses textures should never
+  // extend outside the parent pass texture or the current clip coverage.
+  auto coverage_limit =
+      Rect::MakeOriginSize(global_pass_position, Size(pass_target_size))
+          .Intersection(clip_coverage_back.value());
+  if (!coverage_limit.has_value()) {
+    return std::nullopt;
+  }
+
+  coverage_limit =
+      coverage_limit->Intersection(Rect::MakeSize(root_pass_size));
+  if (!coverage_limit.has_value()) {
+    return std::nullopt;
+  }
+
+  auto subpass_coverage = (subpass.flood_clip_ || has_backdrop_filter)
+                              ? coverage_limit
+                              : GetSubpassCoverage(subpass, coverage_limit);
+  if (!subpass_coverage.has_value()) {
+    return std::nullopt;
+  }
+
+  if (ISize(subpass_coverage->GetSize()).IsEmpty()) {
+    return std::nullopt;
+  }
+  return subpass_coverage;
+}
+
+std::optional<EntityPassTarget> EntityPass::RecordSubpass(
+    const EntityPass& subpass,
+    ContentContext& renderer,
+    ISize root_pass_size,
+    Rect subpass_coverage,
+    Point global_pass_position,
+    uint32_t pass_depth,
+    EntityPassClipStack& clip_coverage_stack,
+    std::shared_ptr<Contents> backdrop_filter_contents) const {
+  auto subpass_size = ISize(subpass_coverage.GetSize());
+  auto subpass_target = CreateRenderTarget(
+      renderer,      // renderer
+      subpass_size,  // size
+      subpass.GetRequiredMipCount(),
+      subpass.GetClearColorOrDefault(subpass_size));  // clear_color
+
+  if (!subpass_target.IsValid()) {
+    VALIDATION_LOG << "Subpass render target is invalid.";
+    return std::nullopt;
+  }
+
+  // Start non-collapsed subpasses with a fresh clip coverage stack limited by
+  // the subpass coverage. This is important because image filters applied to
+  // save layers may transform the subpass texture after it's rendered,
+  // causing parent clip coverage to get misaligned with the actual area that
+  // the subpass will affect in the parent pass.
+  clip_coverage_stack.PushSubpass(subpass_coverage, subpass.clip_height_);
+
+  // Stencil textures aren't shared between EntityPasses (as much of the
+  // time they are transient).
+  if (!subpass.OnRender(
+          renderer,                      // renderer
+          root_pass_size,                // root_pass_size
+          subpass_target,                // pass_target
+          subpass_coverage.GetOrigin(),  // global_pass_position
+          subpass_coverage.GetOrigin() -
+              global_pass_position,            // local_pass_position
+          pass_depth,                          // pass_depth
+          clip_coverage_stack,                 // clip_coverage_stack
+          subpass.clip_height_,                // clip_height_floor
+          std::move(backdrop_filter_contents)  // backdrop_filter_contents
+          )) {
+    // Validation error messages are triggered for all `OnRender()` failure
+    // cases.
+    return std::nullopt;
+  }
+
+  clip_coverage_stack.PopSubpass();
+  return subpass_target;
+}
+
+EntityPass::PendingSubpasses EntityPass::StartRecordingSubpasses(
+    ContentContext& renderer,
+    InlinePassContext& pass_context,
+    ISize root_pass_size,
+    Point global_pass_position,
+    uint32_t pass_depth,
+    const EntityPassClipStack& clip_coverage_stack) const {
+  PendingSubpasses pending_subpasses;
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner =
+      renderer.GetContext()->GetEncodingTaskRunner();
+  if (!task_runner) {
+    return pending_subpasses;
+  }
+
+  std::vector<EntityPass*> subpasses;
+  for (const auto& element : elements_) {
+    if (const auto& entity = std::get_if<Entity>(&element)) {
+      if (entity->GetClipCoverage(std::nullopt).type !=
+          Contents::ClipCoverage::Type::kNoChange) {
+        break;
+      }
+      continue;
+    }
+    EntityPass* subpass = std::get<std::unique_ptr<EntityPass>>(element).get();
+    if (subpass->delegate_->CanElide()) {
+      continue;
+    }
+    if (subpass->backdrop_filter_proc_ ||
+        subpass->delegate_->CanCollapseIntoParentPass(subpass)) {
+      break;
+    }
+    subpasses.push_back(subpass);
+  }
+  // With a single subpass there is nothing to record alongside it.
+  if (subpasses.size() < 2u) {
+    return pending_subpasses;
+  }
+
+  auto pass_target_size =
+      pass_context.GetPassTarget().GetRenderTarget().GetRenderTargetSize();
+  for (const EntityPass* subpass : subpasses) {
+    std::optional<Rect> coverage = GetSubpassTargetCoverage(
+        *subpass, pass_target_size, root_pass_size, global_pass_position,
+        clip_coverage_stack, /*has_backdrop_filter=*/false);
+    if (!coverage.has_value()) {
+      continue;
+    }
+    auto pending = std::make_shared<PendingSubpass>();
+    pending->coverage = coverage.value();
+    pending_subpasses[subpass] = pending;
+
+    // The parent pass waits for every claimed task before returning, so the
+    // references held here outlive the task.
+    task_runner->PostTask([this, subpass, pending, &renderer, root_pass_size,
+                           global_pass_position, pass_depth,
+                           subpass_clip_stack = clip_coverage_stack]() mutable {
+      if (pending->claimed.exchange(true)) {
+        return;
+      }
+      ContentContext::WorkerScope worker_scope;
+      pending->target =
+          RecordSubpass(*subpass,              // subpass
+                        renderer,              // renderer
+                        root_pass_size,        // root_pass_size
+                        pending->coverage,     // subpass_coverage
+                        global_pass_position,  // global_pass_position
+                        pass_depth + 1,        // pass_depth
+                        subpass_clip_stack,    // clip_coverage_stack
+                        nullptr                // backdrop_filter_contents
+          );
+      pending->recorded.Signal();
+    });
+  }
+  return pending_subpasses;
+}
+
 EntityPass::EntityResult EntityPass::GetEntityForElement(
     const EntityPass::Element& element,
     ContentContext& renderer,
@@ -515,7 +701,8 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     Point global_pass_position,
     uint32_t pass_depth,
     EntityPassClipStack& clip_coverage_stack,
-    size_t clip_height_floor) const {
+    size_t clip_height_floor,
+    const PendingSubpasses& pending_subpasses) const {
   //--------------------------------------------------------------------------
   /// Setup entity element.
   ///
@@ -588,88 +775,63 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       pass_context.EndPass();
     }
 
-    if (!clip_coverage_stack.HasCoverage()) {
-      // The current clip is empty. This means the pass texture won't be
-      // visible, so skip it.
-      return EntityPass::EntityResult::Skip();
-    }
-    auto clip_coverage_back = clip_coverage_stack.CurrentClipCoverage();
-    if (!clip_coverage_back.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
-
-    // The maximum coverage of the subpass. Subpasses textures should never
-    // extend outside the parent pass texture or the current clip coverage.
-    auto coverage_limit = Rect::MakeOriginSize(global_pass_position,
-                                               Size(pass_context.GetPassTarget()
-                                                        .GetRenderTarget()
-                                                        .GetRenderTargetSize()))
-                              .Intersection(clip_coverage_back.value());
-    if (!coverage_limit.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
-
-    coverage_limit =
-        coverage_limit->Intersection(Rect::MakeSize(root_pass_size));
-    if (!coverage_limit.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
-
-    auto subpass_coverage =
-        (subpass->flood_clip_ || subpass_backdrop_filter_contents)
-            ? coverage_limit
-            : GetSubpassCoverage(*subpass, coverage_limit);
-    if (!subpass_coverage.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
-
-    auto subpass_size = ISize(subpass_coverage->GetSize());
-    if (subpass_size.IsEmpty()) {
-      return EntityPass::EntityResult::Skip();
-    }
-
-    auto subpass_target = CreateRenderTarget(
-        renderer,      // renderer
-        subpass_size,  // size
-        subpass->GetRequiredMipCount(),
-        subpass->GetClearColorOrDefault(subpass_size));  // clear_color
-
-    if (!subpass_target.IsValid()) {
-      VALIDATION_LOG << "Subpass render target is invalid.";
-      return EntityPass::EntityResult::Failure();
+    std::optional<Rect> subpass_coverage;
+    std::optional<EntityPassTarget> subpass_target;
+    auto pending = pending_subpasses.find(subpass);
+    if (pending != pending_subpasses.end()) {
+      PendingSubpass& pending_subpass = *pending->second;
+      subpass_coverage = pending_subpass.coverage;
+      if (pending_subpass.claimed.exchange(true)) {
+        // A worker is already recording the subpass.
+        pending_subpass.recorded.Wait();
+        subpass_target = std::move(pending_subpass.target);
+      } else {
+        subpass_target =
+            RecordSubpass(*subpass,                  // subpass
+                          renderer,                  // renderer
+                          root_pass_size,            // root_pass_size
+                          subpass_coverage.value(),  // subpass_coverage
+                          global_pass_position,      // global_pass_position
+                          pass_depth + 1,            // pass_depth
+                          clip_coverage_stack,       // clip_coverage_stack
+                          nullptr                    // backdrop_filter_contents
+            );
+        pending_subpass.recorded.Signal();
+      }
+    } else {
+      subpass_coverage = GetSubpassTargetCoverage(
+          *subpass,  // subpass
+          pass_context.GetPassTarget()
+              .GetRenderTarget()
+              .GetRenderTargetSize(),                  // pass_target_size
+          root_pass_size,                              // root_pass_size
+          global_pass_position,                        // global_pass_position
+          clip_coverage_stack,                         // clip_coverage_stack
+          subpass_backdrop_filter_contents != nullptr  // has_backdrop_filter
+      );
+      if (!subpass_coverage.has_value()) {
+        return EntityPass::EntityResult::Skip();
+      }
+      subpass_target = RecordSubpass(
+          *subpass,                         // subpass
+          renderer,                         // renderer
+          root_pass_size,                   // root_pass_size
+          subpass_coverage.value(),         // subpass_coverage
+          global_pass_position,             // global_pass_position
+          pass_depth + 1,                   // pass_depth
+          clip_coverage_stack,              // clip_coverage_stack
+          subpass_backdrop_filter_contents  // backdrop_filter_contents
+      );
     }
-
-    // Start non-collapsed subpasses with a fresh clip coverage stack limited by
-    // the subpass coverage. This is important because image filters applied to
-    // save layers may transform the subpass texture after it's rendered,
-    // causing parent clip coverage to get misaligned with the actual area that
-    // the subpass will affect in the parent pass.
-    clip_coverage_stack.PushSubpass(subpass_coverage, subpass->clip_height_);
-
-    // Stencil textures aren't shared between EntityPasses (as much of the
-    // time they are transient).
-    if (!subpass->OnRender(
-            renderer,                       // renderer
-            root_pass_size,                 // root_pass_size
-            subpass_target,                 // pass_target
-            subpass_coverage->GetOrigin(),  // global_pass_position
-            subpass_coverage->GetOrigin() -
-                global_pass_position,         // local_pass_position
-            ++pass_depth,                     // pass_depth
-            clip_coverage_stack,              // clip_coverage_stack
-            subpass->clip_height_,            // clip_height_floor
-            subpass_backdrop_filter_contents  // backdrop_filter_contents
-            )) {
-      // Validation error messages are triggered for all `OnRender()` failure
-      // cases.
+    if (!subpass_target.has_value()) {
+      // Validation error messages are triggered for all `RecordSubpass()`
+      // failure cases.
       return EntityPass::EntityResult::Failure();
     }
 
-    clip_coverage_stack.PopSubpass();
-
     // The subpass target's texture may have changed during OnRender.
     auto subpass_texture =
-        subpass_target.GetRenderTarget().GetRenderTargetTexture();
+        subpass_target->GetRenderTarget().GetRenderTargetTexture();
 
     auto offscreen_texture_contents =
         subpass->delegate_->CreateContentsForSubpassTarget(
@@ -870,6 +1032,21 @@ bool EntityPass::OnRender(
                   renderer, clip_coverage_stack, global_pass_position);
   }
 
+  // Independent subpasses are recorded on workers while this pass records
+  // its own elements. The tasks refer to this pass, so before returning,
+  // claim those that have not started yet and wait for the others.
+  const PendingSubpasses pending_subpasses =
+      StartRecordingSubpasses(renderer, pass_context, root_pass_size,
+                              global_pass_position, pass_depth,
+                              clip_coverage_stack);
+  fml::ScopedCleanupClosure wait_for_subpasses([&pending_subpasses]() {
+    for (const auto& [subpass, pending] : pending_subpasses) {
+      if (pending->claimed.exchange(true)) {
+        pending->recorded.Wait();
+      }
+    }
+  });
+
   bool is_collapsing_clear_colors = !collapsed_parent_pass &&
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
@@ -893,7 +1070,8 @@ bool EntityPass::OnRender(
                             global_pass_position,  // global_pass_position
                             pass_depth,            // pass_depth
                             clip_coverage_stack,   // clip_coverage_stack
-                            clip_height_floor);    // clip_height_floor
+                            clip_height_floor,     // clip_height_floor
+                            pending_subpasses);    // pending_subpasses
 
     switch (result.status) {
       case EntityResult::kSuccess:
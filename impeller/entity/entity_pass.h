@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "impeller/entity/contents/contents.h"
@@ -226,6 +227,12 @@ class EntityPass {
     static EntityResult Skip() { return {{}, kSkip}; }
   };
 
+  /// A subpass whose recording was started on the context's encoding task
+  /// runner before the parent pass reached it.
+  struct PendingSubpass;
+  using PendingSubpasses =
+      std::unordered_map<const EntityPass*, std::shared_ptr<PendingSubpass>>;
+
   bool RenderElement(Entity& element_entity,
                      size_t clip_height_floor,
                      InlinePassContext& pass_context,
@@ -241,7 +248,47 @@ class EntityPass {
                                    Point global_pass_position,
                                    uint32_t pass_depth,
                                    EntityPassClipStack& clip_coverage_stack,
-                                   size_t clip_height_floor) const;
+                                   size_t clip_height_floor,
+                                   const PendingSubpasses& pending_subpasses =
+                                       PendingSubpasses()) const;
+
+  /// Computes the area of the parent pass that the texture of a
+  /// non-collapsed `subpass` covers. Returns `std::nullopt` if the subpass is
+  /// not visible.
+  std::optional<Rect> GetSubpassTargetCoverage(
+      const EntityPass& subpass,
+      ISize pass_target_size,
+      ISize root_pass_size,
+      Point global_pass_position,
+      const EntityPassClipStack& clip_coverage_stack,
+      bool has_backdrop_filter) const;
+
+  /// Creates the texture of a non-collapsed `subpass` and records the subpass
+  /// into it.
+  std::optional<EntityPassTarget> RecordSubpass(
+      const EntityPass& subpass,
+      ContentContext& renderer,
+      ISize root_pass_size,
+      Rect subpass_coverage,
+      Point global_pass_position,
+      uint32_t pass_depth,
+      EntityPassClipStack& clip_coverage_stack,
+      std::shared_ptr<Contents> backdrop_filter_contents) const;
+
+  /// Starts recording the subpasses in `elements_` that cannot affect the
+  /// state of the parent pass on the context's encoding task runner, if it
+  /// has one.
+  ///
+  /// Only the subpasses before the first element that changes the clip stack
+  /// of this pass (a clip, a collapsed subpass, or a backdrop filter) are
+  /// considered, so that their coverage is already known.
+  PendingSubpasses StartRecordingSubpasses(
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      ISize root_pass_size,
+      Point global_pass_position,
+      uint32_t pass_depth,
+      const EntityPassClipStack& clip_coverage_stack) const;
 
   //----------------------------------------------------------------------------
   /// @brief     OnRender is the internal command recording routine for
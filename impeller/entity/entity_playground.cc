@@ -60,6 +60,7 @@ bool EntityPlayground::OpenPlaygroundHere(Entity entity) {
     bool result = entity.Render(*content_context, pass);
     content_context->GetRenderTargetCache()->End();
     content_context->GetTransientsBuffer().Reset();
+    content_context->GetUploadArena().AdvanceFrame();
     return result;
   };
   return Playground::OpenPlaygroundHere(callback);
@@ -84,6 +85,7 @@ bool EntityPlayground::OpenPlaygroundHere(EntityPlaygroundCallback callback) {
     bool result = callback(content_context, pass);
     content_context.GetRenderTargetCache()->End();
     content_context.GetTransientsBuffer().Reset();
+    content_context.GetUploadArena().AdvanceFrame();
     return result;
   };
   return Playground::OpenPlaygroundHere(pass_callback);
@@ -24,6 +24,7 @@
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
@@ -207,6 +208,62 @@ TEST_P(EntityTest, EntityPassCanMergeSubpassIntoParent) {
   ASSERT_TRUE(OpenPlaygroundHere(pass));
 }
 
+/// Draws the subpass texture as is into the parent pass.
+class TextureSubpassDelegate final : public EntityPassDelegate {
+ public:
+  TextureSubpassDelegate() = default;
+
+  // |EntityPassDelegate|
+  ~TextureSubpassDelegate() override = default;
+
+  // |EntityPassDelgate|
+  bool CanElide() override { return false; }
+
+  // |EntityPassDelgate|
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override {
+    return false;
+  }
+
+  // |EntityPassDelgate|
+  std::shared_ptr<Contents> CreateContentsForSubpassTarget(
+      std::shared_ptr<Texture> target,
+      const Matrix& transform) override {
+    auto size_rect = Rect::MakeSize(target->GetSize());
+    auto contents = TextureContents::MakeRect(size_rect);
+    contents->SetSourceRect(size_rect);
+    contents->SetTexture(std::move(target));
+    return contents;
+  }
+
+  // |EntityPassDelegate|
+  std::shared_ptr<FilterContents> WithImageFilter(
+      const FilterInput::Variant& input,
+      const Matrix& effect_transform) const override {
+    return nullptr;
+  }
+};
+
+TEST_P(EntityTest, EntityPassCanRecordSiblingSubpassesConcurrently) {
+  EntityPass pass;
+
+  // On Vulkan, the playground records sibling subpasses on the encoding task
+  // runner of the context. Nested subpasses wait for their own children.
+  for (int i = 0; i < 8; i++) {
+    auto x = static_cast<Scalar>(100 * (i % 4));
+    auto y = static_cast<Scalar>(100 * (i / 4));
+    auto subpass = CreatePassWithRectPath(Rect::MakeXYWH(x, y, 80, 80),
+                                          std::nullopt);
+    subpass->SetDelegate(std::make_unique<TextureSubpassDelegate>());
+    auto nested = CreatePassWithRectPath(Rect::MakeXYWH(x, y, 40, 40),
+                                         std::nullopt);
+    nested->SetDelegate(std::make_unique<TextureSubpassDelegate>());
+    subpass->AddSubpass(std::move(nested));
+    pass.AddSubpass(std::move(subpass));
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
 TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   // Rect is drawn entirely in negative area.
   auto pass = CreatePassWithRectPath(Rect::MakeLTRB(-200, -200, -100, -100),
@@ -2534,6 +2591,22 @@ TEST_P(EntityTest, SweepGradientContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+TEST_P(EntityTest, GradientTexturesAreUploadedThroughArena) {
+  auto content_context = GetContentContext();
+  auto& arena = content_context->GetUploadArena();
+  const auto uploaded = arena.GetStats().bytes_uploaded_this_frame;
+
+  auto gradient_data =
+      CreateGradientBuffer({Color::Red(), Color::Blue()}, {0.0, 1.0});
+  auto texture = CreateGradientTexture(gradient_data, GetContext(), arena);
+  ASSERT_TRUE(texture);
+
+  const auto stats = arena.GetStats();
+  EXPECT_EQ(stats.bytes_uploaded_this_frame - uploaded,
+            gradient_data.color_bytes.size());
+  EXPECT_GE(stats.allocated_bytes, gradient_data.color_bytes.size());
+}
+
 TEST_P(EntityTest, TiledTextureContentsIsOpaque) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   TiledTextureContents contents;
@@ -2687,6 +2760,31 @@ TEST_P(EntityTest, ContentContextOptionsHasReasonableHashFunctions) {
   EXPECT_NE(hash_c, hash_d);
 }
 
+TEST_P(EntityTest, ContentContextOptionsCanBeRestoredFromHash) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kPlus,
+      .depth_compare = CompareFunction::kLessEqual,
+      .stencil_mode = ContentContextOptions::StencilMode::kCoverCompare,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_depth_stencil_attachments = false,
+      .depth_write_enabled = true,
+      .is_for_rrect_blur_clear = true,
+  };
+  auto restored =
+      ContentContextOptions::FromHash(ContentContextOptions::Hash{}(opts));
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_TRUE(ContentContextOptions::Equal{}(opts, restored.value()));
+
+  // Keys that don't describe valid options are rejected.
+  EXPECT_FALSE(ContentContextOptions::FromHash(~0ull).has_value());
+  opts.sample_count = static_cast<SampleCount>(2);
+  EXPECT_FALSE(
+      ContentContextOptions::FromHash(ContentContextOptions::Hash{}(opts))
+          .has_value());
+}
+
 #ifdef FML_OS_LINUX
 TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
   // Using framebuffer fetch on Vulkan requires that we maintain a subpass input
@@ -2745,6 +2843,78 @@ TEST_P(EntityTest, FillPathGeometryGetPositionBufferReturnsExpectedMode) {
   }
 }
 
+TEST_P(EntityTest, FillPathGeometryRasterizesWithComputeWhenEnabled) {
+  if (!GetContext()->GetCapabilities()->SupportsCompute()) {
+    GTEST_SKIP() << "Compute path rasterization requires compute support.";
+  }
+  RenderTarget target =
+      GetContentContext()->GetRenderTargetCache()->CreateOffscreen(
+          *GetContext(), {200, 200}, 1u);
+  testing::MockRenderPass mock_pass(GetContext(), target);
+  Path path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({100, 0})
+                  .LineTo({100, 100})
+                  .LineTo({50, 50})
+                  .Close()
+                  .TakePath();
+  auto geometry = Geometry::MakeFillPath(path);
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({10, 20}));
+
+  GetContentContext()->SetComputePathRasterization(true);
+  GeometryResult result =
+      geometry->GetPositionBuffer(*GetContentContext(), entity, mock_pass);
+  GetContentContext()->SetComputePathRasterization(false);
+
+  EXPECT_EQ(result.mode, GeometryResult::Mode::kCoverageMask);
+  ASSERT_TRUE(result.coverage_mask);
+  EXPECT_EQ(result.vertex_buffer.vertex_count, 4u);
+  EXPECT_EQ(result.coverage_mask->GetSize(), ISize(100, 100));
+
+  // Convex paths are still tessellated.
+  GetContentContext()->SetComputePathRasterization(true);
+  result = Geometry::MakeFillPath(PathBuilder{}
+                                      .AddRect(Rect::MakeLTRB(0, 0, 100, 100))
+                                      .SetConvexity(Convexity::kConvex)
+                                      .TakePath())
+               ->GetPositionBuffer(*GetContentContext(), entity, mock_pass);
+  GetContentContext()->SetComputePathRasterization(false);
+  EXPECT_EQ(result.mode, GeometryResult::Mode::kNormal);
+}
+
+TEST_P(EntityTest, CanDrawComputeRasterizedPaths) {
+  if (!GetContext()->GetCapabilities()->SupportsCompute()) {
+    GTEST_SKIP() << "Compute path rasterization requires compute support.";
+  }
+  Path path = PathBuilder{}
+                  .AddCircle({250, 250}, 200)
+                  .AddCircle({250, 250}, 100)
+                  .MoveTo({100, 450})
+                  .QuadraticCurveTo({250, 50}, {400, 450})
+                  .Close()
+                  .TakePath(FillType::kOdd);
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeFillPath(path));
+  contents->SetColor(Color::Red());
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    static bool use_compute = true;
+    ImGui::Begin("Controls", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Checkbox("Compute rasterization", &use_compute);
+    ImGui::End();
+
+    Entity entity;
+    entity.SetTransform(Matrix::MakeScale(GetContentScale()));
+    entity.SetContents(contents);
+    context.SetComputePathRasterization(use_compute);
+    bool result = entity.Render(context, pass);
+    context.SetComputePathRasterization(false);
+    return result;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 TEST_P(EntityTest, FailOnValidationError) {
   if (GetParam() != PlaygroundBackend::kVulkan) {
     GTEST_SKIP() << "Validation is only fatal on Vulkan backend.";
@@ -9,6 +9,11 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/renderer/command_queue.h"
+
+#if IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
 
 namespace impeller {
 
@@ -36,6 +41,17 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
+  const ComputePathRasterizer* rasterizer =
+      renderer.GetComputePathRasterizer();
+  if (rasterizer && GetResultMode() != GeometryResult::Mode::kNormal &&
+      !entity.GetTransform().HasPerspective()) {
+    std::optional<GeometryResult> result =
+        GetCoverageMaskBuffer(renderer, *rasterizer, entity, pass);
+    if (result.has_value()) {
+      return std::move(result.value());
+    }
+  }
+
   VertexBuffer vertex_buffer = renderer.GetTessellator()->TessellateConvex(
       path_, host_buffer, entity.GetTransform().GetMaxBasisLength());
 
@@ -47,6 +63,55 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   };
 }
 
+std::optional<GeometryResult> FillPathGeometry::GetCoverageMaskBuffer(
+    const ContentContext& renderer,
+    const ComputePathRasterizer& rasterizer,
+    const Entity& entity,
+    RenderPass& pass) const {
+#if IMPELLER_ENABLE_COMPUTE
+  const std::shared_ptr<Context>& context = renderer.GetContext();
+  auto& host_buffer = renderer.GetTransientsBuffer();
+
+  // The mask has to be complete before the render pass samples it, so it is
+  // encoded into its own command buffer and submitted ahead of the pass.
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return std::nullopt;
+  }
+  command_buffer->SetLabel("Path Coverage Command Buffer");
+  std::optional<ComputePathRasterizer::Mask> mask = rasterizer.Rasterize(
+      *context, *command_buffer, host_buffer, path_, entity.GetTransform());
+  if (!mask.has_value() ||
+      !context->GetCommandQueue()->Submit({std::move(command_buffer)}).ok()) {
+    return std::nullopt;
+  }
+
+  const ISize mask_size = mask->texture->GetSize();
+  auto points = Rect::MakeXYWH(mask->origin.x, mask->origin.y,
+                               mask_size.width, mask_size.height)
+                    .GetPoints();
+  using VS = CoverageMaskClipPipeline::VertexShader;
+  VertexBuffer vertex_buffer =
+      VertexBufferBuilder<VS::PerVertexData>{}
+          .AddVertices({{points[0], Point(0, 0)},
+                        {points[1], Point(1, 0)},
+                        {points[2], Point(0, 1)},
+                        {points[3], Point(1, 1)}})
+          .CreateVertexBuffer(host_buffer);
+
+  // The mask is already in the coordinate space of the pass.
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer = std::move(vertex_buffer),
+      .transform = pass.GetOrthographicTransform(),
+      .mode = GeometryResult::Mode::kCoverageMask,
+      .coverage_mask = std::move(mask->texture),
+  };
+#else
+  return std::nullopt;
+#endif  // IMPELLER_ENABLE_COMPUTE
+}
+
 GeometryResult::Mode FillPathGeometry::GetResultMode() const {
   const auto& bounding_box = path_.GetBoundingBox();
   if (path_.IsConvex() ||
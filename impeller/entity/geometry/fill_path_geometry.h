@@ -35,6 +35,14 @@ class FillPathGeometry final : public Geometry {
   // |Geometry|
   GeometryResult::Mode GetResultMode() const override;
 
+  /// Rasterizes the fill into a coverage mask with a compute shader, for
+  /// paths that would otherwise need stencil-then-cover.
+  std::optional<GeometryResult> GetCoverageMaskBuffer(
+      const ContentContext& renderer,
+      const ComputePathRasterizer& rasterizer,
+      const Entity& entity,
+      RenderPass& pass) const;
+
   Path path_;
   std::optional<Rect> inner_rect_;
 
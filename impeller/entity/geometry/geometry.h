@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_GEOMETRY_H_
 
 #include "impeller/core/formats.h"
+#include "impeller/core/texture.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
@@ -30,12 +31,17 @@ struct GeometryResult {
     /// overdraw or cancel each other out. This is a special case for stroke
     /// geometry.
     kPreventOverdraw,
+    /// The geometry was rasterized into |coverage_mask|. The vertex buffer
+    /// holds a quad over the mask with texture coordinates, and the geometry
+    /// should be stenciled by the covered pixels of the mask.
+    kCoverageMask,
   };
 
   PrimitiveType type = PrimitiveType::kTriangleStrip;
   VertexBuffer vertex_buffer;
   Matrix transform;
   Mode mode = Mode::kNormal;
+  std::shared_ptr<Texture> coverage_mask;
 };
 
 static const GeometryResult kEmptyResult = {
@@ -58,6 +58,7 @@ bool InlinePassContext::EndPass() {
   }
   FML_DCHECK(command_buffer_);
 
+  pass_->PopGPUTimingScope();
   if (!pass_->EncodeCommands()) {
     VALIDATION_LOG << "Failed to encode and submit command buffer while ending "
                       "render pass.";
@@ -115,6 +116,7 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
   command_buffer_->SetLabel(
       "EntityPass Command Buffer: Depth=" + std::to_string(pass_depth) +
       " Count=" + std::to_string(pass_count_));
+  pass_->PushGPUTimingScope("EntityPass");
 
   RenderPassResult result;
   {
@@ -11,12 +11,14 @@ RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
     : RenderTargetAllocator(std::move(allocator)) {}
 
 void RenderTargetCache::Start() {
+  Lock lock(mutex_);
   for (auto& td : render_target_data_) {
     td.used_this_frame = false;
   }
 }
 
 void RenderTargetCache::End() {
+  Lock lock(mutex_);
   std::vector<RenderTargetData> retain;
 
   for (const auto& td : render_target_data_) {
@@ -42,6 +44,7 @@ RenderTarget RenderTargetCache::CreateOffscreen(
 
   FML_DCHECK(existing_color_texture == nullptr &&
              existing_depth_stencil_texture == nullptr);
+  Lock lock(mutex_);
   auto config = RenderTargetConfig{
       .size = size,
       .mip_count = static_cast<size_t>(mip_count),
@@ -92,6 +95,7 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
   FML_DCHECK(existing_color_msaa_texture == nullptr &&
              existing_color_resolve_texture == nullptr &&
              existing_depth_stencil_texture == nullptr);
+  Lock lock(mutex_);
   auto config = RenderTargetConfig{
       .size = size,
       .mip_count = static_cast<size_t>(mip_count),
@@ -127,6 +131,7 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
 }
 
 size_t RenderTargetCache::CachedTextureCount() const {
+  Lock lock(mutex_);
   return render_target_data_.size();
 }
 
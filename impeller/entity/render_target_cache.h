@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 #define FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 
+#include "impeller/base/thread.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -13,6 +14,9 @@ namespace impeller {
 ///        allocated texture data for one frame.
 ///
 ///        Any textures unused after a frame are immediately discarded.
+///
+///        Render targets may be created from several threads at once while
+///        the render passes of a frame are recorded concurrently.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
   explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
@@ -62,7 +66,8 @@ class RenderTargetCache : public RenderTargetAllocator {
     RenderTarget render_target;
   };
 
-  std::vector<RenderTargetData> render_target_data_;
+  mutable Mutex mutex_;
+  std::vector<RenderTargetData> render_target_data_ IPLR_GUARDED_BY(mutex_);
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
@@ -71,12 +76,13 @@ class RenderTargetCache : public RenderTargetAllocator {
  public:
   /// Visible for testing.
   std::vector<RenderTargetData>::const_iterator GetRenderTargetDataBegin()
-      const {
+      const IPLR_NO_THREAD_SAFETY_ANALYSIS {
     return render_target_data_.begin();
   }
 
   /// Visible for testing.
-  std::vector<RenderTargetData>::const_iterator GetRenderTargetDataEnd() const {
+  std::vector<RenderTargetData>::const_iterator GetRenderTargetDataEnd() const
+      IPLR_NO_THREAD_SAFETY_ANALYSIS {
     return render_target_data_.end();
   }
 };
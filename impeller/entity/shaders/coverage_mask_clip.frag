@@ -0,0 +1,19 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D mask;
+
+in highp vec2 v_texture_coords;
+
+void main() {
+  // Stencil the pixels that are at least half covered, which matches the
+  // pixels a tessellated fill without MSAA would touch.
+  if (texture(mask, v_texture_coords).r < float16_t(0.5)) {
+    discard;
+  }
+}
@@ -14,6 +14,7 @@
 #include "third_party/glfw/include/GLFW/glfw3.h"
 
 #include "flutter/fml/build_config.h"
+#include "impeller/entity/gles/entity_es3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/entity/gles/modern_shaders_gles.h"
@@ -103,8 +104,8 @@ PlaygroundImplGLES::PlaygroundImplGLES(PlaygroundSwitches switches)
 PlaygroundImplGLES::~PlaygroundImplGLES() = default;
 
 static std::vector<std::shared_ptr<fml::Mapping>>
-ShaderLibraryMappingsForPlayground() {
-  return {
+ShaderLibraryMappingsForPlayground(const ProcTableGLES& gl) {
+  std::vector<std::shared_ptr<fml::Mapping>> mappings = {
       std::make_shared<fml::NonOwnedMapping>(
           impeller_entity_shaders_gles_data,
           impeller_entity_shaders_gles_length),
@@ -122,6 +123,13 @@ ShaderLibraryMappingsForPlayground() {
       std::make_shared<fml::NonOwnedMapping>(
           impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
   };
+  if (gl.GetCapabilities()->SupportsES3ShaderLibraries()) {
+    // Replaces the GLSL ES 100 entity shaders, so it must come after them.
+    mappings.push_back(std::make_shared<fml::NonOwnedMapping>(
+        impeller_entity_es3_shaders_gles_data,
+        impeller_entity_es3_shaders_gles_length));
+  }
+  return mappings;
 }
 
 // |PlaygroundImpl|
@@ -144,8 +152,9 @@ std::shared_ptr<Context> PlaygroundImplGLES::GetContext() const {
     return nullptr;
   }
 
-  auto context = ContextGLES::Create(
-      std::move(gl), ShaderLibraryMappingsForPlayground(), true);
+  auto shader_mappings = ShaderLibraryMappingsForPlayground(*gl);
+  auto context =
+      ContextGLES::Create(std::move(gl), shader_mappings, true);
   if (!context) {
     FML_LOG(ERROR) << "Could not create context.";
     return nullptr;
@@ -30,11 +30,18 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     const std::vector<ShaderStageIOSlot>& p_inputs,
     const std::vector<ShaderStageBufferLayout>& layouts) {
   std::vector<VertexAttribPointer> vertex_attrib_arrays;
+  uint32_t vertex_attrib_array_mask = 0u;
   for (auto i = 0u; i < p_inputs.size(); i++) {
     const auto& input = p_inputs[i];
     const auto& layout = layouts[input.binding];
     VertexAttribPointer attrib;
     attrib.index = input.location;
+    // Enabled arrays are tracked in a 32-bit mask. This is well above the
+    // GL_MAX_VERTEX_ATTRIBS of the devices we support.
+    if (attrib.index >= 32u) {
+      return false;
+    }
+    vertex_attrib_array_mask |= 1u << attrib.index;
     // Component counts must be 1, 2, 3 or 4. Do that validation now.
     if (input.vec_size < 1u || input.vec_size > 4u) {
       return false;
@@ -51,6 +58,7 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     vertex_attrib_arrays.emplace_back(attrib);
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
+  vertex_attrib_array_mask_ = vertex_attrib_array_mask;
   return true;
 }
 
@@ -97,9 +105,34 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   GLint uniform_count = 0;
   gl.GetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniform_count);
 
+  // Members of uniform blocks don't have locations. They are bound with the
+  // rest of their block.
+  std::vector<GLint> block_indices(uniform_count, -1);
+  if (gl.GetCapabilities()->SupportsUniformBuffers()) {
+    if (!ReadUniformBlockBindings(gl, program)) {
+      return false;
+    }
+    if (!uniform_block_bindings_.empty()) {
+      std::vector<GLuint> uniform_indices(uniform_count);
+      for (GLint i = 0; i < uniform_count; i++) {
+        uniform_indices[i] = i;
+      }
+      gl.GetActiveUniformsiv(program,                 // program
+                             uniform_count,           // count
+                             uniform_indices.data(),  // indices
+                             GL_UNIFORM_BLOCK_INDEX,  // pname
+                             block_indices.data()     // params
+      );
+    }
+  }
+
   // Query the Program for all active uniform locations, and
   // record this via normalized key.
   for (GLint i = 0; i < uniform_count; i++) {
+    if (block_indices[i] != -1) {
+      continue;
+    }
+
     std::vector<GLchar> name;
     name.resize(max_name_size);
     GLsizei written_count = 0u;
@@ -142,10 +175,49 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
+bool BufferBindingsGLES::ReadUniformBlockBindings(const ProcTableGLES& gl,
+                                                  GLuint program) {
+  GLint block_count = 0;
+  gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+  if (block_count <= 0) {
+    return true;
+  }
+
+  GLint max_name_size = 0;
+  gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH,
+                  &max_name_size);
+
+  for (GLint i = 0; i < block_count; i++) {
+    std::vector<GLchar> name;
+    name.resize(max_name_size);
+    GLsizei written_count = 0u;
+    gl.GetActiveUniformBlockName(program,         // program
+                                 i,               // index
+                                 max_name_size,   // buffer_size
+                                 &written_count,  // length
+                                 name.data()      // name
+    );
+    if (written_count <= 0) {
+      VALIDATION_LOG << "Uniform block name could not be read.";
+      return false;
+    }
+
+    // Each program gets its own binding points starting at zero. Binding
+    // points are global state, but every draw rebinds the ranges for all
+    // blocks of the program in use.
+    const GLuint binding = static_cast<GLuint>(i);
+    gl.UniformBlockBinding(program, i, binding);
+    uniform_block_bindings_[NormalizeUniformKey(std::string{
+        name.data(), static_cast<size_t>(written_count)})] = binding;
+  }
+  return true;
+}
+
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+                                              StateTrackerGLES& state,
                                               size_t vertex_offset) const {
+  state.SetEnabledVertexAttribArrays(vertex_attrib_array_mask_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -189,20 +261,13 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
-  }
-  return true;
-}
-
 GLint BufferBindingsGLES::ComputeTextureLocation(
     const ShaderMetadata* metadata) {
   auto location = binding_map_.find(metadata->name);
   if (location != binding_map_.end()) {
-    return location->second[0];
+    return location->second.locations[0];
   }
-  auto& locations = binding_map_[metadata->name] = {};
+  auto& locations = binding_map_[metadata->name].locations;
   auto computed_location =
       uniform_locations_.find(CreateUniformMemberKey(metadata->name));
   if (computed_location == uniform_locations_.end()) {
@@ -213,16 +278,20 @@ GLint BufferBindingsGLES::ComputeTextureLocation(
   return locations[0];
 }
 
-const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
-    const ShaderMetadata* metadata) {
-  auto location = binding_map_.find(metadata->name);
-  if (location != binding_map_.end()) {
-    return location->second;
+BufferBindingsGLES::UniformBinding BufferBindingsGLES::CreateUniformBinding(
+    const ShaderMetadata* metadata) const {
+  UniformBinding binding;
+
+  auto block_binding =
+      uniform_block_bindings_.find(NormalizeUniformKey(metadata->name));
+  if (block_binding != uniform_block_bindings_.end()) {
+    binding.block_binding = block_binding->second;
+    return binding;
   }
 
   // For each metadata member, look up the binding location and record
   // it in the binding map.
-  auto& locations = binding_map_[metadata->name] = {};
+  auto& locations = binding.locations;
   for (const auto& member : metadata->members) {
     if (member.type == ShaderType::kVoid) {
       // Void types are used for padding. We are obviously not going to find
@@ -242,7 +311,25 @@ const std::vector<GLint>& BufferBindingsGLES::ComputeUniformLocations(
     }
     locations.push_back(computed_location->second);
   }
-  return locations;
+  return binding;
+}
+
+const BufferBindingsGLES::UniformBinding&
+BufferBindingsGLES::ComputeUniformBinding(const BufferResource& buffer) {
+  const auto* metadata = buffer.GetMetadata();
+  if (!buffer.HasDynamicMetadata()) {
+    auto found = static_binding_map_.find(metadata);
+    if (found != static_binding_map_.end()) {
+      return found->second;
+    }
+    return static_binding_map_[metadata] = CreateUniformBinding(metadata);
+  }
+
+  auto found = binding_map_.find(metadata->name);
+  if (found != binding_map_.end()) {
+    return found->second;
+  }
+  return binding_map_[metadata->name] = CreateUniformBinding(metadata);
 }
 
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
@@ -255,6 +342,22 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
   const auto& device_buffer_gles = DeviceBufferGLES::Cast(*device_buffer);
+
+  const auto& binding = ComputeUniformBinding(buffer);
+  if (binding.block_binding.has_value()) {
+    const auto& range = buffer.resource.range;
+    const auto alignment =
+        gl.GetCapabilities()->uniform_buffer_offset_alignment;
+    if (range.offset % alignment != 0) {
+      VALIDATION_LOG << "Uniform buffer offset " << range.offset
+                     << " is not a multiple of the required alignment "
+                     << alignment << " for block: " << metadata->name;
+      return false;
+    }
+    return device_buffer_gles.BindUniformRangeAndUploadDataIfNecessary(
+        binding.block_binding.value(), range);
+  }
+
   const uint8_t* buffer_ptr =
       device_buffer_gles.GetBufferData() + buffer.resource.range.offset;
 
@@ -265,7 +368,7 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
 
-  const auto& locations = ComputeUniformLocations(metadata);
+  const auto& locations = binding.locations;
   for (auto i = 0u; i < metadata->members.size(); i++) {
     const auto& member = metadata->members[i];
     auto location = locations[i];
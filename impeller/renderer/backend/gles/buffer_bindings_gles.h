@@ -5,12 +5,14 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_BUFFER_BINDINGS_GLES_H_
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/command.h"
 
 namespace impeller {
@@ -33,6 +35,7 @@ class BufferBindingsGLES {
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
   bool BindVertexAttributes(const ProcTableGLES& gl,
+                            StateTrackerGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
@@ -40,8 +43,6 @@ class BufferBindingsGLES {
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -55,14 +56,43 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  uint32_t vertex_attrib_array_mask_ = 0u;
 
   std::unordered_map<std::string, GLint> uniform_locations_;
 
-  using BindingMap = std::unordered_map<std::string, std::vector<GLint>>;
+  // Normalized uniform block names mapped to the uniform buffer binding points
+  // assigned to them when the program was read. Empty if the context does not
+  // support uniform buffers or the shaders declare none. Only shaders compiled
+  // to GLSL ES 300 (the `entity_es3` library) declare uniform blocks.
+  std::unordered_map<std::string, GLuint> uniform_block_bindings_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How the data described by one piece of shader metadata is
+  ///             bound to the program.
+  ///
+  struct UniformBinding {
+    /// If set, the data is backed by a uniform block at this binding point and
+    /// is bound as a whole with glBindBufferRange.
+    std::optional<GLuint> block_binding;
+    /// Otherwise, the location of each member, or -1 if the member is padding
+    /// or was optimized out.
+    std::vector<GLint> locations;
+  };
+
+  using BindingMap = std::unordered_map<std::string, UniformBinding>;
   BindingMap binding_map_ = {};
 
-  const std::vector<GLint>& ComputeUniformLocations(
-      const ShaderMetadata* metadata);
+  // Bindings for metadata generated by ImpellerC, keyed by address so that no
+  // strings are hashed when binding uniforms at draw time.
+  using StaticBindingMap =
+      std::unordered_map<const ShaderMetadata*, UniformBinding>;
+  StaticBindingMap static_binding_map_ = {};
+
+  bool ReadUniformBlockBindings(const ProcTableGLES& gl, GLuint program);
+
+  UniformBinding CreateUniformBinding(const ShaderMetadata* metadata) const;
+
+  const UniformBinding& ComputeUniformBinding(const BufferResource& buffer);
 
   GLint ComputeTextureLocation(const ShaderMetadata* metadata);
 
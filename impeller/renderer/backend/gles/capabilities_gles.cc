@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 
 #include "impeller/core/formats.h"
+#include "impeller/core/platform.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -22,6 +23,11 @@ static const constexpr char* kNvidiaTextureBorderClampExt =
 static const constexpr char* kMultisampledRenderToTextureExt =
     "GL_EXT_multisampled_render_to_texture";
 
+// https://registry.khronos.org/OpenGL/extensions/OES/OES_EGL_image_external_essl3.txt
+static const constexpr char* kExternalImageExt = "GL_OES_EGL_image_external";
+static const constexpr char* kExternalImageESSL3Ext =
+    "GL_OES_EGL_image_external_essl3";
+
 CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
   {
     GLint value = 0;
@@ -126,6 +132,26 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
   }
 
   is_angle_ = desc->IsANGLE();
+
+  const auto ubo_version = desc->IsES() ? Version{3, 0, 0} : Version{3, 1, 0};
+  if (desc->GetGlVersion().IsAtLeast(ubo_version) &&
+      gl.BindBufferRange.IsAvailable() &&
+      gl.GetActiveUniformBlockName.IsAvailable() &&
+      gl.GetActiveUniformsiv.IsAvailable() &&
+      gl.UniformBlockBinding.IsAvailable()) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
+    uniform_buffer_offset_alignment = value;
+    // Uniform data is suballocated from the host buffer at the default uniform
+    // alignment. Binding ranges at those offsets must be legal.
+    supports_uniform_buffers_ =
+        value > 0 && DefaultUniformAlignment() % value == 0;
+  }
+
+  supports_es3_shader_libraries_ =
+      desc->IsES() && supports_uniform_buffers_ &&
+      (desc->HasExtension(kExternalImageESSL3Ext) ||
+       !desc->HasExtension(kExternalImageExt));
 }
 
 size_t CapabilitiesGLES::GetMaxTextureUnits(ShaderStage stage) const {
@@ -197,6 +223,14 @@ bool CapabilitiesGLES::IsANGLE() const {
   return is_angle_;
 }
 
+bool CapabilitiesGLES::SupportsUniformBuffers() const {
+  return supports_uniform_buffers_;
+}
+
+bool CapabilitiesGLES::SupportsES3ShaderLibraries() const {
+  return supports_es3_shader_libraries_;
+}
+
 PixelFormat CapabilitiesGLES::GetDefaultGlyphAtlasFormat() const {
   return default_glyph_atlas_format_;
 }
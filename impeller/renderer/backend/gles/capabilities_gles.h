@@ -73,10 +73,34 @@ class CapabilitiesGLES final
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // 0 if uniform buffer objects are not supported.
+  size_t uniform_buffer_offset_alignment = 0;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 
   bool IsANGLE() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether uniform blocks in linked programs can be backed by
+  ///             ranges of device buffers bound with glBindBufferRange.
+  ///
+  ///             This requires OpenGL ES 3.0 (or desktop OpenGL 3.1) and an
+  ///             offset alignment that the host buffer's uniform alignment
+  ///             always satisfies.
+  ///
+  bool SupportsUniformBuffers() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether shader libraries compiled to GLSL ES 300 can replace
+  ///             the default GLSL ES 100 ones.
+  ///
+  ///             Their uniform structs are uniform blocks, so this requires
+  ///             an OpenGL ES context that supports uniform buffers. External
+  ///             textures additionally need the ESSL 3 version of the
+  ///             external image extension.
+  ///
+  bool SupportsES3ShaderLibraries() const;
+
   // |Capabilities|
   bool SupportsOffscreenMSAA() const override;
 
@@ -125,6 +149,8 @@ class CapabilitiesGLES final
   bool supports_offscreen_msaa_ = false;
   bool supports_implicit_msaa_ = false;
   bool is_angle_ = false;
+  bool supports_uniform_buffers_ = false;
+  bool supports_es3_shader_libraries_ = false;
   PixelFormat default_glyph_atlas_format_ = PixelFormat::kUnknown;
 };
 
@@ -16,15 +16,20 @@ namespace impeller {
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    fml::UniqueFD cache_directory,
+    bool cache_read_only) {
   return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing));
+      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing,
+                      std::move(cache_directory), cache_read_only));
 }
 
 ContextGLES::ContextGLES(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    fml::UniqueFD cache_directory,
+    bool cache_read_only) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -44,8 +49,9 @@ ContextGLES::ContextGLES(
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(cache_directory),
+                                cache_read_only));
   }
 
   // Create allocators.
@@ -78,6 +84,13 @@ Context::BackendType ContextGLES::GetBackendType() const {
   return Context::BackendType::kOpenGLES;
 }
 
+// |Context|
+void ContextGLES::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+  if (gpu_tracer_) {
+    gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+  }
+}
+
 const ReactorGLES::Ref& ContextGLES::GetReactor() const {
   return reactor_;
 }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
@@ -23,10 +24,18 @@ class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context>,
                           public std::enable_shared_from_this<ContextGLES> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context. Linked programs are persisted in the given
+  ///             cache directory, if it is valid, to skip compiling them on
+  ///             later launches. If |cache_read_only| is set, programs are
+  ///             loaded from the cache but nothing is written to it.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      fml::UniqueFD cache_directory = {},
+      bool cache_read_only = false);
 
   // |Context|
   ~ContextGLES() override;
@@ -43,6 +52,9 @@ class ContextGLES final : public Context,
 
   std::shared_ptr<GPUTracerGLES> GetGPUTracer() const { return gpu_tracer_; }
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
  private:
   ReactorGLES::Ref reactor_;
   std::shared_ptr<ShaderLibraryGLES> shader_library_;
@@ -61,7 +73,9 @@ class ContextGLES final : public Context,
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      fml::UniqueFD cache_directory,
+      bool cache_read_only);
 
   // |Context|
   std::string DescribeGpuModel() const override;
@@ -165,6 +165,10 @@ Version DescriptionGLES::GetGlVersion() const {
   return gl_version_;
 }
 
+std::string DescriptionGLES::GetDriverIdentity() const {
+  return vendor_ + "\n" + renderer_ + "\n" + gl_version_string_;
+}
+
 bool DescriptionGLES::IsES() const {
   return is_es_;
 }
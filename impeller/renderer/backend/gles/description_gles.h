@@ -28,6 +28,10 @@ class DescriptionGLES {
 
   Version GetGlVersion() const;
 
+  /// @brief      Returns the vendor, renderer and GL version strings, which
+  ///             together identify the driver.
+  std::string GetDriverIdentity() const;
+
   bool HasExtension(const std::string& ext) const;
 
   /// @brief      Returns whether GLES includes the debug extension.
@@ -67,6 +67,8 @@ static GLenum ToTarget(DeviceBufferGLES::BindingType type) {
       return GL_ARRAY_BUFFER;
     case DeviceBufferGLES::BindingType::kElementArrayBuffer:
       return GL_ELEMENT_ARRAY_BUFFER;
+    case DeviceBufferGLES::BindingType::kUniformBuffer:
+      return GL_UNIFORM_BUFFER;
   }
   FML_UNREACHABLE();
 }
@@ -97,6 +99,27 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   return true;
 }
 
+bool DeviceBufferGLES::BindUniformRangeAndUploadDataIfNecessary(
+    GLuint index,
+    Range range) const {
+  if (!BindAndUploadDataIfNecessary(BindingType::kUniformBuffer)) {
+    return false;
+  }
+
+  auto buffer = reactor_->GetGLHandle(handle_);
+  if (!buffer.has_value()) {
+    return false;
+  }
+
+  reactor_->GetProcTable().BindBufferRange(GL_UNIFORM_BUFFER,  // target
+                                           index,              // index
+                                           buffer.value(),     // buffer
+                                           range.offset,       // offset
+                                           range.length        // size
+  );
+  return true;
+}
+
 // |DeviceBuffer|
 bool DeviceBufferGLES::SetLabel(const std::string& label) {
   reactor_->SetDebugLabel(handle_, label);
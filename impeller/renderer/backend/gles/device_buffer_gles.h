@@ -34,10 +34,24 @@ class DeviceBufferGLES final
   enum class BindingType {
     kArrayBuffer,
     kElementArrayBuffer,
+    kUniformBuffer,
   };
 
   [[nodiscard]] bool BindAndUploadDataIfNecessary(BindingType type) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Uploads the buffer contents if they have changed and binds
+  ///             the given range of this buffer to the indexed uniform
+  ///             buffer binding point.
+  ///
+  /// @param[in]  index  The uniform buffer binding point.
+  /// @param[in]  range  The range of this buffer to bind. The offset must be a
+  ///                    multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+  ///
+  [[nodiscard]] bool BindUniformRangeAndUploadDataIfNecessary(
+      GLuint index,
+      Range range) const;
+
   void Flush(std::optional<Range> range = std::nullopt) const override;
 
  private:
@@ -67,11 +67,23 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
                       "FrameTimeMS", gpu_ms);
+    {
+      Lock lock(frame_time_callback_mutex_);
+      if (frame_time_callback_) {
+        frame_time_callback_(fml::TimeDelta::FromNanoseconds(duration));
+      }
+    }
     gl.DeleteQueriesEXT(1, &query);
     pending_traces_.pop_front();
   }
 }
 
+void GPUTracerGLES::SetFrameTimeCallback(
+    Context::GPUFrameTimeCallback callback) {
+  Lock lock(frame_time_callback_mutex_);
+  frame_time_callback_ = std::move(callback);
+}
+
 void GPUTracerGLES::MarkFrameEnd(const ProcTableGLES& gl) {
   if (!enabled_ || std::this_thread::get_id() != raster_thread_ ||
       !active_frame_.has_value()) {
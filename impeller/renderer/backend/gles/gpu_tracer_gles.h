@@ -9,7 +9,10 @@
 #include <deque>
 #include <thread>
 
+#include "impeller/base/thread.h"
+#include "impeller/base/thread_safety.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/context.h"
 
 namespace impeller {
 
@@ -40,6 +43,9 @@ class GPUTracerGLES {
   /// @brief Record the end of a frame workload.
   void MarkFrameEnd(const ProcTableGLES& gl);
 
+  /// @brief Set the callback that receives the GPU time of each frame.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
  private:
   void ProcessQueries(const ProcTableGLES& gl);
 
@@ -48,6 +54,10 @@ class GPUTracerGLES {
   std::thread::id raster_thread_;
 
   bool enabled_ = false;
+
+  mutable Mutex frame_time_callback_mutex_;
+  Context::GPUFrameTimeCallback frame_time_callback_ IPLR_GUARDED_BY(
+      frame_time_callback_mutex_);
 };
 
 }  // namespace impeller
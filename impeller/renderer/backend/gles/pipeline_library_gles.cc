@@ -16,8 +16,14 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                                         fml::UniqueFD cache_directory,
+                                         bool cache_read_only)
+    : reactor_(std::move(reactor)),
+      program_binary_cache_(std::make_shared<ProgramBinaryCacheGLES>(
+          reactor_->GetProcTable(),
+          std::move(cache_directory),
+          cache_read_only)) {}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -76,6 +82,7 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
 
 static bool LinkProgram(
     const ReactorGLES& reactor,
+    const ProgramBinaryCacheGLES& program_binary_cache,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
     const std::shared_ptr<const ShaderFunction>& frag_function) {
@@ -90,6 +97,19 @@ static bool LinkProgram(
 
   const auto& gl = reactor.GetProcTable();
 
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+
+  const auto program_key = ProgramBinaryCacheGLES::ComputeProgramKey(
+      *vert_mapping, *frag_mapping, descriptor.GetSpecializationConstants(),
+      descriptor.GetVertexDescriptor()->GetStageInputs());
+  if (program_binary_cache.LoadProgram(gl, *program, program_key)) {
+    return true;
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -135,12 +155,6 @@ static bool LinkProgram(
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
-    return false;
-  }
-
   gl.AttachShader(*program, vert_shader);
   gl.AttachShader(*program, frag_shader);
 
@@ -161,6 +175,7 @@ static bool LinkProgram(
     );
   }
 
+  program_binary_cache.PrepareToLinkProgram(gl, *program);
   gl.LinkProgram(*program);
 
   GLint link_status = GL_FALSE;
@@ -171,6 +186,7 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+  program_binary_cache.StoreProgram(gl, *program, program_key);
   return true;
 }
 
@@ -212,7 +228,8 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
   auto weak_this = weak_from_this();
 
   auto result = reactor_->AddOperation(
-      [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
+      [promise, weak_this, reactor_ptr = reactor_,
+       program_binary_cache = program_binary_cache_, descriptor, vert_function,
        frag_function](const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
@@ -229,10 +246,11 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
+        const auto link_result = LinkProgram(reactor,                //
+                                             *program_binary_cache,  //
+                                             pipeline,               //
+                                             vert_function,          //
+                                             frag_function           //
         );
         if (!link_result) {
           promise->set_value(nullptr);
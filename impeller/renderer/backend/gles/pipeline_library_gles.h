@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -21,9 +22,12 @@ class PipelineLibraryGLES final : public PipelineLibrary {
   friend ContextGLES;
 
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<const ProgramBinaryCacheGLES> program_binary_cache_;
   PipelineMap pipelines_;
 
-  explicit PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                      fml::UniqueFD cache_directory,
+                      bool cache_read_only);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -15,6 +15,10 @@
 
 namespace impeller {
 
+#ifdef IMPELLER_DEBUG
+thread_local uint64_t tls_gl_call_count = 0u;
+#endif  // IMPELLER_DEBUG
+
 const char* GLErrorToString(GLenum value) {
   switch (value) {
     case GL_NO_ERROR:
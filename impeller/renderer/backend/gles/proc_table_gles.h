@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROC_TABLE_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROC_TABLE_GLES_H_
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -46,6 +47,14 @@ struct AutoErrorCheck {
   }
 };
 
+#ifdef IMPELLER_DEBUG
+//------------------------------------------------------------------------------
+/// The number of GL calls made through any |GLProc| on the current thread.
+/// Render passes report it per frame in the timeline.
+///
+extern thread_local uint64_t tls_gl_call_count;
+#endif  // IMPELLER_DEBUG
+
 template <class T>
 struct GLProc {
   using GLFunctionType = T;
@@ -84,6 +93,7 @@ struct GLProc {
     // validation log will at least give us a hint as to what's going on.
     FML_CHECK(IsAvailable()) << "GL function " << name << " is not available. "
                              << "This is likely due to a missing extension.";
+    tls_gl_call_count++;
 #endif  // IMPELLER_DEBUG
 #ifdef IMPELLER_TRACE_ALL_GL_CALLS
     TRACE_EVENT0("impeller", name);
@@ -200,7 +210,15 @@ void(glDepthRange)(GLdouble n, GLdouble f);
   PROC(ClearDepth);                               \
   PROC(DepthRange);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BindBufferRange);                   \
+  PROC(BlitFramebuffer);                   \
+  PROC(GetActiveUniformBlockName);         \
+  PROC(GetActiveUniformsiv);               \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);                 \
+  PROC(UniformBlockBinding);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC)    \
   PROC(DebugMessageControlKHR);             \
@@ -0,0 +1,233 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cinttypes>
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/strings.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x42504c49;  // "ILPB"
+constexpr uint32_t kVersion = 1u;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t program_key;
+  uint64_t driver_key;
+  uint32_t binary_format;
+  uint32_t binary_length;
+};
+
+// FNV-1a, which unlike std::hash is stable across builds of the engine.
+class Hasher {
+ public:
+  void Add(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ ^= bytes[i];
+      hash_ *= 0x100000001b3ull;
+    }
+  }
+
+  template <class T>
+  void Add(const T& value) {
+    Add(&value, sizeof(value));
+  }
+
+  uint64_t GetHash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+std::string ToHex(uint64_t value) {
+  return SPrintF("%016" PRIx64, value);
+}
+
+bool IsProgramBinarySupported(const ProcTableGLES& gl) {
+  const auto desc = gl.GetDescription();
+  const auto version = desc->IsES() ? Version{3, 0, 0} : Version{4, 1, 0};
+  if (!desc->GetGlVersion().IsAtLeast(version) ||
+      !gl.GetProgramBinary.IsAvailable() || !gl.ProgramBinary.IsAvailable()) {
+    return false;
+  }
+  // Drivers may support the entry points but not a single binary format.
+  GLint format_count = 0;
+  gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  return format_count > 0;
+}
+
+}  // namespace
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(const ProcTableGLES& gl,
+                                               fml::UniqueFD cache_directory,
+                                               bool read_only)
+    : read_only_(read_only) {
+  if (!cache_directory.is_valid() || !IsProgramBinarySupported(gl)) {
+    return;
+  }
+
+  Hasher hasher;
+  const std::string driver_identity = gl.GetDescription()->GetDriverIdentity();
+  hasher.Add(driver_identity.data(), driver_identity.size());
+  driver_key_ = hasher.GetHash();
+
+  // Binaries of any other driver, such as the one before a driver update, can
+  // never be loaded again.
+  const std::string driver_directory_name = ToHex(driver_key_);
+  if (read_only_) {
+    directory_ = fml::OpenDirectoryReadOnly(cache_directory,
+                                            driver_directory_name.c_str());
+    is_valid_ = directory_.is_valid();
+    return;
+  }
+  fml::VisitFiles(cache_directory, [&driver_directory_name](
+                                       const fml::UniqueFD& directory,
+                                       const std::string& filename) {
+    if (filename != driver_directory_name) {
+      fml::RemoveDirectoryRecursively(directory, filename.c_str());
+    }
+    return true;
+  });
+
+  directory_ = fml::CreateDirectory(cache_directory, {driver_directory_name},
+                                    fml::FilePermission::kReadWrite);
+  is_valid_ = directory_.is_valid();
+}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsValid() const {
+  return is_valid_;
+}
+
+uint64_t ProgramBinaryCacheGLES::ComputeProgramKey(
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source,
+    const std::vector<Scalar>& specialization_constants,
+    const std::vector<ShaderStageIOSlot>& stage_inputs) {
+  Hasher hasher;
+  hasher.Add(vert_source.GetSize());
+  hasher.Add(vert_source.GetMapping(), vert_source.GetSize());
+  hasher.Add(frag_source.GetSize());
+  hasher.Add(frag_source.GetMapping(), frag_source.GetSize());
+  hasher.Add(specialization_constants.size());
+  hasher.Add(specialization_constants.data(),
+             specialization_constants.size() * sizeof(Scalar));
+  // The attribute locations are bound before linking and are part of the
+  // binary.
+  for (const auto& stage_input : stage_inputs) {
+    hasher.Add(stage_input.location);
+    hasher.Add(stage_input.name, std::strlen(stage_input.name) + 1u);
+  }
+  return hasher.GetHash();
+}
+
+void ProgramBinaryCacheGLES::PrepareToLinkProgram(const ProcTableGLES& gl,
+                                                  GLuint program) const {
+  if (!is_valid_ || read_only_ || !gl.ProgramParameteri.IsAvailable()) {
+    return;
+  }
+  gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         uint64_t program_key) const {
+  if (!is_valid_) {
+    return false;
+  }
+  const std::string file_name = ToHex(program_key);
+  if (!fml::FileExists(directory_, file_name.c_str())) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::LoadProgram");
+
+  auto mapping = fml::FileMapping::CreateReadOnly(directory_, file_name);
+  if (!mapping) {
+    return false;
+  }
+  Header header = {};
+  if (mapping->GetSize() < sizeof(Header)) {
+    EvictProgram(file_name);
+    return false;
+  }
+  std::memcpy(&header, mapping->GetMapping(), sizeof(Header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.program_key != program_key || header.driver_key != driver_key_ ||
+      header.binary_length != mapping->GetSize() - sizeof(Header)) {
+    EvictProgram(file_name);
+    return false;
+  }
+
+  gl.ProgramBinary(program, header.binary_format,
+                   mapping->GetMapping() + sizeof(Header),
+                   header.binary_length);
+
+  // Drivers may still reject the binary, for instance after an update that
+  // did not change the strings identifying them.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    FML_LOG(INFO) << "The driver rejected a cached program binary. Linking "
+                     "the program from source instead.";
+    EvictProgram(file_name);
+    return false;
+  }
+  return true;
+}
+
+bool ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          uint64_t program_key) const {
+  if (!is_valid_ || read_only_) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::StoreProgram");
+
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return false;
+  }
+
+  std::vector<uint8_t> data(sizeof(Header) + binary_length);
+  GLsizei written_length = 0;
+  GLenum binary_format = GL_NONE;
+  gl.GetProgramBinary(program, binary_length, &written_length, &binary_format,
+                      data.data() + sizeof(Header));
+  if (written_length <= 0 || written_length > binary_length) {
+    return false;
+  }
+  data.resize(sizeof(Header) + written_length);
+
+  Header header = {};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.program_key = program_key;
+  header.driver_key = driver_key_;
+  header.binary_format = binary_format;
+  header.binary_length = written_length;
+  std::memcpy(data.data(), &header, sizeof(Header));
+
+  return fml::WriteAtomically(directory_, ToHex(program_key).c_str(),
+                              fml::DataMapping(std::move(data)));
+}
+
+void ProgramBinaryCacheGLES::EvictProgram(const std::string& file_name) const {
+  if (read_only_) {
+    return;
+  }
+  fml::UnlinkFile(directory_, file_name.c_str());
+}
+
+}  // namespace impeller
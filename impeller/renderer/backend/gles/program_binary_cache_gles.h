@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/core/shader_types.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      An on-disk cache of linked programs, retrieved from the driver
+///             with `glGetProgramBinary` and restored on later launches with
+///             `glProgramBinary` instead of compiling and linking the shader
+///             sources again.
+///
+///             Binaries are only usable with the driver that produced them.
+///             They are stored in a subdirectory of the cache directory named
+///             after the driver identity, and the subdirectories of other
+///             drivers are removed when the cache is created. Binaries that
+///             the driver rejects anyway are removed when loading them fails.
+///
+///             A read-only cache loads the binaries that are already stored
+///             but never writes, evicts or creates any files or directories.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache in the given directory. The cache is invalid
+  ///             and does nothing if the directory is invalid or the driver
+  ///             does not support program binaries. A read-only cache is
+  ///             also invalid if no binaries were stored for this driver.
+  ///
+  ProgramBinaryCacheGLES(const ProcTableGLES& gl,
+                         fml::UniqueFD cache_directory,
+                         bool read_only = false);
+
+  ~ProgramBinaryCacheGLES();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the key of a program from everything that affects
+  ///             the result of linking it.
+  ///
+  static uint64_t ComputeProgramKey(
+      const fml::Mapping& vert_source,
+      const fml::Mapping& frag_source,
+      const std::vector<Scalar>& specialization_constants,
+      const std::vector<ShaderStageIOSlot>& stage_inputs);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the driver to keep the binary of the program retrievable
+  ///             once it is linked. Must be called before linking it.
+  ///
+  void PrepareToLinkProgram(const ProcTableGLES& gl, GLuint program) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Restores the cached binary of the program with the given key
+  ///             into |program|.
+  ///
+  /// @return     If the program was restored and linked. Otherwise, the
+  ///             program must be compiled and linked from source.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl,
+                   GLuint program,
+                   uint64_t program_key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the binary of the linked |program| to the cache. Does
+  ///             nothing if the cache is read-only.
+  ///
+  bool StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    uint64_t program_key) const;
+
+ private:
+  uint64_t driver_key_ = 0u;
+  fml::UniqueFD directory_;
+  bool read_only_ = false;
+  bool is_valid_ = false;
+
+  void EvictProgram(const std::string& file_name) const;
+
+  ProgramBinaryCacheGLES(const ProgramBinaryCacheGLES&) = delete;
+
+  ProgramBinaryCacheGLES& operator=(const ProgramBinaryCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
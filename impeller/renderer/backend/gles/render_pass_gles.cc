@@ -16,6 +16,7 @@
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -40,22 +41,22 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateTrackerGLES& state,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.SetEnabled(GL_BLEND, true);
+    state.BlendFuncSeparate(
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.SetEnabled(GL_BLEND, false);
   }
 
   {
@@ -64,7 +65,7 @@ void ConfigureBlending(const ProcTableGLES& gl,
       return (mask & check) ? GL_TRUE : GL_FALSE;
     };
 
-    gl.ColorMask(
+    state.ColorMask(
         is_set(color->write_mask, ColorWriteMaskBits::kRed),    // red
         is_set(color->write_mask, ColorWriteMaskBits::kGreen),  // green
         is_set(color->write_mask, ColorWriteMaskBits::kBlue),   // blue
@@ -74,47 +75,67 @@ void ConfigureBlending(const ProcTableGLES& gl,
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateTrackerGLES& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateTrackerGLES& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.SetEnabled(GL_STENCIL_TEST, false);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.SetEnabled(GL_STENCIL_TEST, true);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
   if (front.has_value() && back.has_value() && front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, state, *front, stencil_reference);
     return;
   }
   if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, state, *front, stencil_reference);
   }
   if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, state, *back, stencil_reference);
   }
 }
 
+#ifdef IMPELLER_DEBUG
+// GL calls elided by state tracking on this thread since the last frame ended.
+static thread_local uint64_t tls_elided_gl_call_count = 0u;
+
+// The value of |tls_gl_call_count| when the last frame ended.
+static thread_local uint64_t tls_frame_start_gl_call_count = 0u;
+
+static void TraceGLCallsPerFrame() {
+  const uint64_t issued = tls_gl_call_count - tls_frame_start_gl_call_count;
+  FML_TRACE_COUNTER("impeller",                                  //
+                    "GLCallsPerFrame",                           //
+                    0,                                           //
+                    "Issued", static_cast<int64_t>(issued),      //
+                    "Elided", static_cast<int64_t>(tls_elided_gl_call_count));
+  tls_frame_start_gl_call_count = tls_gl_call_count;
+  tls_elided_gl_call_count = 0u;
+}
+#endif  // IMPELLER_DEBUG
+
 //------------------------------------------------------------------------------
 /// @brief      Encapsulates data that will be needed in the reactor for the
 ///             encoding of commands for this render pass.
@@ -236,18 +257,30 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-  gl.DepthMask(GL_TRUE);
-  gl.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
-  gl.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
+  // Redundant state changes between consecutive commands are elided by the
+  // tracker. It starts out knowing nothing, so everything set here is issued.
+  StateTrackerGLES state(gl);
+
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_STENCIL_TEST, false);
+  state.SetEnabled(GL_CULL_FACE, false);
+  state.SetEnabled(GL_BLEND, false);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.DepthMask(GL_TRUE);
+  state.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
 
   gl.Clear(clear_bits);
 
+  //----------------------------------------------------------------------------
+  /// Leave the context with no program or vertex attribs bound, including when
+  /// a command fails to encode. Consecutive commands share these instead of
+  /// unbinding them after every draw.
+  ///
+  fml::ScopedCleanupClosure unbind_program_and_vertex_attrib_arrays(
+      [&state]() { state.UnbindProgramAndVertexAttribArrays(); });
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -282,12 +315,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -295,11 +329,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.SetEnabled(GL_DEPTH_TEST, true);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.SetEnabled(GL_DEPTH_TEST, false);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -311,18 +345,15 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.GetX(),  // x
-                target_size.height - viewport.rect.GetY() -
-                    viewport.rect.GetHeight(),  // y
-                viewport.rect.GetWidth(),       // width
-                viewport.rect.GetHeight()       // height
+    state.Viewport(viewport.rect.GetX(),  // x
+                   target_size.height - viewport.rect.GetY() -
+                       viewport.rect.GetHeight(),  // y
+                   viewport.rect.GetWidth(),       // width
+                   viewport.rect.GetHeight()       // height
     );
     if (pass_data.depth_attachment) {
-      if (gl.DepthRangef.IsAvailable()) {
-        gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      } else {
-        gl.DepthRange(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      }
+      state.DepthRange(viewport.depth_range.z_near,
+                       viewport.depth_range.z_far);
     }
 
     //--------------------------------------------------------------------------
@@ -330,15 +361,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.SetEnabled(GL_SCISSOR_TEST, true);
+      state.Scissor(
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
           scissor.GetHeight()                                         // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.SetEnabled(GL_SCISSOR_TEST, false);
     }
 
     //--------------------------------------------------------------------------
@@ -346,15 +377,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.SetEnabled(GL_CULL_FACE, false);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -362,10 +393,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -399,7 +430,7 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
+    if (!pipeline.BindProgram(state)) {
       return false;
     }
 
@@ -407,7 +438,7 @@ struct RenderPassData {
     /// Bind vertex attribs.
     ///
     if (!vertex_desc_gles->BindVertexAttributes(
-            gl, vertex_buffer_view.range.offset)) {
+            gl, state, vertex_buffer_view.range.offset)) {
       return false;
     }
 
@@ -456,22 +487,10 @@ struct RenderPassData {
                           index_buffer_view.range.offset))  // indices
       );
     }
-
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
-      return false;
-    }
-
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
   }
 
+  unbind_program_and_vertex_attrib_arrays.Reset();
+
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
     std::vector<GLenum> attachments;
 
@@ -500,8 +519,10 @@ struct RenderPassData {
   }
 
 #ifdef IMPELLER_DEBUG
+  tls_elided_gl_call_count += state.GetElidedCallCount();
   if (is_default_fbo) {
     tracer->MarkFrameEnd(gl);
+    TraceGLCallsPerFrame();
   }
 #endif  // IMPELLER_DEBUG
 
@@ -30,6 +30,8 @@ class ShaderLibraryGLES final : public ShaderLibrary {
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
   bool is_valid_ = false;
 
+  // Functions in later libraries replace the functions of the same name and
+  // stage in earlier ones.
   explicit ShaderLibraryGLES(
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
 
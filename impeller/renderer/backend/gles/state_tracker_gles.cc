@@ -0,0 +1,219 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+
+namespace impeller {
+
+static std::optional<size_t> ToCapabilityIndex(GLenum capability) {
+  switch (capability) {
+    case GL_BLEND:
+      return 0u;
+    case GL_CULL_FACE:
+      return 1u;
+    case GL_DEPTH_TEST:
+      return 2u;
+    case GL_SCISSOR_TEST:
+      return 3u;
+    case GL_STENCIL_TEST:
+      return 4u;
+  }
+  return std::nullopt;
+}
+
+StateTrackerGLES::StateTrackerGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateTrackerGLES::~StateTrackerGLES() = default;
+
+template <class T>
+bool StateTrackerGLES::UpdateIfChanged(std::optional<T>& state,
+                                       const T& value) {
+  if (state.has_value() && state.value() == value) {
+    elided_call_count_++;
+    return false;
+  }
+  state = value;
+  return true;
+}
+
+template <class T, class Getter>
+bool StateTrackerGLES::UpdateStencilIfChanged(GLenum face,
+                                              Getter getter,
+                                              const T& value) {
+  const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+  const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+  auto& front_state = getter(stencil_faces_[0]);
+  auto& back_state = getter(stencil_faces_[1]);
+  if ((!front || front_state == value) && (!back || back_state == value)) {
+    elided_call_count_++;
+    return false;
+  }
+  if (front) {
+    front_state = value;
+  }
+  if (back) {
+    back_state = value;
+  }
+  return true;
+}
+
+void StateTrackerGLES::SetEnabled(GLenum capability, bool enabled) {
+  auto index = ToCapabilityIndex(capability);
+  if (index.has_value() &&
+      !UpdateIfChanged(capabilities_[index.value()], enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(capability);
+  } else {
+    gl_.Disable(capability);
+  }
+}
+
+void StateTrackerGLES::BlendFuncSeparate(GLenum src_color,
+                                         GLenum dst_color,
+                                         GLenum src_alpha,
+                                         GLenum dst_alpha) {
+  if (UpdateIfChanged(blend_func_, {src_color, dst_color, src_alpha,
+                                    dst_alpha})) {
+    gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateTrackerGLES::BlendEquationSeparate(GLenum mode_color,
+                                             GLenum mode_alpha) {
+  if (UpdateIfChanged(blend_equation_, {mode_color, mode_alpha})) {
+    gl_.BlendEquationSeparate(mode_color, mode_alpha);
+  }
+}
+
+void StateTrackerGLES::ColorMask(GLboolean red,
+                                 GLboolean green,
+                                 GLboolean blue,
+                                 GLboolean alpha) {
+  if (UpdateIfChanged(color_mask_, {red, green, blue, alpha})) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateTrackerGLES::StencilOpSeparate(GLenum face,
+                                         GLenum stencil_fail,
+                                         GLenum depth_fail,
+                                         GLenum depth_stencil_pass) {
+  const std::optional<std::array<GLenum, 3>> op =
+      std::array<GLenum, 3>{stencil_fail, depth_fail, depth_stencil_pass};
+  if (UpdateStencilIfChanged(
+          face, [](StencilFace& state) -> auto& { return state.op; }, op)) {
+    gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  }
+}
+
+void StateTrackerGLES::StencilFuncSeparate(GLenum face,
+                                           GLenum func,
+                                           GLint ref,
+                                           GLuint mask) {
+  const std::optional<std::array<GLuint, 3>> args =
+      std::array<GLuint, 3>{func, static_cast<GLuint>(ref), mask};
+  if (UpdateStencilIfChanged(
+          face, [](StencilFace& state) -> auto& { return state.func; },
+          args)) {
+    gl_.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void StateTrackerGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  const std::optional<GLuint> write_mask = mask;
+  if (UpdateStencilIfChanged(
+          face, [](StencilFace& state) -> auto& { return state.write_mask; },
+          write_mask)) {
+    gl_.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateTrackerGLES::DepthFunc(GLenum func) {
+  if (UpdateIfChanged(depth_func_, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void StateTrackerGLES::DepthMask(GLboolean flag) {
+  if (UpdateIfChanged(depth_mask_, flag)) {
+    gl_.DepthMask(flag);
+  }
+}
+
+void StateTrackerGLES::DepthRange(GLfloat z_near, GLfloat z_far) {
+  if (!UpdateIfChanged(depth_range_, {z_near, z_far})) {
+    return;
+  }
+  if (gl_.DepthRangef.IsAvailable()) {
+    gl_.DepthRangef(z_near, z_far);
+  } else {
+    gl_.DepthRange(z_near, z_far);
+  }
+}
+
+void StateTrackerGLES::Viewport(GLint x,
+                                GLint y,
+                                GLsizei width,
+                                GLsizei height) {
+  if (UpdateIfChanged(viewport_, {x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::Scissor(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  if (UpdateIfChanged(scissor_, {x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::CullFace(GLenum mode) {
+  if (UpdateIfChanged(cull_face_, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void StateTrackerGLES::FrontFace(GLenum mode) {
+  if (UpdateIfChanged(front_face_, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void StateTrackerGLES::UseProgram(GLuint program) {
+  if (UpdateIfChanged(program_, program)) {
+    gl_.UseProgram(program);
+  }
+}
+
+void StateTrackerGLES::SetEnabledVertexAttribArrays(uint32_t mask) {
+  const uint32_t changed = enabled_vertex_attrib_arrays_ ^ mask;
+  for (GLuint index = 0u; index < 32u; index++) {
+    const uint32_t bit = 1u << index;
+    if ((changed & bit) != 0u) {
+      if ((mask & bit) != 0u) {
+        gl_.EnableVertexAttribArray(index);
+      } else {
+        gl_.DisableVertexAttribArray(index);
+      }
+    } else if ((mask & bit) != 0u) {
+      elided_call_count_++;
+    }
+  }
+  enabled_vertex_attrib_arrays_ = mask;
+}
+
+void StateTrackerGLES::UnbindProgramAndVertexAttribArrays() {
+  SetEnabledVertexAttribArrays(0u);
+  UseProgram(0u);
+}
+
+size_t StateTrackerGLES::GetElidedCallCount() const {
+  return elided_call_count_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the fixed function and binding state set while encoding
+///             a render pass and skips GL calls that would not change it.
+///
+///             State starts out unknown, so the first call for each piece of
+///             state is always issued. The tracker must not outlive the
+///             encoding of a single render pass: between passes, other users
+///             of the context (texture uploads, blits, the embedder) may
+///             modify state behind its back.
+///
+class StateTrackerGLES {
+ public:
+  explicit StateTrackerGLES(const ProcTableGLES& gl);
+
+  ~StateTrackerGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      glEnable or glDisable. Only GL_BLEND, GL_CULL_FACE,
+  ///             GL_DEPTH_TEST, GL_SCISSOR_TEST and GL_STENCIL_TEST are
+  ///             tracked. Other capabilities are always passed through.
+  ///
+  void SetEnabled(GLenum capability, bool enabled);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  //----------------------------------------------------------------------------
+  /// @brief      glDepthRangef on OpenGL ES, glDepthRange on desktop GL.
+  ///
+  void DepthRange(GLfloat z_near, GLfloat z_far);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables exactly the vertex attribute arrays whose indices are
+  ///             set in the mask, only toggling those that differ from the
+  ///             arrays enabled for the previous draw.
+  ///
+  void SetEnabledVertexAttribArrays(uint32_t mask);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Disables all vertex attribute arrays and unbinds the program.
+  ///             Called once at the end of a render pass so that the context
+  ///             is left in the same state as if no tracker had been used.
+  ///
+  void UnbindProgramAndVertexAttribArrays();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of calls skipped because they would not have
+  ///             changed any state.
+  ///
+  size_t GetElidedCallCount() const;
+
+ private:
+  struct StencilFace {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLuint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  std::array<std::optional<bool>, 5> capabilities_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  std::array<StencilFace, 2> stencil_faces_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLfloat, 2>> depth_range_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  uint32_t enabled_vertex_attrib_arrays_ = 0u;
+  size_t elided_call_count_ = 0u;
+
+  template <class T>
+  bool UpdateIfChanged(std::optional<T>& state, const T& value);
+
+  template <class T, class Getter>
+  bool UpdateStencilIfChanged(GLenum face, Getter getter, const T& value);
+
+  StateTrackerGLES(const StateTrackerGLES&) = delete;
+
+  StateTrackerGLES& operator=(const StateTrackerGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
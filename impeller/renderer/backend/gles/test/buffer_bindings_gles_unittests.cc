@@ -0,0 +1,280 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/base/allocation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
+#include "impeller/renderer/backend/gles/device_buffer_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// The mocked program has one uniform block, "FragInfo", whose only member is
+// active uniform 0. Active uniform 1 is "VertInfo.mvp" in the default block.
+constexpr const char* kBlockName = "FragInfo";
+constexpr const char* kBlockMemberName = "FragInfo.color";
+constexpr const char* kUniformName = "VertInfo.mvp";
+constexpr GLint kUniformLocation = 3;
+
+void mockGetProgramivWithUniformBlock(GLuint program,
+                                      GLenum pname,
+                                      GLint* params) {
+  switch (pname) {
+    case GL_LINK_STATUS:
+      *params = GL_TRUE;
+      break;
+    case GL_ACTIVE_UNIFORMS:
+      *params = 2;
+      break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+      *params = 32;
+      break;
+    case GL_ACTIVE_UNIFORM_BLOCKS:
+      *params = 1;
+      break;
+    case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH:
+      *params = 32;
+      break;
+    default:
+      *params = 0;
+      break;
+  }
+}
+
+void mockGetActiveUniformBlockName(GLuint program,
+                                   GLuint block_index,
+                                   GLsizei buffer_size,
+                                   GLsizei* length,
+                                   GLchar* name) {
+  *length = std::min<GLsizei>(buffer_size - 1, strlen(kBlockName));
+  memcpy(name, kBlockName, *length);
+  name[*length] = '\0';
+}
+
+void mockGetActiveUniformsiv(GLuint program,
+                             GLsizei count,
+                             const GLuint* indices,
+                             GLenum pname,
+                             GLint* params) {
+  for (GLsizei i = 0; i < count; i++) {
+    params[i] = (pname == GL_UNIFORM_BLOCK_INDEX && indices[i] == 0) ? 0 : -1;
+  }
+}
+
+void mockGetActiveUniform(GLuint program,
+                          GLuint index,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLint* size,
+                          GLenum* type,
+                          GLchar* name) {
+  const char* uniform_name = index == 0 ? kBlockMemberName : kUniformName;
+  *length = std::min<GLsizei>(buffer_size - 1, strlen(uniform_name));
+  memcpy(name, uniform_name, *length);
+  name[*length] = '\0';
+  *size = 1;
+  *type = GL_FLOAT_MAT4;
+}
+
+// Members of uniform blocks have no location. Reading the bindings fails if
+// the block member is queried as though it were a default block uniform.
+GLint mockGetUniformLocation(GLuint program, const GLchar* name) {
+  return strcmp(name, kUniformName) == 0 ? kUniformLocation : -1;
+}
+
+const ProcTableGLES::Resolver kUniformBlockResolver = [](const char* name) {
+  if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramivWithUniformBlock);
+  } else if (strcmp(name, "glGetActiveUniformBlockName") == 0) {
+    return reinterpret_cast<void*>(&mockGetActiveUniformBlockName);
+  } else if (strcmp(name, "glGetActiveUniformsiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetActiveUniformsiv);
+  } else if (strcmp(name, "glGetActiveUniform") == 0) {
+    return reinterpret_cast<void*>(&mockGetActiveUniform);
+  } else if (strcmp(name, "glGetUniformLocation") == 0) {
+    return reinterpret_cast<void*>(&mockGetUniformLocation);
+  }
+  return kMockResolverGLES(name);
+};
+
+class TestWorker final : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+// Uniforms are bound from buffers that already exist. Nothing is allocated.
+class TestAllocator final : public Allocator {
+ public:
+  // |Allocator|
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+ private:
+  // |Allocator|
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  }
+
+  // |Allocator|
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+const ShaderMetadata kFragInfoMetadata = {
+    .name = "FragInfo",
+    .members = {ShaderStructMemberMetadata{
+        .type = ShaderType::kFloat,
+        .name = "color",
+        .offset = 0u,
+        .size = sizeof(Vector4),
+        .byte_length = sizeof(Vector4),
+    }},
+};
+
+const ShaderMetadata kVertInfoMetadata = {
+    .name = "VertInfo",
+    .members = {ShaderStructMemberMetadata{
+        .type = ShaderType::kFloat,
+        .name = "mvp",
+        .offset = 0u,
+        .size = sizeof(Matrix),
+        .byte_length = sizeof(Matrix),
+    }},
+};
+
+std::shared_ptr<DeviceBufferGLES> CreateBuffer(
+    const std::shared_ptr<ReactorGLES>& reactor,
+    size_t size) {
+  auto backing_store = std::make_shared<Allocation>();
+  FML_CHECK(backing_store->Truncate(size));
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = size;
+  auto buffer = std::make_shared<DeviceBufferGLES>(desc, reactor,
+                                                   std::move(backing_store));
+  // Host buffers flush after writing uniform data. The next bind uploads it.
+  buffer->Flush(std::nullopt);
+  return buffer;
+}
+
+Bindings CreateBindings(const ShaderMetadata* metadata, BufferView view) {
+  Bindings bindings;
+  bindings.buffers.push_back(BufferAndUniformSlot{
+      .slot = ShaderUniformSlot{.name = metadata->name.c_str()},
+      .view = BufferResource(metadata, std::move(view)),
+  });
+  return bindings;
+}
+
+}  // namespace
+
+TEST(BufferBindingsGLES, AssignsBindingPointsToUniformBlocks) {
+  auto mock_gles =
+      MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kUniformBlockResolver);
+  const auto& gl = mock_gles->GetProcTable();
+  ASSERT_TRUE(gl.GetCapabilities()->SupportsUniformBuffers());
+
+  BufferBindingsGLES bindings;
+  EXPECT_TRUE(bindings.ReadUniformsBindings(gl, 1u));
+
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), "glUniformBlockBinding"),
+            1);
+}
+
+TEST(BufferBindingsGLES, IgnoresUniformBlocksOnGLES2) {
+  auto mock_gles =
+      MockGLES::Init(std::nullopt, "OpenGL ES 2.0", kUniformBlockResolver);
+  const auto& gl = mock_gles->GetProcTable();
+  ASSERT_FALSE(gl.GetCapabilities()->SupportsUniformBuffers());
+
+  // Without uniform buffers the block member is looked up by location like
+  // any other uniform. The mock driver reports none, which is an error.
+  BufferBindingsGLES bindings;
+  EXPECT_FALSE(bindings.ReadUniformsBindings(gl, 1u));
+
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), "glUniformBlockBinding"),
+            0);
+}
+
+TEST(BufferBindingsGLES, BindsUniformBlocksAsBufferRanges) {
+  auto mock_gles =
+      MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kUniformBlockResolver);
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kUniformBlockResolver));
+  ASSERT_TRUE(reactor->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  const auto& gl = reactor->GetProcTable();
+
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(gl, 1u));
+  mock_gles->GetCapturedCalls();
+
+  auto buffer = CreateBuffer(reactor, 512u);
+  auto vertex_bindings = CreateBindings(
+      &kVertInfoMetadata, BufferView{buffer, Range{0u, sizeof(Matrix)}});
+  auto fragment_bindings = CreateBindings(
+      &kFragInfoMetadata, BufferView{buffer, Range{256u, sizeof(Vector4)}});
+
+  TestAllocator allocator;
+  EXPECT_TRUE(bindings.BindUniformData(gl, allocator, vertex_bindings,
+                                       fragment_bindings));
+
+  // The default block uniform is set member by member. The block is uploaded
+  // once and bound as a whole.
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(calls, std::vector<std::string>({
+                       "glUniformMatrix4fv",
+                       "glBindBuffer",
+                       "glBufferData",
+                       "glBindBufferRange",
+                   }));
+}
+
+TEST(BufferBindingsGLES, RejectsMisalignedUniformBlockRanges) {
+  auto mock_gles =
+      MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kUniformBlockResolver);
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kUniformBlockResolver));
+  ASSERT_TRUE(reactor->IsValid());
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  const auto& gl = reactor->GetProcTable();
+
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(gl, 1u));
+  mock_gles->GetCapturedCalls();
+
+  // The mock driver requires offsets to be multiples of 256 bytes.
+  auto buffer = CreateBuffer(reactor, 512u);
+  auto fragment_bindings = CreateBindings(
+      &kFragInfoMetadata, BufferView{buffer, Range{16u, sizeof(Vector4)}});
+
+  TestAllocator allocator;
+  EXPECT_FALSE(
+      bindings.BindUniformData(gl, allocator, Bindings{}, fragment_bindings));
+
+  auto calls = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), "glBindBufferRange"), 0);
+}
+
+}  // namespace testing
+}  // namespace impeller
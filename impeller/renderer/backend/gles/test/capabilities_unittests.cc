@@ -63,5 +63,45 @@ TEST(CapabilitiesGLES, SupportsFramebufferFetch) {
   EXPECT_TRUE(capabilities->SupportsFramebufferFetch());
 }
 
+TEST(CapabilitiesGLES, SupportsUniformBuffersOnGLES3) {
+  auto mock_gles = MockGLES::Init();
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsUniformBuffers());
+  EXPECT_EQ(capabilities->uniform_buffer_offset_alignment, 256u);
+}
+
+TEST(CapabilitiesGLES, DoesNotSupportUniformBuffersOnGLES2) {
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 2.0");
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_FALSE(capabilities->SupportsUniformBuffers());
+  EXPECT_EQ(capabilities->uniform_buffer_offset_alignment, 0u);
+  EXPECT_FALSE(capabilities->SupportsES3ShaderLibraries());
+}
+
+TEST(CapabilitiesGLES, SupportsES3ShaderLibrariesOnGLES3) {
+  auto mock_gles = MockGLES::Init();
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsES3ShaderLibraries());
+}
+
+TEST(CapabilitiesGLES, ES3ShaderLibrariesNeedESSL3ExternalImages) {
+  auto const extensions = std::vector<const unsigned char*>{
+      reinterpret_cast<const unsigned char*>("GL_KHR_debug"),              //
+      reinterpret_cast<const unsigned char*>("GL_OES_EGL_image_external"),  //
+  };
+  {
+    auto mock_gles = MockGLES::Init(extensions);
+    auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+    EXPECT_FALSE(capabilities->SupportsES3ShaderLibraries());
+  }
+
+  auto essl3_extensions = extensions;
+  essl3_extensions.push_back(reinterpret_cast<const unsigned char*>(
+      "GL_OES_EGL_image_external_essl3"));
+  auto mock_gles = MockGLES::Init(essl3_extensions);
+  auto capabilities = mock_gles->GetProcTable().GetCapabilities();
+  EXPECT_TRUE(capabilities->SupportsES3ShaderLibraries());
+}
+
 }  // namespace testing
 }  // namespace impeller
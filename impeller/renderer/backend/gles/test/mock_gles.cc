@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 
 #include "GLES3/gl3.h"
@@ -83,6 +84,12 @@ void mockGetIntegerv(GLenum name, int* value) {
     case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
       *value = 8;
       break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+      *value = 256;
+      break;
+    case GL_NUM_PROGRAM_BINARY_FORMATS:
+      *value = 1;
+      break;
     default:
       *value = 0;
       break;
@@ -163,6 +170,150 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  RecordGLCall("glEnable");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  RecordGLCall("glDisable");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glViewport");
+}
+
+static_assert(CheckSameSignature<decltype(mockViewport),  //
+                                 decltype(glViewport)>::value);
+
+void mockStencilMaskSeparate(GLenum face, GLuint mask) {
+  RecordGLCall("glStencilMaskSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilMaskSeparate),  //
+                                 decltype(glStencilMaskSeparate)>::value);
+
+void mockEnableVertexAttribArray(GLuint index) {
+  RecordGLCall("glEnableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnableVertexAttribArray),  //
+                                 decltype(glEnableVertexAttribArray)>::value);
+
+void mockDisableVertexAttribArray(GLuint index) {
+  RecordGLCall("glDisableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisableVertexAttribArray),  //
+                                 decltype(glDisableVertexAttribArray)>::value);
+
+void mockGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+  switch (pname) {
+    case GL_LINK_STATUS:
+      *params = GL_TRUE;
+      break;
+    case GL_PROGRAM_BINARY_LENGTH:
+      *params = sizeof(kMockProgramBinary);
+      break;
+    default:
+      *params = 0;
+      break;
+  }
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramiv),  //
+                                 decltype(glGetProgramiv)>::value);
+
+void mockGetProgramBinary(GLuint program,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLenum* binary_format,
+                          void* binary) {
+  RecordGLCall("glGetProgramBinary");
+  *length = std::min<GLsizei>(buffer_size, sizeof(kMockProgramBinary));
+  *binary_format = kMockProgramBinaryFormat;
+  memcpy(binary, kMockProgramBinary, *length);
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramBinary),  //
+                                 decltype(glGetProgramBinary)>::value);
+
+void mockProgramBinary(GLuint program,
+                       GLenum binary_format,
+                       const void* binary,
+                       GLsizei length) {
+  RecordGLCall("glProgramBinary");
+}
+
+static_assert(CheckSameSignature<decltype(mockProgramBinary),  //
+                                 decltype(glProgramBinary)>::value);
+
+GLboolean mockIsProgram(GLuint program) {
+  return GL_TRUE;
+}
+
+static_assert(CheckSameSignature<decltype(mockIsProgram),  //
+                                 decltype(glIsProgram)>::value);
+
+void mockUniformBlockBinding(GLuint program,
+                             GLuint block_index,
+                             GLuint block_binding) {
+  RecordGLCall("glUniformBlockBinding");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniformBlockBinding),  //
+                                 decltype(glUniformBlockBinding)>::value);
+
+void mockBindBuffer(GLenum target, GLuint buffer) {
+  RecordGLCall("glBindBuffer");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBuffer),  //
+                                 decltype(glBindBuffer)>::value);
+
+void mockBufferData(GLenum target,
+                    GLsizeiptr size,
+                    const void* data,
+                    GLenum usage) {
+  RecordGLCall("glBufferData");
+}
+
+static_assert(CheckSameSignature<decltype(mockBufferData),  //
+                                 decltype(glBufferData)>::value);
+
+void mockBindBufferRange(GLenum target,
+                         GLuint index,
+                         GLuint buffer,
+                         GLintptr offset,
+                         GLsizeiptr size) {
+  RecordGLCall("glBindBufferRange");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBufferRange),  //
+                                 decltype(glBindBufferRange)>::value);
+
+void mockUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+  RecordGLCall("glUniform4fv");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniform4fv),  //
+                                 decltype(glUniform4fv)>::value);
+
+void mockUniformMatrix4fv(GLint location,
+                          GLsizei count,
+                          GLboolean transpose,
+                          const GLfloat* value) {
+  RecordGLCall("glUniformMatrix4fv");
+}
+
+static_assert(CheckSameSignature<decltype(mockUniformMatrix4fv),  //
+                                 decltype(glUniformMatrix4fv)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions,
     const char* version_string,
@@ -202,6 +353,38 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(&mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(&mockDisable);
+  } else if (strcmp(name, "glViewport") == 0) {
+    return reinterpret_cast<void*>(&mockViewport);
+  } else if (strcmp(name, "glStencilMaskSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilMaskSeparate);
+  } else if (strcmp(name, "glEnableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockEnableVertexAttribArray);
+  } else if (strcmp(name, "glDisableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockDisableVertexAttribArray);
+  } else if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramiv);
+  } else if (strcmp(name, "glGetProgramBinary") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramBinary);
+  } else if (strcmp(name, "glProgramBinary") == 0) {
+    return reinterpret_cast<void*>(&mockProgramBinary);
+  } else if (strcmp(name, "glIsProgram") == 0) {
+    return reinterpret_cast<void*>(&mockIsProgram);
+  } else if (strcmp(name, "glUniformBlockBinding") == 0) {
+    return reinterpret_cast<void*>(&mockUniformBlockBinding);
+  } else if (strcmp(name, "glBindBuffer") == 0) {
+    return reinterpret_cast<void*>(&mockBindBuffer);
+  } else if (strcmp(name, "glBufferData") == 0) {
+    return reinterpret_cast<void*>(&mockBufferData);
+  } else if (strcmp(name, "glBindBufferRange") == 0) {
+    return reinterpret_cast<void*>(&mockBindBufferRange);
+  } else if (strcmp(name, "glUniform4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniform4fv);
+  } else if (strcmp(name, "glUniformMatrix4fv") == 0) {
+    return reinterpret_cast<void*>(&mockUniformMatrix4fv);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -15,6 +15,10 @@ namespace testing {
 
 extern const ProcTableGLES::Resolver kMockResolverGLES;
 
+/// The binary returned for every program by `glGetProgramBinary`.
+constexpr uint8_t kMockProgramBinary[] = {0x01, 0x02, 0x03, 0x04};
+constexpr GLenum kMockProgramBinaryFormat = 0x1234;
+
 /// @brief      Provides a mocked version of the |ProcTableGLES| class.
 ///
 /// Typically, Open GLES at runtime will be provided the host's GLES bindings
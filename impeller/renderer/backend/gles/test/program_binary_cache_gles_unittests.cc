@@ -0,0 +1,203 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+constexpr uint64_t kProgramKey = 42u;
+constexpr GLuint kProgram = 1u;
+
+fml::UniqueFD OpenDirectory(const fml::ScopedTemporaryDirectory& directory) {
+  return fml::OpenDirectory(directory.path().c_str(), false,
+                            fml::FilePermission::kReadWrite);
+}
+
+size_t CountFiles(const fml::UniqueFD& directory) {
+  size_t count = 0u;
+  fml::VisitFilesRecursively(directory, [&count](const fml::UniqueFD& directory,
+                                                 const std::string& filename) {
+    if (!fml::IsDirectory(directory, filename.c_str())) {
+      count++;
+    }
+    return true;
+  });
+  return count;
+}
+
+void mockGetProgramivFailingLink(GLuint program, GLenum pname, GLint* params) {
+  *params = pname == GL_LINK_STATUS ? GL_FALSE : 0;
+}
+
+const ProcTableGLES::Resolver kFailingLinkResolver = [](const char* name) {
+  if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramivFailingLink);
+  }
+  return kMockResolverGLES(name);
+};
+
+}  // namespace
+
+TEST(ProgramBinaryCacheGLES, StoresAndLoadsProgramBinaries) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto mock_gles = MockGLES::Init();
+  const auto& gl = mock_gles->GetProcTable();
+  ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir));
+  ASSERT_TRUE(cache.IsValid());
+
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey));
+  EXPECT_TRUE(cache.StoreProgram(gl, kProgram, kProgramKey));
+  EXPECT_TRUE(cache.LoadProgram(gl, kProgram, kProgramKey));
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey + 1u));
+
+  std::vector<std::string> expected = {"glGetProgramBinary", "glProgramBinary"};
+  EXPECT_EQ(mock_gles->GetCapturedCalls(), expected);
+}
+
+TEST(ProgramBinaryCacheGLES, EvictsRejectedBinaries) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  {
+    auto mock_gles = MockGLES::Init();
+    ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(),
+                                 OpenDirectory(temp_dir));
+    ASSERT_TRUE(cache.StoreProgram(mock_gles->GetProcTable(), kProgram,
+                                   kProgramKey));
+  }
+
+  auto mock_gles =
+      MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kFailingLinkResolver);
+  const auto& gl = mock_gles->GetProcTable();
+  ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir));
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey));
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glProgramBinary"}));
+
+  // The rejected binary is not loaded again.
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey));
+  EXPECT_TRUE(mock_gles->GetCapturedCalls().empty());
+}
+
+TEST(ProgramBinaryCacheGLES, EvictsBinariesOfOtherDrivers) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  {
+    auto mock_gles = MockGLES::Init();
+    ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(),
+                                 OpenDirectory(temp_dir));
+    ASSERT_TRUE(cache.StoreProgram(mock_gles->GetProcTable(), kProgram,
+                                   kProgramKey));
+  }
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 1u);
+
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 3.1");
+  const auto& gl = mock_gles->GetProcTable();
+  ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir));
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 0u);
+  EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey));
+}
+
+TEST(ProgramBinaryCacheGLES, IsDisabledWithoutProgramBinarySupport) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 2.0");
+  const auto& gl = mock_gles->GetProcTable();
+  ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir));
+  EXPECT_FALSE(cache.IsValid());
+  EXPECT_FALSE(cache.StoreProgram(gl, kProgram, kProgramKey));
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 0u);
+}
+
+TEST(ProgramBinaryCacheGLES, ReadOnlyCacheLoadsButNeverWrites) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  {
+    auto mock_gles = MockGLES::Init();
+    ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(),
+                                 OpenDirectory(temp_dir));
+    ASSERT_TRUE(cache.StoreProgram(mock_gles->GetProcTable(), kProgram,
+                                   kProgramKey));
+  }
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 1u);
+
+  {
+    auto mock_gles = MockGLES::Init();
+    const auto& gl = mock_gles->GetProcTable();
+    ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir),
+                                 /*read_only=*/true);
+    ASSERT_TRUE(cache.IsValid());
+    EXPECT_TRUE(cache.LoadProgram(gl, kProgram, kProgramKey));
+    EXPECT_FALSE(cache.StoreProgram(gl, kProgram, kProgramKey + 1u));
+    EXPECT_EQ(mock_gles->GetCapturedCalls(),
+              std::vector<std::string>({"glProgramBinary"}));
+  }
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 1u);
+
+  // Rejected binaries are not evicted.
+  {
+    auto mock_gles =
+        MockGLES::Init(std::nullopt, "OpenGL ES 3.0", kFailingLinkResolver);
+    const auto& gl = mock_gles->GetProcTable();
+    ProgramBinaryCacheGLES cache(gl, OpenDirectory(temp_dir),
+                                 /*read_only=*/true);
+    EXPECT_FALSE(cache.LoadProgram(gl, kProgram, kProgramKey));
+  }
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 1u);
+
+  // Neither are the binaries of other drivers.
+  {
+    auto mock_gles = MockGLES::Init(std::nullopt, "OpenGL ES 3.1");
+    ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(),
+                                 OpenDirectory(temp_dir),
+                                 /*read_only=*/true);
+    EXPECT_FALSE(cache.IsValid());
+  }
+  EXPECT_EQ(CountFiles(temp_dir.fd()), 1u);
+}
+
+TEST(ProgramBinaryCacheGLES, ReadOnlyCacheDoesNotCreateDirectories) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto mock_gles = MockGLES::Init();
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(),
+                               OpenDirectory(temp_dir), /*read_only=*/true);
+  EXPECT_FALSE(cache.IsValid());
+
+  size_t entry_count = 0u;
+  fml::VisitFiles(temp_dir.fd(), [&entry_count](const fml::UniqueFD& directory,
+                                                const std::string& filename) {
+    entry_count++;
+    return true;
+  });
+  EXPECT_EQ(entry_count, 0u);
+}
+
+TEST(ProgramBinaryCacheGLES, ProgramKeyCoversLinkInputs) {
+  const fml::DataMapping vert(std::string("vertex"));
+  const fml::DataMapping frag(std::string("fragment"));
+  const std::vector<ShaderStageIOSlot> inputs = {
+      {"position", 0u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u, 0u},
+  };
+  const std::vector<ShaderStageIOSlot> moved_inputs = {
+      {"position", 1u, 0u, 0u, ShaderType::kFloat, 32u, 2u, 1u, 0u},
+  };
+
+  const auto key =
+      ProgramBinaryCacheGLES::ComputeProgramKey(vert, frag, {}, inputs);
+  EXPECT_EQ(key,
+            ProgramBinaryCacheGLES::ComputeProgramKey(vert, frag, {}, inputs));
+  EXPECT_NE(key,
+            ProgramBinaryCacheGLES::ComputeProgramKey(frag, vert, {}, inputs));
+  EXPECT_NE(key,
+            ProgramBinaryCacheGLES::ComputeProgramKey(vert, frag, {1}, inputs));
+  EXPECT_NE(key, ProgramBinaryCacheGLES::ComputeProgramKey(vert, frag, {},
+                                                           moved_inputs));
+}
+
+}  // namespace testing
+}  // namespace impeller
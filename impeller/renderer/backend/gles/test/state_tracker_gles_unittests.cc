@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(StateTrackerGLES, FirstCallIsAlwaysIssued) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_BLEND, false);
+  state.Viewport(0, 0, 100, 100);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glDisable", "glViewport"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateTrackerGLES, ElidesRedundantCalls) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_BLEND, true);
+  state.SetEnabled(GL_BLEND, true);
+  state.Viewport(0, 0, 100, 100);
+  state.Viewport(0, 0, 100, 100);
+  state.Viewport(0, 0, 50, 100);
+  state.SetEnabled(GL_BLEND, false);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glEnable", "glViewport", "glViewport", "glDisable"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateTrackerGLES, UntrackedCapabilitiesArePassedThrough) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabled(GL_DITHER, true);
+  state.SetEnabled(GL_DITHER, true);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glEnable", "glEnable"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateTrackerGLES, TracksStencilFacesIndependently) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+  // Both faces already have this mask.
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT, 0x0F);
+  // Only the front face differs, but a call for both faces is required.
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glStencilMaskSeparate", "glStencilMaskSeparate",
+                 "glStencilMaskSeparate", "glStencilMaskSeparate"}));
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateTrackerGLES, OnlyTogglesChangedVertexAttribArrays) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.SetEnabledVertexAttribArrays(0b011);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glEnableVertexAttribArray", "glEnableVertexAttribArray"}));
+
+  state.SetEnabledVertexAttribArrays(0b110);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glDisableVertexAttribArray", "glEnableVertexAttribArray"}));
+
+  state.UnbindProgramAndVertexAttribArrays();
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glDisableVertexAttribArray", "glDisableVertexAttribArray"}));
+}
+
+}  // namespace testing
+}  // namespace impeller
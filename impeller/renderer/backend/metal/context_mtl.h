@@ -103,6 +103,9 @@ class ContextMTL final : public Context,
   std::shared_ptr<GPUTracerMTL> GetGPUTracer() const;
 #endif  // IMPELLER_DEBUG
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
   // |Context|
   void StoreTaskForGPU(const std::function<void()>& task) override;
 
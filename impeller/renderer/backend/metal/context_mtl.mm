@@ -324,6 +324,13 @@ std::shared_ptr<GPUTracerMTL> ContextMTL::GetGPUTracer() const {
 }
 #endif  // IMPELLER_DEBUG
 
+// |Context|
+void ContextMTL::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+#ifdef IMPELLER_DEBUG
+  gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+#endif  // IMPELLER_DEBUG
+}
+
 std::shared_ptr<const fml::SyncSwitch> ContextMTL::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
@@ -12,6 +12,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/scalar.h"
+#include "impeller/renderer/context.h"
 
 namespace impeller {
 
@@ -34,6 +35,9 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   ///        aggregate frame workload metric.
   void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
 
+  /// @brief Set the callback that receives the GPU time of each frame.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
  private:
   struct GPUTraceState {
     Scalar smallest_timestamp = std::numeric_limits<float>::max();
@@ -44,6 +48,8 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[16] IPLR_GUARDED_BY(trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  Context::GPUFrameTimeCallback frame_time_callback_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
 };
 
 }  // namespace impeller
@@ -20,6 +20,12 @@ void GPUTracerMTL::MarkFrameEnd() {
   }
 }
 
+void GPUTracerMTL::SetFrameTimeCallback(
+    Context::GPUFrameTimeCallback callback) {
+  Lock lock(trace_state_mutex_);
+  frame_time_callback_ = std::move(callback);
+}
+
 void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
   if (@available(ios 10.3, tvos 10.2, macos 10.15, macCatalyst 13.0, *)) {
     Lock lock(trace_state_mutex_);
@@ -48,6 +54,9 @@ void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
         FML_TRACE_COUNTER("flutter", "GPUTracer",
                           reinterpret_cast<int64_t>(this),  // Trace Counter ID
                           "FrameTimeMS", gpu_ms);
+        if (self->frame_time_callback_) {
+          self->frame_time_callback_(fml::TimeDelta::FromMillisecondsF(gpu_ms));
+        }
       }
     }];
   }
@@ -4,4 +4,91 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+#ifdef IMPELLER_DEBUG
+// Command buffers may be encoded on multiple threads.
+static std::atomic<uint64_t> g_pipeline_barrier_count = 0u;
+static std::atomic<uint64_t> g_image_barrier_count = 0u;
+static std::atomic<uint64_t> g_elided_barrier_count = 0u;
+#endif  // IMPELLER_DEBUG
+
+BarrierBatchVK::BarrierBatchVK(vk::CommandBuffer cmd_buffer)
+    : cmd_buffer_(cmd_buffer) {}
+
+BarrierBatchVK::~BarrierBatchVK() {
+  FML_DCHECK(image_barriers_.empty())
+      << "Barriers were added to a batch that was never flushed.";
+}
+
+void BarrierBatchVK::AddImageBarrier(const vk::ImageMemoryBarrier& barrier,
+                                     vk::PipelineStageFlags src_stage,
+                                     vk::PipelineStageFlags dst_stage) {
+  const bool has_pending_transition =
+      std::any_of(image_barriers_.begin(), image_barriers_.end(),
+                  [&barrier](const vk::ImageMemoryBarrier& pending) {
+                    return pending.image == barrier.image;
+                  });
+  if (has_pending_transition) {
+    Flush();
+  }
+  image_barriers_.push_back(barrier);
+  src_stage_ |= src_stage;
+  dst_stage_ |= dst_stage;
+}
+
+void BarrierBatchVK::AddElidedBarrier() {
+#ifdef IMPELLER_DEBUG
+  g_elided_barrier_count.fetch_add(1u, std::memory_order_relaxed);
+#endif  // IMPELLER_DEBUG
+}
+
+void BarrierBatchVK::Flush() {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  cmd_buffer_.pipelineBarrier(src_stage_,      // src stage
+                              dst_stage_,      // dst stage
+                              {},              // dependency flags
+                              nullptr,         // memory barriers
+                              nullptr,         // buffer barriers
+                              image_barriers_  // image barriers
+  );
+#ifdef IMPELLER_DEBUG
+  g_pipeline_barrier_count.fetch_add(1u, std::memory_order_relaxed);
+  g_image_barrier_count.fetch_add(image_barriers_.size(),
+                                  std::memory_order_relaxed);
+#endif  // IMPELLER_DEBUG
+  image_barriers_.clear();
+  src_stage_ = {};
+  dst_stage_ = {};
+}
+
+size_t BarrierBatchVK::GetPendingBarrierCount() const {
+  return image_barriers_.size();
+}
+
+void TraceBarriersPerFrameVK() {
+#ifdef IMPELLER_DEBUG
+  const auto pipeline_barriers =
+      static_cast<int64_t>(g_pipeline_barrier_count.exchange(0u));
+  const auto image_barriers =
+      static_cast<int64_t>(g_image_barrier_count.exchange(0u));
+  const auto elided = static_cast<int64_t>(g_elided_barrier_count.exchange(0u));
+  FML_TRACE_COUNTER("impeller",                             //
+                    "BarriersPerFrameVK",                   //
+                    0,                                      //
+                    "PipelineBarriers", pipeline_barriers,  //
+                    "ImageBarriers", image_barriers,        //
+                    "Elided", elided);
+#endif  // IMPELLER_DEBUG
+}
+
+}  // namespace impeller
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 
+#include <cstddef>
+#include <vector>
+
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -49,6 +52,69 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Collects the image layout transitions needed before a group of
+///             commands and encodes them with a single call to
+///             `vkCmdPipelineBarrier`.
+///
+///             The synchronization scopes of the batched barriers are merged.
+///             This may make an individual transition wait on more stages
+///             than it strictly needs to, but transitions that are batched
+///             together precede the same commands and would otherwise be
+///             serialized one after the other anyway.
+///
+///             Pending barriers must be encoded with `Flush` before any
+///             command that depends on them is recorded.
+///
+class BarrierBatchVK {
+ public:
+  explicit BarrierBatchVK(vk::CommandBuffer cmd_buffer);
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add an image memory barrier to the batch.
+  ///
+  ///             A batch may only contain one transition per image. If the
+  ///             image already has a pending transition, the batch is flushed
+  ///             first.
+  ///
+  void AddImageBarrier(const vk::ImageMemoryBarrier& barrier,
+                       vk::PipelineStageFlags src_stage,
+                       vk::PipelineStageFlags dst_stage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that a transition was skipped because the image was
+  ///             already in the requested layout.
+  ///
+  void AddElidedBarrier();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode all pending barriers to the command buffer.
+  ///
+  void Flush();
+
+  size_t GetPendingBarrierCount() const;
+
+ private:
+  vk::CommandBuffer cmd_buffer_;
+  vk::PipelineStageFlags src_stage_ = {};
+  vk::PipelineStageFlags dst_stage_ = {};
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+
+  BarrierBatchVK(const BarrierBatchVK&) = delete;
+
+  BarrierBatchVK& operator=(const BarrierBatchVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      In debug builds, emits trace counters for the number of
+///             pipeline barriers encoded, image layout transitions encoded
+///             and transitions elided since the last call. Called once per
+///             frame.
+///
+void TraceBarriersPerFrameVK();
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
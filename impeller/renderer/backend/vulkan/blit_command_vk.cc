@@ -92,7 +92,11 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  BarrierBatchVK barriers(cmd_buffer);
+  const bool transitioned = src.SetLayout(src_barrier, barriers) &&
+                            dst.SetLayout(dst_barrier, barriers);
+  barriers.Flush();
+  if (!transitioned) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
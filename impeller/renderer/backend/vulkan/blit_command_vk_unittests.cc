@@ -29,6 +29,27 @@ TEST(BlitCommandVkTest, BlitCopyTextureToTextureCommandVK) {
   EXPECT_TRUE(encoder->IsTracking(cmd.destination));
 }
 
+TEST(BlitCommandVkTest, BlitCopyTextureToTextureBatchesLayoutTransitions) {
+  auto context = MockVulkanContextBuilder().Build();
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  BlitCopyTextureToTextureCommandVK cmd;
+  cmd.source = context->GetResourceAllocator()->CreateTexture({
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+  });
+  cmd.destination = context->GetResourceAllocator()->CreateTexture({
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+  });
+  EXPECT_TRUE(cmd.Encode(*encoder.get()));
+
+  // The source and destination are transitioned by one barrier before the
+  // copy, and the destination by another one after it.
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkCmdPipelineBarrier"), 2);
+}
+
 TEST(BlitCommandVkTest, BlitCopyTextureToBufferCommandVK) {
   auto context = MockVulkanContextBuilder().Build();
   auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
@@ -172,6 +172,19 @@ fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSets(
                                                                       context);
 }
 
+fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::GetOrCreateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context) {
+  if (!IsValid()) {
+    return fml::Status(fml::StatusCode::kUnknown, "command encoder invalid");
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetOrCreateDescriptorSet(
+      layout, writes, write_count, context);
+}
+
 void CommandEncoderVK::PushDebugGroup(std::string_view label) const {
   if (!HasValidationLayers()) {
     return;
@@ -206,4 +219,31 @@ void CommandEncoderVK::InsertDebugMarker(std::string_view label) const {
   }
 }
 
+void CommandEncoderVK::PushGPUTimingScope(std::string_view label) {
+  if (!tracked_objects_) {
+    return;
+  }
+  std::optional<size_t> parent = gpu_timing_scopes_.empty()
+                                     ? std::nullopt
+                                     : gpu_timing_scopes_.back();
+  gpu_timing_scopes_.push_back(tracked_objects_->GetGPUProbe().RecordScopeStart(
+      GetCommandBuffer(), label, parent));
+}
+
+void CommandEncoderVK::PopGPUTimingScope() {
+  if (!tracked_objects_ || gpu_timing_scopes_.empty()) {
+    return;
+  }
+  std::optional<size_t> scope = gpu_timing_scopes_.back();
+  gpu_timing_scopes_.pop_back();
+  if (scope.has_value()) {
+    tracked_objects_->GetGPUProbe().RecordScopeEnd(GetCommandBuffer(),
+                                                   scope.value());
+  }
+}
+
+bool CommandEncoderVK::IsRecordingGPUTimingScopes() const {
+  return tracked_objects_ && tracked_objects_->GetGPUProbe().IsRecording();
+}
+
 }  // namespace impeller
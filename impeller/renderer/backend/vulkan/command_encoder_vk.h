@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <string_view>
+#include <vector>
 
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/command_queue_vk.h"
@@ -81,12 +83,34 @@ class CommandEncoderVK {
 
   void InsertDebugMarker(std::string_view label) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start a GPU timing scope nested in the innermost open scope of
+  ///             this encoder. Only recorded while GPU tracing is enabled and
+  ///             a frame is being traced. See |GPUTracerVK|.
+  ///
+  void PushGPUTimingScope(std::string_view label);
+
+  void PopGPUTimingScope();
+
+  bool IsRecordingGPUTimingScopes() const;
+
   bool EndCommandBuffer() const;
 
   fml::StatusOr<vk::DescriptorSet> AllocateDescriptorSets(
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given layout and contents from
+  ///             the descriptor pool of this encoder. Identical sets are
+  ///             shared. See |DescriptorPoolVK::GetOrCreateDescriptorSet|.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetOrCreateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context);
+
  private:
   friend class ContextVK;
   friend class CommandQueueVK;
@@ -96,6 +120,8 @@ class CommandEncoderVK {
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::shared_ptr<HostBuffer> host_buffer_;
+  // The open timing scopes, or std::nullopt for scopes that are not recorded.
+  std::vector<std::optional<size_t>> gpu_timing_scopes_;
   bool is_valid_ = true;
 
   void Reset();
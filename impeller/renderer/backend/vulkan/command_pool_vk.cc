@@ -155,9 +155,14 @@ void CommandPoolVK::Destroy() {
   collected_buffers_.clear();
 }
 
+// A command pool and the recycler generation it was created in.
+struct ThreadLocalCommandPool {
+  uint64_t generation = 0u;
+  std::shared_ptr<CommandPoolVK> pool;
+};
+
 // Associates a resource with a thread and context.
-using CommandPoolMap =
-    std::unordered_map<uint64_t, std::shared_ptr<CommandPoolVK>>;
+using CommandPoolMap = std::unordered_map<uint64_t, ThreadLocalCommandPool>;
 
 // CommandPoolVK Lifecycle:
 // 1. End of frame will reset the command pool (clearing this on a thread).
@@ -190,9 +195,16 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
   }
   CommandPoolMap& pool_map = *tls_command_pool_map.get();
   auto const hash = strong_context->GetHash();
+  auto const generation = generation_.load(std::memory_order_acquire);
   auto const it = pool_map.find(hash);
   if (it != pool_map.end()) {
-    return it->second;
+    if (it->second.generation == generation) {
+      return it->second.pool;
+    }
+    // The pool was handed out before the last |Dispose| on another thread.
+    // Drop this thread's reference so that it is recycled once the command
+    // buffers recorded into it have completed.
+    pool_map.erase(it);
   }
 
   // Otherwise, create a new resource and return it.
@@ -203,7 +215,8 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
 
   auto const resource = std::make_shared<CommandPoolVK>(
       std::move(data->pool), std::move(data->buffers), context_);
-  pool_map.emplace(hash, resource);
+  pool_map.emplace(hash, ThreadLocalCommandPool{.generation = generation,
+                                                .pool = resource});
 
   {
     Lock all_pools_lock(g_all_pools_map_mutex);
@@ -276,6 +289,7 @@ CommandPoolRecyclerVK::~CommandPoolRecyclerVK() {
 }
 
 void CommandPoolRecyclerVK::Dispose() {
+  generation_.fetch_add(1u, std::memory_order_acq_rel);
   CommandPoolMap* pool_map = tls_command_pool_map.get();
   if (pool_map) {
     pool_map->clear();
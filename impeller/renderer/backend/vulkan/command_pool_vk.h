@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_POOL_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_POOL_VK_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -90,6 +92,13 @@ class CommandPoolVK final {
 /// is moved to a background thread, reset, and made available for the next time
 /// |Get| is called and needs to create a command pool.
 ///
+/// Command buffers may be recorded concurrently on multiple threads, each
+/// thread recording into its own pool. Pools handed out to other threads
+/// before a |Dispose| are released and recycled the next time those threads
+/// call |Get|, so worker threads that record every frame do not accumulate
+/// command buffers in a pool that is never reset. This is the case for the
+/// threads of |ContextVK::GetEncodingTaskRunner|, which record subpasses.
+///
 /// Commands in the command pool are not necessarily done executing when the
 /// pool is recycled, when all references are dropped to the pool, they are
 /// reset and returned to the pool of available pools.
@@ -135,11 +144,18 @@ class CommandPoolRecyclerVK final
                std::vector<vk::UniqueCommandBuffer>&& buffers);
 
   /// @brief      Clears all recycled command pools to let them be reclaimed.
+  ///
+  ///             The current thread's pools are released immediately. Pools
+  ///             of other threads are released on their next call to |Get|.
   void Dispose();
 
  private:
   std::weak_ptr<ContextVK> context_;
 
+  // Incremented by every |Dispose|. Thread-local pools created in an earlier
+  // generation are not handed out again.
+  std::atomic<uint64_t> generation_ = 0u;
+
   Mutex recycled_mutex_;
   std::vector<RecycledData> recycled_ IPLR_GUARDED_BY(recycled_mutex_);
 
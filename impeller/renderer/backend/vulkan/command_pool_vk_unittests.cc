@@ -162,5 +162,40 @@ TEST(CommandPoolRecyclerVKTest, CommandBuffersAreRecycled) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, DisposeRecyclesPoolsOfOtherThreads) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const recycler = context->GetCommandPoolRecycler();
+
+  fml::AutoResetWaitableEvent acquired;
+  fml::AutoResetWaitableEvent disposed;
+  std::shared_ptr<CommandPoolVK> pool1;
+  std::shared_ptr<CommandPoolVK> pool2;
+  std::shared_ptr<CommandPoolVK> pool3;
+
+  std::thread worker([&]() {
+    pool1 = recycler->Get();
+    pool2 = recycler->Get();
+    acquired.Signal();
+    disposed.Wait();
+    pool3 = recycler->Get();
+  });
+
+  acquired.Wait();
+  // This normally is called at the end of a frame on the raster thread.
+  recycler->Dispose();
+  disposed.Signal();
+  worker.join();
+
+  // Within a frame, the worker thread keeps using the same pool.
+  EXPECT_EQ(pool1, pool2);
+  // After the frame ended, the worker thread no longer records into it.
+  EXPECT_NE(pool1, pool3);
+
+  pool1.reset();
+  pool2.reset();
+  pool3.reset();
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
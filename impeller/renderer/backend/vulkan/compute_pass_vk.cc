@@ -245,19 +245,23 @@ bool ComputePassVK::EncodeCommands() const {
   // Since we only use global memory barrier, we don't have to worry about
   // compute to compute dependencies across cmd buffers. Instead, we pessimize
   // here and assume that we wrote to a storage image or buffer and that a
-  // render pass will read from it. if there are ever scenarios where we end up
-  // with compute to compute dependencies this should be revisited.
+  // render pass or a blit pass will read from it. if there are ever scenarios
+  // where we end up with compute to compute dependencies this should be
+  // revisited.
 
   // This does not currently handle image barriers as we do not use them
   // for anything.
   vk::MemoryBarrier barrier;
   barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
-  barrier.dstAccessMask =
-      vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead;
+  barrier.dstAccessMask = vk::AccessFlagBits::eIndexRead |
+                          vk::AccessFlagBits::eVertexAttributeRead |
+                          vk::AccessFlagBits::eTransferRead;
 
   command_buffer_->GetEncoder()->GetCommandBuffer().pipelineBarrier(
       vk::PipelineStageFlagBits::eComputeShader,
-      vk::PipelineStageFlagBits::eVertexInput, {}, 1, &barrier, 0, {}, 0, {});
+      vk::PipelineStageFlagBits::eVertexInput |
+          vk::PipelineStageFlagBits::eTransfer,
+      {}, 1, &barrier, 0, {}, 0, {});
 
   return true;
 }
@@ -155,6 +155,11 @@ void ContextVK::Setup(Settings settings) {
 #endif  // FML_OS_ANDROID
   });
 
+  if (settings.enable_concurrent_pass_encoding) {
+    encoding_message_loop_ = fml::ConcurrentMessageLoop::Create(
+        ChooseThreadCountForWorkers(std::thread::hardware_concurrency()));
+  }
+
   auto& dispatcher = VULKAN_HPP_DEFAULT_DISPATCHER;
   dispatcher.init(settings.proc_address_callback);
 
@@ -520,6 +525,14 @@ ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner> ContextVK::GetEncodingTaskRunner()
+    const {
+  if (!encoding_message_loop_) {
+    return nullptr;
+  }
+  return encoding_message_loop_->GetTaskRunner();
+}
+
 void ContextVK::Shutdown() {
   // There are multiple objects, for example |CommandPoolVK|, that in their
   // destructors make a strong reference to |ContextVK|. Resetting these shared
@@ -530,6 +543,9 @@ void ContextVK::Shutdown() {
   resource_manager_.reset();
 
   raster_message_loop_->Terminate();
+  if (encoding_message_loop_) {
+    encoding_message_loop_->Terminate();
+  }
 }
 
 std::shared_ptr<SurfaceContextVK> ContextVK::CreateSurfaceContext() {
@@ -570,6 +586,11 @@ std::shared_ptr<GPUTracerVK> ContextVK::GetGPUTracer() const {
   return gpu_tracer_;
 }
 
+// |Context|
+void ContextVK::SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {
+  gpu_tracer_->SetFrameTimeCallback(std::move(callback));
+}
+
 std::shared_ptr<DescriptorPoolRecyclerVK> ContextVK::GetDescriptorPoolRecycler()
     const {
   return descriptor_pool_recycler_;
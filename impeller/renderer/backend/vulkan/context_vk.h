@@ -49,6 +49,9 @@ class ContextVK final : public Context,
     fml::UniqueFD cache_directory;
     bool enable_validation = false;
     bool enable_gpu_tracing = false;
+    /// Record independent render passes of a frame on worker threads. See
+    /// |Context::GetEncodingTaskRunner|.
+    bool enable_concurrent_pass_encoding = false;
     /// If validations are requested but cannot be enabled, log a fatal error.
     bool fatal_missing_validations = false;
 
@@ -162,8 +165,15 @@ class ContextVK final : public Context,
 
   std::shared_ptr<CommandQueue> GetCommandQueue() const override;
 
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetEncodingTaskRunner()
+      const override;
+
   std::shared_ptr<GPUTracerVK> GetGPUTracer() const;
 
+  // |Context|
+  void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) override;
+
   void RecordFrameEndTime() const;
 
   void InitializeCommonlyUsedShadersIfNeeded() const override;
@@ -197,6 +207,9 @@ class ContextVK final : public Context,
   std::shared_ptr<CommandPoolRecyclerVK> command_pool_recycler_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
+  // Separate from |raster_message_loop_| because pipeline compile jobs run
+  // there, and a recording task waiting on a pipeline must not starve them.
+  std::shared_ptr<fml::ConcurrentMessageLoop> encoding_message_loop_;
   std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
   std::shared_ptr<CommandQueue> command_queue_vk_;
@@ -233,6 +233,18 @@ TEST(ContextVKTest, FatalMissingValidations) {
                "");
 }
 
+TEST(ContextVKTest, EncodingTaskRunnerIsOptIn) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  EXPECT_EQ(context->GetEncodingTaskRunner(), nullptr);
+
+  context = MockVulkanContextBuilder()
+                .SetSettingsCallback([](ContextVK::Settings& settings) {
+                  settings.enable_concurrent_pass_encoding = true;
+                })
+                .Build();
+  EXPECT_NE(context->GetEncodingTaskRunner(), nullptr);
+}
+
 TEST(ContextVKTest, HasDefaultColorFormat) {
   std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
 
@@ -6,6 +6,7 @@
 
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "vulkan/vulkan_enums.hpp"
@@ -120,6 +121,62 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   return set;
 }
 
+template <class HandleT>
+static uint64_t HandleToKey(HandleT handle) {
+  return reinterpret_cast<uint64_t>(
+      static_cast<typename HandleT::CType>(handle));
+}
+
+std::size_t DescriptorPoolVK::DescriptorSetKeyHash::operator()(
+    const std::vector<uint64_t>& key) const {
+  std::size_t seed = fml::HashCombine();
+  for (uint64_t word : key) {
+    fml::HashCombineSeed(seed, word);
+  }
+  return seed;
+}
+
+fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::GetOrCreateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const ContextVK& context_vk) {
+  key_workspace_.clear();
+  key_workspace_.push_back(HandleToKey(layout));
+  for (size_t i = 0u; i < write_count; i++) {
+    const vk::WriteDescriptorSet& write = writes[i];
+    key_workspace_.push_back(write.dstBinding);
+    key_workspace_.push_back(static_cast<uint64_t>(write.descriptorType));
+    if (write.pImageInfo) {
+      key_workspace_.push_back(HandleToKey(write.pImageInfo->sampler));
+      key_workspace_.push_back(HandleToKey(write.pImageInfo->imageView));
+      key_workspace_.push_back(
+          static_cast<uint64_t>(write.pImageInfo->imageLayout));
+    }
+    if (write.pBufferInfo) {
+      key_workspace_.push_back(HandleToKey(write.pBufferInfo->buffer));
+      key_workspace_.push_back(write.pBufferInfo->offset);
+      key_workspace_.push_back(write.pBufferInfo->range);
+    }
+  }
+
+  if (auto found = cached_sets_.find(key_workspace_);
+      found != cached_sets_.end()) {
+    return found->second;
+  }
+
+  auto set = AllocateDescriptorSets(layout, context_vk);
+  if (!set.ok()) {
+    return set;
+  }
+  for (size_t i = 0u; i < write_count; i++) {
+    writes[i].dstSet = set.value();
+  }
+  context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+  cached_sets_.emplace(key_workspace_, set.value());
+  return set;
+}
+
 fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   auto new_pool = context_vk.GetDescriptorPoolRecycler()->Get();
   if (!new_pool) {
@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -34,9 +36,37 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context_vk);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given layout whose contents are
+  ///             described by `writes`.
+  ///
+  ///             Sets are cached by their layout and contents for the lifetime
+  ///             of the pool. Draws that bind exactly the same resources share
+  ///             one set and skip both the allocation and the descriptor
+  ///             update. The `dstSet` member of the writes is overwritten.
+  ///
+  ///             The resources referenced by the writes must outlive the pool,
+  ///             which is already the case for resources tracked by the
+  ///             encoder that owns the pool.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetOrCreateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const ContextVK& context_vk);
+
  private:
+  struct DescriptorSetKeyHash {
+    std::size_t operator()(const std::vector<uint64_t>& key) const;
+  };
+
   std::weak_ptr<const ContextVK> context_;
   std::vector<vk::UniqueDescriptorPool> pools_;
+  std::vector<uint64_t> key_workspace_;
+  std::unordered_map<std::vector<uint64_t>,
+                     vk::DescriptorSet,
+                     DescriptorSetKeyHash>
+      cached_sets_;
 
   fml::Status CreateNewPool(const ContextVK& context_vk);
 
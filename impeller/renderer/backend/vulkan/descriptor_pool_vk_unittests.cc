@@ -123,5 +123,39 @@ TEST(DescriptorPoolRecyclerVKTest, ReclaimDropsDescriptorPoolIfSizeIsExceeded) {
   context->Shutdown();
 }
 
+TEST(DescriptorPoolRecyclerVKTest, IdenticalDescriptorSetsAreShared) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto pool = DescriptorPoolVK(context);
+
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.offset = 0u;
+    buffer_info.range = 64u;
+
+    vk::WriteDescriptorSet write;
+    write.dstBinding = 0u;
+    write.descriptorCount = 1u;
+    write.descriptorType = vk::DescriptorType::eUniformBuffer;
+    write.pBufferInfo = &buffer_info;
+
+    EXPECT_TRUE(pool.GetOrCreateDescriptorSet({}, &write, 1u, *context).ok());
+    EXPECT_TRUE(pool.GetOrCreateDescriptorSet({}, &write, 1u, *context).ok());
+
+    // A different offset into the buffer needs its own set.
+    buffer_info.offset = 256u;
+    EXPECT_TRUE(pool.GetOrCreateDescriptorSet({}, &write, 1u, *context).ok());
+  }
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateDescriptorSets"),
+      2u);
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkUpdateDescriptorSets"), 2u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,8 +4,10 @@
 
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <thread>
 #include <utility>
 
@@ -20,7 +22,9 @@
 
 namespace impeller {
 
-static constexpr uint32_t kPoolSize = 128u;
+// Each timing scope uses two queries, and there is a scope for most entities
+// in a frame.
+static constexpr uint32_t kPoolSize = 1024u;
 
 GPUTracerVK::GPUTracerVK(std::weak_ptr<ContextVK> context,
                          bool enable_gpu_tracing)
@@ -103,6 +107,18 @@ void GPUTracerVK::MarkFrameEnd() {
   FML_DCHECK(state.pending_buffers == 0u);
   state.pending_buffers = 0;
   state.current_index = 0;
+  state.open_scopes = 0;
+  state.scopes.clear();
+}
+
+void GPUTracerVK::SetFrameTimeCallback(Context::GPUFrameTimeCallback callback) {
+  Lock lock(trace_state_mutex_);
+  frame_time_callback_ = std::move(callback);
+}
+
+std::map<std::string, double> GPUTracerVK::GetLastFrameScopeTimings() const {
+  Lock lock(trace_state_mutex_);
+  return last_frame_scope_timings_;
 }
 
 std::unique_ptr<GPUProbe> GPUTracerVK::CreateGPUProbe() {
@@ -129,8 +145,8 @@ void GPUTracerVK::RecordCmdBufferStart(const vk::CommandBuffer& buffer,
 
   // We size the query pool to kPoolSize, but Flutter applications can create an
   // unbounded amount of work per frame. If we encounter this, stop recording
-  // cmds.
-  if (state.current_index >= kPoolSize) {
+  // cmds. Queries reserved for the ends of open scopes must stay available.
+  if (state.current_index + state.open_scopes + 2 > kPoolSize) {
     return;
   }
 
@@ -161,6 +177,64 @@ void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
   state.current_index += 1;
 }
 
+std::optional<size_t> GPUTracerVK::RecordScopeStart(
+    const vk::CommandBuffer& buffer,
+    GPUProbe& probe,
+    std::string_view label,
+    std::optional<size_t> parent) {
+  if (!enabled_ || !probe.index_.has_value()) {
+    return std::nullopt;
+  }
+  Lock lock(trace_state_mutex_);
+  GPUTraceState& state = trace_states_[probe.index_.value()];
+
+  // Leave room for the start and end of this scope, the ends of all scopes
+  // that are still open and the end of the cmd buffer.
+  if (state.current_index + state.open_scopes + 3 > kPoolSize) {
+    return std::nullopt;
+  }
+
+  // Both ends of a scope are written at the bottom of the pipe so that the
+  // scope measures the time until its commands have completed instead of
+  // overlapping with the commands recorded before it.
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
+                        state.query_pool.get(), state.current_index);
+  state.scopes.push_back(GPUTimingScope{
+      .label = std::string(label),
+      .parent = parent,
+      .start_query = static_cast<uint32_t>(state.current_index),
+  });
+  state.current_index += 1;
+  state.open_scopes += 1;
+  return state.scopes.size() - 1;
+}
+
+void GPUTracerVK::RecordScopeEnd(const vk::CommandBuffer& buffer,
+                                 GPUProbe& probe,
+                                 size_t scope) {
+  if (!enabled_ || !probe.index_.has_value()) {
+    return;
+  }
+  Lock lock(trace_state_mutex_);
+  GPUTraceState& state = trace_states_[probe.index_.value()];
+
+  if (scope >= state.scopes.size() ||
+      state.scopes[scope].end_query.has_value()) {
+    return;
+  }
+  // The query was reserved when the scope started, unless the frame state
+  // was reset in the meantime.
+  if (state.current_index + 1 >= kPoolSize) {
+    return;
+  }
+
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
+                        state.query_pool.get(), state.current_index);
+  state.scopes[scope].end_query = static_cast<uint32_t>(state.current_index);
+  state.current_index += 1;
+  state.open_scopes -= 1;
+}
+
 void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   if (!enabled_) {
     return;
@@ -169,6 +243,7 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   size_t pending = 0;
   size_t query_count = 0;
   vk::QueryPool pool;
+  std::vector<GPUTimingScope> scopes;
   {
     Lock lock(trace_state_mutex_);
     GPUTraceState& state = trace_states_[frame_index];
@@ -178,6 +253,10 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
     pending = state.pending_buffers;
     query_count = state.current_index;
     pool = state.query_pool.get();
+    if (pending == 0) {
+      scopes = std::move(state.scopes);
+      state.scopes.clear();
+    }
   }
 
   if (pending == 0) {
@@ -211,6 +290,51 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
       FML_TRACE_COUNTER("flutter", "GPUTracer",
                         reinterpret_cast<int64_t>(this),  // Trace Counter ID
                         "FrameTimeMS", gpu_ms);
+      Context::GPUFrameTimeCallback frame_time_callback;
+      {
+        Lock lock(trace_state_mutex_);
+        frame_time_callback = frame_time_callback_;
+      }
+      if (frame_time_callback) {
+        frame_time_callback(fml::TimeDelta::FromMillisecondsF(gpu_ms));
+      }
+
+      std::map<std::string, double> scope_timings;
+      // Parents are always recorded before their children.
+      std::vector<std::string> paths(scopes.size());
+      for (auto i = 0u; i < scopes.size(); i++) {
+        const GPUTimingScope& scope = scopes[i];
+        paths[i] = scope.parent.has_value()
+                       ? paths[scope.parent.value()] + "/" + scope.label
+                       : scope.label;
+        if (!scope.end_query.has_value()) {
+          continue;
+        }
+        uint64_t start = bits[scope.start_query];
+        uint64_t end = bits[scope.end_query.value()];
+        if (end < start) {
+          continue;
+        }
+        scope_timings[paths[i]] +=
+            ((end - start) * timestamp_period_) / 1000000;
+      }
+#if FLUTTER_TIMELINE_ENABLED
+      if (!scope_timings.empty()) {
+        std::vector<const char*> names;
+        std::vector<std::string> values;
+        for (const auto& [path, ms] : scope_timings) {
+          names.push_back(path.c_str());
+          values.push_back(std::to_string(ms));
+        }
+        fml::tracing::TraceTimelineEvent(
+            "flutter", "GPUTimingScopes",
+            reinterpret_cast<int64_t>(this),  // Trace Counter ID
+            /*flow_id_count=*/0, /*flow_ids=*/nullptr,
+            Dart_Timeline_Event_Counter, names, values);
+      }
+#endif  // FLUTTER_TIMELINE_ENABLED
+      Lock lock(trace_state_mutex_);
+      last_frame_scope_timings_ = std::move(scope_timings);
     }
 
     // Record this query to be reset the next time a command is recorded.
@@ -249,4 +373,30 @@ void GPUProbe::RecordCmdBufferEnd(const vk::CommandBuffer& buffer) {
   tracer->RecordCmdBufferEnd(buffer, *this);
 }
 
+std::optional<size_t> GPUProbe::RecordScopeStart(
+    const vk::CommandBuffer& buffer,
+    std::string_view label,
+    std::optional<size_t> parent) {
+  if (!index_.has_value()) {
+    return std::nullopt;
+  }
+  auto tracer = tracer_.lock();
+  if (!tracer) {
+    return std::nullopt;
+  }
+  return tracer->RecordScopeStart(buffer, *this, label, parent);
+}
+
+void GPUProbe::RecordScopeEnd(const vk::CommandBuffer& buffer, size_t scope) {
+  auto tracer = tracer_.lock();
+  if (!tracer) {
+    return;
+  }
+  tracer->RecordScopeEnd(buffer, *this, scope);
+}
+
+bool GPUProbe::IsRecording() const {
+  return index_.has_value();
+}
+
 }  // namespace impeller
@@ -5,8 +5,13 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_GPU_TRACER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_GPU_TRACER_VK_H_
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
@@ -19,6 +24,11 @@ class GPUProbe;
 /// @brief A class that uses timestamp queries to record the approximate GPU
 /// execution time.
 ///
+/// Besides the time of the whole frame, the time spent in nested timing scopes
+/// (see |CommandEncoderVK::PushGPUTimingScope|) is aggregated per frame and
+/// reported as a "GPUTimingScopes" trace counter. Only the whole frame time
+/// reaches the FrameTiming API, through |SetFrameTimeCallback|.
+///
 /// To enable, add the following metadata to the application's Android manifest:
 ///   <meta-data
 ///       android:name="io.flutter.embedding.android.EnableVulkanGPUTracing"
@@ -45,6 +55,18 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   // visible for testing.
   bool IsEnabled() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The GPU time in milliseconds spent in each timing scope of the
+  ///             last frame whose command buffers have all completed.
+  ///
+  ///             Scopes are keyed by the labels of the scope and its parents
+  ///             joined with "/". Scopes with the same key are summed.
+  ///
+  std::map<std::string, double> GetLastFrameScopeTimings() const;
+
+  /// @brief Set the callback that receives the GPU time of each frame.
+  void SetFrameTimeCallback(Context::GPUFrameTimeCallback callback);
+
   /// Initialize the set of query pools.
   void InitializeQueryPool(const ContextVK& context);
 
@@ -66,12 +88,37 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   ///        time.
   void RecordCmdBufferEnd(const vk::CommandBuffer& buffer, GPUProbe& probe);
 
+  /// @brief Record a timestamp query for the start of a timing scope.
+  ///
+  /// @return The scope to pass to [RecordScopeEnd], or std::nullopt if the
+  ///         scope is not being recorded.
+  std::optional<size_t> RecordScopeStart(const vk::CommandBuffer& buffer,
+                                         GPUProbe& probe,
+                                         std::string_view label,
+                                         std::optional<size_t> parent);
+
+  /// @brief Record a timestamp query for the end of a timing scope.
+  void RecordScopeEnd(const vk::CommandBuffer& buffer,
+                      GPUProbe& probe,
+                      size_t scope);
+
   std::weak_ptr<ContextVK> context_;
 
+  struct GPUTimingScope {
+    std::string label;
+    std::optional<size_t> parent;
+    uint32_t start_query = 0u;
+    std::optional<uint32_t> end_query;
+  };
+
   struct GPUTraceState {
     size_t current_index = 0;
     size_t pending_buffers = 0;
+    // Scopes whose end has not been written yet. A query is reserved for the
+    // end of each of them.
+    size_t open_scopes = 0;
     vk::UniqueQueryPool query_pool;
+    std::vector<GPUTimingScope> scopes;
   };
 
   mutable Mutex trace_state_mutex_;
@@ -79,6 +126,10 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
       trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
   std::vector<size_t> IPLR_GUARDED_BY(trace_state_mutex_) states_to_reset_ = {};
+  std::map<std::string, double> last_frame_scope_timings_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
+  Context::GPUFrameTimeCallback frame_time_callback_ IPLR_GUARDED_BY(
+      trace_state_mutex_);
 
   // The number of nanoseconds for each timestamp unit.
   float timestamp_period_ = 1;
@@ -115,6 +166,21 @@ class GPUProbe {
   ///        time.
   void RecordCmdBufferEnd(const vk::CommandBuffer& buffer);
 
+  /// @brief Record the start of a timing scope nested in the parent scope.
+  ///
+  /// @return The scope to pass to [RecordScopeEnd], or std::nullopt if the
+  ///         scope is not being recorded.
+  std::optional<size_t> RecordScopeStart(const vk::CommandBuffer& buffer,
+                                         std::string_view label,
+                                         std::optional<size_t> parent);
+
+  /// @brief Record the end of a timing scope.
+  void RecordScopeEnd(const vk::CommandBuffer& buffer, size_t scope);
+
+  /// @brief Whether the command buffer is traced as part of a frame, so that
+  ///        timing scopes are recorded.
+  bool IsRecording() const;
+
  private:
   friend class GPUTracerVK;
 
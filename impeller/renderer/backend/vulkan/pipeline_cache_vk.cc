@@ -6,6 +6,7 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstdlib>
 #include <sstream>
 
 #include "flutter/fml/mapping.h"
@@ -16,6 +17,10 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+// One "<hex variant key> <pipeline label>" entry per line.
+static constexpr const char* kPipelineVariantsFileName =
+    "flutter.impeller.vkvariants";
+
 static bool VerifyExistingCache(const fml::Mapping& mapping,
                                 const CapabilitiesVK& caps) {
   return true;
@@ -98,6 +103,8 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
   }
 
   is_valid_ = !!cache_;
+
+  LoadPipelineVariants();
 }
 
 PipelineCacheVK::~PipelineCacheVK() {
@@ -185,6 +192,77 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not persist pipeline cache to disk.";
     return;
   }
+  PersistPipelineVariants();
+}
+
+bool PipelineCacheVK::AddPipelineVariant(const std::string& pipeline_label,
+                                         uint64_t variant_key) {
+  Lock lock(variants_mutex_);
+  return variants_[pipeline_label].insert(variant_key).second;
+}
+
+std::vector<uint64_t> PipelineCacheVK::GetPipelineVariants(
+    const std::string& pipeline_label) const {
+  Lock lock(variants_mutex_);
+  auto found = variants_.find(pipeline_label);
+  if (found == variants_.end()) {
+    return {};
+  }
+  return {found->second.begin(), found->second.end()};
+}
+
+void PipelineCacheVK::LoadPipelineVariants() {
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_directory_,
+                                                  kPipelineVariantsFileName);
+  if (!mapping || mapping->GetSize() == 0u) {
+    return;
+  }
+  const std::string contents(
+      reinterpret_cast<const char*>(mapping->GetMapping()),
+      mapping->GetSize());
+  std::istringstream stream(contents);
+  std::string line;
+  Lock lock(variants_mutex_);
+  while (std::getline(stream, line)) {
+    const size_t separator = line.find(' ');
+    if (separator == std::string::npos || separator == 0u ||
+        separator + 1 == line.size()) {
+      continue;
+    }
+    const std::string key_string = line.substr(0u, separator);
+    char* key_end = nullptr;
+    const uint64_t key = std::strtoull(key_string.c_str(), &key_end, 16);
+    if (key_end != key_string.c_str() + key_string.size()) {
+      continue;
+    }
+    variants_[line.substr(separator + 1)].insert(key);
+  }
+}
+
+void PipelineCacheVK::PersistPipelineVariants() const {
+  std::ostringstream stream;
+  {
+    Lock lock(variants_mutex_);
+    if (variants_.empty()) {
+      return;
+    }
+    stream << std::hex;
+    for (const auto& [label, keys] : variants_) {
+      for (uint64_t key : keys) {
+        stream << key << " " << label << "\n";
+      }
+    }
+  }
+  const std::string data = stream.str();
+  fml::NonOwnedMapping mapping(reinterpret_cast<const uint8_t*>(data.data()),
+                               data.size());
+  if (!fml::WriteAtomically(cache_directory_, kPipelineVariantsFileName,
+                            mapping)) {
+    VALIDATION_LOG << "Could not persist pipeline variants to disk.";
+  }
 }
 
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
@@ -5,7 +5,14 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "flutter/fml/file.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
 
@@ -33,12 +40,35 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Add a pipeline variant to the set persisted along with the
+  ///             pipeline cache.
+  ///
+  /// @return     If the variant was not recorded before.
+  ///
+  bool AddPipelineVariant(const std::string& pipeline_label,
+                          uint64_t variant_key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The recorded variants of the pipeline with the given label,
+  ///             including those loaded from disk.
+  ///
+  std::vector<uint64_t> GetPipelineVariants(
+      const std::string& pipeline_label) const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
   const fml::UniqueFD cache_directory_;
   vk::UniquePipelineCache cache_;
   bool is_valid_ = false;
+  mutable Mutex variants_mutex_;
+  std::map<std::string, std::set<uint64_t>> variants_
+      IPLR_GUARDED_BY(variants_mutex_);
+
+  void LoadPipelineVariants();
+
+  void PersistPipelineVariants() const;
 
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
 
@@ -270,6 +270,20 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+// |PipelineLibrary|
+void PipelineLibraryVK::RecordPipelineVariant(const std::string& pipeline_label,
+                                              uint64_t variant_key) {
+  if (pso_cache_->AddPipelineVariant(pipeline_label, variant_key)) {
+    cache_dirty_ = true;
+  }
+}
+
+// |PipelineLibrary|
+std::vector<uint64_t> PipelineLibraryVK::GetRecordedPipelineVariants(
+    const std::string& pipeline_label) const {
+  return pso_cache_->GetPipelineVariants(pipeline_label);
+}
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
     if (cache_dirty_) {
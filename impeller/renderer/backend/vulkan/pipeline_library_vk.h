@@ -71,6 +71,14 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
+  // |PipelineLibrary|
+  void RecordPipelineVariant(const std::string& pipeline_label,
+                             uint64_t variant_key) override;
+
+  // |PipelineLibrary|
+  std::vector<uint64_t> GetRecordedPipelineVariants(
+      const std::string& pipeline_label) const override;
+
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc);
 
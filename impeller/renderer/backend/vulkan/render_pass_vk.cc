@@ -89,6 +89,9 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
   barrier.dst_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
                       vk::PipelineStageFlagBits::eTransfer;
 
+  // Transition all attachments with a single pipeline barrier.
+  BarrierBatchVK barriers(barrier.cmd_buffer);
+
   RenderPassBuilderVK builder;
 
   for (const auto& [bind_point, color] : render_target_.GetColorAttachments()) {
@@ -99,11 +102,12 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         color.load_action,                                   //
         color.store_action                                   //
     );
-    TextureVK::Cast(*color.texture).SetLayout(barrier);
+    TextureVK::Cast(*color.texture).SetLayout(barrier, barriers);
     if (color.resolve_texture) {
-      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier);
+      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier, barriers);
     }
   }
+  barriers.Flush();
 
   if (auto depth = render_target_.GetDepthAttachment(); depth.has_value()) {
     builder.SetDepthStencilAttachment(
@@ -334,6 +338,21 @@ void RenderPassVK::SetCommandLabel(std::string_view label) {
 #endif  // IMPELLER_DEBUG
 }
 
+// |RenderPass|
+void RenderPassVK::PushGPUTimingScope(std::string_view label) {
+  command_buffer_->GetEncoder()->PushGPUTimingScope(label);
+}
+
+// |RenderPass|
+void RenderPassVK::PopGPUTimingScope() {
+  command_buffer_->GetEncoder()->PopGPUTimingScope();
+}
+
+// |RenderPass|
+bool RenderPassVK::IsRecordingGPUTimingScopes() const {
+  return command_buffer_->GetEncoder()->IsRecordingGPUTimingScopes();
+}
+
 // |RenderPass|
 void RenderPassVK::SetStencilReference(uint32_t value) {
   command_buffer_vk_.setStencilReference(
@@ -461,34 +480,36 @@ fml::Status RenderPassVK::Draw() {
   const auto& pipeline_vk = PipelineVK::Cast(*pipeline_);
 
   auto descriptor_result =
-      command_buffer_->GetEncoder()->AllocateDescriptorSets(
-          pipeline_vk.GetDescriptorSetLayout(), context_vk);
+      command_buffer_->GetEncoder()->GetOrCreateDescriptorSet(
+          pipeline_vk.GetDescriptorSetLayout(), write_workspace_.data(),
+          descriptor_write_offset_, context_vk);
   if (!descriptor_result.ok()) {
     return fml::Status(fml::StatusCode::kAborted,
                        "Could not allocate descriptor sets.");
   }
   const auto descriptor_set = descriptor_result.value();
   const auto pipeline_layout = pipeline_vk.GetPipelineLayout();
-  command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                  pipeline_vk.GetPipeline());
-
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set;
+  if (bound_pipeline_ != pipeline_vk.GetPipeline()) {
+    bound_pipeline_ = pipeline_vk.GetPipeline();
+    // Pipelines with different layouts disturb the bound descriptor sets.
+    bound_descriptor_set_ = vk::DescriptorSet{};
+    command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                    bound_pipeline_);
+  }
+
+  if (bound_descriptor_set_ != descriptor_set) {
+    bound_descriptor_set_ = descriptor_set;
+    command_buffer_vk_.bindDescriptorSets(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        pipeline_layout,                   // layout
+        0,                                 // first set
+        1,                                 // set count
+        &descriptor_set,                   // sets
+        0,                                 // offset count
+        nullptr                            // offsets
+    );
   }
 
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
-
-  command_buffer_vk_.bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_layout,                   // layout
-      0,                                 // first set
-      1,                                 // set count
-      &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
-  );
-
   if (pipeline_uses_input_attachments_) {
     InsertBarrierForInputAttachmentRead(
         command_buffer_vk_, TextureVK::Cast(*color_image_vk_).GetImage());
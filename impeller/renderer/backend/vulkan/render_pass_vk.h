@@ -53,6 +53,10 @@ class RenderPassVK final : public RenderPass {
   bool pipeline_uses_input_attachments_ = false;
   std::shared_ptr<SamplerVK> immutable_sampler_;
 
+  // Per-pass state, used to skip redundant binds between commands.
+  vk::Pipeline bound_pipeline_;
+  vk::DescriptorSet bound_descriptor_set_;
+
   RenderPassVK(const std::shared_ptr<const Context>& context,
                const RenderTarget& target,
                std::shared_ptr<CommandBufferVK> command_buffer);
@@ -64,6 +68,15 @@ class RenderPassVK final : public RenderPass {
   // |RenderPass|
   void SetCommandLabel(std::string_view label) override;
 
+  // |RenderPass|
+  void PushGPUTimingScope(std::string_view label) override;
+
+  // |RenderPass|
+  void PopGPUTimingScope() override;
+
+  // |RenderPass|
+  bool IsRecordingGPUTimingScopes() const override;
+
   // |RenderPass|
   void SetStencilReference(uint32_t value) override;
 
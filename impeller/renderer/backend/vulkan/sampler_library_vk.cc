@@ -20,6 +20,7 @@ static const std::unique_ptr<const Sampler> kNullSampler = nullptr;
 
 const std::unique_ptr<const Sampler>& SamplerLibraryVK::GetSampler(
     SamplerDescriptor desc) {
+  Lock lock(samplers_mutex_);
   auto found = samplers_.find(desc);
   if (found != samplers_.end()) {
     return found->second;
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 
 #include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain/khr/khr_swapchain_vk.h"
@@ -88,6 +89,7 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
   }
   parent_->GetCommandPoolRecycler()->Dispose();
   parent_->GetResourceAllocator()->DebugTraceMemoryStatistics();
+  TraceBarriersPerFrameVK();
   return surface;
 }
 
@@ -7,6 +7,7 @@
 #include "fml/synchronization/count_down_latch.h"
 #include "gtest/gtest.h"
 #include "impeller/renderer//backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -80,6 +81,87 @@ TEST(GPUTracerVK, CanTraceCmdBuffer) {
                         "vkGetQueryPoolResults") != called->end());
 }
 
+TEST(GPUTracerVK, AggregatesNestedTimingScopes) {
+  auto const context =
+      MockVulkanContextBuilder()
+          .SetSettingsCallback([](ContextVK::Settings& settings) {
+            settings.enable_gpu_tracing = true;
+          })
+          .Build();
+  auto tracer = context->GetGPUTracer();
+
+  ASSERT_TRUE(tracer->IsEnabled());
+  tracer->MarkFrameStart();
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto& encoder = *CommandBufferVK::Cast(*cmd_buffer).GetEncoder();
+  EXPECT_TRUE(encoder.IsRecordingGPUTimingScopes());
+  encoder.PushGPUTimingScope("EntityPass");
+  for (int i = 0; i < 2; i++) {
+    encoder.PushGPUTimingScope("TextContents");
+    encoder.PopGPUTimingScope();
+  }
+  encoder.PopGPUTimingScope();
+  encoder.PushGPUTimingScope("Unclosed");
+
+  auto latch = std::make_shared<fml::CountDownLatch>(1u);
+  if (!context->GetCommandQueue()
+           ->Submit(
+               {cmd_buffer},
+               [latch](CommandBuffer::Status status) { latch->CountDown(); })
+           .ok()) {
+    GTEST_FAIL() << "Failed to submit cmd buffer";
+  }
+
+  tracer->MarkFrameEnd();
+  latch->Wait();
+
+  std::map<std::string, double> timings = tracer->GetLastFrameScopeTimings();
+  EXPECT_EQ(timings.size(), 2u);
+  EXPECT_TRUE(timings.find("EntityPass") != timings.end());
+  EXPECT_TRUE(timings.find("EntityPass/TextContents") != timings.end());
+}
+
+TEST(GPUTracerVK, ReservesQueriesForTheEndsOfOpenScopes) {
+  auto const context =
+      MockVulkanContextBuilder()
+          .SetSettingsCallback([](ContextVK::Settings& settings) {
+            settings.enable_gpu_tracing = true;
+          })
+          .Build();
+  auto tracer = context->GetGPUTracer();
+
+  ASSERT_TRUE(tracer->IsEnabled());
+  tracer->MarkFrameStart();
+
+  // Nest more scopes than the query pool of 1024 timestamps can hold.
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto& encoder = *CommandBufferVK::Cast(*cmd_buffer).GetEncoder();
+  for (int i = 0; i < 1024; i++) {
+    encoder.PushGPUTimingScope("Scope");
+  }
+  for (int i = 0; i < 1024; i++) {
+    encoder.PopGPUTimingScope();
+  }
+
+  auto latch = std::make_shared<fml::CountDownLatch>(1u);
+  if (!context->GetCommandQueue()
+           ->Submit(
+               {cmd_buffer},
+               [latch](CommandBuffer::Status status) { latch->CountDown(); })
+           .ok()) {
+    GTEST_FAIL() << "Failed to submit cmd buffer";
+  }
+
+  tracer->MarkFrameEnd();
+  latch->Wait();
+
+  // The start and end of the cmd buffer take one query each. Every scope that
+  // was started takes two, and all of them could be ended.
+  std::map<std::string, double> timings = tracer->GetLastFrameScopeTimings();
+  EXPECT_EQ(timings.size(), (1024u - 2u) / 2u);
+}
+
 TEST(GPUTracerVK, DoesNotTraceOutsideOfFrameWorkload) {
   auto const context =
       MockVulkanContextBuilder()
@@ -92,6 +174,9 @@ TEST(GPUTracerVK, DoesNotTraceOutsideOfFrameWorkload) {
   ASSERT_TRUE(tracer->IsEnabled());
 
   auto cmd_buffer = context->CreateCommandBuffer();
+  EXPECT_FALSE(CommandBufferVK::Cast(*cmd_buffer)
+                   .GetEncoder()
+                   ->IsRecordingGPUTimingScopes());
   auto blit_pass = cmd_buffer->CreateBlitPass();
   blit_pass->EncodeCommands(context->GetResourceAllocator());
 
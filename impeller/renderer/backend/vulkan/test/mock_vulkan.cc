@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -286,7 +287,10 @@ VkResult vkCreateImage(VkDevice device,
                        const VkImageCreateInfo* pCreateInfo,
                        const VkAllocationCallbacks* pAllocator,
                        VkImage* pImage) {
-  *pImage = reinterpret_cast<VkImage>(0xD0D0CACA);
+  // Hand out distinct handles so that barriers on different images can be
+  // told apart.
+  static std::atomic<uint64_t> next_image = 0xD0D0CACA;
+  *pImage = reinterpret_cast<VkImage>(next_image.fetch_add(1u));
   return VK_SUCCESS;
 }
 
@@ -461,6 +465,21 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+void vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                          VkPipelineStageFlags srcStageMask,
+                          VkPipelineStageFlags dstStageMask,
+                          VkDependencyFlags dependencyFlags,
+                          uint32_t memoryBarrierCount,
+                          const VkMemoryBarrier* pMemoryBarriers,
+                          uint32_t bufferMemoryBarrierCount,
+                          const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+                          uint32_t imageMemoryBarrierCount,
+                          const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+}
+
 void vkFreeCommandBuffers(VkDevice device,
                           VkCommandPool commandPool,
                           uint32_t commandBufferCount,
@@ -617,6 +636,15 @@ VkResult vkAllocateDescriptorSets(
   return VK_SUCCESS;
 }
 
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkUpdateDescriptorSets");
+}
+
 VkResult vkGetPhysicalDeviceSurfaceFormatsKHR(
     VkPhysicalDevice physicalDevice,
     VkSurfaceKHR surface,
@@ -823,6 +851,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyCommandPool;
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
@@ -859,6 +889,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkResetDescriptorPool;
   } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceFormatsKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceSurfaceFormatsKHR;
   } else if (strcmp("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", pName) == 0) {
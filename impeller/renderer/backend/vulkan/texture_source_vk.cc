@@ -32,8 +32,17 @@ vk::ImageLayout TextureSourceVK::SetLayoutWithoutEncoding(
 }
 
 fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
+  BarrierBatchVK batch(barrier.cmd_buffer);
+  auto status = SetLayout(barrier, batch);
+  batch.Flush();
+  return status;
+}
+
+fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier,
+                                       BarrierBatchVK& batch) const {
   const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
   if (barrier.new_layout == old_layout) {
+    batch.AddElidedBarrier();
     return {};
   }
 
@@ -51,13 +60,7 @@ fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
   image_barrier.subresourceRange.baseArrayLayer = 0u;
   image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc_.type);
 
-  barrier.cmd_buffer.pipelineBarrier(barrier.src_stage,  // src stage
-                                     barrier.dst_stage,  // dst stage
-                                     {},                 // dependency flags
-                                     nullptr,            // memory barriers
-                                     nullptr,            // buffer barriers
-                                     image_barrier       // image barriers
-  );
+  batch.AddImageBarrier(image_barrier, barrier.src_stage, barrier.dst_stage);
 
   return {};
 }
@@ -85,6 +85,21 @@ class TextureSourceVK {
   ///
   fml::Status SetLayout(const BarrierVK& barrier) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the layout transition `barrier` to `batch` instead of
+  ///             encoding it immediately. `barrier.cmd_buffer` is ignored.
+  ///
+  ///             No barrier is added if the image is already in
+  ///             `barrier.new_layout`.
+  ///
+  /// @param[in]  barrier  The barrier.
+  /// @param[in]  batch    The batch encoded before the commands that depend
+  ///                      on the new layout.
+  ///
+  /// @return     If the layout transition was successfully added.
+  ///
+  fml::Status SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Store the layout of the image.
   ///
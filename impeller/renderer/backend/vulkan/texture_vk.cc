@@ -160,6 +160,11 @@ bool TextureVK::SetLayout(const BarrierVK& barrier) const {
   return source_ ? source_->SetLayout(barrier).ok() : false;
 }
 
+bool TextureVK::SetLayout(const BarrierVK& barrier,
+                          BarrierBatchVK& batch) const {
+  return source_ ? source_->SetLayout(barrier, batch).ok() : false;
+}
+
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
   return source_ ? source_->SetLayoutWithoutEncoding(layout)
@@ -46,6 +46,11 @@ struct Resource {
     return dynamic_metadata_ ? dynamic_metadata_.get() : metadata_;
   }
 
+  /// @brief Whether the metadata was generated at runtime. Unlike metadata
+  ///        generated by ImpellerC, its address is not stable and must not be
+  ///        used as a cache key.
+  bool HasDynamicMetadata() const { return dynamic_metadata_ != nullptr; }
+
  private:
   // Static shader metadata (typically generated by ImpellerC).
   const ShaderMetadata* metadata_ = nullptr;
@@ -0,0 +1,309 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/compute_path_rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "impeller/base/validation.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/formats.h"
+#include "impeller/core/platform.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
+#include "impeller/renderer/path_coverage.comp.h"
+#include "impeller/renderer/pipeline_library.h"
+
+namespace impeller {
+
+using CS = PathCoverageComputeShader;
+
+ComputePathRasterizer::ComputePathRasterizer(const Context& context) {
+  if (!context.GetCapabilities()->SupportsCompute()) {
+    return;
+  }
+  auto pipeline_desc =
+      ComputePipelineBuilder<CS>::MakeDefaultPipelineDescriptor(context);
+  if (!pipeline_desc.has_value()) {
+    return;
+  }
+  pipeline_desc->SetLabel("Path Coverage Pipeline");
+  pipeline_ = context.GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+}
+
+ComputePathRasterizer::~ComputePathRasterizer() = default;
+
+bool ComputePathRasterizer::IsValid() const {
+  return pipeline_ != nullptr;
+}
+
+ComputePathRasterizer::Bins ComputePathRasterizer::BinPath(
+    const Path& path,
+    const Matrix& transform) {
+  Bins bins;
+  auto polyline = path.CreatePolyline(transform.GetMaxBasisLengthXY());
+  if (polyline.points->empty()) {
+    return bins;
+  }
+
+  Point min(std::numeric_limits<Scalar>::max(),
+            std::numeric_limits<Scalar>::max());
+  Point max(std::numeric_limits<Scalar>::lowest(),
+            std::numeric_limits<Scalar>::lowest());
+  for (Point& point : *polyline.points) {
+    point = transform * point;
+    min = min.Min(point);
+    max = max.Max(point);
+  }
+  bins.origin = IPoint(std::floor(min.x), std::floor(min.y));
+  const int64_t width = static_cast<int64_t>(std::ceil(max.x)) - bins.origin.x;
+  const int64_t height =
+      static_cast<int64_t>(std::ceil(max.y)) - bins.origin.y;
+  if (width <= 0 || height <= 0) {
+    return bins;
+  }
+  // Each invocation of the compute shader writes four pixels.
+  bins.size = ISize((width + 3) / 4 * 4, height);
+  bins.tiles_x = (bins.size.width + kTileSize - 1) / kTileSize;
+  bins.tiles_y = (bins.size.height + kTileSize - 1) / kTileSize;
+  bins.backdrops.resize(bins.size.height * bins.tiles_x, 0.0f);
+
+  // Fills are implicitly closed, so every contour ends with a segment back to
+  // its start.
+  const Point offset(bins.origin.x, bins.origin.y);
+  for (auto i = 0u; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    for (auto j = start; j < end; j++) {
+      Point a = polyline.GetPoint(j) - offset;
+      Point b = polyline.GetPoint(j + 1 < end ? j + 1 : start) - offset;
+      // Horizontal segments have no area to the right of them.
+      if (a.y != b.y) {
+        bins.segments.emplace_back(a.x, a.y, b.x, b.y);
+      }
+    }
+  }
+
+  std::vector<std::vector<uint32_t>> tiles(bins.tiles_x * bins.tiles_y);
+  const int64_t last_tile_x = bins.tiles_x - 1;
+  const int64_t last_tile_y = bins.tiles_y - 1;
+  for (auto i = 0u; i < bins.segments.size(); i++) {
+    const Vector4& segment = bins.segments[i];
+    const Scalar x_min = std::min(segment.x, segment.z);
+    const Scalar x_max = std::max(segment.x, segment.z);
+    const Scalar y_min = std::min(segment.y, segment.w);
+    const Scalar y_max = std::max(segment.y, segment.w);
+    const Scalar direction = segment.w > segment.y ? 1.0f : -1.0f;
+
+    // The tiles whose columns the segment overlaps need to evaluate it per
+    // pixel.
+    const int64_t tile_x0 =
+        std::clamp<int64_t>(std::floor(x_min / kTileSize), 0, last_tile_x);
+    const int64_t tile_x1 = std::clamp<int64_t>(
+        std::ceil(x_max / kTileSize) - 1, tile_x0, last_tile_x);
+    const int64_t tile_y0 =
+        std::clamp<int64_t>(std::floor(y_min / kTileSize), 0, last_tile_y);
+    const int64_t tile_y1 = std::clamp<int64_t>(
+        std::ceil(y_max / kTileSize) - 1, tile_y0, last_tile_y);
+    for (auto ty = tile_y0; ty <= tile_y1; ty++) {
+      for (auto tx = tile_x0; tx <= tile_x1; tx++) {
+        tiles[ty * bins.tiles_x + tx].push_back(i);
+      }
+    }
+
+    // Tiles further right see the segment as a full crossing of each row.
+    // Record it in the column after the last overlapped tile and accumulate
+    // the backdrops across each row below.
+    if (tile_x1 == last_tile_x) {
+      continue;
+    }
+    const int64_t row0 = std::max<int64_t>(std::floor(y_min), 0);
+    const int64_t row1 =
+        std::min<int64_t>(std::ceil(y_max), bins.size.height);
+    for (auto row = row0; row < row1; row++) {
+      const Scalar dy = std::min<Scalar>(y_max, row + 1) -
+                        std::max<Scalar>(y_min, row);
+      if (dy > 0) {
+        bins.backdrops[row * bins.tiles_x + tile_x1 + 1] += direction * dy;
+      }
+    }
+  }
+
+  for (auto row = 0; row < bins.size.height; row++) {
+    for (auto tx = 1u; tx < bins.tiles_x; tx++) {
+      bins.backdrops[row * bins.tiles_x + tx] +=
+          bins.backdrops[row * bins.tiles_x + tx - 1];
+    }
+  }
+
+  bins.tile_ranges.reserve(tiles.size() * 2);
+  for (const auto& tile : tiles) {
+    bins.tile_ranges.push_back(bins.tile_segments.size());
+    bins.tile_ranges.push_back(tile.size());
+    bins.tile_segments.insert(bins.tile_segments.end(), tile.begin(),
+                              tile.end());
+  }
+  return bins;
+}
+
+// The integral of clamp(u, 0, 1). Matches path_coverage.comp.
+static Scalar IntegrateClamped(Scalar u) {
+  if (u <= 0) {
+    return 0;
+  }
+  if (u < 1) {
+    return 0.5f * u * u;
+  }
+  return u - 0.5f;
+}
+
+// The signed area of the pixel to the right of the segment. Matches
+// path_coverage.comp.
+static Scalar SegmentArea(const Vector4& segment, Scalar px, Scalar py) {
+  Point a(segment.x, segment.y);
+  Point b(segment.z, segment.w);
+  Scalar direction = 1;
+  if (a.y > b.y) {
+    std::swap(a, b);
+    direction = -1;
+  }
+  const Scalar y_lo = std::max(a.y, py);
+  const Scalar y_hi = std::min(b.y, py + 1);
+  if (y_lo >= y_hi) {
+    return 0;
+  }
+  const Scalar dxdy = (b.x - a.x) / (b.y - a.y);
+  const Scalar x_lo = a.x + (y_lo - a.y) * dxdy;
+  const Scalar x_hi = a.x + (y_hi - a.y) * dxdy;
+
+  Scalar fraction;
+  if (std::abs(x_hi - x_lo) < 1e-6f) {
+    fraction = std::clamp<Scalar>(px + 1 - x_lo, 0, 1);
+  } else {
+    fraction = (IntegrateClamped(px + 1 - x_lo) -
+                IntegrateClamped(px + 1 - x_hi)) /
+               (x_hi - x_lo);
+  }
+  return direction * (y_hi - y_lo) * fraction;
+}
+
+std::vector<uint8_t> ComputePathRasterizer::ComputeCoverage(
+    const Bins& bins,
+    FillType fill_type) {
+  std::vector<uint8_t> coverage(bins.size.Area(), 0u);
+  for (auto y = 0; y < bins.size.height; y++) {
+    for (auto x = 0; x < bins.size.width; x++) {
+      const uint32_t tile_x = x / kTileSize;
+      const uint32_t tile = (y / kTileSize) * bins.tiles_x + tile_x;
+      Scalar winding = bins.backdrops[y * bins.tiles_x + tile_x];
+      const uint32_t offset = bins.tile_ranges[tile * 2];
+      const uint32_t count = bins.tile_ranges[tile * 2 + 1];
+      for (auto i = 0u; i < count; i++) {
+        winding += SegmentArea(bins.segments[bins.tile_segments[offset + i]],
+                               x, y);
+      }
+      Scalar alpha = std::abs(winding);
+      if (fill_type == FillType::kOdd) {
+        alpha = std::fmod(alpha, 2.0f);
+        alpha = std::min(alpha, 2 - alpha);
+      }
+      coverage[y * bins.size.width + x] =
+          std::round(std::clamp<Scalar>(alpha, 0, 1) * 255);
+    }
+  }
+  return coverage;
+}
+
+std::optional<ComputePathRasterizer::Mask> ComputePathRasterizer::Rasterize(
+    const Context& context,
+    CommandBuffer& command_buffer,
+    HostBuffer& host_buffer,
+    const Path& path,
+    const Matrix& transform) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  Bins bins = BinPath(path, transform);
+  if (bins.size.IsEmpty() || bins.segments.empty()) {
+    return std::nullopt;
+  }
+
+  const auto& allocator = context.GetResourceAllocator();
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+  buffer_desc.size = bins.size.Area();
+  auto coverage_buffer = allocator->CreateBuffer(buffer_desc);
+
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  texture_desc.format = PixelFormat::kR8UNormInt;
+  texture_desc.size = bins.size;
+  auto texture = allocator->CreateTexture(texture_desc);
+  if (!coverage_buffer || !texture) {
+    VALIDATION_LOG << "Could not allocate the path coverage mask.";
+    return std::nullopt;
+  }
+  texture->SetLabel("Path Coverage Mask");
+
+  auto compute_pass = command_buffer.CreateComputePass();
+  if (!compute_pass) {
+    return std::nullopt;
+  }
+  compute_pass->SetLabel("Path Coverage");
+  compute_pass->SetPipeline(pipeline_);
+
+  CS::Config config;
+  config.width = bins.size.width;
+  config.height = bins.size.height;
+  config.tiles_x = bins.tiles_x;
+  config.fill_type = path.GetFillType() == FillType::kOdd ? 1u : 0u;
+  CS::BindConfig(*compute_pass, host_buffer.EmplaceUniform(config));
+
+  const size_t alignment = DefaultUniformAlignment();
+  CS::BindSegments(
+      *compute_pass,
+      host_buffer.Emplace(bins.segments.data(),
+                          bins.segments.size() * sizeof(Vector4), alignment));
+  CS::BindTileRanges(
+      *compute_pass,
+      host_buffer.Emplace(bins.tile_ranges.data(),
+                          bins.tile_ranges.size() * sizeof(uint32_t),
+                          alignment));
+  // Tiles without segments leave this empty, but empty bindings are invalid.
+  if (bins.tile_segments.empty()) {
+    bins.tile_segments.push_back(0u);
+  }
+  CS::BindTileSegments(
+      *compute_pass,
+      host_buffer.Emplace(bins.tile_segments.data(),
+                          bins.tile_segments.size() * sizeof(uint32_t),
+                          alignment));
+  CS::BindBackdrops(
+      *compute_pass,
+      host_buffer.Emplace(bins.backdrops.data(),
+                          bins.backdrops.size() * sizeof(float), alignment));
+  CS::BindCoverage(*compute_pass,
+                   DeviceBuffer::AsBufferView(coverage_buffer));
+
+  if (!compute_pass->Compute(ISize(bins.size.Area() / 4, 1)).ok() ||
+      !compute_pass->EncodeCommands()) {
+    VALIDATION_LOG << "Could not encode the path coverage compute pass.";
+    return std::nullopt;
+  }
+
+  auto blit_pass = command_buffer.CreateBlitPass();
+  if (!blit_pass ||
+      !blit_pass->AddCopy(DeviceBuffer::AsBufferView(coverage_buffer), texture,
+                          {}, "Path Coverage Copy") ||
+      !blit_pass->EncodeCommands(allocator)) {
+    VALIDATION_LOG << "Could not copy the path coverage into a texture.";
+    return std::nullopt;
+  }
+
+  return Mask{.texture = std::move(texture), .origin = bins.origin};
+}
+
+}  // namespace impeller
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_COMPUTE_PATH_RASTERIZER_H_
+#define FLUTTER_IMPELLER_RENDERER_COMPUTE_PATH_RASTERIZER_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/size.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pipeline_descriptor.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/pipeline.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Rasterizes the fill of a path into a coverage mask using a
+///             compute shader, instead of tessellating it on the CPU.
+///
+///             The path is flattened into line segments, which are binned on
+///             the CPU into 16x16 pixel tiles. The compute shader then
+///             computes the exact area coverage of each pixel from the
+///             segments crossing its tile, plus the winding contributed by the
+///             segments to the left of the tile.
+///
+///             Only available if the context supports compute.
+///             |FillPathGeometry| uses it for paths that need
+///             stencil-then-cover when |ContentContext| enables it.
+///
+class ComputePathRasterizer {
+ public:
+  static constexpr uint32_t kTileSize = 16u;
+
+  /// The flattened segments of a path, binned into tiles.
+  struct Bins {
+    /// The position of the top left corner of the mask in the coordinate space
+    /// of the transformed path.
+    IPoint origin;
+    /// The size of the mask. The width is a multiple of four.
+    ISize size;
+    uint32_t tiles_x = 0u;
+    uint32_t tiles_y = 0u;
+    /// Segments as (x0, y0, x1, y1) relative to the origin.
+    std::vector<Vector4> segments;
+    /// For each tile, the offset and count of its entries in |tile_segments|.
+    std::vector<uint32_t> tile_ranges;
+    std::vector<uint32_t> tile_segments;
+    /// For each row of pixels and tile column, the winding of the segments
+    /// entirely to the left of the tile.
+    std::vector<float> backdrops;
+  };
+
+  struct Mask {
+    /// An R8 texture holding the coverage of the path.
+    std::shared_ptr<Texture> texture;
+    /// The position of the top left corner of the texture in the coordinate
+    /// space of the transformed path.
+    IPoint origin;
+  };
+
+  explicit ComputePathRasterizer(const Context& context);
+
+  ~ComputePathRasterizer();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the rasterization of the fill of a path into a command
+  ///             buffer.
+  ///
+  /// @return     The coverage mask, or std::nullopt if the path covers no
+  ///             pixels or the commands could not be encoded.
+  ///
+  std::optional<Mask> Rasterize(const Context& context,
+                                CommandBuffer& command_buffer,
+                                HostBuffer& host_buffer,
+                                const Path& path,
+                                const Matrix& transform) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Flatten and bin the path. Visible for testing.
+  ///
+  static Bins BinPath(const Path& path, const Matrix& transform);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compute the coverage mask on the CPU, with the same math as
+  ///             the compute shader. Used to check the compute shader against.
+  ///
+  /// @return     One byte of coverage per pixel of the mask.
+  ///
+  static std::vector<uint8_t> ComputeCoverage(const Bins& bins,
+                                              FillType fill_type);
+
+ private:
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>> pipeline_;
+
+  ComputePathRasterizer(const ComputePathRasterizer&) = delete;
+
+  ComputePathRasterizer& operator=(const ComputePathRasterizer&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_COMPUTE_PATH_RASTERIZER_H_
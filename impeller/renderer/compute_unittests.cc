@@ -9,18 +9,108 @@
 #include "impeller/fixtures/sample.comp.h"
 #include "impeller/fixtures/stage1.comp.h"
 #include "impeller/fixtures/stage2.comp.h"
+#include "impeller/geometry/path_builder.h"
 #include "impeller/playground/compute_playground_test.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_path_rasterizer.h"
 #include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/prefix_sum_test.comp.h"
 #include "impeller/renderer/threadgroup_sizing_test.comp.h"
+#include "impeller/tessellator/tessellator_libtess.h"
 
 namespace impeller {
 namespace testing {
 using ComputeTest = ComputePlaygroundTest;
 INSTANTIATE_COMPUTE_SUITE(ComputeTest);
 
+namespace {
+
+// The coverage of the fill of a path as drawn by the CPU tessellation path,
+// sampled at 16x16 points per pixel. The path is flattened with the same
+// tolerance as |FillPathGeometry| uses. Independent of the path rasterizer, so
+// it can serve as a reference for it.
+std::vector<uint8_t> SampleTessellatedCoverage(const Path& path,
+                                               const Matrix& transform,
+                                               IPoint origin,
+                                               ISize size) {
+  constexpr int kSamples = 16;
+  std::vector<Point> triangles;
+  TessellatorLibtess tessellator;
+  auto result = tessellator.Tessellate(
+      path, transform.GetMaxBasisLengthXY(),
+      [&triangles, &transform](const float* vertices, size_t vertices_count,
+                               const uint16_t* indices, size_t indices_count) {
+        auto vertex = [&](size_t i) {
+          return transform * Point(vertices[i * 2], vertices[i * 2 + 1]);
+        };
+        if (indices) {
+          for (size_t i = 0; i < indices_count; i++) {
+            triangles.push_back(vertex(indices[i]));
+          }
+        } else {
+          for (size_t i = 0; i < vertices_count; i++) {
+            triangles.push_back(vertex(i));
+          }
+        }
+        return true;
+      });
+  EXPECT_EQ(result, TessellatorLibtess::Result::kSuccess);
+
+  auto is_inside = [&triangles](Point point) {
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+      Scalar d0 = (triangles[i + 1] - triangles[i]).Cross(point - triangles[i]);
+      Scalar d1 = (triangles[i + 2] - triangles[i + 1])
+                      .Cross(point - triangles[i + 1]);
+      Scalar d2 = (triangles[i] - triangles[i + 2])
+                      .Cross(point - triangles[i + 2]);
+      if ((d0 >= 0 && d1 >= 0 && d2 >= 0) || (d0 <= 0 && d1 <= 0 && d2 <= 0)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<uint8_t> coverage(size.Area());
+  for (int y = 0; y < size.height; y++) {
+    for (int x = 0; x < size.width; x++) {
+      int inside = 0;
+      for (int sy = 0; sy < kSamples; sy++) {
+        for (int sx = 0; sx < kSamples; sx++) {
+          Point sample(origin.x + x + (sx + 0.5f) / kSamples,
+                       origin.y + y + (sy + 0.5f) / kSamples);
+          inside += is_inside(sample) ? 1 : 0;
+        }
+      }
+      coverage[y * size.width + x] =
+          (inside * 255 + kSamples * kSamples / 2) / (kSamples * kSamples);
+    }
+  }
+  return coverage;
+}
+
+// Compares coverage against the tessellated reference. Point sampling is off
+// by up to a row of samples where an edge crosses a pixel. The rasterizer sums
+// the area covered by each edge, which is only exact if no two edges cross
+// inside a pixel, so the few pixels holding an intersection may differ more.
+void ExpectMatchesTessellatedCoverage(const uint8_t* actual,
+                                      const std::vector<uint8_t>& expected) {
+  double total_difference = 0.0;
+  size_t mismatches = 0u;
+  for (size_t i = 0; i < expected.size(); i++) {
+    const int difference = std::abs(actual[i] - expected[i]);
+    total_difference += difference;
+    if (difference > 24) {
+      mismatches++;
+    }
+  }
+  EXPECT_LE(mismatches, 16u);
+  EXPECT_LT(total_difference / expected.size(), 0.5);
+}
+
+}  // namespace
+
 TEST_P(ComputeTest, CapabilitiesReportSupport) {
   auto context = GetContext();
   ASSERT_TRUE(context);
@@ -499,5 +589,132 @@ TEST_P(ComputeTest, ReturnsEarlyWhenAnyGridDimensionIsZero) {
   pass->EncodeCommands();
 }
 
+TEST(ComputePathRasterizerTest, ComputesExactCoverageOfRect) {
+  // A rect offset by half a pixel covers half of the pixels on its edges and
+  // a quarter of the pixels on its corners.
+  auto path =
+      PathBuilder{}.AddRect(Rect::MakeXYWH(10.5, 20.5, 5, 3)).TakePath();
+  auto bins = ComputePathRasterizer::BinPath(path, Matrix());
+  EXPECT_EQ(bins.origin, IPoint(10, 20));
+  EXPECT_EQ(bins.size, ISize(8, 4));
+  EXPECT_EQ(bins.tiles_x, 1u);
+  EXPECT_EQ(bins.tiles_y, 1u);
+  // The horizontal edges are skipped.
+  EXPECT_EQ(bins.segments.size(), 2u);
+
+  auto coverage =
+      ComputePathRasterizer::ComputeCoverage(bins, FillType::kNonZero);
+  std::vector<uint8_t> expected = {
+      64,  128, 128, 128, 128, 64,  0, 0,  //
+      128, 255, 255, 255, 255, 128, 0, 0,  //
+      128, 255, 255, 255, 255, 128, 0, 0,  //
+      64,  128, 128, 128, 128, 64,  0, 0,  //
+  };
+  EXPECT_EQ(coverage, expected);
+}
+
+TEST(ComputePathRasterizerTest, AccumulatesBackdropsAcrossTiles) {
+  // A ring spanning several tiles, so that the pixels inside the hole only
+  // see the segments of the ring through the backdrops.
+  auto path = PathBuilder{}
+                  .AddCircle(Point(50, 50), 40)
+                  .AddCircle(Point(50, 50), 20)
+                  .TakePath(FillType::kOdd);
+  auto bins = ComputePathRasterizer::BinPath(path, Matrix());
+  EXPECT_GT(bins.tiles_x, 1u);
+  EXPECT_GT(bins.tiles_y, 1u);
+
+  auto coverage = ComputePathRasterizer::ComputeCoverage(bins, FillType::kOdd);
+  auto at = [&](Point point) {
+    IPoint pixel = IPoint(point.x, point.y) - bins.origin;
+    return coverage[pixel.y * bins.size.width + pixel.x];
+  };
+  EXPECT_EQ(at(Point(50, 50)), 0u);
+  EXPECT_EQ(at(Point(50, 20)), 255u);
+  EXPECT_EQ(at(Point(80, 50)), 255u);
+  EXPECT_EQ(at(Point(15, 15)), 0u);
+}
+
+TEST(ComputePathRasterizerTest, MatchesTessellatedFill) {
+  auto path = PathBuilder{}
+                  .MoveTo(Point(50, 5))
+                  .LineTo(Point(79, 95))
+                  .LineTo(Point(2, 40))
+                  .LineTo(Point(98, 40))
+                  .LineTo(Point(21, 95))
+                  .Close()
+                  .AddCircle(Point(50, 50), 12)
+                  .TakePath(FillType::kNonZero);
+  auto transform = Matrix::MakeTranslation({3.25, 7.75});
+  auto bins = ComputePathRasterizer::BinPath(path, transform);
+  auto coverage =
+      ComputePathRasterizer::ComputeCoverage(bins, FillType::kNonZero);
+  auto expected =
+      SampleTessellatedCoverage(path, transform, bins.origin, bins.size);
+  ExpectMatchesTessellatedCoverage(coverage.data(), expected);
+}
+
+TEST_P(ComputeTest, PathRasterizerMatchesCPUCoverage) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsCompute());
+  auto host_buffer = HostBuffer::Create(context->GetResourceAllocator());
+
+  ComputePathRasterizer rasterizer(*context);
+  ASSERT_TRUE(rasterizer.IsValid());
+
+  auto path = PathBuilder{}
+                  .MoveTo(Point(50, 5))
+                  .LineTo(Point(79, 95))
+                  .LineTo(Point(2, 40))
+                  .LineTo(Point(98, 40))
+                  .LineTo(Point(21, 95))
+                  .Close()
+                  .AddCircle(Point(50, 50), 12)
+                  .TakePath(FillType::kOdd);
+  auto transform = Matrix::MakeTranslation({3.25, 7.75});
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto mask = rasterizer.Rasterize(*context, *cmd_buffer, *host_buffer, path,
+                                   transform);
+  ASSERT_TRUE(mask.has_value());
+
+  auto bins = ComputePathRasterizer::BinPath(path, transform);
+  EXPECT_EQ(mask->origin, bins.origin);
+  EXPECT_EQ(mask->texture->GetSize(), bins.size);
+  auto expected = ComputePathRasterizer::ComputeCoverage(bins, FillType::kOdd);
+  auto tessellated =
+      SampleTessellatedCoverage(path, transform, bins.origin, bins.size);
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size = expected.size();
+  auto readback = context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  ASSERT_TRUE(readback);
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  ASSERT_TRUE(blit_pass->AddCopy(mask->texture, readback));
+  ASSERT_TRUE(blit_pass->EncodeCommands(context->GetResourceAllocator()));
+
+  fml::AutoResetWaitableEvent latch;
+  ASSERT_TRUE(
+      context->GetCommandQueue()
+          ->Submit({cmd_buffer},
+                   [&latch, readback, &expected,
+                    &tessellated](CommandBuffer::Status status) {
+                     EXPECT_EQ(status, CommandBuffer::Status::kCompleted);
+                     const uint8_t* actual = readback->OnGetContents();
+                     EXPECT_TRUE(actual);
+                     // Allow for differences in floating point precision.
+                     for (size_t i = 0; i < expected.size(); i++) {
+                       EXPECT_NEAR(actual[i], expected[i], 1) << "at " << i;
+                     }
+                     ExpectMatchesTessellatedCoverage(actual, tessellated);
+                     latch.Signal();
+                   })
+          .ok());
+
+  latch.Wait();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/time/time_delta.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
@@ -164,6 +166,23 @@ class Context {
   /// @brief Return the graphics queue for submitting command buffers.
   virtual std::shared_ptr<CommandQueue> GetCommandQueue() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the task runner on which independent render passes of
+  ///             the same frame may be recorded concurrently.
+  ///
+  ///             A pass recorded here is submitted by its task. The raster
+  ///             thread waits for the task before it encodes anything that
+  ///             samples from the pass, so the pass is always submitted
+  ///             before its readers.
+  ///
+  /// @return     The task runner, or `nullptr` if every render pass must be
+  ///             recorded on the raster thread.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner> GetEncodingTaskRunner()
+      const {
+    return nullptr;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -191,6 +210,19 @@ class Context {
   /// shader variants, as well as forcing driver initialization.
   virtual void InitializeCommonlyUsedShadersIfNeeded() const {}
 
+  using GPUFrameTimeCallback = std::function<void(fml::TimeDelta gpu_time)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback that receives the GPU time of each frame as
+  ///             measured by the GPU tracer of the backend. Replaces any
+  ///             previous callback.
+  ///
+  ///             The callback is only invoked while GPU tracing is enabled. It
+  ///             may be invoked on any thread, some time after the commands
+  ///             of the frame have completed.
+  ///
+  virtual void SetGPUFrameTimeCallback(GPUFrameTimeCallback callback) {}
+
  protected:
   Context();
 
@@ -34,4 +34,12 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibrary::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+void PipelineLibrary::RecordPipelineVariant(const std::string& pipeline_label,
+                                            uint64_t variant_key) {}
+
+std::vector<uint64_t> PipelineLibrary::GetRecordedPipelineVariants(
+    const std::string& pipeline_label) const {
+  return {};
+}
+
 }  // namespace impeller
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_LIBRARY_H_
 #define FLUTTER_IMPELLER_RENDERER_PIPELINE_LIBRARY_H_
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "compute_pipeline_descriptor.h"
 #include "impeller/renderer/pipeline.h"
@@ -51,6 +54,25 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records that a variant of the pipeline with the given label
+  ///             was used. The variant key is opaque to the library.
+  ///
+  ///             Backends with a persistent pipeline cache store the recorded
+  ///             variants next to it so that they can be compiled ahead of
+  ///             their first use on the next launch. Other backends ignore
+  ///             them.
+  ///
+  virtual void RecordPipelineVariant(const std::string& pipeline_label,
+                                     uint64_t variant_key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The variant keys of the pipeline with the given label that
+  ///             were recorded by previous launches.
+  ///
+  virtual std::vector<uint64_t> GetRecordedPipelineVariants(
+      const std::string& pipeline_label) const;
+
  protected:
   PipelineLibrary();
 
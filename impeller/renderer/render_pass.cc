@@ -100,6 +100,14 @@ void RenderPass::SetCommandLabel(std::string_view label) {
 #endif  // IMPELLER_DEBUG
 }
 
+void RenderPass::PushGPUTimingScope(std::string_view label) {}
+
+void RenderPass::PopGPUTimingScope() {}
+
+bool RenderPass::IsRecordingGPUTimingScopes() const {
+  return false;
+}
+
 void RenderPass::SetStencilReference(uint32_t value) {
   pending_.stencil_reference = value;
 }
@@ -62,6 +62,25 @@ class RenderPass : public ResourceBinder {
   /// The debugging label to use for the command.
   virtual void SetCommandLabel(std::string_view label);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start a GPU timing scope around the commands recorded until
+  ///             the matching call to |PopGPUTimingScope|. Scopes may be
+  ///             nested and must be closed before the pass is encoded.
+  ///
+  ///             Only backends with GPU tracing enabled record the scopes.
+  ///             Elsewhere, this does nothing.
+  ///
+  virtual void PushGPUTimingScope(std::string_view label);
+
+  virtual void PopGPUTimingScope();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether |PushGPUTimingScope| currently records anything on
+  ///             this pass. Callers that open many scopes can check this to
+  ///             skip computing their labels.
+  ///
+  virtual bool IsRecordingGPUTimingScopes() const;
+
   //----------------------------------------------------------------------------
   /// The reference value to use in stenciling operations. Stencil configuration
   /// is part of pipeline setup and can be read from the pipelines descriptor.
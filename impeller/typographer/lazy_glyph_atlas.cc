@@ -29,6 +29,7 @@ LazyGlyphAtlas::LazyGlyphAtlas(
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
 void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
+  Lock lock(atlas_mutex_);
   FML_DCHECK(alpha_atlas_ == nullptr && color_atlas_ == nullptr);
   if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
     frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
@@ -38,6 +39,7 @@ void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
+  Lock lock(atlas_mutex_);
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
   alpha_atlas_.reset();
@@ -47,6 +49,7 @@ void LazyGlyphAtlas::ResetTextFrames() {
 const std::shared_ptr<GlyphAtlas>& LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type) const {
+  Lock lock(atlas_mutex_);
   {
     if (type == GlyphAtlas::Type::kAlphaBitmap && alpha_atlas_) {
       return alpha_atlas_;
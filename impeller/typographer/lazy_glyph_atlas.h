@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_LAZY_GLYPH_ATLAS_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_LAZY_GLYPH_ATLAS_H_
 
+#include "impeller/base/thread.h"
 #include "impeller/renderer/context.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_frame.h"
@@ -34,8 +35,13 @@ class LazyGlyphAtlas {
   FontGlyphMap color_glyph_map_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
-  mutable std::shared_ptr<GlyphAtlas> alpha_atlas_;
-  mutable std::shared_ptr<GlyphAtlas> color_atlas_;
+  // The atlases are created by the first text contents that is rendered,
+  // which may be on any of the threads that record render passes.
+  mutable Mutex atlas_mutex_;
+  mutable std::shared_ptr<GlyphAtlas> alpha_atlas_
+      IPLR_GUARDED_BY(atlas_mutex_);
+  mutable std::shared_ptr<GlyphAtlas> color_atlas_
+      IPLR_GUARDED_BY(atlas_mutex_);
 
   LazyGlyphAtlas(const LazyGlyphAtlas&) = delete;
 
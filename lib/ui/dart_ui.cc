@@ -31,6 +31,7 @@
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
 #include "flutter/lib/ui/painting/vertices.h"
+#include "flutter/lib/ui/ring_buffer/ring_buffer_natives.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 #include "flutter/lib/ui/semantics/string_attribute.h"
@@ -116,6 +117,9 @@ typedef CanvasPath Path;
   V(PlatformConfigurationNativeApi::GetScaledFontSize)             \
   V(PlatformIsolateNativeApi::IsRunningOnPlatformThread)           \
   V(PlatformIsolateNativeApi::Spawn)                               \
+  V(RingBufferNatives::LoadUint64Acquire)                          \
+  V(RingBufferNatives::StoreUint64Release)                         \
+  V(RingBufferNatives::StoreUint32Release)                         \
   V(DartRuntimeHooks::Logger_PrintDebugString)                     \
   V(DartRuntimeHooks::Logger_PrintString)                          \
   V(DartRuntimeHooks::ScheduleMicrotask)                           \
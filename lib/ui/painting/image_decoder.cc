@@ -12,6 +12,10 @@
 
 namespace flutter {
 
+// The byte budget of the decoded image cache. This includes both the decoded
+// images and the encoded bytes used to verify cache hits.
+static constexpr size_t kImageDecoderCacheBytes = 64 * 1024 * 1024;
+
 std::unique_ptr<ImageDecoder> ImageDecoder::Make(
     const Settings& settings,
     const TaskRunners& runners,
@@ -42,6 +46,7 @@ ImageDecoder::ImageDecoder(
     : runners_(runners),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      cache_(kImageDecoderCacheBytes),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
@@ -50,6 +55,138 @@ ImageDecoder::ImageDecoder(
 
 ImageDecoder::~ImageDecoder() = default;
 
+void ImageDecoder::DecodeWithCache(fml::RefPtr<ImageDescriptor> descriptor,
+                                   uint32_t target_width,
+                                   uint32_t target_height,
+                                   const ImageResult& result) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  sk_sp<SkData> data = descriptor ? descriptor->data() : nullptr;
+  // Only encoded images are shared. Raw pixels also depend on the pixel format
+  // and row bytes of the descriptor.
+  if (!data || !descriptor->is_compressed()) {
+    Decode(std::move(descriptor), target_width, target_height, result);
+    return;
+  }
+
+  // Hashing is proportional to the size of the encoded image, so it is done on
+  // a worker thread before the cache lookup. As in |ImageDecoderSkia::Decode|,
+  // the descriptor is only referenced and released on the UI thread.
+  auto raw_descriptor = descriptor.get();
+  raw_descriptor->AddRef();
+  concurrent_task_runner_->PostTask(
+      [decoder = GetWeakPtr(), ui_runner = runners_.GetUITaskRunner(),
+       raw_descriptor, data = std::move(data), target_width, target_height,
+       result]() mutable {
+        const auto key =
+            ImageDecoderCache::MakeKey(*data, target_width, target_height);
+        ui_runner->PostTask([decoder, raw_descriptor, data = std::move(data),
+                             key, target_width, target_height,
+                             result]() mutable {
+          auto descriptor = fml::Ref(raw_descriptor);
+          raw_descriptor->Release();
+          if (!decoder) {
+            result(nullptr, "Image decoder not available.");
+            return;
+          }
+          decoder->DecodeWithKey(std::move(descriptor), std::move(data), key,
+                                 target_width, target_height, result, nullptr);
+        });
+      });
+}
+
+sk_sp<SkData> ImageDecoder::GetEncodedData(
+    const ImageDecoderCache::Key& key) const {
+  if (auto data = cache_.GetData(key)) {
+    return data;
+  }
+  auto pending = pending_decodes_.find(key);
+  return pending == pending_decodes_.end() ? nullptr : pending->second->data;
+}
+
+void ImageDecoder::DecodeWithKey(fml::RefPtr<ImageDescriptor> descriptor,
+                                 sk_sp<SkData> data,
+                                 const ImageDecoderCache::Key& key,
+                                 uint32_t target_width,
+                                 uint32_t target_height,
+                                 const ImageResult& result,
+                                 const sk_sp<SkData>& verified_data) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  // All cached and pending entries for a key have byte-equal encoded data, so
+  // it is enough to compare against one of them. Comparing is proportional to
+  // the size of the image and is done on a worker thread unless the same
+  // buffer is shared or was already compared.
+  sk_sp<SkData> known_data = GetEncodedData(key);
+  if (known_data && known_data != data && known_data != verified_data) {
+    auto raw_descriptor = descriptor.get();
+    raw_descriptor->AddRef();
+    concurrent_task_runner_->PostTask(
+        [decoder = GetWeakPtr(), ui_runner = runners_.GetUITaskRunner(),
+         raw_descriptor, data = std::move(data),
+         known_data = std::move(known_data), key, target_width, target_height,
+         result]() mutable {
+          const bool equal = known_data->equals(data.get());
+          ui_runner->PostTask([decoder, raw_descriptor, data = std::move(data),
+                               known_data = std::move(known_data), equal, key,
+                               target_width, target_height, result]() mutable {
+            auto descriptor = fml::Ref(raw_descriptor);
+            raw_descriptor->Release();
+            if (!decoder) {
+              result(nullptr, "Image decoder not available.");
+            } else if (!equal) {
+              // A hash collision. Decode independently.
+              decoder->Decode(std::move(descriptor), target_width,
+                              target_height, result);
+            } else {
+              // The entry for the key may have changed in the meantime, in
+              // which case the bytes are compared again.
+              decoder->DecodeWithKey(std::move(descriptor), std::move(data),
+                                     key, target_width, target_height, result,
+                                     known_data);
+            }
+          });
+        });
+    return;
+  }
+
+  // This always runs in a task posted from |DecodeWithCache|, so cache hits are
+  // still returned asynchronously.
+  if (auto image = cache_.Get(key)) {
+    result(image, std::string());
+    return;
+  }
+
+  auto pending = pending_decodes_.find(key);
+  if (pending != pending_decodes_.end()) {
+    pending->second->results.push_back(result);
+    return;
+  }
+
+  // The pending results are shared with the decode callback so that they are
+  // still invoked if this decoder is collected before the decode finishes.
+  auto decode = std::make_shared<PendingDecode>();
+  decode->data = std::move(data);
+  decode->results.push_back(result);
+  pending_decodes_[key] = decode;
+  Decode(std::move(descriptor), target_width, target_height,
+         [decoder = GetWeakPtr(), key, decode](
+             const sk_sp<DlImage>& image, const std::string& decode_error) {
+           if (decoder) {
+             decoder->pending_decodes_.erase(key);
+             if (image) {
+               decoder->cache_.Put(key, decode->data, image);
+             }
+           }
+           for (const auto& result : decode->results) {
+             result(image, decode_error);
+           }
+         });
+}
+
+void ImageDecoder::PurgeCache() {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  cache_.Purge();
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
@@ -6,12 +6,15 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/image_decoder_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
 namespace flutter {
@@ -44,6 +47,27 @@ class ImageDecoder {
                       uint32_t target_height,
                       const ImageResult& result) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Like `Decode`, but shares the result between descriptors with
+  ///             identical encoded bytes and target sizes. Finished decodes are
+  ///             kept in a byte-budgeted LRU cache, and concurrent requests for
+  ///             the same image wait on a single decode. Encoded bytes are
+  ///             hashed and compared on a worker thread. The result is always
+  ///             returned asynchronously on the UI thread.
+  ///
+  void DecodeWithCache(fml::RefPtr<ImageDescriptor> descriptor,
+                       uint32_t target_width,
+                       uint32_t target_height,
+                       const ImageResult& result);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all images in the decoded image cache. Images that are
+  ///             still referenced by the framework stay alive.
+  ///
+  void PurgeCache();
+
+  const ImageDecoderCache& GetCache() const { return cache_; }
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  protected:
@@ -57,6 +81,30 @@ class ImageDecoder {
       fml::WeakPtr<IOManager> io_manager);
 
  private:
+  struct PendingDecode {
+    sk_sp<SkData> data;
+    std::vector<ImageResult> results;
+  };
+
+  // Returns the encoded bytes of the cached or pending decode for the key.
+  sk_sp<SkData> GetEncodedData(const ImageDecoderCache::Key& key) const;
+
+  // Continues |DecodeWithCache| on the UI thread once the key is known.
+  // |verified_data| was already found to be equal to |data|, if not null.
+  void DecodeWithKey(fml::RefPtr<ImageDescriptor> descriptor,
+                     sk_sp<SkData> data,
+                     const ImageDecoderCache::Key& key,
+                     uint32_t target_width,
+                     uint32_t target_height,
+                     const ImageResult& result,
+                     const sk_sp<SkData>& verified_data);
+
+  ImageDecoderCache cache_;
+  std::unordered_map<ImageDecoderCache::Key,
+                     std::shared_ptr<PendingDecode>,
+                     ImageDecoderCache::Key::Hash>
+      pending_decodes_;
+
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
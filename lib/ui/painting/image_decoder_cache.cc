@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decoder_cache.h"
+
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+size_t ImageDecoderCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.data_hash, key.target_width, key.target_height);
+}
+
+ImageDecoderCache::Key ImageDecoderCache::MakeKey(const SkData& data,
+                                                  uint32_t target_width,
+                                                  uint32_t target_height) {
+  TRACE_EVENT0("flutter", "ImageDecoderCache::MakeKey");
+  const std::string_view bytes(static_cast<const char*>(data.data()),
+                               data.size());
+  return Key{.data_hash = std::hash<std::string_view>{}(bytes),
+             .target_width = target_width,
+             .target_height = target_height};
+}
+
+ImageDecoderCache::ImageDecoderCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+ImageDecoderCache::~ImageDecoderCache() = default;
+
+sk_sp<DlImage> ImageDecoderCache::Get(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->image;
+}
+
+sk_sp<SkData> ImageDecoderCache::GetData(const Key& key) const {
+  auto found = index_.find(key);
+  return found == index_.end() ? nullptr : found->second->data;
+}
+
+void ImageDecoderCache::Put(const Key& key,
+                            sk_sp<SkData> data,
+                            sk_sp<DlImage> image) {
+  if (!data || !image) {
+    return;
+  }
+  auto existing = index_.find(key);
+  if (existing != index_.end()) {
+    Erase(existing->second);
+  }
+
+  const size_t bytes = image->GetApproximateByteSize() + data->size();
+  if (bytes > max_bytes_) {
+    return;
+  }
+  while (bytes_ + bytes > max_bytes_ && !entries_.empty()) {
+    Erase(std::prev(entries_.end()));
+  }
+
+  entries_.push_front(Entry{.key = key,
+                            .data = std::move(data),
+                            .image = std::move(image),
+                            .bytes = bytes});
+  index_[key] = entries_.begin();
+  bytes_ += bytes;
+}
+
+void ImageDecoderCache::Purge() {
+  TRACE_EVENT0("flutter", "ImageDecoderCache::Purge");
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+void ImageDecoderCache::Erase(std::list<Entry>::iterator entry) {
+  bytes_ -= entry->bytes;
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+}  // namespace flutter
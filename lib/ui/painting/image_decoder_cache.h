@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A byte-budgeted, least-recently-used cache of decoded images
+///             keyed by the contents of their encoded bytes and the size they
+///             were decoded at. This lets identical encoded images (e.g. the
+///             same avatar shown in many places) share one decode and one
+///             texture.
+///
+///             Keys are a hash of the encoded bytes. Hashing and comparing
+///             encoded images is proportional to their size, so the cache does
+///             neither on lookup. The owner computes keys off the UI thread and
+///             checks that its bytes equal those of `GetData` before using an
+///             entry, so hash collisions never produce the wrong image.
+///
+///             This object is not thread safe. The `ImageDecoder` that owns it
+///             only accesses it on the UI thread.
+///
+class ImageDecoderCache {
+ public:
+  struct Key {
+    size_t data_hash = 0;
+    uint32_t target_width = 0;
+    uint32_t target_height = 0;
+
+    bool operator==(const Key& other) const {
+      return data_hash == other.data_hash &&
+             target_width == other.target_width &&
+             target_height == other.target_height;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hashes all of the encoded bytes. Must not be called on the UI
+  ///             thread.
+  ///
+  static Key MakeKey(const SkData& data,
+                     uint32_t target_width,
+                     uint32_t target_height);
+
+  explicit ImageDecoderCache(size_t max_bytes);
+
+  ~ImageDecoderCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the cached image for the key, and marks it as most
+  ///             recently used. The caller must already have checked that its
+  ///             encoded bytes are equal to those returned by `GetData`.
+  ///
+  sk_sp<DlImage> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the encoded bytes of the cached image for the key, or
+  ///             null if there is none.
+  ///
+  sk_sp<SkData> GetData(const Key& key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an image to the cache, evicting the least recently used
+  ///             entries until the cache is within its byte budget. Images
+  ///             larger than the whole budget are not cached. Both the image
+  ///             and its encoded bytes count towards the budget.
+  ///
+  void Put(const Key& key, sk_sp<SkData> data, sk_sp<DlImage> image);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all cached images. Called in response to memory
+  ///             pressure.
+  ///
+  void Purge();
+
+  size_t GetByteSize() const { return bytes_; }
+
+  size_t GetCount() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    Key key;
+    sk_sp<SkData> data;
+    sk_sp<DlImage> image;
+    size_t bytes = 0;
+  };
+
+  const size_t max_bytes_;
+  size_t bytes_ = 0;
+  // Most recently used entries are at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash> index_;
+
+  void Erase(std::list<Entry>::iterator entry);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_CACHE_H_
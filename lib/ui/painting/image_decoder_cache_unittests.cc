@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decoder_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DlImage> MakeImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(SK_ColorRED);
+  bitmap.setImmutable();
+  return DlImage::Make(bitmap.asImage());
+}
+
+sk_sp<SkData> MakeData(const char* contents) {
+  return SkData::MakeWithCString(contents);
+}
+
+}  // namespace
+
+TEST(ImageDecoderCacheTest, ReturnsImageForEqualBytesAndSize) {
+  ImageDecoderCache cache(1024 * 1024);
+  auto data = MakeData("encoded");
+  auto image = MakeImage(10, 10);
+  cache.Put(ImageDecoderCache::MakeKey(*data, 10, 10), data, image);
+
+  // A different buffer with the same contents hits the cache.
+  auto same_data = MakeData("encoded");
+  EXPECT_EQ(cache.Get(ImageDecoderCache::MakeKey(*same_data, 10, 10)), image);
+  // Other target sizes or contents do not.
+  EXPECT_EQ(cache.Get(ImageDecoderCache::MakeKey(*data, 5, 5)), nullptr);
+  auto other_data = MakeData("other");
+  EXPECT_EQ(cache.Get(ImageDecoderCache::MakeKey(*other_data, 10, 10)),
+            nullptr);
+}
+
+TEST(ImageDecoderCacheTest, KeepsEncodedBytesToVerifyHashMatches) {
+  ImageDecoderCache cache(1024 * 1024);
+  auto data = MakeData("encoded");
+  auto key = ImageDecoderCache::MakeKey(*data, 10, 10);
+  EXPECT_EQ(cache.GetData(key), nullptr);
+  cache.Put(key, data, MakeImage(10, 10));
+
+  // Lookups do not compare bytes. Callers compare against the stored ones.
+  EXPECT_EQ(cache.GetData(key), data);
+  EXPECT_FALSE(cache.GetData(key)->equals(MakeData("collides").get()));
+}
+
+TEST(ImageDecoderCacheTest, EvictsLeastRecentlyUsedEntries) {
+  auto first_data = MakeData("first");
+  auto second_data = MakeData("second");
+  auto third_data = MakeData("third");
+  auto first_key = ImageDecoderCache::MakeKey(*first_data, 10, 10);
+  auto second_key = ImageDecoderCache::MakeKey(*second_data, 10, 10);
+  auto third_key = ImageDecoderCache::MakeKey(*third_data, 10, 10);
+
+  auto image = MakeImage(10, 10);
+  const size_t entry_bytes = image->GetApproximateByteSize() + 16;
+  ImageDecoderCache cache(entry_bytes * 2);
+
+  cache.Put(first_key, first_data, MakeImage(10, 10));
+  cache.Put(second_key, second_data, MakeImage(10, 10));
+  ASSERT_EQ(cache.GetCount(), 2u);
+
+  // Touch the first entry so that the second one is evicted.
+  ASSERT_NE(cache.Get(first_key), nullptr);
+  cache.Put(third_key, third_data, MakeImage(10, 10));
+
+  EXPECT_EQ(cache.GetCount(), 2u);
+  EXPECT_LE(cache.GetByteSize(), entry_bytes * 2);
+  EXPECT_NE(cache.Get(first_key), nullptr);
+  EXPECT_EQ(cache.Get(second_key), nullptr);
+  EXPECT_NE(cache.Get(third_key), nullptr);
+}
+
+TEST(ImageDecoderCacheTest, SkipsImagesLargerThanBudget) {
+  ImageDecoderCache cache(100);
+  auto data = MakeData("encoded");
+  cache.Put(ImageDecoderCache::MakeKey(*data, 100, 100), data,
+            MakeImage(100, 100));
+  EXPECT_EQ(cache.GetCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(ImageDecoderCacheTest, PurgeDropsAllEntries) {
+  ImageDecoderCache cache(1024 * 1024);
+  auto data = MakeData("encoded");
+  cache.Put(ImageDecoderCache::MakeKey(*data, 10, 10), data,
+            MakeImage(10, 10));
+  ASSERT_EQ(cache.GetCount(), 1u);
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -26,6 +26,7 @@
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkPoint.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSamplingOptions.h"
 #include "third_party/skia/include/core/SkSize.h"
 
@@ -57,6 +58,10 @@ float CalculateArea(SkPoint abc[3]) {
                       b.fX * a.fY);
 }
 
+// The scale requested from the codec for previews. Codecs return their
+// closest supported size, e.g. 1/8 for JPEG.
+static constexpr float kPreviewScale = 0.125f;
+
 // Note: This was calculated from SkColorSpace::MakeSRGB().
 static constexpr float kSrgbGamutArea = 0.0982f;
 
@@ -113,7 +118,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     SkISize target_size,
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    std::optional<SkIRect> region) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -127,13 +133,42 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
                            target_size.height()));
 
   const SkISize source_size = descriptor->image_info().dimensions();
+  SkIRect source_region = SkIRect::MakeSize(source_size);
+  if (region.has_value() && !source_region.intersect(region.value())) {
+    std::string decode_error("Decode region is outside of the image.");
+    FML_DLOG(ERROR) << decode_error;
+    return DecompressResult{.decode_error = decode_error};
+  }
+
+  // Pick the decode size so that the region, rather than the whole image,
+  // covers the target size.
   auto decode_size = source_size;
   if (descriptor->is_compressed()) {
     decode_size = descriptor->get_scaled_dimensions(std::max(
-        static_cast<float>(target_size.width()) / source_size.width(),
-        static_cast<float>(target_size.height()) / source_size.height()));
+        static_cast<float>(target_size.width()) / source_region.width(),
+        static_cast<float>(target_size.height()) / source_region.height()));
   }
 
+  // The region in the coordinates of the decoded image.
+  SkIRect decode_region = SkIRect::MakeSize(decode_size);
+  if (source_region != SkIRect::MakeSize(source_size)) {
+    const float scale_x =
+        static_cast<float>(decode_size.width()) / source_size.width();
+    const float scale_y =
+        static_cast<float>(decode_size.height()) / source_size.height();
+    if (!decode_region.intersect(
+            SkRect::MakeLTRB(source_region.left() * scale_x,
+                             source_region.top() * scale_y,
+                             source_region.right() * scale_x,
+                             source_region.bottom() * scale_y)
+                .roundOut())) {
+      std::string decode_error("Decode region is too small to decode.");
+      FML_DLOG(ERROR) << decode_error;
+      return DecompressResult{.decode_error = decode_error};
+    }
+  }
+  const bool decodes_region = decode_region != SkIRect::MakeSize(decode_size);
+
   //----------------------------------------------------------------------------
   /// 1. Decode the image.
   ///
@@ -143,23 +178,26 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       supports_wide_gamut ? IsWideGamut(base_image_info.colorSpace()) : false;
   SkAlphaType alpha_type =
       ChooseCompatibleAlphaType(base_image_info.alphaType());
-  SkImageInfo image_info;
+  SkImageInfo decode_info;
   if (is_wide_gamut) {
     SkColorType color_type = alpha_type == SkAlphaType::kOpaque_SkAlphaType
                                  ? kBGR_101010x_XR_SkColorType
                                  : kRGBA_F16_SkColorType;
-    image_info =
+    decode_info =
         base_image_info.makeWH(decode_size.width(), decode_size.height())
             .makeColorType(color_type)
             .makeAlphaType(alpha_type)
             .makeColorSpace(SkColorSpace::MakeSRGB());
   } else {
-    image_info =
+    decode_info =
         base_image_info.makeWH(decode_size.width(), decode_size.height())
             .makeColorType(
                 ChooseCompatibleColorType(base_image_info.colorType()))
             .makeAlphaType(alpha_type);
   }
+  // Only the region is ever held in memory, never the whole decoded image.
+  const SkImageInfo image_info =
+      decode_info.makeDimensions(decode_region.size());
 
   const auto pixel_format =
       impeller::skia_conversions::ToPixelFormat(image_info.colorType());
@@ -171,19 +209,32 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     return DecompressResult{.decode_error = decode_error};
   }
 
+  // When the decoded image still has to be resized, it is only an
+  // intermediate. Keep it in host memory so that just the final, target sized
+  // bitmap is backed by a device buffer.
+  const bool needs_resize = decode_region.size() != target_size;
+
   auto bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
 
   if (descriptor->is_compressed()) {
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    const bool allocated = needs_resize
+                               ? bitmap->tryAllocPixels()
+                               : bitmap->tryAllocPixels(bitmap_allocator.get());
+    if (!allocated) {
       std::string decode_error(
           "Could not allocate intermediate for image decompression.");
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
     }
     // Decode the image into the image generator's closest supported size.
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    const bool decoded =
+        decodes_region
+            ? descriptor->get_pixels(decode_info, decode_region,
+                                     bitmap->pixmap())
+            : descriptor->get_pixels(bitmap->pixmap());
+    if (!decoded) {
       std::string decode_error("Could not decompress image.");
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
@@ -194,18 +245,35 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     auto pixel_ref = SkMallocPixelRef::MakeWithData(
         base_image_info, descriptor->row_bytes(), descriptor->data());
     temp_bitmap->setPixelRef(pixel_ref, 0, 0);
+    if (decodes_region) {
+      // Raw pixels are never scaled while decoding, so the region can
+      // reference the source pixels directly.
+      auto region_bitmap = std::make_shared<SkBitmap>();
+      if (!temp_bitmap->extractSubset(region_bitmap.get(), decode_region)) {
+        std::string decode_error("Could not extract the decode region.");
+        FML_DLOG(ERROR) << decode_error;
+        return DecompressResult{.decode_error = decode_error};
+      }
+      temp_bitmap = std::move(region_bitmap);
+    }
 
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
-      std::string decode_error(
-          "Could not allocate intermediate for pixel conversion.");
-      FML_DLOG(ERROR) << decode_error;
-      return DecompressResult{.decode_error = decode_error};
+    if (needs_resize) {
+      // Scaling converts the pixels as well, so scale directly from the
+      // source pixels instead of converting them into a full size copy first.
+      bitmap = std::move(temp_bitmap);
+    } else {
+      if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+        std::string decode_error(
+            "Could not allocate intermediate for pixel conversion.");
+        FML_DLOG(ERROR) << decode_error;
+        return DecompressResult{.decode_error = decode_error};
+      }
+      temp_bitmap->readPixels(bitmap->pixmap());
     }
-    temp_bitmap->readPixels(bitmap->pixmap());
     bitmap->setImmutable();
   }
 
-  if (bitmap->dimensions() == target_size) {
+  if (!needs_resize) {
     std::shared_ptr<impeller::DeviceBuffer> buffer =
         bitmap_allocator->GetDeviceBuffer();
     if (!buffer) {
@@ -243,16 +311,64 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
 
   std::shared_ptr<impeller::DeviceBuffer> buffer =
       scaled_allocator->GetDeviceBuffer();
-  buffer->Flush();
-
   if (!buffer) {
     return DecompressResult{.decode_error = "Unable to get device buffer"};
   }
+  buffer->Flush();
+
   return DecompressResult{.device_buffer = std::move(buffer),
                           .sk_bitmap = scaled_bitmap,
                           .image_info = scaled_bitmap->info()};
 }
 
+DecompressResult ImageDecoderImpeller::DecompressPreview(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    bool supports_wide_gamut,
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    std::optional<SkIRect> region) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!descriptor || !descriptor->is_compressed()) {
+    return DecompressResult{
+        .decode_error = "Only encoded images have a preview."};
+  }
+
+  // The smallest size the codec itself can decode to. JPEG reaches it by
+  // only reconstructing the DC coefficients of each block.
+  const SkISize source_size = descriptor->image_info().dimensions();
+  const SkISize preview_size =
+      descriptor->get_scaled_dimensions(kPreviewScale);
+  if (preview_size.width() >= source_size.width() ||
+      preview_size.height() >= source_size.height()) {
+    return DecompressResult{
+        .decode_error = "The codec cannot decode a reduced size preview."};
+  }
+
+  SkIRect source_region = SkIRect::MakeSize(source_size);
+  if (region.has_value() && !source_region.intersect(region.value())) {
+    return DecompressResult{
+        .decode_error = "Decode region is outside of the image."};
+  }
+  SkISize preview_target = source_region.size();
+  preview_target.set(
+      std::max(1, preview_target.width() * preview_size.width() /
+                      source_size.width()),
+      std::max(1, preview_target.height() * preview_size.height() /
+                      source_size.height()));
+  if (preview_target.width() >= target_size.width() ||
+      preview_target.height() >= target_size.height()) {
+    // The target is already as small as the preview would be.
+    return DecompressResult{
+        .decode_error = "The target size is smaller than the preview."};
+  }
+
+  // The preview target is what the codec decodes to, so the codec does all
+  // of the downscaling.
+  return DecompressTexture(descriptor, preview_target, max_texture_size,
+                           supports_wide_gamut, allocator, region);
+}
+
 /// Only call this method if the GPU is available.
 static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
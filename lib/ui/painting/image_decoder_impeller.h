@@ -6,12 +6,14 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
 #include <future>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "impeller/core/formats.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkRect.h"
 
 namespace impeller {
 class Context;
@@ -61,12 +63,45 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  /// @brief Decode an image into a host visible device buffer of the target
+  ///        size. Where the codec supports it, the image is downscaled while
+  ///        decoding, and nothing but the result is allocated when the
+  ///        decoded size already matches the target size.
+  /// @param descriptor  The image to decode.
+  /// @param target_size The size of the result.
+  /// @param max_texture_size The largest size the result may have.
+  /// @param supports_wide_gamut Whether wide gamut images may be decoded in a
+  ///                    wide gamut pixel format.
+  /// @param allocator   The allocator for the device buffer.
+  /// @param region      If set, only this region of the image (in image
+  ///                    coordinates) is decoded and scaled to the target
+  ///                    size. Codecs that support it skip the pixels outside
+  ///                    of the region entirely.
+  /// @return            The decoded image or a decode error.
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      std::optional<SkIRect> region = std::nullopt);
+
+  /// @brief Decode a low resolution preview of an image, to be shown until
+  ///        the `DecompressTexture` result for `target_size` is ready. The
+  ///        preview is decoded at the smallest size the codec can decode to
+  ///        natively (1/8 for JPEG), which is much cheaper than a full
+  ///        decode. Codecs without native downscaling, such as PNG, have no
+  ///        preview, since it would cost as much as the full decode.
+  /// @return            The preview, or an error if there is no preview that
+  ///                    is cheaper and smaller than the target size.
+  /// @see   `DecompressTexture`
+  static DecompressResult DecompressPreview(
+      ImageDescriptor* descriptor,
+      SkISize target_size,
+      impeller::ISize max_texture_size,
+      bool supports_wide_gamut,
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      std::optional<SkIRect> region = std::nullopt);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///        This method is only suported on the metal backend.
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_NO_GL_UNITTESTS_H_
 
 #include <stdint.h>
+#include <vector>
 
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/device_buffer.h"
@@ -68,7 +69,12 @@ class TestImpellerAllocator : public impeller::Allocator {
 
   ~TestImpellerAllocator() = default;
 
+  // The sizes of all device buffers created by this allocator, in order.
+  const std::vector<size_t>& GetBufferSizes() const { return buffer_sizes_; }
+
  private:
+  std::vector<size_t> buffer_sizes_;
+
   uint16_t MinimumBytesPerRow(PixelFormat format) const override { return 0; }
 
   ISize GetMaxTextureSizeSupported() const override {
@@ -77,6 +83,7 @@ class TestImpellerAllocator : public impeller::Allocator {
 
   std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) override {
+    buffer_sizes_.push_back(desc.size);
     return std::make_shared<TestImpellerDeviceBuffer>(desc);
   }
 
@@ -740,6 +740,127 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderTest, ResizedDecodesOnlyAllocateTargetSizedDeviceBuffers) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  auto result = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(60, 20), {100, 100},
+      /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(result.device_buffer);
+  ASSERT_EQ(result.sk_bitmap->width(), 60);
+  ASSERT_EQ(result.sk_bitmap->height(), 20);
+
+  // The full size decode is a host memory intermediate. Only the resized
+  // bitmap is backed by a device buffer.
+  ASSERT_EQ(allocator->GetBufferSizes().size(), 1u);
+  EXPECT_EQ(allocator->GetBufferSizes()[0], 60u * 20u * 4u);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST(ImageDecoderTest, RegionDecodesOnlyAllocateTheRegion) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  auto full = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(600, 200), {1000, 1000},
+      /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(full.device_buffer);
+
+  auto region_allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  auto region = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(300, 100), {1000, 1000},
+      /*supports_wide_gamut=*/false, region_allocator,
+      SkIRect::MakeXYWH(300, 100, 300, 100));
+  ASSERT_TRUE(region.device_buffer);
+  ASSERT_EQ(region.sk_bitmap->width(), 300);
+  ASSERT_EQ(region.sk_bitmap->height(), 100);
+  ASSERT_EQ(region_allocator->GetBufferSizes().size(), 1u);
+  EXPECT_EQ(region_allocator->GetBufferSizes()[0], 300u * 100u * 4u);
+
+  for (int y = 0; y < 100; y += 33) {
+    for (int x = 0; x < 300; x += 33) {
+      EXPECT_EQ(region.sk_bitmap->getColor(x, y),
+                full.sk_bitmap->getColor(300 + x, 100 + y));
+    }
+  }
+
+  auto outside = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(300, 100), {1000, 1000},
+      /*supports_wide_gamut=*/false, region_allocator,
+      SkIRect::MakeXYWH(600, 0, 100, 100));
+  EXPECT_FALSE(outside.device_buffer);
+  EXPECT_FALSE(outside.decode_error.empty());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST(ImageDecoderTest, PreviewsAreDecodedAtTheCodecsSmallestScale) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  auto preview = ImageDecoderImpeller::DecompressPreview(
+      descriptor.get(), SkISize::Make(600, 200), {1000, 1000},
+      /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(preview.device_buffer);
+  EXPECT_EQ(preview.sk_bitmap->width(), 75);
+  EXPECT_EQ(preview.sk_bitmap->height(), 25);
+  // JPEG downscales while decoding, so there is no intermediate.
+  ASSERT_EQ(allocator->GetBufferSizes().size(), 1u);
+  EXPECT_EQ(allocator->GetBufferSizes()[0], 75u * 25u * 4u);
+
+  // There is no point in a preview that is as large as the target.
+  auto small = ImageDecoderImpeller::DecompressPreview(
+      descriptor.get(), SkISize::Make(60, 20), {1000, 1000},
+      /*supports_wide_gamut=*/false, allocator);
+  EXPECT_FALSE(small.device_buffer);
+
+  // PNG cannot downscale while decoding, so a preview would cost as much as
+  // the full decode.
+  auto png_data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(png_data);
+  std::shared_ptr<ImageGenerator> png_generator =
+      registry.CreateCompatibleGenerator(png_data);
+  ASSERT_TRUE(png_generator);
+  auto png_descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(png_data), std::move(png_generator));
+  auto png_preview = ImageDecoderImpeller::DecompressPreview(
+      png_descriptor.get(), SkISize::Make(500, 500), {1000, 1000},
+      /*supports_wide_gamut=*/false, allocator);
+  EXPECT_FALSE(png_preview.device_buffer);
+  EXPECT_FALSE(png_preview.decode_error.empty());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST(ImageDecoderTest, ImagesWithTransparencyArePremulAlpha) {
   auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
   ASSERT_TRUE(data);
@@ -1050,6 +1171,107 @@ TEST_F(ImageDecoderFixtureTest,
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+/// A two frame image generator whose info can be changed between decodes. An
+/// unknown alpha type makes allocating the bitmap of a frame fail.
+class TwoFrameImageGenerator : public ImageGenerator {
+ public:
+  explicit TwoFrameImageGenerator(SkAlphaType alpha_type)
+      : info_(SkImageInfo::Make(2, 2, kN32_SkColorType, alpha_type)) {}
+  ~TwoFrameImageGenerator() = default;
+  const SkImageInfo& GetInfo() { return info_; }
+
+  unsigned int GetFrameCount() const { return 2; }
+
+  unsigned int GetPlayCount() const { return kInfinitePlayCount; }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(unsigned int frame_index) {
+    return {std::nullopt, 0, SkCodecAnimation::DisposalMethod::kKeep};
+  }
+
+  SkISize GetScaledDimensions(float scale) {
+    return SkISize::Make(info_.width(), info_.height());
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) {
+    return true;
+  };
+
+  void SetAlphaType(SkAlphaType alpha_type) {
+    info_ = info_.makeAlphaType(alpha_type);
+  }
+
+ private:
+  SkImageInfo info_;
+};
+
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecLookaheadRetriesFailedFrames) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto generator =
+      std::make_shared<TwoFrameImageGenerator>(kUnknown_SkAlphaType);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+      auto codec = fml::MakeRefCounted<MultiFrameCodec>(generator);
+      auto& state = *codec->state_;
+
+      // Allocating the first frame fails, so nothing is decoded ahead and the
+      // frame is decoded again when it is requested, which fails too.
+      state.DecodeAhead();
+      EXPECT_TRUE(state.decodedFrames_.empty());
+      EXPECT_EQ(state.decodeFrameIndex_, state.nextFrameIndex_);
+      auto [failed_frame, decode_error] = state.TakeNextFrame();
+      EXPECT_FALSE(failed_frame.has_value());
+      EXPECT_FALSE(decode_error.empty());
+      state.nextFrameIndex_ = 1;
+      EXPECT_EQ(state.decodeFrameIndex_, state.nextFrameIndex_);
+
+      // Once allocating succeeds, the next frames are decoded ahead in order.
+      generator->SetAlphaType(kPremul_SkAlphaType);
+      state.DecodeAhead();
+      EXPECT_EQ(state.decodedFrames_.size(), 2u);
+      // The claim on the decoder is released once the frames are published.
+      EXPECT_FALSE(state.decoding_);
+      for (int index : {1, 0}) {
+        auto [frame, error] = state.TakeNextFrame();
+        if (!frame.has_value()) {
+          return false;
+        }
+        EXPECT_EQ(frame->index, index);
+        state.nextFrameIndex_ = (state.nextFrameIndex_ + 1) % 2;
+      }
+      return true;
+    }));
+  });
+
+  // Destroy the Isolate
+  isolate = nullptr;
+
+  // Destroy the IO manager
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
 TEST_F(ImageDecoderFixtureTest, NullCheckBuffer) {
   auto context = std::make_shared<impeller::TestImpellerContext>();
   auto allocator = ImpellerAllocator(context->GetResourceAllocator());
@@ -131,4 +131,14 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_pixels(const SkImageInfo& decode_info,
+                                 const SkIRect& region,
+                                 const SkPixmap& pixmap) const {
+  FML_DCHECK(generator_);
+  FML_DCHECK(pixmap.dimensions() == region.size());
+  return generator_->GetPixelsInRegion(decode_info, region,
+                                       pixmap.writable_addr(),
+                                       pixmap.rowBytes());
+}
+
 }  // namespace flutter
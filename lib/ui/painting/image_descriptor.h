@@ -17,6 +17,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/tonic/dart_library_natives.h"
 
@@ -110,6 +111,14 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets only the pixels in `region` of this image decoded at the
+  ///         size of `decode_info`, transformed based on the EXIF orientation
+  ///         tag, if applicable. `pixmap` must have the size of `region`.
+  /// @see    `ImageGenerator::GetPixelsInRegion`
+  bool get_pixels(const SkImageInfo& decode_info,
+                  const SkIRect& region,
+                  const SkPixmap& pixmap) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -35,6 +35,24 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+bool ImageGenerator::GetPixelsInRegion(const SkImageInfo& info,
+                                       const SkIRect& region,
+                                       void* pixels,
+                                       size_t row_bytes) {
+  FML_DCHECK(SkIRect::MakeSize(info.dimensions()).contains(region));
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                    << info.computeMinByteSize() << "B";
+    return false;
+  }
+  if (!GetPixels(info, bitmap.getPixels(), bitmap.rowBytes())) {
+    return false;
+  }
+  return bitmap.readPixels(info.makeDimensions(region.size()), pixels,
+                           row_bytes, region.x(), region.y());
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -188,6 +206,45 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetPixelsInRegion(
+    const SkImageInfo& info,
+    const SkIRect& region,
+    void* pixels,
+    size_t row_bytes) {
+  FML_DCHECK(SkIRect::MakeSize(info.dimensions()).contains(region));
+  // Re-oriented images are decoded in their encoded orientation, where the
+  // region is somewhere else. Let the default implementation handle those.
+  if (codec_->getOrigin() == kTopLeft_SkEncodedOrigin) {
+    const SkImageInfo region_info = info.makeDimensions(region.size());
+    SkCodec::Options options;
+
+    // Some codecs (e.g. WebP) decode an arbitrary subset directly, but only
+    // relative to the unscaled image.
+    if (info.dimensions() == codec_->dimensions()) {
+      options.fSubset = &region;
+      if (codec_->getPixels(region_info, pixels, row_bytes, &options) ==
+          SkCodec::kSuccess) {
+        return true;
+      }
+    }
+
+    // Scanline decoders (e.g. JPEG) crop the columns while decoding at any
+    // supported scale. The rows above the region are skipped and the rows
+    // below it are never decoded.
+    const SkIRect columns =
+        SkIRect::MakeXYWH(region.x(), 0, region.width(), info.height());
+    options.fSubset = &columns;
+    if (codec_->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder &&
+        codec_->startScanlineDecode(info, &options) == SkCodec::kSuccess &&
+        codec_->skipScanlines(region.y()) &&
+        codec_->getScanlines(pixels, region.height(), row_bytes) ==
+            region.height()) {
+      return true;
+    }
+  }
+  return ImageGenerator::GetPixelsInRegion(info, region, pixels, row_bytes);
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -13,6 +13,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -135,6 +136,30 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode only a region of the first frame of the image into a
+  ///             given buffer.
+  /// @param[in]  info       The size and color info of the whole decoded
+  ///                        image. As with `GetPixels`, the size must be one
+  ///                        returned by `GetScaledDimensions`.
+  /// @param[in]  region     The region of the decoded image to return, in the
+  ///                        coordinates of `info`. It must lie within the
+  ///                        bounds of `info`.
+  /// @param[in]  pixels     The location where the decoded region should be
+  ///                        written. It must be large enough for an image of
+  ///                        the region's size.
+  /// @param[in]  row_bytes  The total number of bytes that make up a single
+  ///                        row of the decoded region.
+  /// @return     True if the region was successfully decoded.
+  /// @note       The default implementation decodes the whole image into a
+  ///             temporary buffer and copies the region out of it. Decoders
+  ///             that can skip the pixels outside of the region should
+  ///             override it.
+  /// @see        `GetPixels`
+  virtual bool GetPixelsInRegion(const SkImageInfo& info,
+                                 const SkIRect& region,
+                                 void* pixels,
+                                 size_t row_bytes);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +237,12 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetPixelsInRegion(const SkImageInfo& info,
+                         const SkIRect& region,
+                         void* pixels,
+                         size_t row_bytes) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
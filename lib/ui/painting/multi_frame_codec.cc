@@ -4,9 +4,11 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <atomic>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -53,12 +55,49 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+namespace {
+
+// The maximum number of frames a codec decodes ahead of the frame that was
+// last requested.
+constexpr size_t kMaxLookaheadFrames = 2;
+
+// The number of bytes of frames decoded ahead of time, across all codecs of
+// all engines in the process. Lookahead is skipped once this budget is
+// exhausted so that many animated images on screen cannot grow the memory
+// footprint without bound.
+constexpr size_t kLookaheadBudgetBytes = 32 * 1024 * 1024;
+std::atomic<size_t> gLookaheadBytes = 0;
+
+bool ReserveLookaheadBytes(size_t bytes) {
+  size_t current = gLookaheadBytes.load(std::memory_order_relaxed);
+  do {
+    if (current + bytes > kLookaheadBudgetBytes) {
+      return false;
+    }
+  } while (!gLookaheadBytes.compare_exchange_weak(current, current + bytes,
+                                                  std::memory_order_relaxed));
+  return true;
+}
+
+void ReleaseLookaheadBytes(size_t bytes) {
+  gLookaheadBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+MultiFrameCodec::State::~State() {
+  for (const auto& frame : decodedFrames_) {
+    ReleaseLookaheadBytes(frame.bitmap.computeByteSize());
+  }
+}
+
+std::pair<std::optional<MultiFrameCodec::State::DecodedFrame>, std::string>
+MultiFrameCodec::State::DecodeNextFrame() {
+  const int frameIndex = decodeFrameIndex_;
+  // Frames are always decoded in order, so move on to the next frame even if
+  // this one fails. That matches the behavior of frames requested one by one.
+  decodeFrameIndex_ = (decodeFrameIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -71,11 +110,10 @@ MultiFrameCodec::State::GetNextFrameImage(
          << info.computeMinByteSize() << "B";
     std::string decode_error = ostr.str();
     FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    return std::make_pair(std::nullopt, decode_error);
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -86,7 +124,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -102,12 +140,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
+    ostr << "Could not getPixels for frame " << frameIndex;
     std::string decode_error = ostr.str();
     FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    return std::make_pair(std::nullopt, decode_error);
   }
 
   const bool keep_current_frame =
@@ -132,7 +170,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
   if (frameInfo.disposal_method ==
@@ -142,6 +180,107 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  // The bitmap may be shared with |lastRequiredFrame_|, which is never written
+  // to in place, so it is safe to hand out to another thread.
+  bitmap.setImmutable();
+  return std::make_pair(DecodedFrame{.index = frameIndex,
+                                     .duration = frameInfo.duration,
+                                     .bitmap = std::move(bitmap)},
+                        std::string());
+}
+
+std::pair<std::optional<MultiFrameCodec::State::DecodedFrame>, std::string>
+MultiFrameCodec::State::TakeNextFrame() {
+  {
+    std::unique_lock lock(decode_mutex_);
+    // A lookahead decode in progress is decoding the requested frame if none
+    // is ready yet.
+    decode_cv_.wait(lock,
+                    [this] { return !decoding_ || !decodedFrames_.empty(); });
+    if (!decodedFrames_.empty()) {
+      DecodedFrame frame = std::move(decodedFrames_.front());
+      decodedFrames_.pop_front();
+      ReleaseLookaheadBytes(frame.bitmap.computeByteSize());
+      FML_DCHECK(frame.index == nextFrameIndex_);
+      return std::make_pair(std::move(frame), std::string());
+    }
+    decoding_ = true;
+  }
+
+  FML_DCHECK(decodeFrameIndex_ == nextFrameIndex_);
+  auto result = DecodeNextFrame();
+
+  {
+    std::scoped_lock lock(decode_mutex_);
+    decoding_ = false;
+  }
+  decode_cv_.notify_all();
+  return result;
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  const size_t frame_bytes = generator_->GetInfo().computeMinByteSize();
+  std::unique_lock lock(decode_mutex_);
+  lookaheadPending_ = false;
+  while (!decoding_ && decodedFrames_.size() < kMaxLookaheadFrames) {
+    if (!ReserveLookaheadBytes(frame_bytes)) {
+      return;
+    }
+    decoding_ = true;
+    lock.unlock();
+
+    const int frame_index = decodeFrameIndex_;
+    auto [frame, decode_error] = DecodeNextFrame();
+    if (frame.has_value()) {
+      // Account for the real allocation which may include row padding.
+      gLookaheadBytes.fetch_add(frame->bitmap.computeByteSize(),
+                                std::memory_order_relaxed);
+    } else {
+      // Leave the failure to be reported when the frame is requested, which
+      // retries decoding it.
+      decodeFrameIndex_ = frame_index;
+    }
+    ReleaseLookaheadBytes(frame_bytes);
+
+    lock.lock();
+    decoding_ = false;
+    if (frame.has_value()) {
+      decodedFrames_.push_back(std::move(frame.value()));
+    }
+    decode_cv_.notify_all();
+    if (!frame.has_value()) {
+      return;
+    }
+  }
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner) {
+  if (!concurrent_runner || frameCount_ < 2) {
+    return;
+  }
+  {
+    std::scoped_lock lock(decode_mutex_);
+    if (lookaheadPending_ || decodedFrames_.size() >= kMaxLookaheadFrames) {
+      return;
+    }
+    lookaheadPending_ = true;
+  }
+  concurrent_runner->PostTask([weak_state = weak_from_this()]() {
+    if (auto state = weak_state.lock()) {
+      state->DecodeAhead();
+    }
+  });
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+MultiFrameCodec::State::GetNextFrameImage(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -193,15 +332,17 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   int duration = 0;
   sk_sp<DlImage> dlImage;
   std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+  std::optional<DecodedFrame> frame;
+  std::tie(frame, decode_error) = TakeNextFrame();
+  if (frame.has_value()) {
+    std::tie(dlImage, decode_error) = GetNextFrameImage(
+        frame->bitmap, std::move(resourceContext), gpu_disable_sync_switch,
+        impeller_context, std::move(unref_queue));
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame->duration;
   }
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
@@ -245,6 +386,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       concurrent_runner = dart_state->GetConcurrentTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -257,6 +399,9 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
             io_manager->GetImpellerContext());
+        // Decode the following frames while the current one is on screen so
+        // that the next request only has to upload.
+        state->ScheduleDecodeAhead(concurrent_runner);
       }));
 
   return Dart_Null();
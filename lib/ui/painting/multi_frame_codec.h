@@ -9,10 +9,18 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 namespace flutter {
 
+namespace testing {
+class ImageDecoderFixtureTest_MultiFrameCodecLookaheadRetriesFailedFrames_Test;
+}  // namespace testing
+
 class MultiFrameCodec : public Codec {
  public:
   explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
@@ -38,9 +46,11 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
+  struct State : public std::enable_shared_from_this<State> {
     explicit State(std::shared_ptr<ImageGenerator> generator);
 
+    ~State();
+
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
@@ -50,16 +60,66 @@ class MultiFrameCodec : public Codec {
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_ = 0;
+
+    // A frame that has been decoded and composited on the CPU ahead of being
+    // requested, but that has not been uploaded yet.
+    struct DecodedFrame {
+      int index = 0;
+      int duration = 0;
+      SkBitmap bitmap;
+    };
+
+    // Frames are decoded in order either on the IO thread when requested or
+    // ahead of time on the concurrent task runner. A thread claims the next
+    // decode by setting |decoding_| while holding |decode_mutex_|, and then
+    // decodes without holding the mutex.
+    //
+    // Guards |decoding_|, |decodedFrames_| and |lookaheadPending_|.
+    std::mutex decode_mutex_;
+    // Signaled when a claimed decode finishes.
+    std::condition_variable decode_cv_;
+    // Whether a thread has claimed the next decode.
+    bool decoding_ = false;
+    // Frames decoded ahead of time, starting at |nextFrameIndex_|.
+    std::deque<DecodedFrame> decodedFrames_;
+    // Whether a lookahead decode has been posted and not run yet.
+    bool lookaheadPending_ = false;
+
+    // Only accessed by the thread that claimed the next decode.
+    //
+    // The index of the next frame to decode.
+    int decodeFrameIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
-
     // The rectangle that should be cleared if the previous frame's disposal
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
+    // Decodes the frame at |decodeFrameIndex_| and advances it. Must be called
+    // by the thread that claimed the decode, without |decode_mutex_| held.
+    std::pair<std::optional<DecodedFrame>, std::string> DecodeNextFrame();
+
+    // Returns the frame at |nextFrameIndex_|, decoding it now if it was not
+    // decoded ahead of time. Waits for a lookahead decode of the frame that is
+    // in progress.
+    std::pair<std::optional<DecodedFrame>, std::string> TakeNextFrame();
+
+    // Decodes up to |kMaxLookaheadFrames| frames ahead of the current frame,
+    // within the lookahead byte budget. Safe to call on any thread.
+    //
+    // The budget is process-wide rather than per codec: it is shared by the
+    // codecs of all engines, so that the memory held by lookahead stays
+    // bounded however many animated images are on screen. A codec may
+    // therefore decode nothing ahead while other codecs hold the budget.
+    void DecodeAhead();
+
+    void ScheduleDecodeAhead(
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner);
+
     std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -78,6 +138,9 @@ class MultiFrameCodec : public Codec {
   // Shared across the UI and IO task runners.
   std::shared_ptr<State> state_;
 
+  FML_FRIEND_TEST(testing::ImageDecoderFixtureTest,
+                  MultiFrameCodecLookaheadRetriesFailedFrames);
+
   FML_FRIEND_MAKE_REF_COUNTED(MultiFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(MultiFrameCodec);
 };
@@ -449,7 +449,7 @@ class PlatformDispatcher {
 
   // This value must match kPointerDataFieldCount in pointer_data.cc. (The
   // pointer_data.cc also lists other locations that must be kept consistent.)
-  static const int _kPointerDataFieldCount = 36;
+  static const int _kPointerDataFieldCount = 39;
 
   static PointerDataPacket _unpackPointerDataPacket(ByteData packet) {
     const int kStride = Int64List.bytesPerElement;
@@ -459,6 +459,15 @@ class PlatformDispatcher {
     final List<PointerData> data = <PointerData>[];
     for (int i = 0; i < length; ++i) {
       int offset = i * _kPointerDataFieldCount;
+      // The records right before this one that are its earlier samples. See
+      // PointerDataCoalescer in pointer_data_dispatcher.h.
+      final int historicalSampleCount = packet.getInt64(kStride * (offset + _kPointerDataFieldCount - 1), _kFakeHostEndian);
+      assert(historicalSampleCount <= data.length);
+      List<PointerData> historical = const <PointerData>[];
+      if (historicalSampleCount > 0) {
+        historical = List<PointerData>.unmodifiable(data.sublist(data.length - historicalSampleCount));
+        data.removeRange(data.length - historicalSampleCount, data.length);
+      }
       data.add(PointerData(
         // The unpacking code must match the struct in pointer_data.h.
         embedderId: packet.getInt64(kStride * offset++, _kFakeHostEndian),
@@ -497,7 +506,11 @@ class PlatformDispatcher {
         scale: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
         rotation: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
         viewId: packet.getInt64(kStride * offset++, _kFakeHostEndian),
+        predictedPhysicalDeltaX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
+        predictedPhysicalDeltaY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
+        historical: historical,
       ));
+      offset++; // historical_sample_count was read above.
       assert(offset == (i + 1) * _kPointerDataFieldCount);
     }
     return PointerDataPacket(data: data);
@@ -177,6 +177,9 @@ class PointerData {
     this.panDeltaY = 0.0,
     this.scale = 0.0,
     this.rotation = 0.0,
+    this.predictedPhysicalDeltaX = 0.0,
+    this.predictedPhysicalDeltaY = 0.0,
+    this.historical = const <PointerData>[],
   });
 
   /// The ID of the [FlutterView] this [PointerEvent] originated from.
@@ -380,6 +383,29 @@ class PointerData {
   /// The current angle of the pan/zoom in radians, with 0.0 as the initial angle.
   final double rotation;
 
+  /// The distance on the X coordinate, in physical pixels, from [physicalX] to
+  /// where the pointer is expected to be one frame after [timeStamp].
+  ///
+  /// Zero if the engine did not predict the position of the pointer. The
+  /// engine only predicts positions of move and hover events that it
+  /// coalesced, see [historical].
+  final double predictedPhysicalDeltaX;
+
+  /// The distance on the Y coordinate, in physical pixels, from [physicalY] to
+  /// where the pointer is expected to be one frame after [timeStamp].
+  ///
+  /// Zero if the engine did not predict the position of the pointer.
+  final double predictedPhysicalDeltaY;
+
+  /// Earlier samples of this event, oldest first.
+  ///
+  /// When the engine coalesces move or hover events of a pointer that arrive
+  /// faster than the framework handles them, only the most recent one is
+  /// delivered as an event. The ones it replaced are kept here so that
+  /// consumers that need every sample, such as velocity trackers or stylus
+  /// strokes, still see them.
+  final List<PointerData> historical;
+
   @override
   String toString() => 'PointerData(viewId: $viewId, x: $physicalX, y: $physicalY)';
 
@@ -420,6 +446,9 @@ class PointerData {
              'panDeltaY: $panDeltaY, '
              'scale: $scale, '
              'rotation: $rotation, '
+             'predictedPhysicalDeltaX: $predictedPhysicalDeltaX, '
+             'predictedPhysicalDeltaY: $predictedPhysicalDeltaY, '
+             'historical: ${historical.length} samples, '
              'viewId: $viewId'
            ')';
   }
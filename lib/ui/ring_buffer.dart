@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.ui;
+
+/// Reads from a single-producer/single-consumer ring buffer that the embedder
+/// shares with this isolate.
+///
+/// The embedder creates the ring buffer with `FlutterEngineCreateRingBuffer`,
+/// which posts its storage to a [SendPort] of this isolate as a [Uint8List].
+/// Pass that list to this constructor. Afterwards, the embedder posts an
+/// [int] to the same port whenever there are new bytes to [read].
+///
+/// The positions in the control block of the storage are shared with the
+/// embedder's thread, and are loaded and stored with acquire and release
+/// semantics.
+class RingBufferReader {
+  /// Creates a reader of the storage posted by `FlutterEngineCreateRingBuffer`.
+  RingBufferReader(this.storage)
+      : assert(storage.lengthInBytes > _kHeaderSize),
+        capacity = ByteData.sublistView(storage)
+            .getUint32(_kCapacityOffset, Endian.host);
+
+  static const int _kWritePositionOffset = 0;
+  static const int _kNotificationPendingOffset = 8;
+  static const int _kCapacityOffset = 12;
+  static const int _kReadPositionOffset = 64;
+  static const int _kHeaderSize = 128;
+
+  /// The storage shared with the embedder, including the control block.
+  final Uint8List storage;
+
+  /// The number of payload bytes the ring buffer can hold.
+  final int capacity;
+
+  /// The number of bytes that can be read right now.
+  int get readableLength {
+    return _loadUint64Acquire(storage, _kWritePositionOffset) -
+        _loadUint64Acquire(storage, _kReadPositionOffset);
+  }
+
+  /// Copies up to `destination.length` bytes out of the ring buffer and
+  /// returns the number of bytes copied.
+  ///
+  /// Once the ring buffer has been drained, the embedder's next write sends a
+  /// new wakeup. Writes that raced with the drain did not, so when this
+  /// returns fewer bytes than requested, check [readableLength] once more
+  /// before waiting for the next wakeup.
+  int read(Uint8List destination) {
+    final int write = _loadUint64Acquire(storage, _kWritePositionOffset);
+    final int read = _loadUint64Acquire(storage, _kReadPositionOffset);
+    final int count = math.min(destination.length, write - read);
+
+    final int offset = read & (capacity - 1);
+    final int first = math.min(count, capacity - offset);
+    destination.setRange(0, first, storage, _kHeaderSize + offset);
+    destination.setRange(first, count, storage, _kHeaderSize);
+    _storeUint64Release(storage, _kReadPositionOffset, read + count);
+
+    if (read + count == write) {
+      _storeUint32Release(storage, _kNotificationPendingOffset, 0);
+    }
+    return count;
+  }
+
+  @Native<Int64 Function(Handle, Int64)>(symbol: 'RingBufferNatives::LoadUint64Acquire')
+  external static int _loadUint64Acquire(Uint8List storage, int offset);
+
+  @Native<Void Function(Handle, Int64, Int64)>(symbol: 'RingBufferNatives::StoreUint64Release')
+  external static void _storeUint64Release(Uint8List storage, int offset, int value);
+
+  @Native<Void Function(Handle, Int64, Int64)>(symbol: 'RingBufferNatives::StoreUint32Release')
+  external static void _storeUint32Release(Uint8List storage, int offset, int value);
+}
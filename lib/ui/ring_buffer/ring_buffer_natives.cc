@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/ring_buffer/ring_buffer_natives.h"
+
+#include <atomic>
+
+#include "third_party/tonic/converter/dart_converter.h"
+
+namespace flutter {
+
+namespace {
+
+// Gives scoped access to a field of the shared storage, or throws if the
+// field does not fit into the storage or is not naturally aligned.
+template <typename T>
+class ScopedAtomicField {
+ public:
+  ScopedAtomicField(Dart_Handle storage, int64_t offset) : storage_(storage) {
+    Dart_TypedData_Type type;
+    void* data = nullptr;
+    intptr_t length = 0;
+    if (Dart_IsError(
+            Dart_TypedDataAcquireData(storage_, &type, &data, &length))) {
+      Dart_ThrowException(tonic::ToDart("Storage is not typed data."));
+      return;
+    }
+    acquired_ = true;
+    if (type != Dart_TypedData_kUint8 || offset < 0 ||
+        offset + static_cast<int64_t>(sizeof(T)) > length ||
+        (reinterpret_cast<uintptr_t>(data) + offset) % alignof(T) != 0) {
+      Dart_TypedDataReleaseData(storage_);
+      acquired_ = false;
+      Dart_ThrowException(tonic::ToDart("Invalid ring buffer field."));
+      return;
+    }
+    field_ = reinterpret_cast<std::atomic<T>*>(static_cast<uint8_t*>(data) +
+                                               offset);
+  }
+
+  ~ScopedAtomicField() {
+    if (acquired_) {
+      Dart_TypedDataReleaseData(storage_);
+    }
+  }
+
+  std::atomic<T>* get() const { return field_; }
+
+ private:
+  Dart_Handle storage_;
+  bool acquired_ = false;
+  std::atomic<T>* field_ = nullptr;
+};
+
+}  // namespace
+
+// The embedder accesses the same fields as std::atomic, which is only
+// meaningful to Dart if they are plain integers.
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+int64_t RingBufferNatives::LoadUint64Acquire(Dart_Handle storage,
+                                             int64_t offset) {
+  ScopedAtomicField<uint64_t> field(storage, offset);
+  if (!field.get()) {
+    return 0;
+  }
+  return static_cast<int64_t>(field.get()->load(std::memory_order_acquire));
+}
+
+void RingBufferNatives::StoreUint64Release(Dart_Handle storage,
+                                           int64_t offset,
+                                           int64_t value) {
+  ScopedAtomicField<uint64_t> field(storage, offset);
+  if (field.get()) {
+    field.get()->store(static_cast<uint64_t>(value),
+                       std::memory_order_release);
+  }
+}
+
+void RingBufferNatives::StoreUint32Release(Dart_Handle storage,
+                                           int64_t offset,
+                                           int64_t value) {
+  ScopedAtomicField<uint32_t> field(storage, offset);
+  if (field.get()) {
+    field.get()->store(static_cast<uint32_t>(value),
+                       std::memory_order_release);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
+#define FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
+
+#include <cstdint>
+
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The atomic accesses that `RingBufferReader` in dart:ui makes to
+///             the control block of a ring buffer shared with the embedder.
+///             The embedder side is |EmbedderRingBuffer|.
+///
+class RingBufferNatives {
+ public:
+  static int64_t LoadUint64Acquire(Dart_Handle storage, int64_t offset);
+  static void StoreUint64Release(Dart_Handle storage,
+                                 int64_t offset,
+                                 int64_t value);
+  static void StoreUint32Release(Dart_Handle storage,
+                                 int64_t offset,
+                                 int64_t value);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_RING_BUFFER_RING_BUFFER_NATIVES_H_
@@ -44,6 +44,7 @@ part 'platform_dispatcher.dart';
 part 'platform_isolate.dart';
 part 'plugins.dart';
 part 'pointer.dart';
+part 'ring_buffer.dart';
 part 'semantics.dart';
 part 'setup_hooks.dart';
 part 'text.dart';
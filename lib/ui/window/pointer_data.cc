@@ -16,7 +16,7 @@ namespace flutter {
 //  * POINTER_DATA_FIELD_COUNT in AndroidTouchProcessor.java
 //
 // (This is a centralized list of all locations that should be kept up-to-date.)
-static constexpr int kPointerDataFieldCount = 36;
+static constexpr int kPointerDataFieldCount = 39;
 static constexpr int kBytesPerField = sizeof(int64_t);
 
 static_assert(sizeof(PointerData) == kBytesPerField * kPointerDataFieldCount,
@@ -103,6 +103,15 @@ struct alignas(8) PointerData {
   double scale;
   double rotation;
   int64_t view_id;
+  // Where the pointer is expected to be one frame after `time_stamp`,
+  // relative to `physical_x` and `physical_y`. Zero if there is no
+  // prediction.
+  double predicted_physical_delta_x;
+  double predicted_physical_delta_y;
+  // The number of records right before this one in the packet that are
+  // earlier samples of this event rather than events of their own. See
+  // `PointerDataCoalescer`.
+  int64_t historical_sample_count;
 
   void Clear();
 };
@@ -46,6 +46,9 @@ void CreateSimulatedPointerData(PointerData& data,  // NOLINT
   data.scroll_delta_x = 0.0;
   data.scroll_delta_y = 0.0;
   data.view_id = 0;
+  data.predicted_physical_delta_x = 0.0;
+  data.predicted_physical_delta_y = 0.0;
+  data.historical_sample_count = 0;
 }
 
 void CreateSimulatedMousePointerData(PointerData& data,  // NOLINT
@@ -86,6 +89,9 @@ void CreateSimulatedMousePointerData(PointerData& data,  // NOLINT
   data.scroll_delta_x = scroll_delta_x;
   data.scroll_delta_y = scroll_delta_y;
   data.view_id = 0;
+  data.predicted_physical_delta_x = 0.0;
+  data.predicted_physical_delta_y = 0.0;
+  data.historical_sample_count = 0;
 }
 
 void CreateSimulatedTrackpadGestureData(PointerData& data,  // NOLINT
@@ -132,6 +138,9 @@ void CreateSimulatedTrackpadGestureData(PointerData& data,  // NOLINT
   data.scale = scale;
   data.rotation = rotation;
   data.view_id = 0;
+  data.predicted_physical_delta_x = 0.0;
+  data.predicted_physical_delta_y = 0.0;
+  data.historical_sample_count = 0;
 }
 
 void UnpackPointerPacket(std::vector<PointerData>& output,  // NOLINT
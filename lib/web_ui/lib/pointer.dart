@@ -72,6 +72,9 @@ class PointerData {
     this.panDeltaY = 0.0,
     this.scale = 0.0,
     this.rotation = 0.0,
+    this.predictedPhysicalDeltaX = 0.0,
+    this.predictedPhysicalDeltaY = 0.0,
+    this.historical = const <PointerData>[],
   });
   final int viewId;
   final int embedderId;
@@ -109,6 +112,9 @@ class PointerData {
   final double panDeltaY;
   final double scale;
   final double rotation;
+  final double predictedPhysicalDeltaX;
+  final double predictedPhysicalDeltaY;
+  final List<PointerData> historical;
 
   @override
   String toString() => 'PointerData(viewId: $viewId, x: $physicalX, y: $physicalY)';
@@ -148,6 +154,9 @@ class PointerData {
            'panDeltaY: $panDeltaY, '
            'scale: $scale, '
            'rotation: $rotation, '
+           'predictedPhysicalDeltaX: $predictedPhysicalDeltaX, '
+           'predictedPhysicalDeltaY: $predictedPhysicalDeltaY, '
+           'historical: ${historical.length} samples, '
            'viewId: $viewId'
            ')';
   }
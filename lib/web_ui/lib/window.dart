@@ -168,6 +168,22 @@ abstract final class IsolateNameServer {
   }
 }
 
+class RingBufferReader {
+  RingBufferReader(this.storage) : capacity = 0;
+
+  final Uint8List storage;
+
+  final int capacity;
+
+  int get readableLength {
+    throw UnimplementedError();
+  }
+
+  int read(Uint8List destination) {
+    throw UnimplementedError();
+  }
+}
+
 SingletonFlutterWindow get window => engine.window;
 
 class FrameData {
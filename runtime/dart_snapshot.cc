@@ -254,6 +254,15 @@ const uint8_t* DartSnapshot::GetInstructionsMapping() const {
   return instructions_ ? instructions_->GetMapping() : nullptr;
 }
 
+const std::shared_ptr<const fml::Mapping>& DartSnapshot::GetData() const {
+  return data_;
+}
+
+const std::shared_ptr<const fml::Mapping>& DartSnapshot::GetInstructions()
+    const {
+  return instructions_;
+}
+
 bool DartSnapshot::IsDontNeedSafe() const {
   if (data_ && !data_->IsDontNeedSafe()) {
     return false;
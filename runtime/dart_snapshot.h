@@ -160,6 +160,20 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///
   const uint8_t* GetInstructionsMapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the mapping of the heap snapshot.
+  ///
+  /// @return     The data mapping, or null if there is none.
+  ///
+  const std::shared_ptr<const fml::Mapping>& GetData() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the mapping of the instructions snapshot.
+  ///
+  /// @return     The instructions mapping, or null if there is none.
+  ///
+  const std::shared_ptr<const fml::Mapping>& GetInstructions() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns whether both the data and instructions mappings are
   ///             safe to use with madvise(DONTNEED).
@@ -34,6 +34,8 @@ const std::string_view ServiceProtocol::kGetDisplayRefreshRateExtensionName =
     "_flutter.getDisplayRefreshRate";
 const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
     "_flutter.getSkSLs";
+const std::string_view ServiceProtocol::kGetFrameStatisticsExtensionName =
+    "_flutter.getFrameStatistics";
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
@@ -42,6 +44,8 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetTraceRingBufferExtensionName =
+    "_flutter.getTraceRingBuffer";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -60,9 +64,11 @@ ServiceProtocol::ServiceProtocol()
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
+          kGetFrameStatisticsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kGetTraceRingBufferExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
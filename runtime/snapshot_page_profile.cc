@@ -0,0 +1,245 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+
+#if defined(FML_OS_POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // defined(FML_OS_POSIX)
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x50534c46;  // "FLSP"
+constexpr uint32_t kVersion = 1u;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t page_size;
+  uint32_t mapping_count;
+};
+
+struct MappingHeader {
+  uint64_t mapping_size;
+  uint32_t range_count;
+  uint32_t reserved;
+};
+
+size_t GetPageSize() {
+#if defined(FML_OS_POSIX)
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  return page_size;
+#else   // defined(FML_OS_POSIX)
+  return 4096u;
+#endif  // defined(FML_OS_POSIX)
+}
+
+// The first page of the mapping and the number of pages it spans. Mappings
+// of symbols in a shared library need not start on a page boundary.
+std::pair<uint8_t*, size_t> GetPages(const fml::Mapping& mapping) {
+  const size_t page_size = GetPageSize();
+  const uintptr_t start = reinterpret_cast<uintptr_t>(mapping.GetMapping());
+  const uintptr_t first_page = start & ~(page_size - 1u);
+  const uintptr_t end = start + mapping.GetSize();
+  return {reinterpret_cast<uint8_t*>(first_page),
+          (end - first_page + page_size - 1u) / page_size};
+}
+
+}  // namespace
+
+SnapshotPageProfile::SnapshotPageProfile(
+    const fml::RefPtr<const DartSnapshot>& vm_snapshot,
+    const fml::RefPtr<const DartSnapshot>& isolate_snapshot) {
+  for (const auto& snapshot : {vm_snapshot, isolate_snapshot}) {
+    mappings_.push_back(snapshot ? snapshot->GetData() : nullptr);
+    mappings_.push_back(snapshot ? snapshot->GetInstructions() : nullptr);
+  }
+}
+
+SnapshotPageProfile::~SnapshotPageProfile() = default;
+
+bool SnapshotPageProfile::IsSupported() {
+#if defined(FML_OS_POSIX)
+  return true;
+#else   // defined(FML_OS_POSIX)
+  return false;
+#endif  // defined(FML_OS_POSIX)
+}
+
+std::vector<SnapshotPageProfile::PageRange>
+SnapshotPageProfile::GetResidentPages(const fml::Mapping& mapping) {
+  std::vector<PageRange> ranges;
+#if defined(FML_OS_POSIX)
+  if (mapping.GetMapping() == nullptr || mapping.GetSize() == 0u) {
+    return ranges;
+  }
+  auto [first_page, page_count] = GetPages(mapping);
+#if defined(FML_OS_MACOSX)
+  std::vector<char> residency(page_count);
+#else   // defined(FML_OS_MACOSX)
+  std::vector<unsigned char> residency(page_count);
+#endif  // defined(FML_OS_MACOSX)
+  if (::mincore(first_page, page_count * GetPageSize(), residency.data()) !=
+      0) {
+    FML_DLOG(ERROR) << "Could not query the residency of a snapshot.";
+    return ranges;
+  }
+  for (size_t page = 0; page < page_count; page++) {
+    if ((residency[page] & 1) == 0) {
+      continue;
+    }
+    if (!ranges.empty() &&
+        ranges.back().first_page + ranges.back().page_count == page) {
+      ranges.back().page_count++;
+    } else {
+      ranges.push_back({static_cast<uint32_t>(page), 1u});
+    }
+  }
+#endif  // defined(FML_OS_POSIX)
+  return ranges;
+}
+
+size_t SnapshotPageProfile::LimitPages(std::vector<PageRange>& ranges,
+                                       size_t max_pages) {
+  size_t pages = 0u;
+  for (auto range = ranges.begin(); range != ranges.end(); range++) {
+    if (pages + range->page_count >= max_pages) {
+      range->page_count = max_pages - pages;
+      ranges.erase(range->page_count == 0u ? range : range + 1, ranges.end());
+      return max_pages;
+    }
+    pages += range->page_count;
+  }
+  return pages;
+}
+
+size_t SnapshotPageProfile::Prefetch(const fml::Mapping& mapping,
+                                     const std::vector<PageRange>& ranges) {
+  size_t prefetched_pages = 0u;
+#if defined(FML_OS_POSIX)
+  if (mapping.GetMapping() == nullptr || mapping.GetSize() == 0u) {
+    return prefetched_pages;
+  }
+  auto [first_page, page_count] = GetPages(mapping);
+  for (const auto& range : ranges) {
+    if (range.first_page >= page_count) {
+      continue;
+    }
+    const size_t count = std::min<size_t>(range.page_count,
+                                          page_count - range.first_page);
+    if (::madvise(first_page + range.first_page * GetPageSize(),
+                  count * GetPageSize(), MADV_WILLNEED) == 0) {
+      prefetched_pages += count;
+    }
+  }
+#endif  // defined(FML_OS_POSIX)
+  return prefetched_pages;
+}
+
+std::unique_ptr<fml::Mapping> SnapshotPageProfile::Record() const {
+  TRACE_EVENT0("flutter", "SnapshotPageProfile::Record");
+  std::vector<uint8_t> data(sizeof(Header));
+  Header header = {};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.page_size = GetPageSize();
+  header.mapping_count = mappings_.size();
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  size_t remaining_pages = kMaxProfiledPages;
+  for (const auto& mapping : mappings_) {
+    std::vector<PageRange> ranges;
+    MappingHeader mapping_header = {};
+    if (mapping) {
+      ranges = GetResidentPages(*mapping);
+      remaining_pages -= LimitPages(ranges, remaining_pages);
+      mapping_header.mapping_size = mapping->GetSize();
+    }
+    mapping_header.range_count = ranges.size();
+    const size_t offset = data.size();
+    data.resize(offset + sizeof(MappingHeader) +
+                ranges.size() * sizeof(PageRange));
+    std::memcpy(data.data() + offset, &mapping_header, sizeof(MappingHeader));
+    if (!ranges.empty()) {
+      std::memcpy(data.data() + offset + sizeof(MappingHeader), ranges.data(),
+                  ranges.size() * sizeof(PageRange));
+    }
+  }
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+size_t SnapshotPageProfile::Replay(const fml::Mapping& profile) const {
+  TRACE_EVENT0("flutter", "SnapshotPageProfile::Replay");
+  const uint8_t* data = profile.GetMapping();
+  const size_t size = profile.GetSize();
+  Header header;
+  if (data == nullptr || size < sizeof(Header)) {
+    return 0u;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.page_size != GetPageSize() ||
+      header.mapping_count != mappings_.size()) {
+    FML_LOG(WARNING) << "Ignoring an incompatible snapshot page profile.";
+    return 0u;
+  }
+
+  size_t prefetched_pages = 0u;
+  size_t remaining_pages = kMaxProfiledPages;
+  size_t offset = sizeof(Header);
+  for (const auto& mapping : mappings_) {
+    MappingHeader mapping_header;
+    if (size - offset < sizeof(MappingHeader)) {
+      break;
+    }
+    std::memcpy(&mapping_header, data + offset, sizeof(MappingHeader));
+    offset += sizeof(MappingHeader);
+    if ((size - offset) / sizeof(PageRange) < mapping_header.range_count) {
+      break;
+    }
+    std::vector<PageRange> ranges(mapping_header.range_count);
+    if (!ranges.empty()) {
+      std::memcpy(ranges.data(), data + offset,
+                  ranges.size() * sizeof(PageRange));
+    }
+    offset += ranges.size() * sizeof(PageRange);
+    if (mapping && mapping->GetSize() == mapping_header.mapping_size) {
+      remaining_pages -= LimitPages(ranges, remaining_pages);
+      prefetched_pages += Prefetch(*mapping, ranges);
+    }
+  }
+  return prefetched_pages;
+}
+
+bool SnapshotPageProfile::RecordToFile(const std::string& path) const {
+  auto directory =
+      fml::OpenDirectory(fml::paths::GetDirectoryName(path).c_str(), false,
+                         fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    return false;
+  }
+  const std::string file_name = path.substr(path.find_last_of("/\\") + 1);
+  return fml::WriteAtomically(directory, file_name.c_str(), *Record());
+}
+
+size_t SnapshotPageProfile::ReplayFromFile(const std::string& path) const {
+  auto profile = fml::FileMapping::CreateReadOnly(path);
+  if (!profile) {
+    return 0u;
+  }
+  return Replay(*profile);
+}
+
+}  // namespace flutter
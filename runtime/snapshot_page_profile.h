@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/runtime/dart_snapshot.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A snapshot of which pages of the Dart snapshots were resident
+///             in memory after an application launched.
+///
+///             Snapshots are mapped lazily, so without a profile their pages
+///             are faulted in one at a time, in whatever order the VM first
+///             touches them. Replaying a profile recorded on a previous launch
+///             asks the kernel to read those pages ahead before the VM needs
+///             them.
+///
+///             This is not a trace of the page faults of the launch. Residency
+///             is read from the page cache, so a profile also covers pages that
+///             the kernel read ahead around the faults, and pages that were
+///             cached before the launch. Pages are recorded in address order
+///             rather than in the order they were touched, and are read ahead
+///             in that order. A profile covers at most `kMaxProfiledPages`
+///             pages, so that a fully cached snapshot does not make every
+///             later launch read all of it.
+///
+///             Residency is only observable on POSIX platforms. Elsewhere, an
+///             empty profile is recorded and replaying is a no-op.
+///
+class SnapshotPageProfile {
+ public:
+  /// The number of pages a profile records and replays at most, across all
+  /// snapshots. The pages of the VM snapshot come first.
+  static constexpr size_t kMaxProfiledPages = 4096u;
+
+  /// A run of consecutive pages, relative to the first page of a mapping.
+  struct PageRange {
+    uint32_t first_page = 0u;
+    uint32_t page_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a profile of the data and instructions mappings of
+  ///             the given snapshots. Either snapshot may be null.
+  ///
+  SnapshotPageProfile(const fml::RefPtr<const DartSnapshot>& vm_snapshot,
+                      const fml::RefPtr<const DartSnapshot>& isolate_snapshot);
+
+  ~SnapshotPageProfile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether residency is observable on this platform, and so
+  ///             whether recording and replaying profiles does anything.
+  ///
+  static bool IsSupported();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the pages of the snapshots that are currently
+  ///             resident in memory.
+  ///
+  ///             Residency includes pages read ahead by the kernel or by
+  ///             replaying a profile, and pages left in the page cache by
+  ///             other processes. Profiles should only be recorded on
+  ///             launches that did not replay one, so that they do not grow
+  ///             with every launch. Pages past `kMaxProfiledPages` are not
+  ///             recorded.
+  ///
+  /// @return     The serialized profile.
+  ///
+  std::unique_ptr<fml::Mapping> Record() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to read ahead the pages in the serialized
+  ///             profile. This does not wait for the reads to complete.
+  ///
+  ///             Snapshots whose size differs from the one they had when the
+  ///             profile was recorded are skipped, since the application has
+  ///             been updated since. Pages past `kMaxProfiledPages` are not
+  ///             read ahead.
+  ///
+  /// @return     The number of pages that were prefetched.
+  ///
+  size_t Replay(const fml::Mapping& profile) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the profile and writes it to the given file. The
+  ///             directory of the file must already exist.
+  ///
+  bool RecordToFile(const std::string& path) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replays the profile in the given file, if there is one.
+  ///
+  size_t ReplayFromFile(const std::string& path) const;
+
+  static std::vector<PageRange> GetResidentPages(const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the pages past the given number from the ranges.
+  ///
+  /// @return     The number of pages left in the ranges.
+  ///
+  static size_t LimitPages(std::vector<PageRange>& ranges, size_t max_pages);
+
+  static size_t Prefetch(const fml::Mapping& mapping,
+                         const std::vector<PageRange>& ranges);
+
+ private:
+  std::vector<std::shared_ptr<const fml::Mapping>> mappings_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SnapshotPageProfile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
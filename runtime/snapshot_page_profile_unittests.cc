@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct ProfileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t page_size;
+  uint32_t mapping_count;
+};
+
+std::shared_ptr<const fml::Mapping> CreateSnapshotFile(
+    const fml::UniqueFD& directory,
+    const char* name,
+    size_t size) {
+  std::vector<uint8_t> contents(size, 0xab);
+  fml::DataMapping data(std::move(contents));
+  if (!fml::WriteAtomically(directory, name, data)) {
+    return nullptr;
+  }
+  return fml::FileMapping::CreateReadOnly(directory, name);
+}
+
+}  // namespace
+
+TEST(SnapshotPageProfileTest, RecordsAndReplaysResidentPages) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto data = CreateSnapshotFile(temp_dir.fd(), "data", 64u * 1024u);
+  auto instructions =
+      CreateSnapshotFile(temp_dir.fd(), "instructions", 32u * 1024u);
+  ASSERT_TRUE(data);
+  ASSERT_TRUE(instructions);
+  auto snapshot = DartSnapshot::IsolateSnapshotFromMappings(data, instructions);
+  ASSERT_TRUE(snapshot);
+
+  // Touch the start of the data so that at least one page is resident.
+  volatile uint8_t first_byte = data->GetMapping()[0];
+  (void)first_byte;
+
+  SnapshotPageProfile profile(nullptr, snapshot);
+  const std::string path =
+      fml::paths::JoinPaths({temp_dir.path(), "launch.profile"});
+  ASSERT_TRUE(profile.RecordToFile(path));
+
+#if defined(FML_OS_POSIX)
+  EXPECT_FALSE(SnapshotPageProfile::GetResidentPages(*data).empty());
+  EXPECT_GT(profile.ReplayFromFile(path), 0u);
+#else   // defined(FML_OS_POSIX)
+  EXPECT_EQ(profile.ReplayFromFile(path), 0u);
+#endif  // defined(FML_OS_POSIX)
+
+  // A snapshot of a different size belongs to another build of the
+  // application and is not prefetched.
+  auto other_data = CreateSnapshotFile(temp_dir.fd(), "other", 16u * 1024u);
+  ASSERT_TRUE(other_data);
+  SnapshotPageProfile other_profile(
+      nullptr, DartSnapshot::IsolateSnapshotFromMappings(other_data, nullptr));
+  EXPECT_EQ(other_profile.ReplayFromFile(path), 0u);
+}
+
+TEST(SnapshotPageProfileTest, IgnoresMalformedProfiles) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto data = CreateSnapshotFile(temp_dir.fd(), "data", 16u * 1024u);
+  ASSERT_TRUE(data);
+  SnapshotPageProfile profile(
+      nullptr, DartSnapshot::IsolateSnapshotFromMappings(data, nullptr));
+
+  EXPECT_EQ(profile.Replay(fml::DataMapping(std::vector<uint8_t>{})), 0u);
+  EXPECT_EQ(profile.ReplayFromFile(
+                fml::paths::JoinPaths({temp_dir.path(), "missing.profile"})),
+            0u);
+
+  auto recorded = profile.Record();
+  ASSERT_TRUE(recorded);
+  ASSERT_GE(recorded->GetSize(), sizeof(ProfileHeader));
+
+  std::vector<uint8_t> incompatible(
+      recorded->GetMapping(), recorded->GetMapping() + recorded->GetSize());
+  ProfileHeader header;
+  std::memcpy(&header, incompatible.data(), sizeof(header));
+  header.version++;
+  std::memcpy(incompatible.data(), &header, sizeof(header));
+  EXPECT_EQ(profile.Replay(fml::DataMapping(std::move(incompatible))), 0u);
+
+  // Profiles that were cut short are not read past their end.
+  std::vector<uint8_t> truncated(recorded->GetMapping(),
+                                 recorded->GetMapping() + sizeof(header));
+  EXPECT_EQ(profile.Replay(fml::DataMapping(std::move(truncated))), 0u);
+}
+
+TEST(SnapshotPageProfileTest, PrefetchClampsRangesToTheMapping) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto data = CreateSnapshotFile(temp_dir.fd(), "data", 16u * 1024u);
+  ASSERT_TRUE(data);
+  const size_t prefetched = SnapshotPageProfile::Prefetch(
+      *data, {{0u, 1u}, {0u, 1000000u}, {1000000u, 1u}});
+#if defined(FML_OS_POSIX)
+  EXPECT_GT(prefetched, 1u);
+  EXPECT_LE(prefetched, 1u + (16u * 1024u) / 4096u + 1u);
+#else   // defined(FML_OS_POSIX)
+  EXPECT_EQ(prefetched, 0u);
+#endif  // defined(FML_OS_POSIX)
+}
+
+TEST(SnapshotPageProfileTest, LimitsTheNumberOfPages) {
+  std::vector<SnapshotPageProfile::PageRange> ranges = {
+      {0u, 4u}, {8u, 4u}, {16u, 4u}};
+  EXPECT_EQ(SnapshotPageProfile::LimitPages(ranges, 100u), 12u);
+  EXPECT_EQ(ranges.size(), 3u);
+
+  EXPECT_EQ(SnapshotPageProfile::LimitPages(ranges, 6u), 6u);
+  ASSERT_EQ(ranges.size(), 2u);
+  EXPECT_EQ(ranges[1].first_page, 8u);
+  EXPECT_EQ(ranges[1].page_count, 2u);
+
+  EXPECT_EQ(SnapshotPageProfile::LimitPages(ranges, 4u), 4u);
+  EXPECT_EQ(ranges.size(), 1u);
+
+  EXPECT_EQ(SnapshotPageProfile::LimitPages(ranges, 0u), 0u);
+  EXPECT_TRUE(ranges.empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
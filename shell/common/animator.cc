@@ -46,6 +46,11 @@ Animator::Animator(Delegate& delegate,
 
 Animator::~Animator() = default;
 
+void Animator::SetFrameStatistics(
+    std::shared_ptr<FrameStatistics> frame_statistics) {
+  frame_statistics_ = std::move(frame_statistics);
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -69,7 +74,12 @@ void Animator::BeginFrame(
   frame_request_number_++;
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
-  frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  const fml::TimePoint build_start = fml::TimePoint::Now();
+  frame_timings_recorder_->RecordBuildStart(build_start);
+  if (frame_statistics_) {
+    frame_statistics_->RecordVsyncOverhead(
+        build_start - frame_timings_recorder_->GetVsyncStartTime());
+  }
 
   size_t flow_id_count = trace_flow_ids_.size();
   std::unique_ptr<uint64_t[]> flow_ids =
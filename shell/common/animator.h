@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -51,6 +52,10 @@ class Animator final {
 
   ~Animator();
 
+  /// Sets the aggregator that the vsync overhead of every frame is recorded
+  /// into. May be null.
+  void SetFrameStatistics(std::shared_ptr<FrameStatistics> frame_statistics);
+
   void RequestFrame(bool regenerate_layer_trees = true);
 
   //--------------------------------------------------------------------------
@@ -134,6 +139,7 @@ class Animator final {
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  std::shared_ptr<FrameStatistics> frame_statistics_;
 
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder_;
   std::unordered_map<int64_t, std::unique_ptr<LayerTreeTask>>
@@ -108,6 +108,18 @@ void onPointerDataPacketMain() {
   };
 }
 
+@pragma('vm:entry-point')
+void onHistoricalPointerDataPacketMain() {
+  PlatformDispatcher.instance.onPointerDataPacket = (PointerDataPacket packet) {
+    List<int> sequence = <int>[];
+    for (PointerData data in packet.data) {
+      sequence.add(PointerChange.values.indexOf(data.change));
+      sequence.add(data.historical.length);
+    }
+    nativeOnPointerDataPacket(sequence);
+  };
+}
+
 @pragma('vm:entry-point')
 void emptyMain() {}
 
@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+FrameStatisticsHistogram::FrameStatisticsHistogram() {
+  Reset();
+}
+
+FrameStatisticsHistogram::~FrameStatisticsHistogram() = default;
+
+size_t FrameStatisticsHistogram::GetBucketIndex(uint64_t value) {
+  if (value < kSubBucketCount) {
+    return value;
+  }
+  size_t exponent = 63u;
+  while ((value >> exponent) == 0u) {
+    exponent--;
+  }
+  const size_t shift = exponent - kSubBucketBits;
+  const size_t sub_bucket = (value >> shift) - kSubBucketCount;
+  return (shift + 1u) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t FrameStatisticsHistogram::GetBucketUpperBound(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const size_t shift = index / kSubBucketCount - 1u;
+  const uint64_t sub_bucket = index % kSubBucketCount;
+  const uint64_t lower = (kSubBucketCount + sub_bucket) << shift;
+  return lower + ((uint64_t{1} << shift) - 1u);
+}
+
+void FrameStatisticsHistogram::Record(uint64_t value) {
+  buckets_[GetBucketIndex(value)].fetch_add(1u, std::memory_order_relaxed);
+  count_.fetch_add(1u, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max &&
+         !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t FrameStatisticsHistogram::GetValueAtPercentile(
+    double percentile) const {
+  // Recording may continue while this walks the buckets, so use the counts as
+  // they are read rather than |count_|.
+  std::array<uint64_t, kBucketCount> counts;
+  uint64_t total = 0u;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0u) {
+    return 0u;
+  }
+  const uint64_t target = std::max<uint64_t>(
+      1u, std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * total));
+  uint64_t seen = 0u;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += counts[i];
+    if (seen >= target) {
+      return std::min(GetBucketUpperBound(i),
+                      max_.load(std::memory_order_relaxed));
+    }
+  }
+  return max_.load(std::memory_order_relaxed);
+}
+
+FrameStatisticsHistogram::Summary FrameStatisticsHistogram::GetSummary()
+    const {
+  Summary summary;
+  summary.count = count_.load(std::memory_order_relaxed);
+  summary.max = max_.load(std::memory_order_relaxed);
+  if (summary.count > 0u) {
+    summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                   summary.count;
+  }
+  summary.p50 = GetValueAtPercentile(50.0);
+  summary.p90 = GetValueAtPercentile(90.0);
+  summary.p99 = GetValueAtPercentile(99.0);
+  return summary;
+}
+
+void FrameStatisticsHistogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0u, std::memory_order_relaxed);
+  }
+  count_.store(0u, std::memory_order_relaxed);
+  sum_.store(0u, std::memory_order_relaxed);
+  max_.store(0u, std::memory_order_relaxed);
+}
+
+FrameStatistics::FrameStatistics() = default;
+
+FrameStatistics::~FrameStatistics() = default;
+
+FrameStatisticsHistogram& FrameStatistics::GetHistogram(Histogram histogram) {
+  return histograms_[static_cast<size_t>(histogram)];
+}
+
+static uint64_t ToMicroseconds(fml::TimeDelta delta) {
+  return std::max<int64_t>(delta.ToMicroseconds(), 0);
+}
+
+void FrameStatistics::RecordVsyncOverhead(fml::TimeDelta overhead) {
+  GetHistogram(Histogram::kVsyncOverhead).Record(ToMicroseconds(overhead));
+}
+
+void FrameStatistics::RecordRasterizedFrame(
+    const FrameTimingsRecorder& recorder) {
+  const fml::TimePoint vsync_start = recorder.GetVsyncStartTime();
+  const fml::TimePoint raster_end = recorder.GetRasterEndTime();
+  const fml::TimeDelta budget = recorder.GetVsyncTargetTime() - vsync_start;
+  const fml::TimeDelta build = recorder.GetBuildDuration();
+  const fml::TimeDelta raster = raster_end - recorder.GetRasterStartTime();
+  GetHistogram(Histogram::kBuild).Record(ToMicroseconds(build));
+  GetHistogram(Histogram::kRaster).Record(ToMicroseconds(raster));
+  GetHistogram(Histogram::kTotal)
+      .Record(ToMicroseconds(raster_end - vsync_start));
+  GetHistogram(Histogram::kRasterCacheBytes)
+      .Record(recorder.GetLayerCacheBytes() + recorder.GetPictureCacheBytes());
+
+  frame_count_.fetch_add(1u, std::memory_order_relaxed);
+  if (build > budget || raster > budget) {
+    janky_frame_count_.fetch_add(1u, std::memory_order_relaxed);
+  }
+}
+
+void FrameStatistics::RecordGpuFrameTime(fml::TimeDelta gpu_time) {
+  GetHistogram(Histogram::kGpu).Record(ToMicroseconds(gpu_time));
+}
+
+FrameStatistics::Summary FrameStatistics::GetSummary() const {
+  Summary summary;
+  summary.frame_count = frame_count_.load(std::memory_order_relaxed);
+  summary.janky_frame_count =
+      janky_frame_count_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kHistogramCount; i++) {
+    summary.histograms[i] = histograms_[i].GetSummary();
+  }
+  return summary;
+}
+
+void FrameStatistics::Reset() {
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+  frame_count_.store(0u, std::memory_order_relaxed);
+  janky_frame_count_.store(0u, std::memory_order_relaxed);
+}
+
+}  // namespace flutter
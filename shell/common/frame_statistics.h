@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/flow/frame_timings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// A histogram of unsigned values with a bounded relative error, in the style
+/// of an HDR histogram. Values below |kSubBucketCount| are counted exactly.
+/// Larger values share a bucket with the values that have the same leading
+/// |kSubBucketBits| + 1 bits, which bounds the error to 1/|kSubBucketCount|.
+///
+/// Recording is lock-free and can happen concurrently from any thread.
+class FrameStatisticsHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 4u;
+  static constexpr size_t kSubBucketCount = 1u << kSubBucketBits;
+  static constexpr size_t kBucketCount =
+      (64u - kSubBucketBits + 1u) * kSubBucketCount;
+
+  struct Summary {
+    uint64_t count = 0u;
+    uint64_t max = 0u;
+    double mean = 0.0;
+    uint64_t p50 = 0u;
+    uint64_t p90 = 0u;
+    uint64_t p99 = 0u;
+  };
+
+  FrameStatisticsHistogram();
+
+  ~FrameStatisticsHistogram();
+
+  void Record(uint64_t value);
+
+  /// The smallest recorded value that is at least |percentile| percent of
+  /// the recorded values, rounded up to the largest value of its bucket.
+  uint64_t GetValueAtPercentile(double percentile) const;
+
+  Summary GetSummary() const;
+
+  void Reset();
+
+  static size_t GetBucketIndex(uint64_t value);
+
+  static uint64_t GetBucketUpperBound(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+  std::atomic<uint64_t> count_ = 0u;
+  std::atomic<uint64_t> sum_ = 0u;
+  std::atomic<uint64_t> max_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatisticsHistogram);
+};
+
+/// Aggregates the timings of every rendered frame in the engine so that
+/// percentiles can be reported without sending each |FrameTiming| to the UI
+/// isolate. This class is thread-safe.
+class FrameStatistics {
+ public:
+  enum class Histogram {
+    /// The time from the vsync signal to the start of the build, in
+    /// microseconds.
+    kVsyncOverhead,
+    /// The time spent building the layer tree on the UI thread, in
+    /// microseconds.
+    kBuild,
+    /// The time spent rasterizing on the raster thread, in microseconds.
+    kRaster,
+    /// The time from the vsync signal to the end of rasterization, in
+    /// microseconds.
+    kTotal,
+    /// The size of the layer and picture raster caches after the frame, in
+    /// bytes.
+    kRasterCacheBytes,
+    /// The time the GPU spent on the frame, in microseconds. Only recorded
+    /// while the GPU tracer of the Impeller backend is enabled.
+    kGpu,
+  };
+
+  static constexpr size_t kHistogramCount =
+      static_cast<size_t>(Histogram::kGpu) + 1;
+
+  struct Summary {
+    uint64_t frame_count = 0u;
+    /// Frames whose build or rasterization took longer than the frame budget,
+    /// the time between their vsync and vsync target times.
+    uint64_t janky_frame_count = 0u;
+    std::array<FrameStatisticsHistogram::Summary, kHistogramCount> histograms;
+
+    const FrameStatisticsHistogram::Summary& Get(Histogram histogram) const {
+      return histograms[static_cast<size_t>(histogram)];
+    }
+  };
+
+  FrameStatistics();
+
+  ~FrameStatistics();
+
+  /// Called by the |Animator| when it starts building a frame.
+  void RecordVsyncOverhead(fml::TimeDelta overhead);
+
+  /// Called by the |Rasterizer| once a frame has been rasterized.
+  ///
+  /// Each phase is judged against the frame budget on its own. With
+  /// pipelining, a frame can be built while the previous one is rasterized,
+  /// and so finish after its vsync target time without either phase having
+  /// missed the budget. Such frames are not janky.
+  void RecordRasterizedFrame(const FrameTimingsRecorder& recorder);
+
+  /// Called with the GPU time of a frame, once its commands have completed.
+  void RecordGpuFrameTime(fml::TimeDelta gpu_time);
+
+  Summary GetSummary() const;
+
+  void Reset();
+
+ private:
+  std::array<FrameStatisticsHistogram, kHistogramCount> histograms_;
+  std::atomic<uint64_t> frame_count_ = 0u;
+  std::atomic<uint64_t> janky_frame_count_ = 0u;
+
+  FrameStatisticsHistogram& GetHistogram(Histogram histogram);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
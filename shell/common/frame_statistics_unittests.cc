@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+void RecordFrame(FrameStatistics& statistics,
+                 fml::TimeDelta build,
+                 fml::TimeDelta vsync_budget) {
+  FrameTimingsRecorder recorder;
+  const auto vsync_start = fml::TimePoint::Now() - build;
+  recorder.RecordVsync(vsync_start, vsync_start + vsync_budget);
+  recorder.RecordBuildStart(vsync_start);
+  recorder.RecordBuildEnd(vsync_start + build);
+  recorder.RecordRasterStart(vsync_start + build);
+  recorder.RecordRasterEnd();
+  statistics.RecordRasterizedFrame(recorder);
+}
+
+}  // namespace
+
+TEST(FrameStatisticsHistogramTest, BucketsBoundRelativeError) {
+  for (uint64_t value = 0u; value < 16u; value++) {
+    EXPECT_EQ(FrameStatisticsHistogram::GetBucketIndex(value), value);
+    EXPECT_EQ(FrameStatisticsHistogram::GetBucketUpperBound(value), value);
+  }
+  for (uint64_t value : {16ull, 17ull, 31ull, 32ull, 33ull, 1000ull, 16667ull,
+                         1ull << 40, ~0ull}) {
+    const auto index = FrameStatisticsHistogram::GetBucketIndex(value);
+    ASSERT_LT(index, FrameStatisticsHistogram::kBucketCount);
+    const auto upper = FrameStatisticsHistogram::GetBucketUpperBound(index);
+    EXPECT_GE(upper, value);
+    EXPECT_LE(upper - value, value / 16u);
+    if (index > 0u) {
+      EXPECT_LT(FrameStatisticsHistogram::GetBucketUpperBound(index - 1),
+                value);
+    }
+  }
+  EXPECT_EQ(FrameStatisticsHistogram::GetBucketIndex(~0ull),
+            FrameStatisticsHistogram::kBucketCount - 1);
+}
+
+TEST(FrameStatisticsHistogramTest, ComputesPercentiles) {
+  FrameStatisticsHistogram histogram;
+  EXPECT_EQ(histogram.GetValueAtPercentile(50.0), 0u);
+
+  for (uint64_t value = 1u; value <= 100u; value++) {
+    histogram.Record(value);
+  }
+  const auto summary = histogram.GetSummary();
+  EXPECT_EQ(summary.count, 100u);
+  EXPECT_EQ(summary.max, 100u);
+  EXPECT_DOUBLE_EQ(summary.mean, 50.5);
+  EXPECT_GE(summary.p50, 50u);
+  EXPECT_LE(summary.p50, 51u);
+  EXPECT_GE(summary.p90, 90u);
+  EXPECT_LE(summary.p90, 95u);
+  EXPECT_GE(summary.p99, 99u);
+  EXPECT_LE(summary.p99, 100u);
+  EXPECT_EQ(histogram.GetValueAtPercentile(100.0), 100u);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.GetSummary().count, 0u);
+  EXPECT_EQ(histogram.GetSummary().max, 0u);
+}
+
+TEST(FrameStatisticsHistogramTest, RecordsConcurrently) {
+  FrameStatisticsHistogram histogram;
+  std::vector<std::thread> threads;
+  for (uint64_t i = 0u; i < 4u; i++) {
+    threads.emplace_back([&histogram, i]() {
+      for (uint64_t value = 0u; value < 1000u; value++) {
+        histogram.Record(value * (i + 1u));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto summary = histogram.GetSummary();
+  EXPECT_EQ(summary.count, 4000u);
+  EXPECT_EQ(summary.max, 3996u);
+}
+
+TEST(FrameStatisticsTest, CountsJankyFrames) {
+  FrameStatistics statistics;
+  RecordFrame(statistics, fml::TimeDelta::FromMilliseconds(2),
+              fml::TimeDelta::FromSeconds(60));
+  RecordFrame(statistics, fml::TimeDelta::FromMilliseconds(4),
+              fml::TimeDelta::FromMilliseconds(1));
+  statistics.RecordVsyncOverhead(fml::TimeDelta::FromMicroseconds(250));
+
+  const auto summary = statistics.GetSummary();
+  EXPECT_EQ(summary.frame_count, 2u);
+  EXPECT_EQ(summary.janky_frame_count, 1u);
+
+  const auto& build = summary.Get(FrameStatistics::Histogram::kBuild);
+  EXPECT_EQ(build.count, 2u);
+  EXPECT_EQ(build.max, 4000u);
+  // Rounded up to the largest value of the bucket of 2000.
+  EXPECT_GE(build.p50, 2000u);
+  EXPECT_LE(build.p50, 2000u + 2000u / 16u);
+  EXPECT_EQ(summary.Get(FrameStatistics::Histogram::kTotal).count, 2u);
+  EXPECT_GE(summary.Get(FrameStatistics::Histogram::kTotal).max, 4000u);
+  EXPECT_EQ(summary.Get(FrameStatistics::Histogram::kRasterCacheBytes).max, 0u);
+  EXPECT_EQ(summary.Get(FrameStatistics::Histogram::kVsyncOverhead).max, 250u);
+
+  statistics.Reset();
+  EXPECT_EQ(statistics.GetSummary().frame_count, 0u);
+  EXPECT_EQ(statistics.GetSummary().janky_frame_count, 0u);
+}
+
+TEST(FrameStatisticsTest, JudgesEachPhaseAgainstTheBudget) {
+  FrameStatistics statistics;
+  // Rasterization waited for the previous frame, so the frame finished after
+  // its vsync target time even though neither phase took longer than the
+  // budget.
+  FrameTimingsRecorder recorder;
+  const auto vsync_start =
+      fml::TimePoint::Now() - fml::TimeDelta::FromMilliseconds(20);
+  recorder.RecordVsync(vsync_start,
+                       vsync_start + fml::TimeDelta::FromMilliseconds(16));
+  recorder.RecordBuildStart(vsync_start);
+  recorder.RecordBuildEnd(vsync_start + fml::TimeDelta::FromMilliseconds(2));
+  recorder.RecordRasterStart(vsync_start +
+                             fml::TimeDelta::FromMilliseconds(19));
+  recorder.RecordRasterEnd();
+  statistics.RecordRasterizedFrame(recorder);
+
+  const auto summary = statistics.GetSummary();
+  EXPECT_EQ(summary.frame_count, 1u);
+  EXPECT_EQ(summary.janky_frame_count, 0u);
+  EXPECT_GE(summary.Get(FrameStatistics::Histogram::kTotal).max, 20000u);
+}
+
+TEST(FrameStatisticsTest, RecordsGpuFrameTimes) {
+  FrameStatistics statistics;
+  statistics.RecordGpuFrameTime(fml::TimeDelta::FromMicroseconds(1500));
+  statistics.RecordGpuFrameTime(fml::TimeDelta::FromMicroseconds(3000));
+
+  const auto summary = statistics.GetSummary();
+  const auto& gpu = summary.Get(FrameStatistics::Histogram::kGpu);
+  EXPECT_EQ(gpu.count, 2u);
+  EXPECT_EQ(gpu.max, 3000u);
+  EXPECT_EQ(summary.frame_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
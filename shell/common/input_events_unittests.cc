@@ -182,6 +182,10 @@ void CreateSimulatedPointerData(PointerData& data,
   data.platformData = 0;
   data.scroll_delta_x = 0.0;
   data.scroll_delta_y = 0.0;
+  data.view_id = 0;
+  data.predicted_physical_delta_x = 0.0;
+  data.predicted_physical_delta_y = 0.0;
+  data.historical_sample_count = 0;
 }
 
 TEST_F(ShellTest, MissAtMostOneFrameForIrregularInputEvents) {
@@ -368,6 +372,71 @@ TEST_F(ShellTest, CanCorrectlyPipePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, CanUnpackHistoricalPointerSamples) {
+  // Sets up shell with test fixture.
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell({
+      .settings = settings,
+      .platform_view_create_callback = ShellTestPlatformViewBuilder({
+          .simulate_vsync = true,
+      }),
+  });
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onHistoricalPointerDataPacketMain");
+  // Sets up native handler.
+  fml::AutoResetWaitableEvent reportLatch;
+  std::vector<int64_t> result_sequence;
+  auto nativeOnPointerDataPacket = [&reportLatch, &result_sequence](
+                                       Dart_NativeArguments args) {
+    Dart_Handle exception = nullptr;
+    result_sequence = tonic::DartConverter<std::vector<int64_t>>::FromArguments(
+        args, 0, exception);
+    reportLatch.Signal();
+  };
+  // Starts engine.
+  AddNativeCallback("NativeOnPointerDataPacket",
+                    CREATE_NATIVE_ENTRY(nativeOnPointerDataPacket));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+  // Starts test. The two moves before the last one are its historical
+  // samples, as written by PointerDataCoalescer.
+  auto packet = std::make_unique<PointerDataPacket>(5);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0.0, 0.0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0.0, 0.0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1.0, 0.0);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 2.0, 0.0);
+  packet->SetPointerData(3, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 3.0, 0.0);
+  data.historical_sample_count = 2;
+  packet->SetPointerData(4, data);
+  ShellTest::DispatchPointerData(shell.get(), std::move(packet));
+  ShellTest::VSyncFlush(shell.get());
+
+  reportLatch.Wait();
+  // Each event reports its change followed by its number of historical
+  // samples.
+  size_t expect_length = 6;
+  ASSERT_EQ(result_sequence.size(), expect_length);
+  ASSERT_EQ(PointerData::Change(result_sequence[0]), PointerData::Change::kAdd);
+  ASSERT_EQ(result_sequence[1], 0);
+  ASSERT_EQ(PointerData::Change(result_sequence[2]),
+            PointerData::Change::kDown);
+  ASSERT_EQ(result_sequence[3], 0);
+  ASSERT_EQ(PointerData::Change(result_sequence[4]),
+            PointerData::Change::kMove);
+  ASSERT_EQ(result_sequence[5], 2);
+
+  // Cleans up shell.
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   // Sets up shell with test fixture.
   auto settings = CreateSettingsForFixture();
@@ -12,6 +12,9 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
@@ -134,6 +137,36 @@ TEST_F(PersistentCacheTest, CanRemoveOldPersistentCache) {
   fml::RemoveFilesInDirectory(base_dir.fd());
 }
 
+TEST_F(PersistentCacheTest, ImpellerCacheDirectoryIsPerEngineVersion) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+
+  constexpr char kOldEngineVersion[] = "old";
+  auto old_created = fml::CreateDirectory(
+      base_dir.fd(), {"flutter_engine", kOldEngineVersion, "impeller", "gles"},
+      fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(old_created.is_valid());
+
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  auto cache_dir = PersistentCache::MakeImpellerCacheDirectory("gles");
+  ASSERT_TRUE(cache_dir.is_valid());
+
+  fml::DataMapping test_data(std::string("test"));
+  ASSERT_TRUE(fml::WriteAtomically(cache_dir, "test", test_data));
+  auto engine_dir = fml::OpenDirectoryReadOnly(base_dir.fd(), "flutter_engine");
+  auto file = fml::OpenFileReadOnly(
+      engine_dir,
+      fml::paths::JoinPaths({GetFlutterEngineVersion(), "impeller", "gles",
+                             "test"})
+          .c_str());
+  ASSERT_TRUE(file.is_valid());
+  ASSERT_FALSE(
+      fml::OpenDirectoryReadOnly(engine_dir, kOldEngineVersion).is_valid());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 TEST_F(PersistentCacheTest, CanPurgePersistentCache) {
   fml::ScopedTemporaryDirectory base_dir;
   ASSERT_TRUE(base_dir.fd().is_valid());
@@ -199,5 +232,146 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, WarmsUpMostUsedSkSLsFirst) {
+  std::vector<sk_sp<SkData>> shader_keys = {SkData::MakeWithCString("a"),
+                                            SkData::MakeWithCString("b"),
+                                            SkData::MakeWithCString("c")};
+  sk_sp<SkData> shader_value = SkData::MakeWithCString("value");
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.cache_sksl = true;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  for (const auto& shader_key : shader_keys) {
+    StorePersistentCache(persistent_cache, *shader_key, *shader_value);
+  }
+
+  // Skia loads the last shader, which records its use.
+  persistent_cache->load(*shader_keys[2]);
+  std::promise<bool> io_flushed;
+  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [&io_flushed]() { io_flushed.set_value(true); });
+  io_flushed.get_future().get();  // Wait for the IO thread to flush the files.
+
+  // The next run warms up the used shader first.
+  PersistentCache::ResetCacheForProcess();
+  fml::Thread thread("context");
+  std::vector<std::string> warmed_keys;
+  std::shared_ptr<PersistentCache::SkSLWarmUp> warm_up;
+  fml::AutoResetWaitableEvent warmed_up;
+  thread.GetTaskRunner()->PostTask([&]() {
+    warm_up = PersistentCache::StartSkSLWarmUp(
+        thread.GetTaskRunner(), [&](const PersistentCache::SkSLCache& sksl) {
+          warmed_keys.emplace_back(
+              reinterpret_cast<const char*>(sksl.key->bytes()));
+          if (warmed_keys.size() == shader_keys.size()) {
+            warmed_up.Signal();
+          }
+          return true;
+        });
+  });
+  warmed_up.Wait();
+  fml::TaskRunner::RunNowOrPostTask(thread.GetTaskRunner(), [&]() {
+    EXPECT_TRUE(warm_up->IsDone());
+    EXPECT_EQ(warm_up->GetWarmedCount(), 3u);
+    warm_up = nullptr;
+    warmed_up.Signal();
+  });
+  warmed_up.Wait();
+  ASSERT_EQ(warmed_keys.size(), 3u);
+  EXPECT_EQ(warmed_keys[0], "c");
+
+  // A cancelled warm-up precompiles no more shaders.
+  warmed_keys.clear();
+  thread.GetTaskRunner()->PostTask([&]() {
+    warm_up = PersistentCache::StartSkSLWarmUp(
+        thread.GetTaskRunner(), [&](const PersistentCache::SkSLCache& sksl) {
+          warmed_keys.emplace_back(
+              reinterpret_cast<const char*>(sksl.key->bytes()));
+          warm_up->Cancel();
+          return true;
+        });
+  });
+  // Flush the tasks in which the other shaders would have been precompiled.
+  for (size_t i = 0; i <= shader_keys.size(); i++) {
+    fml::AutoResetWaitableEvent task_ran;
+    thread.GetTaskRunner()->PostTask([&task_ran]() { task_ran.Signal(); });
+    task_ran.Wait();
+  }
+  fml::TaskRunner::RunNowOrPostTask(thread.GetTaskRunner(), [&]() {
+    EXPECT_TRUE(warm_up->IsDone());
+    EXPECT_EQ(warm_up->GetWarmedCount(), 1u);
+    warm_up = nullptr;
+    warmed_up.Signal();
+  });
+  warmed_up.Wait();
+  EXPECT_EQ(warmed_keys.size(), 1u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(PersistentCacheTest, WarmsUpSkSLsBeforeAndBetweenFrames) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  std::vector<sk_sp<SkData>> shader_keys = {SkData::MakeWithCString("a"),
+                                            SkData::MakeWithCString("b"),
+                                            SkData::MakeWithCString("c")};
+  sk_sp<SkData> shader_value = SkData::MakeWithCString("value");
+  for (const auto& shader_key : shader_keys) {
+    StorePersistentCache(PersistentCache::GetCacheForProcess(), *shader_key,
+                         *shader_value);
+  }
+
+  fml::Thread thread("context");
+  size_t warmed_count = 0;
+  size_t warmed_before_first_frame = 0;
+  std::shared_ptr<PersistentCache::SkSLWarmUp> warm_up;
+  fml::AutoResetWaitableEvent warmed_up;
+  thread.GetTaskRunner()->PostTask([&]() {
+    warm_up = PersistentCache::StartSkSLWarmUp(
+        thread.GetTaskRunner(), [&](const PersistentCache::SkSLCache& sksl) {
+          warmed_count++;
+          if (warmed_count == 1u) {
+            // The first frame is scheduled while the first SkSL is warmed up,
+            // and is not held up by the others.
+            thread.GetTaskRunner()->PostTask([&]() {
+              warm_up->ReportFirstUse();
+              warmed_before_first_frame = warm_up->GetWarmedCount();
+            });
+          }
+          if (warmed_count == shader_keys.size()) {
+            warmed_up.Signal();
+          }
+          return true;
+        });
+  });
+  warmed_up.Wait();
+  fml::TaskRunner::RunNowOrPostTask(thread.GetTaskRunner(), [&]() {
+    EXPECT_TRUE(warm_up->IsDone());
+    EXPECT_EQ(warm_up->GetWarmedCount(), 3u);
+    warm_up = nullptr;
+    warmed_up.Signal();
+  });
+  warmed_up.Wait();
+  EXPECT_EQ(warmed_before_first_frame, 1u);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -15,6 +15,22 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+PointerDataCoalescer::PointerDataCoalescer() = default;
+PointerDataCoalescer::~PointerDataCoalescer() = default;
+
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    const PointerDataDispatcherMaker& dispatcher_maker,
+    fml::closure on_packet_handled)
+    : delegate_(delegate),
+      dispatcher_(dispatcher_maker
+                      ? dispatcher_maker(delegate)
+                      : std::make_unique<DefaultPointerDataDispatcher>(
+                            delegate)),
+      on_packet_handled_(std::move(on_packet_handled)),
+      weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +88,133 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+namespace {
+
+bool CanCoalesce(const PointerData& earlier, const PointerData& later) {
+  if (later.change != PointerData::Change::kMove &&
+      later.change != PointerData::Change::kHover) {
+    return false;
+  }
+  return earlier.change == later.change &&
+         earlier.signal_kind == PointerData::SignalKind::kNone &&
+         later.signal_kind == PointerData::SignalKind::kNone &&
+         earlier.kind == later.kind && earlier.buttons == later.buttons &&
+         earlier.view_id == later.view_id &&
+         earlier.synthesized == later.synthesized;
+}
+
+}  // namespace
+
+std::unique_ptr<PointerDataPacket> PointerDataCoalescer::Push(
+    std::unique_ptr<PointerDataPacket> packet) {
+  stats_.events_received += packet->GetLength();
+  if (is_packet_in_flight_) {
+    AppendPendingEvents(*packet);
+    return nullptr;
+  }
+  FML_DCHECK(pending_events_.empty());
+  is_packet_in_flight_ = true;
+  stats_.packets_dispatched++;
+  return packet;
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataCoalescer::OnPacketHandled(
+    fml::TimeDelta prediction_interval) {
+  if (pending_events_.empty()) {
+    is_packet_in_flight_ = false;
+    return nullptr;
+  }
+  return TakePendingPacket(prediction_interval);
+}
+
+void PointerDataCoalescer::AppendPendingEvents(
+    const PointerDataPacket& packet) {
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    PendingEvent pending{.event = packet.GetPointerData(i)};
+    pending.event.historical_sample_count = 0;
+    // Only the most recent pending event of the same device may be merged,
+    // anything older has already been followed by a different change.
+    for (auto it = pending_events_.rbegin(); it != pending_events_.rend();
+         ++it) {
+      if (it->event.device != pending.event.device) {
+        continue;
+      }
+      if (CanCoalesce(it->event, pending.event)) {
+        pending.event.physical_delta_x += it->event.physical_delta_x;
+        pending.event.physical_delta_y += it->event.physical_delta_y;
+        pending.historical = std::move(it->historical);
+        pending.historical.push_back(it->event);
+        pending_events_.erase(std::next(it).base());
+        stats_.events_coalesced++;
+      }
+      break;
+    }
+    pending_events_.push_back(std::move(pending));
+  }
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataCoalescer::TakePendingPacket(
+    fml::TimeDelta prediction_interval) {
+  size_t record_count = 0;
+  for (const PendingEvent& pending : pending_events_) {
+    record_count += pending.historical.size() + 1;
+  }
+  auto packet = std::make_unique<PointerDataPacket>(record_count);
+  size_t index = 0;
+  for (PendingEvent& pending : pending_events_) {
+    for (const PointerData& sample : pending.historical) {
+      packet->SetPointerData(index++, sample);
+    }
+    PointerData& event = pending.event;
+    event.historical_sample_count = pending.historical.size();
+    if (!pending.historical.empty()) {
+      // Extrapolate the average velocity over the coalesced samples.
+      const PointerData& oldest = pending.historical.front();
+      const int64_t elapsed = event.time_stamp - oldest.time_stamp;
+      if (elapsed > 0) {
+        const double scale =
+            static_cast<double>(prediction_interval.ToMicroseconds()) /
+            elapsed;
+        event.predicted_physical_delta_x =
+            (event.physical_x - oldest.physical_x) * scale;
+        event.predicted_physical_delta_y =
+            (event.physical_y - oldest.physical_y) * scale;
+      }
+    }
+    packet->SetPointerData(index++, event);
+  }
+  pending_events_.clear();
+  stats_.packets_dispatched++;
+  TraceStatsToTimeline();
+  return packet;
+}
+
+void PointerDataCoalescer::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter",                                        //
+                    "PointerEventCoalescing",                         //
+                    reinterpret_cast<int64_t>(this),                  //
+                    "EventsReceived", stats_.events_received,         //
+                    "EventsCoalesced", stats_.events_coalesced,       //
+                    "PacketsDispatched", stats_.packets_dispatched);
+#endif  // !FLUTTER_RELEASE
+}
+
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "CoalescingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
+  // The framework handles the packet before the next frame starts.
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->on_packet_handled_();
+        }
+      });
+}
+
 }  // namespace flutter
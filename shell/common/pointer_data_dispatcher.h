@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -172,6 +173,130 @@ using PointerDataDispatcherMaker =
     std::function<std::unique_ptr<PointerDataDispatcher>(
         PointerDataDispatcher::Delegate&)>;
 
+//------------------------------------------------------------------------------
+/// Coalesces pointer events on the platform thread while the framework is
+/// still handling previously dispatched events.
+///
+/// The first packet is dispatched right away. Packets that arrive before that
+/// packet is reported as handled are held back, and consecutive move or hover
+/// events of the same device among them are coalesced into the most recent
+/// one. This targets high frequency input devices (e.g. 1 kHz mice and
+/// styluses) that would otherwise deliver several events per device per frame
+/// to the framework.
+///
+/// No sample is lost. A coalesced event is preceded in the packet by the
+/// samples it replaced, oldest first, and its `historical_sample_count` says
+/// how many of them there are. The framework receives them as
+/// `PointerData.historical`. The `physical_delta_x` and `physical_delta_y` of
+/// the coalesced event are the sum of the deltas of all its samples.
+///
+/// A coalesced event also carries a predicted position. It is extrapolated
+/// linearly from the oldest and the newest sample to one prediction interval,
+/// usually a frame, after the newest sample.
+///
+/// Any other change (down, up, add, remove, cancel, signals, pan/zoom) or a
+/// change of buttons ends coalescing for that device so the ordering of state
+/// changes is preserved.
+///
+/// This object is only used on the platform thread. The UI thread reports
+/// handled packets through `CoalescingPointerDataDispatcher`. Enabled by
+/// `Settings::enable_pointer_event_coalescing`.
+class PointerDataCoalescer {
+ public:
+  struct Stats {
+    /// The number of pointer events received from the platform.
+    size_t events_received = 0;
+    /// The number of pointer events coalesced into a later event of the same
+    /// device and only delivered as its historical samples.
+    size_t events_coalesced = 0;
+    /// The number of packets dispatched to the framework.
+    size_t packets_dispatched = 0;
+  };
+
+  PointerDataCoalescer();
+
+  ~PointerDataCoalescer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes a packet received from the platform.
+  ///
+  /// @return     The packet to dispatch right away, or `nullptr` if its events
+  ///             are held back until the previous packet has been handled.
+  ///
+  std::unique_ptr<PointerDataPacket> Push(
+      std::unique_ptr<PointerDataPacket> packet);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports that the framework handled the last dispatched
+  ///             packet.
+  ///
+  /// @param[in]  prediction_interval  How far past their newest sample the
+  ///                                  positions of coalesced events are
+  ///                                  predicted.
+  ///
+  /// @return     A packet of the events held back since, to be dispatched
+  ///             right away, or `nullptr` if there are none.
+  ///
+  std::unique_ptr<PointerDataPacket> OnPacketHandled(
+      fml::TimeDelta prediction_interval);
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct PendingEvent {
+    PointerData event;
+    // The samples coalesced into `event`, oldest first.
+    std::vector<PointerData> historical;
+  };
+
+  void AppendPendingEvents(const PointerDataPacket& packet);
+  std::unique_ptr<PointerDataPacket> TakePendingPacket(
+      fml::TimeDelta prediction_interval);
+  void TraceStatsToTimeline() const;
+
+  std::vector<PendingEvent> pending_events_;
+  bool is_packet_in_flight_ = false;
+  Stats stats_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataCoalescer);
+};
+
+//------------------------------------------------------------------------------
+/// Wraps the dispatcher of the platform, such as
+/// `SmoothPointerDataDispatcher`, and reports every packet it dispatches as
+/// handled at the next vsync, once the framework has processed it. The report
+/// is what releases the events held back by `PointerDataCoalescer` on the
+/// platform thread.
+class CoalescingPointerDataDispatcher : public PointerDataDispatcher {
+ public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  delegate          the `Flutter::Engine`
+  /// @param[in]  dispatcher_maker  Creates the wrapped dispatcher, usually
+  ///                               `PlatformView::GetDispatcherMaker`.
+  /// @param[in]  on_packet_handled Called on the UI thread for every packet
+  ///                               once it is handled.
+  ///
+  CoalescingPointerDataDispatcher(
+      Delegate& delegate,
+      const PointerDataDispatcherMaker& dispatcher_maker,
+      fml::closure on_packet_handled);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  Delegate& delegate_;
+  std::unique_ptr<PointerDataDispatcher> dispatcher_;
+  fml::closure on_packet_handled_;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
@@ -0,0 +1,203 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    auto callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  fml::closure vsync_callback;
+};
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t device,
+                              double x,
+                              double dx) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kMouse;
+  data.device = device;
+  // One sample per millisecond.
+  data.time_stamp = static_cast<int64_t>(x * 1000);
+  data.physical_x = x;
+  data.physical_delta_x = dx;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+constexpr fml::TimeDelta kPredictionInterval =
+    fml::TimeDelta::FromMilliseconds(16);
+
+}  // namespace
+
+TEST(PointerDataCoalescerTest, DispatchesImmediatelyWhenIdle) {
+  PointerDataCoalescer coalescer;
+
+  EXPECT_NE(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kMove, 0, 1, 1)})),
+            nullptr);
+
+  // Nothing was held back, so the next packet goes out right away as well.
+  EXPECT_EQ(coalescer.OnPacketHandled(kPredictionInterval), nullptr);
+  EXPECT_NE(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kMove, 0, 2, 1)})),
+            nullptr);
+  EXPECT_EQ(coalescer.GetStats().events_coalesced, 0u);
+  EXPECT_EQ(coalescer.GetStats().packets_dispatched, 2u);
+}
+
+TEST(PointerDataCoalescerTest, KeepsCoalescedSamplesAsHistory) {
+  PointerDataCoalescer coalescer;
+
+  ASSERT_NE(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kMove, 0, 1, 1)})),
+            nullptr);
+  for (int i = 2; i <= 5; i++) {
+    EXPECT_EQ(coalescer.Push(CreatePacket(
+                  {CreatePointerData(PointerData::Change::kMove, 0, i, 1),
+                   CreatePointerData(PointerData::Change::kMove, 1, i, 2)})),
+              nullptr);
+  }
+
+  auto packet = coalescer.OnPacketHandled(kPredictionInterval);
+  ASSERT_NE(packet, nullptr);
+  // Each device has three historical samples followed by its event.
+  ASSERT_EQ(packet->GetLength(), 8u);
+  for (int64_t device = 0; device < 2; device++) {
+    for (size_t i = 0; i < 3; i++) {
+      PointerData sample = packet->GetPointerData(device * 4 + i);
+      EXPECT_EQ(sample.device, device);
+      EXPECT_EQ(sample.physical_x, 2 + i);
+      EXPECT_EQ(sample.historical_sample_count, 0);
+    }
+    PointerData event = packet->GetPointerData(device * 4 + 3);
+    EXPECT_EQ(event.device, device);
+    EXPECT_EQ(event.physical_x, 5);
+    EXPECT_EQ(event.historical_sample_count, 3);
+    EXPECT_EQ(event.physical_delta_x, 4 * (device + 1));
+    // 3 pixels in 3 ms, extrapolated over 16 ms.
+    EXPECT_DOUBLE_EQ(event.predicted_physical_delta_x, 16);
+    EXPECT_EQ(event.predicted_physical_delta_y, 0);
+  }
+
+  EXPECT_EQ(coalescer.GetStats().events_received, 9u);
+  EXPECT_EQ(coalescer.GetStats().events_coalesced, 6u);
+  EXPECT_EQ(coalescer.GetStats().packets_dispatched, 2u);
+}
+
+TEST(PointerDataCoalescerTest, PreservesStateChanges) {
+  PointerDataCoalescer coalescer;
+
+  ASSERT_NE(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kHover, 0, 0, 0)})),
+            nullptr);
+  EXPECT_EQ(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kHover, 0, 1, 1),
+                 CreatePointerData(PointerData::Change::kDown, 0, 1, 0),
+                 CreatePointerData(PointerData::Change::kMove, 0, 2, 1),
+                 CreatePointerData(PointerData::Change::kMove, 0, 3, 1),
+                 CreatePointerData(PointerData::Change::kUp, 0, 3, 0),
+                 CreatePointerData(PointerData::Change::kHover, 0, 4, 1)})),
+            nullptr);
+
+  auto packet = coalescer.OnPacketHandled(kPredictionInterval);
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 6u);
+  EXPECT_EQ(packet->GetPointerData(0).change, PointerData::Change::kHover);
+  EXPECT_EQ(packet->GetPointerData(1).change, PointerData::Change::kDown);
+  EXPECT_EQ(packet->GetPointerData(2).change, PointerData::Change::kMove);
+  EXPECT_EQ(packet->GetPointerData(2).physical_x, 2);
+  EXPECT_EQ(packet->GetPointerData(3).change, PointerData::Change::kMove);
+  EXPECT_EQ(packet->GetPointerData(3).historical_sample_count, 1);
+  EXPECT_EQ(packet->GetPointerData(3).physical_delta_x, 2);
+  EXPECT_EQ(packet->GetPointerData(4).change, PointerData::Change::kUp);
+  EXPECT_EQ(packet->GetPointerData(5).change, PointerData::Change::kHover);
+  EXPECT_EQ(coalescer.GetStats().events_coalesced, 1u);
+
+  // The in-flight packet is released only once it is handled.
+  EXPECT_EQ(coalescer.Push(CreatePacket(
+                {CreatePointerData(PointerData::Change::kHover, 0, 5, 1)})),
+            nullptr);
+  EXPECT_NE(coalescer.OnPacketHandled(kPredictionInterval), nullptr);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, WrapsPlatformDispatcher) {
+  FakePointerDataDispatcherDelegate delegate;
+  size_t wrapped_packets = 0;
+  size_t handled_packets = 0;
+
+  class CountingDispatcher : public DefaultPointerDataDispatcher {
+   public:
+    CountingDispatcher(Delegate& inner_delegate, size_t& count)
+        : DefaultPointerDataDispatcher(inner_delegate), count_(count) {}
+
+    void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+      count_++;
+      DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                   trace_flow_id);
+    }
+
+   private:
+    size_t& count_;
+  };
+
+  CoalescingPointerDataDispatcher dispatcher(
+      delegate,
+      [&wrapped_packets](PointerDataDispatcher::Delegate& inner_delegate) {
+        return std::make_unique<CountingDispatcher>(inner_delegate,
+                                                    wrapped_packets);
+      },
+      [&handled_packets]() { handled_packets++; });
+
+  dispatcher.DispatchPacket(
+      CreatePacket({CreatePointerData(PointerData::Change::kMove, 0, 1, 1)}),
+      0);
+  EXPECT_EQ(wrapped_packets, 1u);
+  EXPECT_EQ(delegate.packets.size(), 1u);
+  EXPECT_EQ(handled_packets, 0u);
+
+  delegate.FireVsync();
+  EXPECT_EQ(handled_packets, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -76,6 +76,20 @@ void Rasterizer::SetImpellerContext(
   impeller_context_ = std::move(impeller_context);
 }
 
+void Rasterizer::SetFrameStatistics(
+    std::shared_ptr<FrameStatistics> frame_statistics) {
+  frame_statistics_ = std::move(frame_statistics);
+  if (auto context = impeller_context_.lock()) {
+    context->SetGPUFrameTimeCallback(
+        [weak_statistics = std::weak_ptr<FrameStatistics>(frame_statistics_)](
+            fml::TimeDelta gpu_time) {
+          if (auto statistics = weak_statistics.lock()) {
+            statistics->RecordGpuFrameTime(gpu_time);
+          }
+        });
+  }
+}
+
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
 
@@ -656,6 +670,9 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   // TODO(dkwingsmt): Pass in raster cache(s) for all views.
   // See https://github.com/flutter/flutter/issues/135530, item 4.
   frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
+  if (frame_statistics_) {
+    frame_statistics_->RecordRasterizedFrame(frame_timings_recorder);
+  }
   FireNextFrameCallbackIfPresent();
 
   if (surface_->GetContext()) {
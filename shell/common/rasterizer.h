@@ -31,6 +31,7 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"  // nogncheck
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -207,6 +208,19 @@ class Rasterizer final : public SnapshotDelegate,
 
   void SetImpellerContext(std::weak_ptr<impeller::Context> impeller_context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the aggregator that the timings of every rasterized
+  ///             frame are recorded into. May be null.
+  ///
+  ///             The GPU time of frames is recorded too if the Impeller
+  ///             context was set before. Spawned shells share the context, so
+  ///             the GPU time is only recorded into the statistics of the
+  ///             shell whose rasterizer was set up last.
+  ///
+  /// @param[in]  frame_statistics  The frame statistics of the shell.
+  ///
+  void SetFrameStatistics(std::shared_ptr<FrameStatistics> frame_statistics);
+
   //----------------------------------------------------------------------------
   /// @brief      Rasterizers may be created well before an on-screen surface is
   ///             available for rendering. Shells usually create a rasterizer in
@@ -749,6 +763,7 @@ class Rasterizer final : public SnapshotDelegate,
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::weak_ptr<impeller::Context> impeller_context_;
+  std::shared_ptr<FrameStatistics> frame_statistics_;
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
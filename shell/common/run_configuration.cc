@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -16,6 +17,25 @@
 
 namespace flutter {
 
+// Asset directories with a packed bundle are resolved through its index, so
+// looking up assets does not touch the filesystem. Assets missing from the
+// packed bundle are still looked up in the directory. Only precompiled code
+// uses the packed bundle, as the tooling updates the loose files of the
+// directory while JIT code is hot reloaded.
+static std::unique_ptr<AssetResolver> CreateAssetResolver(
+    fml::UniqueFD directory) {
+  if (DartVM::IsRunningPrecompiledCode() &&
+      fml::FileExists(directory, PackedAssetBundle::kFileName)) {
+    auto directory_bundle = std::make_unique<DirectoryAssetBundle>(
+        fml::Duplicate(directory.get()), true);
+    if (auto packed_bundle = PackedAssetBundle::Create(
+            directory, true, std::move(directory_bundle))) {
+      return packed_bundle;
+    }
+  }
+  return std::make_unique<DirectoryAssetBundle>(std::move(directory), true);
+}
+
 RunConfiguration RunConfiguration::InferFromSettings(
     const Settings& settings,
     const fml::RefPtr<fml::TaskRunner>& io_worker,
@@ -23,14 +43,12 @@ RunConfiguration RunConfiguration::InferFromSettings(
   auto asset_manager = std::make_shared<AssetManager>();
 
   if (fml::UniqueFD::traits_type::IsValid(settings.assets_dir)) {
-    asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-        fml::Duplicate(settings.assets_dir), true));
+    asset_manager->PushBack(
+        CreateAssetResolver(fml::Duplicate(settings.assets_dir)));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  asset_manager->PushBack(CreateAssetResolver(fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead)));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker, launch_type),
@@ -5,6 +5,7 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -14,6 +15,7 @@
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
@@ -22,7 +24,9 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
@@ -42,6 +46,7 @@
 #include "third_party/skia/include/codec/SkWebpDecoder.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -52,6 +57,12 @@ constexpr char kFontChange[] = "fontsChange";
 
 namespace {
 
+// Whether the process should record the snapshot page profile after its first
+// frame. The pages resident then are only those the launch needed if no
+// profile was replayed, since the replayed pages are resident too. So a profile
+// is only recorded by launches without a usable one, and only once.
+std::atomic<bool> gShouldRecordSnapshotPageProfile = false;
+
 std::unique_ptr<Engine> CreateEngine(
     Engine::Delegate& delegate,
     const PointerDataDispatcherMaker& dispatcher_maker,
@@ -124,6 +135,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_to_ring_buffer) {
+      fml::tracing::TraceRingBufferSetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -145,6 +160,24 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+// Creates the default font manager on a worker while the rest of the shell is
+// set up, so that |Engine::SetupDefaultFontManager| only has to look it up.
+void PrefetchDefaultFontManager(const Settings& settings, const DartVMRef& vm) {
+#if !defined(FML_OS_WIN)
+  // Embedders that prefetch the font manager themselves do so even earlier.
+  // Font managers created from initialization data, as well as the ones on
+  // Windows, are not cached, so creating one here would not help.
+  if (!vm || settings.prefetched_default_font_manager ||
+      settings.font_initialization_data != 0) {
+    return;
+  }
+  vm->GetConcurrentWorkerTaskRunner()->PostTask([]() {
+    TRACE_EVENT0("flutter", "ShellSetupDefaultFontManager");
+    txt::GetDefaultFontManager();
+  });
+#endif  // !defined(FML_OS_WIN)
+}
+
 }  // namespace
 
 std::pair<DartVMRef, fml::RefPtr<const DartSnapshot>>
@@ -154,6 +187,15 @@ Shell::InferVmInitDataFromSettings(Settings& settings) {
   // arguments are ignored.
   auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
   auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  if (!settings.snapshot_page_profile_path.empty() &&
+      SnapshotPageProfile::IsSupported() && !DartVMRef::IsInstanceRunning()) {
+    // Read ahead the pages the VM touched during the last launch before it
+    // starts faulting them in one at a time.
+    const size_t prefetched_pages =
+        SnapshotPageProfile(vm_snapshot, isolate_snapshot)
+            .ReplayFromFile(settings.snapshot_page_profile_path);
+    gShouldRecordSnapshotPageProfile = prefetched_pages == 0u;
+  }
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
@@ -176,7 +218,26 @@ std::unique_ptr<Shell> Shell::Create(
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
-  auto [vm, isolate_snapshot] = InferVmInitDataFromSettings(settings);
+  if (!task_runners.IsValid()) {
+    FML_LOG(ERROR) << "Task runners to run the shell were invalid.";
+    return nullptr;
+  }
+
+  // The VM is first needed to create the engine on the UI thread, which is
+  // otherwise idle until then. Map the snapshots and start the VM there so that
+  // this overlaps with creating the platform view and the GPU and IO contexts.
+  // Tasks run in order, so the engine is always created after this.
+  auto vm_init_promise = std::make_shared<std::promise<VMInitData>>();
+  std::shared_future<VMInitData> vm_init_data =
+      vm_init_promise->get_future().share();
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetUITaskRunner(), [vm_init_promise, settings]() mutable {
+        TRACE_EVENT0("flutter", "ShellSetupDartVM");
+        auto vm_init_data = InferVmInitDataFromSettings(settings);
+        PrefetchDefaultFontManager(settings, vm_init_data.first);
+        vm_init_promise->set_value(std::move(vm_init_data));
+      });
+
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
@@ -187,8 +248,7 @@ std::unique_ptr<Shell> Shell::Create(
                             /*parent_io_manager=*/nullptr,     //
                             resource_cache_limit_calculator,   //
                             settings,                          //
-                            std::move(vm),                     //
-                            std::move(isolate_snapshot),       //
+                            std::move(vm_init_data),           //
                             on_create_platform_view,           //
                             on_create_rasterizer,              //
                             CreateEngine, is_gpu_disabled);
@@ -210,7 +270,7 @@ static impeller::RuntimeStageBackend DetermineRuntimeStageBackend(
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
-    DartVMRef vm,
+    std::shared_future<VMInitData> vm_init_data,
     fml::RefPtr<fml::RasterThreadMerger> parent_merger,
     std::shared_ptr<ShellIOManager> parent_io_manager,
     const std::shared_ptr<ResourceCacheLimitCalculator>&
@@ -218,7 +278,6 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     const TaskRunners& task_runners,
     const PlatformData& platform_data,
     const Settings& settings,
-    fml::RefPtr<const DartSnapshot> isolate_snapshot,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     const Shell::EngineCreateCallback& on_create_engine,
@@ -229,7 +288,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   }
 
   auto shell = std::unique_ptr<Shell>(
-      new Shell(std::move(vm), task_runners, std::move(parent_merger),
+      new Shell(vm_init_data, task_runners, std::move(parent_merger),
                 resource_cache_limit_calculator, settings,
                 std::make_shared<VolatilePathTracker>(
                     task_runners.GetUITaskRunner(),
@@ -237,7 +296,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                 is_gpu_disabled));
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformView");
+    platform_view = on_create_platform_view(*shell.get());
+  }
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
@@ -259,6 +322,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        rasterizer->SetFrameStatistics(shell->GetFrameStatistics());
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -314,7 +378,28 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
-  auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  PointerDataDispatcherMaker dispatcher_maker =
+      platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_event_coalescing) {
+    // Events are coalesced on the platform thread. The dispatcher of the
+    // platform still filters the packets on the UI thread, the wrapper only
+    // reports when they have been handled.
+    shell->pointer_data_coalescer_ = std::make_unique<PointerDataCoalescer>();
+    dispatcher_maker = [platform_maker = std::move(dispatcher_maker),
+                        weak_shell = shell->weak_factory_.GetWeakPtr(),
+                        platform_task_runner =
+                            shell->GetTaskRunners().GetPlatformTaskRunner()](
+                           PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<CoalescingPointerDataDispatcher>(
+          delegate, platform_maker, [weak_shell, platform_task_runner]() {
+            platform_task_runner->PostTask([weak_shell]() {
+              if (weak_shell) {
+                weak_shell->OnPointerDataPacketHandled();
+              }
+            });
+          });
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -325,7 +410,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          shell = shell.get(),                             //
                          &dispatcher_maker,                               //
                          &platform_data,                                  //
-                         isolate_snapshot = std::move(isolate_snapshot),  //
+                         vm_init_data,                                    //
                          vsync_waiter = std::move(vsync_waiter),          //
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
@@ -335,16 +420,19 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              platform_view->GetImpellerContext())]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
+        auto [vm, isolate_snapshot] = vm_init_data.get();
+        FML_CHECK(vm) << "Must have access to VM to create a shell.";
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        animator->SetFrameStatistics(shell->GetFrameStatistics());
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
             dispatcher_maker,                     //
-            *shell->GetDartVM(),                  //
+            *vm.get(),                            //
             std::move(isolate_snapshot),          //
             task_runners,                         //
             platform_data,                        //
@@ -359,10 +447,25 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
             ));
       }));
 
+  std::unique_ptr<Engine> engine;
+  std::unique_ptr<Rasterizer> rasterizer;
+  std::shared_ptr<ShellIOManager> io_manager;
+  {
+    // The time spent here is the part of the critical path that is not on the
+    // platform thread.
+    TRACE_EVENT0("flutter", "ShellWaitForSubsystems");
+    engine = engine_future.get();
+    rasterizer = rasterizer_future.get();
+    io_manager = io_manager_future.get();
+  }
+
+  // The engine was created with the VM, so this does not block.
+  shell->GetDartVM();
+
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    io_manager)                //
   ) {
     return nullptr;
   }
@@ -378,8 +481,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     const std::shared_ptr<ResourceCacheLimitCalculator>&
         resource_cache_limit_calculator,
     Settings settings,
-    DartVMRef vm,
-    fml::RefPtr<const DartSnapshot> isolate_snapshot,
+    std::shared_future<VMInitData> vm_init_data,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
     const Shell::EngineCreateCallback& on_create_engine,
@@ -408,20 +510,18 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                          task_runners = task_runners,                        //
                          platform_data = platform_data,                      //
                          settings = settings,                                //
-                         vm = std::move(vm),                                 //
-                         isolate_snapshot = std::move(isolate_snapshot),     //
+                         vm_init_data = std::move(vm_init_data),             //
                          on_create_platform_view = on_create_platform_view,  //
                          on_create_rasterizer = on_create_rasterizer,        //
                          on_create_engine = on_create_engine,
                          is_gpu_disabled]() mutable {
-        shell = CreateShellOnPlatformThread(std::move(vm),                    //
+        shell = CreateShellOnPlatformThread(std::move(vm_init_data),          //
                                             parent_thread_merger,             //
                                             parent_io_manager,                //
                                             resource_cache_limit_calculator,  //
                                             task_runners,                     //
                                             platform_data,                    //
                                             settings,                         //
-                                            std::move(isolate_snapshot),      //
                                             on_create_platform_view,          //
                                             on_create_rasterizer,             //
                                             on_create_engine, is_gpu_disabled);
@@ -431,7 +531,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
   return shell;
 }
 
-Shell::Shell(DartVMRef vm,
+Shell::Shell(std::shared_future<VMInitData> vm_init_data,
              const TaskRunners& task_runners,
              fml::RefPtr<fml::RasterThreadMerger> parent_merger,
              const std::shared_ptr<ResourceCacheLimitCalculator>&
@@ -443,9 +543,10 @@ Shell::Shell(DartVMRef vm,
       parent_raster_thread_merger_(std::move(parent_merger)),
       resource_cache_limit_calculator_(resource_cache_limit_calculator),
       settings_(settings),
-      vm_(std::move(vm)),
+      vm_init_data_(std::move(vm_init_data)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      frame_statistics_(std::make_shared<FrameStatistics>()),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(!settings.enable_software_rendering || !settings.enable_impeller)
@@ -458,7 +559,8 @@ Shell::Shell(DartVMRef vm,
            "release. Remove the explicit opt-out. If you need to opt-out, "
            "report a bug describing the issue.";
   }
-  FML_CHECK(vm_) << "Must have access to VM to create a shell.";
+  FML_CHECK(vm_init_data_.valid())
+      << "Must have access to VM to create a shell.";
   FML_DCHECK(task_runners_.IsValid());
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
@@ -508,6 +610,11 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetIOTaskRunner(),
       std::bind(&Shell::OnServiceProtocolGetSkSLs, this, std::placeholders::_1,
                 std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameStatisticsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_
       [ServiceProtocol::kEstimateRasterCacheMemoryExtensionName] = {
           task_runners_.GetRasterTaskRunner(),
@@ -522,13 +629,21 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
   PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
-  vm_->GetServiceProtocol()->RemoveHandler(this);
+  // The VM is unresolved if setting up the shell failed.
+  if (vm_) {
+    vm_->GetServiceProtocol()->RemoveHandler(this);
+  }
 
   fml::AutoResetWaitableEvent platiso_latch, ui_latch, gpu_latch,
       platform_latch, io_latch;
@@ -598,10 +713,12 @@ std::unique_ptr<Shell> Shell::Spawn(
       fml::SyncSwitch::Handlers()
           .SetIfFalse([&is_gpu_disabled] { is_gpu_disabled = false; })
           .SetIfTrue([&is_gpu_disabled] { is_gpu_disabled = true; }));
+  std::promise<VMInitData> vm_init_data;
+  vm_init_data.set_value({vm_, vm_->GetVMData()->GetIsolateSnapshot()});
   std::unique_ptr<Shell> result = CreateWithSnapshot(
       PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
-      io_manager_, resource_cache_limit_calculator_, GetSettings(), vm_,
-      vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
+      io_manager_, resource_cache_limit_calculator_, GetSettings(),
+      vm_init_data.get_future().share(), on_create_platform_view,
       on_create_rasterizer,
       [engine = this->engine_.get(), initial_route](
           Engine::Delegate& delegate,
@@ -648,6 +765,14 @@ void Shell::NotifyLowMemoryWarning() const {
         TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
                                trace_id);
       });
+  task_runners_.GetUITaskRunner()->PostTask([engine = weak_engine_]() {
+    if (!engine) {
+      return;
+    }
+    if (auto image_decoder = engine->GetImageDecoderWeakPtr()) {
+      image_decoder->PurgeCache();
+    }
+  });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
   // to purge them.
 }
@@ -825,8 +950,21 @@ fml::WeakPtr<ShellIOManager> Shell::GetIOManager() {
   return io_manager_->GetWeakPtr();
 }
 
+fml::WeakPtr<const Shell> Shell::GetWeakPtr() const {
+  return weak_factory_.GetWeakPtr();
+}
+
+DartVMRef& Shell::ResolveVM() const {
+  if (!vm_) {
+    FML_DCHECK(
+        task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+    vm_ = vm_init_data_.get().first;
+  }
+  return vm_;
+}
+
 DartVM* Shell::GetDartVM() {
-  return &vm_;
+  return &ResolveVM();
 }
 
 // |PlatformView::Delegate|
@@ -1083,12 +1221,39 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (pointer_data_coalescer_) {
+    packet = pointer_data_coalescer_->Push(std::move(packet));
+    if (!packet) {
+      return;
+    }
+  }
+  DispatchPointerDataPacketToEngine(std::move(packet));
+}
+
+void Shell::OnPointerDataPacketHandled() {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(pointer_data_coalescer_);
+  // Predict the positions of coalesced events one frame ahead.
+  double refresh_rate = GetMainDisplayRefreshRate();
+  fml::TimeDelta frame_interval = fml::TimeDelta::FromMillisecondsF(
+      (refresh_rate > 0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                        : fml::kDefaultFrameBudget)
+          .count());
+  std::unique_ptr<PointerDataPacket> packet =
+      pointer_data_coalescer_->OnPacketHandled(frame_interval);
+  if (packet) {
+    DispatchPointerDataPacketToEngine(std::move(packet));
+  }
+}
+
+void Shell::DispatchPointerDataPacketToEngine(
+    std::unique_ptr<PointerDataPacket> packet) {
   TRACE_EVENT0_WITH_FLOW_IDS(
       "flutter", "Shell::OnPlatformViewDispatchPointerDataPacket",
       /*flow_id_count=*/1, /*flow_ids=*/&next_pointer_flow_id_);
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
-  FML_DCHECK(is_set_up_);
-  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -1454,7 +1619,8 @@ void Shell::OnRootIsolateCreated() {
       [self = weak_factory_.GetWeakPtr(),
        description = std::move(description)]() {
         if (self) {
-          self->vm_->GetServiceProtocol()->AddHandler(self.get(), description);
+          self->ResolveVM()->GetServiceProtocol()->AddHandler(self.get(),
+                                                              description);
         }
       });
   is_added_to_service_protocol_ = true;
@@ -1464,7 +1630,7 @@ void Shell::OnRootIsolateCreated() {
 void Shell::UpdateIsolateDescription(const std::string isolate_name,
                                      int64_t isolate_port) {
   Handler::Description description(isolate_port, isolate_name);
-  vm_->GetServiceProtocol()->SetHandlerDescription(this, description);
+  ResolveVM()->GetServiceProtocol()->SetHandlerDescription(this, description);
 }
 
 void Shell::SetNeedsReportTimings(bool value) {
@@ -1550,6 +1716,27 @@ void Shell::ReportTimings() {
   });
 }
 
+void Shell::RecordSnapshotPageProfile() {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (settings_.snapshot_page_profile_path.empty() ||
+      !gShouldRecordSnapshotPageProfile.exchange(false)) {
+    return;
+  }
+  // The pages resident now are the ones launching the application needed, so
+  // record them off the raster thread for the next launch.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [vm_data = ResolveVM()->GetVMData(),
+       path = settings_.snapshot_page_profile_path]() {
+        SnapshotPageProfile profile(fml::Ref(&vm_data->GetVMSnapshot()),
+                                    vm_data->GetIsolateSnapshot());
+        if (!profile.RecordToFile(path)) {
+          FML_LOG(ERROR) << "Could not write the snapshot page profile to "
+                         << path;
+        }
+      });
+}
+
 size_t Shell::UnreportedFramesCount() const {
   // Check that this is running on the raster thread to avoid race conditions.
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1567,6 +1754,11 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (!snapshot_page_profile_recorded_) {
+    snapshot_page_profile_recorded_ = true;
+    RecordSnapshotPageProfile();
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1908,6 +2100,44 @@ bool Shell::OnServiceProtocolGetSkSLs(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  static constexpr std::pair<FrameStatistics::Histogram, const char*>
+      kHistograms[] = {
+          {FrameStatistics::Histogram::kVsyncOverhead, "vsyncOverheadMicros"},
+          {FrameStatistics::Histogram::kBuild, "buildMicros"},
+          {FrameStatistics::Histogram::kRaster, "rasterMicros"},
+          {FrameStatistics::Histogram::kTotal, "totalMicros"},
+          {FrameStatistics::Histogram::kRasterCacheBytes, "rasterCacheBytes"},
+          {FrameStatistics::Histogram::kGpu, "gpuMicros"},
+      };
+
+  const auto summary = frame_statistics_->GetSummary();
+  if (params.count("reset") && params.at("reset") == "true") {
+    frame_statistics_->Reset();
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", summary.frame_count, allocator);
+  response->AddMember<uint64_t>("jankyFrameCount", summary.janky_frame_count,
+                                allocator);
+  for (const auto& [histogram, name] : kHistograms) {
+    const auto& values = summary.Get(histogram);
+    rapidjson::Value histogram_json(rapidjson::kObjectType);
+    histogram_json.AddMember<uint64_t>("count", values.count, allocator);
+    histogram_json.AddMember<double>("mean", values.mean, allocator);
+    histogram_json.AddMember<uint64_t>("max", values.max, allocator);
+    histogram_json.AddMember<uint64_t>("p50", values.p50, allocator);
+    histogram_json.AddMember<uint64_t>("p90", values.p90, allocator);
+    histogram_json.AddMember<uint64_t>("p99", values.p99, allocator);
+    response->AddMember(rapidjson::StringRef(name), histogram_json, allocator);
+  }
+  return true;
+}
+
 bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
     rapidjson::Document* response) {
@@ -2114,6 +2344,24 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const std::string trace = fml::tracing::TraceRingBufferExportJSON();
+  if (params.count("clear") && params.at("clear") == "true") {
+    fml::tracing::TraceRingBufferClear();
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRingBufferIsEnabled(),
+                      allocator);
+  response->AddMember("trace", rapidjson::Value(trace, allocator), allocator);
+  return true;
+}
+
 void Shell::OnPlatformViewAddView(int64_t view_id,
                                   const ViewportMetrics& viewport_metrics,
                                   AddViewCallback callback) {
@@ -2246,6 +2494,10 @@ bool Shell::ReloadSystemFonts() {
   return true;
 }
 
+const std::shared_ptr<FrameStatistics>& Shell::GetFrameStatistics() const {
+  return frame_statistics_;
+}
+
 std::shared_ptr<const fml::SyncSwitch> Shell::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
@@ -2314,11 +2566,7 @@ const std::weak_ptr<VsyncWaiter> Shell::GetVsyncWaiter() const {
 
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 Shell::GetConcurrentWorkerTaskRunner() const {
-  FML_DCHECK(vm_);
-  if (!vm_) {
-    return nullptr;
-  }
-  return vm_->GetConcurrentWorkerTaskRunner();
+  return ResolveVM()->GetConcurrentWorkerTaskRunner();
 }
 
 SkISize Shell::ExpectedFrameSize(int64_t view_id) {
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <future>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -36,6 +37,7 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
@@ -278,6 +280,13 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::WeakPtr<ShellIOManager> GetIOManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Shells may only be accessed on the platform task runner.
+  ///
+  /// @return     A weak pointer to the shell.
+  ///
+  fml::WeakPtr<const Shell> GetWeakPtr() const;
+
   // Embedders should call this under low memory conditions to free up
   // internal caches used.
   //
@@ -365,6 +374,15 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
       const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the statistics aggregated over every frame
+  ///             rendered by this shell. These are updated by the animator
+  ///             and the rasterizer and may be read from any thread.
+  ///
+  /// @return     The frame statistics of this shell.
+  ///
+  const std::shared_ptr<FrameStatistics>& GetFrameStatistics() const;
+
   //----------------------------------------------------------------------------
   /// @brief     Marks the GPU as available or unavailable.
   void SetGpuAvailability(GpuAvailability availability);
@@ -426,6 +444,10 @@ class Shell final : public PlatformView::Delegate,
   InferVmInitDataFromSettings(Settings& settings);
 
  private:
+  // The running VM and the isolate snapshot to launch the root isolate from.
+  // The VM may still be starting while the rest of the shell is set up.
+  using VMInitData = std::pair<DartVMRef, fml::RefPtr<const DartSnapshot>>;
+
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
                          rapidjson::Document*)>;
@@ -442,7 +464,10 @@ class Shell final : public PlatformView::Delegate,
       resource_cache_limit_calculator_;
   size_t resource_cache_limit_;
   const Settings settings_;
-  DartVMRef vm_;
+  // Resolved from |vm_init_data_| by |ResolveVM|, at the latest when the shell
+  // is set up.
+  mutable DartVMRef vm_;
+  std::shared_future<VMInitData> vm_init_data_;
   mutable std::mutex time_recorder_mutex_;
   std::optional<fml::TimePoint> latest_frame_target_time_;
   std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
@@ -451,6 +476,10 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
+  std::shared_ptr<FrameStatistics> frame_statistics_;
+  // Only set if `Settings::enable_pointer_event_coalescing` is. Used on the
+  // platform thread.
+  std::unique_ptr<PointerDataCoalescer> pointer_data_coalescer_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
@@ -471,6 +500,9 @@ class Shell final : public PlatformView::Delegate,
   uint64_t next_pointer_flow_id_ = 0;
 
   bool first_frame_rasterized_ = false;
+  // Whether the pages of the snapshots touched before the first frame have
+  // been recorded. Only accessed on the raster thread.
+  bool snapshot_page_profile_recorded_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
@@ -506,7 +538,7 @@ class Shell final : public PlatformView::Delegate,
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
-  Shell(DartVMRef vm,
+  Shell(std::shared_future<VMInitData> vm_init_data,
         const TaskRunners& task_runners,
         fml::RefPtr<fml::RasterThreadMerger> parent_merger,
         const std::shared_ptr<ResourceCacheLimitCalculator>&
@@ -516,7 +548,7 @@ class Shell final : public PlatformView::Delegate,
         bool is_gpu_disabled);
 
   static std::unique_ptr<Shell> CreateShellOnPlatformThread(
-      DartVMRef vm,
+      std::shared_future<VMInitData> vm_init_data,
       fml::RefPtr<fml::RasterThreadMerger> parent_merger,
       std::shared_ptr<ShellIOManager> parent_io_manager,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
@@ -524,7 +556,6 @@ class Shell final : public PlatformView::Delegate,
       const TaskRunners& task_runners,
       const PlatformData& platform_data,
       const Settings& settings,
-      fml::RefPtr<const DartSnapshot> isolate_snapshot,
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
       const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
       const EngineCreateCallback& on_create_engine,
@@ -538,13 +569,17 @@ class Shell final : public PlatformView::Delegate,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
           resource_cache_limit_calculator,
       Settings settings,
-      DartVMRef vm,
-      fml::RefPtr<const DartSnapshot> isolate_snapshot,
+      std::shared_future<VMInitData> vm_init_data,
       const CreateCallback<PlatformView>& on_create_platform_view,
       const CreateCallback<Rasterizer>& on_create_rasterizer,
       const EngineCreateCallback& on_create_engine,
       bool is_gpu_disabled);
 
+  // Returns |vm_|, waiting for the VM to start if the platform view asks for
+  // it while it is still starting. Until the shell is set up, this may only be
+  // called on the platform thread.
+  DartVMRef& ResolveVM() const;
+
   bool Setup(std::unique_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
              std::unique_ptr<Rasterizer> rasterizer,
@@ -552,6 +587,8 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  void RecordSnapshotPageProfile();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -583,6 +620,13 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
 
+  void DispatchPointerDataPacketToEngine(
+      std::unique_ptr<PointerDataPacket> packet);
+
+  // Releases the pointer events held back by `pointer_data_coalescer_` once
+  // the framework handled the previous packet.
+  void OnPointerDataPacketHandled();
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(int32_t node_id,
                                              SemanticsAction action,
@@ -749,6 +793,14 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the percentiles of the frame timings aggregated since the
+  // shell was created, or since the last call with the "reset" parameter.
+  bool OnServiceProtocolGetFrameStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   bool OnServiceProtocolEstimateRasterCacheMemory(
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -771,6 +823,15 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the events in the trace ring buffers of all threads, as a
+  // string in Chrome's JSON trace format. The buffers are cleared afterwards
+  // if the "clear" parameter is set.
+  bool OnServiceProtocolGetTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
@@ -4,15 +4,43 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/shell_pool.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+// The settings to run the shell test fixtures. |aot_symbols| must outlive the
+// VM.
+static Settings CreateSettingsForFixtures(const fml::UniqueFD& assets_dir,
+                                          testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,24 +52,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateSettingsForFixtures(assets_dir, aot_symbols);
 
     thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
         "io.flutter.bench.",
@@ -120,4 +131,148 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures how long it takes to get a running shell spawned from another one,
+// either by spawning it or by taking it from a pool of spawned shells.
+static void GetSpawnedShells(benchmark::State& state, bool pooled) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateSettingsForFixtures(assets_dir, aot_symbols);
+
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::kPlatform |
+                               ThreadHost::Type::kRaster |
+                               ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  Shell::CreateCallback<PlatformView> on_create_platform_view =
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      };
+  Shell::CreateCallback<Rasterizer> on_create_rasterizer = [](Shell& shell) {
+    return std::make_unique<Rasterizer>(shell);
+  };
+  auto create_configuration = [&settings]() {
+    auto configuration = RunConfiguration::InferFromSettings(settings);
+    configuration.SetEntrypoint("emptyMain");
+    return configuration;
+  };
+
+  auto shell = Shell::Create(flutter::PlatformData(), task_runners, settings,
+                             on_create_platform_view, on_create_rasterizer);
+  FML_CHECK(shell);
+
+  // Shells are spawned and destroyed on the platform thread.
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetPlatformTaskRunner()->PostTask([&]() {
+    shell->RunEngine(create_configuration());
+    std::unique_ptr<ShellPool> pool;
+    if (pooled) {
+      pool = std::make_unique<ShellPool>(*shell, 1, create_configuration, "/",
+                                         on_create_platform_view,
+                                         on_create_rasterizer);
+      pool->Fill();
+    }
+    while (state.KeepRunning()) {
+      auto spawn = pooled ? pool->Acquire()
+                          : shell->Spawn(create_configuration(), "/",
+                                         on_create_platform_view,
+                                         on_create_rasterizer);
+      FML_CHECK(spawn);
+      benchmarking::ScopedPauseTiming pause(state);
+      spawn.reset();
+      // The pool would refill in a later platform task, but this one blocks
+      // the platform thread until the benchmark is done.
+      if (pooled) {
+        pool->Fill();
+      }
+    }
+    pool.reset();
+    shell.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+static void BM_ShellSpawn(benchmark::State& state) {
+  GetSpawnedShells(state, false);
+}
+
+BENCHMARK(BM_ShellSpawn)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_ShellAcquireFromPool(benchmark::State& state) {
+  GetSpawnedShells(state, true);
+}
+
+BENCHMARK(BM_ShellAcquireFromPool)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Creates the given number of assets spread over a few subdirectories, like
+// the fonts, images and shaders of an app.
+static std::vector<std::string> CreateAssets(const fml::UniqueFD& directory,
+                                             size_t count) {
+  std::vector<std::string> asset_names;
+  const char* subdirs[] = {"fonts", "images", "shaders"};
+  for (const char* subdir : subdirs) {
+    fml::OpenDirectory(directory, subdir, true,
+                       fml::FilePermission::kReadWrite);
+  }
+  for (size_t i = 0; i < count; i++) {
+    auto name = std::string(subdirs[i % 3]) + "/asset_" + std::to_string(i);
+    FML_CHECK(fml::WriteAtomically(directory, name.c_str(),
+                                   fml::DataMapping(name)));
+    asset_names.push_back(std::move(name));
+  }
+  return asset_names;
+}
+
+// Resolves every asset of a bundle along with a pattern lookup like the one
+// made for the shader warm-up, as an app does during startup.
+static void LookUpAssets(benchmark::State& state, bool packed) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kReadWrite);
+  const auto asset_names = CreateAssets(asset_dir_fd, state.range(0));
+  if (packed) {
+    FML_CHECK(PackedAssetBundle::PackDirectory(asset_dir_fd));
+  }
+
+  while (state.KeepRunning()) {
+    AssetManager asset_manager;
+    if (packed) {
+      asset_manager.PushBack(PackedAssetBundle::Create(asset_dir_fd, false));
+    } else {
+      asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+          fml::Duplicate(asset_dir_fd.get()), false));
+    }
+    for (const auto& asset_name : asset_names) {
+      benchmark::DoNotOptimize(asset_manager.GetAsMapping(asset_name));
+    }
+    benchmark::DoNotOptimize(
+        asset_manager.GetAsMappings("(.*)_0", std::string("shaders")));
+  }
+}
+
+static void BM_AssetLookupFromDirectory(benchmark::State& state) {
+  LookUpAssets(state, false);
+}
+
+BENCHMARK(BM_AssetLookupFromDirectory)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_AssetLookupFromPackedBundle(benchmark::State& state) {
+  LookUpAssets(state, true);
+}
+
+BENCHMARK(BM_AssetLookupFromPackedBundle)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
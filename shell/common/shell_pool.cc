@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shell_pool.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ShellPool::ShellPool(
+    const Shell& spawner,
+    size_t capacity,
+    RunConfigurationCallback on_create_configuration,
+    std::string initial_route,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer)
+    : spawner_(spawner.GetWeakPtr()),
+      platform_task_runner_(spawner.GetTaskRunners().GetPlatformTaskRunner()),
+      capacity_(capacity),
+      on_create_configuration_(std::move(on_create_configuration)),
+      initial_route_(std::move(initial_route)),
+      on_create_platform_view_(std::move(on_create_platform_view)),
+      on_create_rasterizer_(std::move(on_create_rasterizer)),
+      weak_factory_(this) {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+}
+
+ShellPool::~ShellPool() = default;
+
+void ShellPool::Fill() {
+  TRACE_EVENT0("flutter", "ShellPool::Fill");
+  while (idle_shells_.size() < capacity_) {
+    auto shell = SpawnShell();
+    if (!shell) {
+      return;
+    }
+    idle_shells_.push_back(std::move(shell));
+  }
+}
+
+std::unique_ptr<Shell> ShellPool::Acquire() {
+  TRACE_EVENT0("flutter", "ShellPool::Acquire");
+  std::unique_ptr<Shell> shell;
+  if (idle_shells_.empty()) {
+    shell = SpawnShell();
+  } else {
+    shell = std::move(idle_shells_.front());
+    idle_shells_.pop_front();
+  }
+  ScheduleRefill();
+  return shell;
+}
+
+void ShellPool::Clear() {
+  idle_shells_.clear();
+}
+
+size_t ShellPool::GetIdleShellCount() const {
+  return idle_shells_.size();
+}
+
+size_t ShellPool::GetCapacity() const {
+  return capacity_;
+}
+
+std::unique_ptr<Shell> ShellPool::SpawnShell() const {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "ShellPool::SpawnShell");
+  if (!spawner_) {
+    FML_DLOG(WARNING) << "The shell to spawn pooled shells from was destroyed.";
+    return nullptr;
+  }
+  auto configuration = on_create_configuration_();
+  if (!configuration.IsValid()) {
+    FML_LOG(ERROR) << "Could not create the run configuration of a pooled "
+                      "shell.";
+    return nullptr;
+  }
+  return spawner_->Spawn(std::move(configuration), initial_route_,
+                         on_create_platform_view_, on_create_rasterizer_);
+}
+
+void ShellPool::ScheduleRefill() {
+  if (refill_scheduled_ || idle_shells_.size() >= capacity_ || !spawner_) {
+    return;
+  }
+  refill_scheduled_ = true;
+  // Spawn one shell per task so that the platform thread stays responsive
+  // while the pool refills.
+  platform_task_runner_->PostTask([pool = weak_factory_.GetWeakPtr()]() {
+    // The pool may outlive the shell it spawns from.
+    if (!pool || !pool->spawner_) {
+      return;
+    }
+    pool->refill_scheduled_ = false;
+    if (pool->idle_shells_.size() < pool->capacity_) {
+      auto shell = pool->SpawnShell();
+      if (!shell) {
+        return;
+      }
+      pool->idle_shells_.push_back(std::move(shell));
+    }
+    pool->ScheduleRefill();
+  });
+}
+
+}  // namespace flutter
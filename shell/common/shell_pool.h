@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+#define FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps a number of idle shells spawned from a running shell, so
+///             that views which come and go often can be given a shell
+///             without waiting for one to be spawned.
+///
+///             Spawned shells share the VM, the isolate group, the IO manager
+///             (and with it the resource context and the image caches) and the
+///             font collection of the shell they are spawned from. They also
+///             share its GPU context if the platform views created for them
+///             do.
+///
+///             Pooled shells are run as soon as they are spawned, since
+///             `Shell::Spawn` runs the shell it returns. Their root isolate
+///             has already entered its entrypoint, with the initial route of
+///             the pool, when the shell is handed out. Every pooled shell
+///             therefore starts on the same route. A view that needs another
+///             route must navigate once it has acquired its shell, for
+///             example by pushing the route over the navigation channel.
+///
+///             The pool must only be used on the platform thread of the
+///             shell it spawns from. The pool may outlive that shell, but
+///             it stops spawning shells once that shell is destroyed. The
+///             idle shells keep working, as spawned shells do not depend on
+///             the shell they were spawned from.
+///
+///             The pool is not exposed through the embedder API. That API
+///             has no notion of spawned engines. Embedders show views that
+///             come and go often by adding them to a single engine with
+///             `FlutterEngineAddView` instead. Spawned shells would also
+///             present through the renderer callbacks of the spawning
+///             engine.
+///
+class ShellPool {
+ public:
+  using RunConfigurationCallback = std::function<RunConfiguration()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an empty pool. Call `Fill` to spawn its shells.
+  ///
+  /// @param[in]  spawner                  The running shell to spawn from.
+  /// @param[in]  capacity                 The number of idle shells to keep.
+  /// @param[in]  on_create_configuration  Creates the run configuration of
+  ///                                      each spawned shell.
+  /// @param[in]  initial_route            The initial route of every spawned
+  ///                                      shell.
+  /// @param[in]  on_create_platform_view  See `Shell::Spawn`.
+  /// @param[in]  on_create_rasterizer     See `Shell::Spawn`.
+  ///
+  ShellPool(const Shell& spawner,
+            size_t capacity,
+            RunConfigurationCallback on_create_configuration,
+            std::string initial_route,
+            Shell::CreateCallback<PlatformView> on_create_platform_view,
+            Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+
+  ~ShellPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Spawns shells until the pool is full. This blocks for as long
+  ///             as spawning them takes, so it is best called while the
+  ///             application is otherwise idle.
+  ///
+  void Fill();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands out an idle shell and schedules spawning its
+  ///             replacement on the platform thread. If the pool is empty, a
+  ///             shell is spawned synchronously instead.
+  ///
+  /// @return     The shell, or null if it could not be spawned, for example
+  ///             because the shell to spawn from was destroyed.
+  ///
+  std::unique_ptr<Shell> Acquire();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the idle shells, for example when the system is low
+  ///             on memory. The pool is refilled by the next call to `Fill`
+  ///             or `Acquire`.
+  ///
+  void Clear();
+
+  size_t GetIdleShellCount() const;
+
+  size_t GetCapacity() const;
+
+ private:
+  const fml::WeakPtr<const Shell> spawner_;
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  const size_t capacity_;
+  const RunConfigurationCallback on_create_configuration_;
+  const std::string initial_route_;
+  const Shell::CreateCallback<PlatformView> on_create_platform_view_;
+  const Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
+  std::deque<std::unique_ptr<Shell>> idle_shells_;
+  bool refill_scheduled_ = false;
+  fml::WeakPtrFactory<ShellPool> weak_factory_;  // Must be the last member.
+
+  std::unique_ptr<Shell> SpawnShell() const;
+
+  void ScheduleRefill();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHELL_POOL_H_
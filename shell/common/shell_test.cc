@@ -318,6 +318,9 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetTraceRingBuffer:
+        shell->OnServiceProtocolGetTraceRingBuffer(params, response);
+        break;
     }
     finished.set_value(true);
   });
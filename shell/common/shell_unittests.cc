@@ -20,6 +20,7 @@
 
 #include "assets/asset_resolver.h"
 #include "assets/directory_asset_bundle.h"
+#include "assets/packed_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
@@ -33,9 +34,12 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/shell_pool.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -488,6 +492,78 @@ TEST_F(ShellTest,
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, PlatformViewCanAccessDartVMWhileItStarts) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "io.flutter.test." + GetCurrentTestName() + ".",
+      ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+          ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  // The VM starts on the UI thread while the platform view is created, so
+  // asking for it has to wait until it is running.
+  DartVM* vm_during_platform_view_creation = nullptr;
+  auto shell = Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [&vm_during_platform_view_creation](Shell& shell) {
+        vm_during_platform_view_creation = shell.GetDartVM();
+        const auto vsync_clock = std::make_shared<ShellTestVsyncClock>();
+        return ShellTestPlatformView::Create(
+            shell, shell.GetTaskRunners(), vsync_clock,
+            [task_runners = shell.GetTaskRunners()]() {
+              return static_cast<std::unique_ptr<VsyncWaiter>>(
+                  std::make_unique<VsyncWaiterFallback>(task_runners));
+            },
+            ShellTestPlatformView::BackendType::kDefaultBackend, nullptr,
+            shell.GetIsGpuDisabledSyncSwitch());
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  ASSERT_NE(vm_during_platform_view_creation, nullptr);
+  ASSERT_NE(vm_during_platform_view_creation->GetVMData(), nullptr);
+  ASSERT_EQ(vm_during_platform_view_creation, shell->GetDartVM());
+  DestroyShell(std::move(shell), task_runners);
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
+TEST_F(ShellTest, PlatformViewCanAccessWorkerTaskRunnerWhileVMStarts) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "io.flutter.test." + GetCurrentTestName() + ".",
+      ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+          ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  // iOS hands the worker task runner to its platform view.
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+  auto shell = Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [&worker_task_runner](Shell& shell) {
+        worker_task_runner = shell.GetConcurrentWorkerTaskRunner();
+        const auto vsync_clock = std::make_shared<ShellTestVsyncClock>();
+        return ShellTestPlatformView::Create(
+            shell, shell.GetTaskRunners(), vsync_clock,
+            [task_runners = shell.GetTaskRunners()]() {
+              return static_cast<std::unique_ptr<VsyncWaiter>>(
+                  std::make_unique<VsyncWaiterFallback>(task_runners));
+            },
+            ShellTestPlatformView::BackendType::kDefaultBackend, nullptr,
+            shell.GetIsGpuDisabledSyncSwitch());
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  ASSERT_NE(worker_task_runner, nullptr);
+  ASSERT_EQ(worker_task_runner, shell->GetConcurrentWorkerTaskRunner());
+  DestroyShell(std::move(shell), task_runners);
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, InitializeWithDisabledGpu) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -2566,6 +2642,35 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetTraceRingBufferWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  fml::tracing::TraceRingBufferClear();
+  fml::tracing::TraceRingBufferSetEnabled(true);
+  TRACE_EVENT_INSTANT0("flutter", "ServiceProtocolRingBufferEvent");
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["clear"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTraceRingBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), params,
+                    &document);
+  fml::tracing::TraceRingBufferSetEnabled(false);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "TraceRingBuffer");
+  EXPECT_TRUE(document["enabled"].GetBool());
+  const std::string trace = document["trace"].GetString();
+  EXPECT_NE(trace.find("ServiceProtocolRingBufferEvent"), std::string::npos)
+      << trace;
+  EXPECT_EQ(fml::tracing::TraceRingBufferExportJSON().find(
+                "ServiceProtocolRingBufferEvent"),
+            std::string::npos);
+
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -3138,6 +3243,132 @@ TEST_F(ShellTest, AssetManagerMulti) {
   }
 }
 
+TEST_F(ShellTest, PackedAssetBundleResolvesAssets) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kReadWrite);
+  fml::UniqueFD subdir_fd =
+      fml::OpenDirectory((asset_dir.path() + "/subdir").c_str(), true,
+                         fml::FilePermission::kReadWrite);
+
+  std::vector<std::string> filenames = {"good0", "bad0"};
+  std::vector<std::string> subdir_filenames = {"good1", "bad1"};
+  for (const auto& filename : filenames) {
+    ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, filename.c_str(),
+                                     fml::DataMapping(filename)));
+  }
+  for (const auto& filename : subdir_filenames) {
+    ASSERT_TRUE(fml::WriteAtomically(subdir_fd, filename.c_str(),
+                                     fml::DataMapping(filename)));
+  }
+
+  ASSERT_TRUE(PackedAssetBundle::PackDirectory(asset_dir_fd));
+  auto bundle = PackedAssetBundle::Create(asset_dir_fd, false);
+  ASSERT_TRUE(bundle);
+
+  // The loose files are no longer needed.
+  for (const auto& filename : subdir_filenames) {
+    ASSERT_TRUE(fml::UnlinkFile(subdir_fd, filename.c_str()));
+  }
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(std::move(bundle)));
+
+  for (const auto& filename : {"good0", "bad0", "subdir/good1"}) {
+    auto mapping = asset_manager.GetAsMapping(filename);
+    ASSERT_TRUE(mapping != nullptr) << filename;
+    std::string result(reinterpret_cast<const char*>(mapping->GetMapping()),
+                       mapping->GetSize());
+    EXPECT_EQ(result, std::string(filename).substr(
+                          std::string(filename).rfind('/') + 1));
+  }
+  EXPECT_EQ(asset_manager.GetAsMapping("good1"), nullptr);
+  EXPECT_EQ(asset_manager.GetAsMapping(PackedAssetBundle::kFileName), nullptr);
+
+  EXPECT_EQ(asset_manager.GetAsMappings("(.*)", std::nullopt).size(), 4u);
+  EXPECT_EQ(asset_manager.GetAsMappings("good(.*)", std::nullopt).size(), 2u);
+  auto mappings = asset_manager.GetAsMappings("good(.*)", "subdir");
+  ASSERT_EQ(mappings.size(), 1u);
+  std::string result(reinterpret_cast<const char*>(mappings[0]->GetMapping()),
+                     mappings[0]->GetSize());
+  EXPECT_EQ(result, "good1");
+}
+
+TEST_F(ShellTest, PackedAssetBundleDoesNotHideUpdatedAssetsInJIT) {
+  if (DartVM::IsRunningPrecompiledCode()) {
+    GTEST_SKIP() << "Packed bundles are only ignored by JIT code.";
+  }
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, "asset",
+                                   fml::DataMapping("packed")));
+  ASSERT_TRUE(PackedAssetBundle::PackDirectory(asset_dir_fd));
+
+  // Hot reload updates the loose file.
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, "asset",
+                                   fml::DataMapping("updated")));
+
+  Settings settings = CreateSettingsForFixture();
+  settings.assets_path = asset_dir.path();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto mapping = configuration.GetAssetManager()->GetAsMapping("asset");
+  ASSERT_TRUE(mapping != nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            "updated");
+}
+
+TEST_F(ShellTest, PackedAssetBundleFallsBackForAssetsAddedLater) {
+  fml::ScopedTemporaryDirectory asset_dir;
+  fml::UniqueFD asset_dir_fd = fml::OpenDirectory(
+      asset_dir.path().c_str(), false, fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fml::WriteAtomically(asset_dir_fd, "packed",
+                                   fml::DataMapping("packed")));
+  ASSERT_TRUE(PackedAssetBundle::PackDirectory(asset_dir_fd));
+  ASSERT_TRUE(
+      fml::WriteAtomically(asset_dir_fd, "added", fml::DataMapping("added")));
+
+  AssetManager asset_manager;
+  ASSERT_TRUE(asset_manager.PushBack(PackedAssetBundle::Create(
+      asset_dir_fd, false,
+      std::make_unique<DirectoryAssetBundle>(
+          fml::Duplicate(asset_dir_fd.get()), false))));
+  for (const auto& filename : {"packed", "added"}) {
+    auto mapping = asset_manager.GetAsMapping(filename);
+    ASSERT_TRUE(mapping != nullptr) << filename;
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                          mapping->GetSize()),
+              filename);
+  }
+  EXPECT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+}
+
+TEST_F(ShellTest, PackedAssetBundleRejectsMalformedData) {
+  PackedAssetBundle::Assets assets;
+  assets["asset"] = std::make_unique<fml::DataMapping>("contents");
+  assets["empty"] = std::make_unique<fml::DataMapping>("");
+  auto packed = PackedAssetBundle::Pack(assets);
+  AssetManager asset_manager;
+
+  std::vector<uint8_t> truncated(packed->GetMapping(),
+                                 packed->GetMapping() + packed->GetSize() - 1);
+  EXPECT_FALSE(asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_shared<fml::DataMapping>(std::move(truncated)), false)));
+
+  std::vector<uint8_t> bad_magic(packed->GetMapping(),
+                                 packed->GetMapping() + packed->GetSize());
+  bad_magic[0] ^= 0xff;
+  EXPECT_FALSE(asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_shared<fml::DataMapping>(std::move(bad_magic)), false)));
+
+  EXPECT_TRUE(asset_manager.PushBack(
+      std::make_unique<PackedAssetBundle>(std::move(packed), false)));
+  auto empty = asset_manager.GetAsMapping("empty");
+  ASSERT_TRUE(empty != nullptr);
+  EXPECT_EQ(empty->GetSize(), 0u);
+}
+
 #if defined(OS_FUCHSIA)
 TEST_F(ShellTest, AssetManagerMultiSubdir) {
   std::string subdir_path = "subdir";
@@ -3303,6 +3534,100 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, ShellPoolHandsOutSpawnedShells) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  std::unique_ptr<ShellPool> pool;
+  std::unique_ptr<Shell> acquired;
+  PostSync(platform_task_runner, [&]() {
+    pool = std::make_unique<ShellPool>(
+        *shell, 2,
+        [&settings]() {
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("emptyMain");
+          return configuration;
+        },
+        "/foo",
+        [](Shell& shell) {
+          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    ASSERT_EQ(pool->GetIdleShellCount(), 0u);
+    pool->Fill();
+    ASSERT_EQ(pool->GetIdleShellCount(), 2u);
+
+    acquired = pool->Acquire();
+    ASSERT_NE(acquired, nullptr);
+    ASSERT_TRUE(acquired->IsSetup());
+    ASSERT_EQ(pool->GetIdleShellCount(), 1u);
+  });
+
+  PostSync(acquired->GetTaskRunners().GetUITaskRunner(), [&acquired]() {
+    ASSERT_EQ(acquired->GetEngine()->InitialRoute(), "/foo");
+    ASSERT_EQ(acquired->GetEngine()->GetLastEntrypoint(), "emptyMain");
+  });
+
+  // The replacement of the acquired shell is spawned in a later task.
+  PostSync(platform_task_runner, [&]() {
+    ASSERT_EQ(pool->GetIdleShellCount(), 2u);
+    pool->Clear();
+    ASSERT_EQ(pool->GetIdleShellCount(), 0u);
+    pool.reset();
+    acquired.reset();
+  });
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, ShellPoolOutlivesTheShellItSpawnsFrom) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  std::unique_ptr<ShellPool> pool;
+  PostSync(platform_task_runner, [&]() {
+    pool = std::make_unique<ShellPool>(
+        *shell, 1,
+        [&settings]() {
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("emptyMain");
+          return configuration;
+        },
+        "/",
+        [](Shell& shell) {
+          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    pool->Fill();
+    ASSERT_EQ(pool->GetIdleShellCount(), 1u);
+  });
+
+  DestroyShell(std::move(shell));
+
+  PostSync(platform_task_runner, [&]() {
+    // The idle shell is still handed out, but no replacement is spawned.
+    auto acquired = pool->Acquire();
+    ASSERT_NE(acquired, nullptr);
+    ASSERT_EQ(pool->Acquire(), nullptr);
+    pool.reset();
+    acquired.reset();
+  });
+}
+
 TEST_F(ShellTest, SpawnWithDartEntrypointArgs) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -355,6 +355,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  settings.trace_to_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceToRingBuffer));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -412,6 +415,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         {snapshot_asset_path, isolate_snapshot_instr_filename});
   }
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPageProfilePath),
+                              &settings.snapshot_page_profile_path);
+
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
@@ -469,6 +475,8 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
   settings.enable_vulkan_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanGPUTracing));
+  settings.enable_pointer_event_coalescing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerEventCoalescing));
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
@@ -53,6 +53,12 @@ DEF_SWITCH(IsolateSnapshotInstructions,
            "isolate-snapshot-instr",
            "The isolate instructions snapshot that will be memory mapped as "
            "read and executable. SnapshotAssetPath must be present.")
+DEF_SWITCH(SnapshotPageProfilePath,
+           "snapshot-page-profile-path",
+           "Path to a file recording the pages of the Dart snapshots resident "
+           "after launch. If the file exists, those pages are read ahead "
+           "before the VM starts. Otherwise, or if the snapshots changed, "
+           "the file is written after the first frame.")
 DEF_SWITCH(CacheDirPath,
            "cache-dir-path",
            "Path to the cache directory. "
@@ -202,6 +208,12 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(TraceToRingBuffer,
+           "trace-to-ring-buffer",
+           "Record trace events into per-thread ring buffers instead of the "
+           "timeline. The most recent events can be fetched in Chrome's JSON "
+           "trace format with the _flutter.getTraceRingBuffer service "
+           "extension.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -283,6 +295,13 @@ DEF_SWITCH(EnableVulkanGPUTracing,
            "enable-vulkan-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "Vulkan backend.")
+DEF_SWITCH(EnablePointerEventCoalescing,
+           "enable-pointer-event-coalescing",
+           "Coalesce move and hover events of the same pointer that arrive "
+           "while the framework is still handling previous pointer events. "
+           "This reduces UI thread work for high frequency input devices. "
+           "The replaced samples are delivered as the historical samples of "
+           "the event they were coalesced into.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
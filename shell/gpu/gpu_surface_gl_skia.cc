@@ -7,6 +7,7 @@
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/fml/size.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/context_options.h"
@@ -61,8 +62,6 @@ sk_sp<GrDirectContext> GPUSurfaceGLSkia::MakeGLContext(
 
   context->setResourceCacheLimit(kGrCacheMaxByteSize);
 
-  PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(context.get());
-
   return context;
 }
 
@@ -70,6 +69,7 @@ GPUSurfaceGLSkia::GPUSurfaceGLSkia(GPUSurfaceGLDelegate* delegate,
                                    bool render_to_surface)
     : GPUSurfaceGLSkia(MakeGLContext(delegate), delegate, render_to_surface) {
   context_owner_ = true;
+  WarmUpKnownSkSLs();
 }
 
 GPUSurfaceGLSkia::GPUSurfaceGLSkia(const sk_sp<GrDirectContext>& gr_context,
@@ -113,6 +113,39 @@ GPUSurfaceGLSkia::~GPUSurfaceGLSkia() {
   delegate_->GLContextClearCurrent();
 }
 
+void GPUSurfaceGLSkia::WarmUpKnownSkSLs() {
+  if (!valid_) {
+    return;
+  }
+
+  if (!fml::MessageLoop::IsInitializedForCurrentThread()) {
+    auto context_switch = delegate_->GLContextMakeCurrent();
+    if (context_switch->GetResult()) {
+      PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(
+          context_.get());
+    }
+    return;
+  }
+
+  // This surface owns its context, so the warm-up lives as long as both and
+  // only precompiles on this thread.
+  owned_sksl_warm_up_ = PersistentCache::StartSkSLWarmUp(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(),
+      [this](const PersistentCache::SkSLCache& sksl) {
+        auto context_switch = delegate_->GLContextMakeCurrent();
+        if (!context_switch->GetResult()) {
+          return false;
+        }
+        return context_->precompileShader(*sksl.key, *sksl.value);
+      });
+  sksl_warm_up_ = owned_sksl_warm_up_;
+}
+
+void GPUSurfaceGLSkia::SetSkSLWarmUp(
+    const std::weak_ptr<PersistentCache::SkSLWarmUp>& sksl_warm_up) {
+  sksl_warm_up_ = sksl_warm_up;
+}
+
 // |Surface|
 bool GPUSurfaceGLSkia::IsValid() {
   return valid_;
@@ -217,6 +250,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLSkia::AcquireFrame(
   if (delegate_ == nullptr) {
     return nullptr;
   }
+
+  // Skia compiles the SkSLs that are not warmed up yet when the frame uses
+  // them, instead of the frame waiting for all of them. The others are warmed
+  // up between frames.
+  if (auto sksl_warm_up = sksl_warm_up_.lock()) {
+    sksl_warm_up->ReportFirstUse();
+    sksl_warm_up_.reset();
+  }
+
   auto context_switch = delegate_->GLContextMakeCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR)
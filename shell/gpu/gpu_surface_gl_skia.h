@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
@@ -55,7 +56,16 @@ class GPUSurfaceGLSkia : public Surface {
   // |Surface|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // Sets the warm-up of the known SkSLs in the context of this surface, which
+  // is told when the first frame uses the context. The warm-up is owned by the
+  // owner of the context. Surfaces that create their context start and own
+  // their warm-up.
+  void SetSkSLWarmUp(
+      const std::weak_ptr<PersistentCache::SkSLWarmUp>& sksl_warm_up);
+
  private:
+  void WarmUpKnownSkSLs();
+
   bool CreateOrUpdateSurfaces(const SkISize& size);
 
   sk_sp<SkSurface> AcquireRenderSurface(
@@ -74,6 +84,9 @@ class GPUSurfaceGLSkia : public Surface {
   // `GLContextFrameBufferInfo`.
   std::optional<SkIRect> existing_damage_ = std::nullopt;
   bool context_owner_ = false;
+  // Only set if |context_owner_|.
+  std::shared_ptr<PersistentCache::SkSLWarmUp> owned_sksl_warm_up_;
+  std::weak_ptr<PersistentCache::SkSLWarmUp> sksl_warm_up_;
   // TODO(38466): Refactor GPU surface APIs take into account the fact that an
   // external view embedder may want to render to the root surface. This is a
   // hack to make avoid allocating resources for the root surface when an
@@ -180,6 +180,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
               display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
               impeller_dispatcher.FinishRecording();
               aiks_context->GetContentContext().GetTransientsBuffer().Reset();
+              aiks_context->GetContentContext().GetUploadArena().AdvanceFrame();
               aiks_context->GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
               return true;
             }));
@@ -297,6 +298,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
               display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
               impeller_dispatcher.FinishRecording();
               aiks_context->GetContentContext().GetTransientsBuffer().Reset();
+              aiks_context->GetContentContext().GetUploadArena().AdvanceFrame();
               aiks_context->GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
               return true;
             }));
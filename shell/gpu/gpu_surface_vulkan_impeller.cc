@@ -107,6 +107,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
                   SkIRect::MakeWH(cull_rect.width, cull_rect.height));
               impeller_dispatcher.FinishRecording();
               aiks_context->GetContentContext().GetTransientsBuffer().Reset();
+              aiks_context->GetContentContext().GetUploadArena().AdvanceFrame();
               aiks_context->GetContentContext()
                   .GetLazyGlyphAtlas()
                   ->ResetTextFrames();
@@ -4,11 +4,13 @@
 
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/impeller/renderer/backend/gles/context_gles.h"
 #include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
 #include "flutter/impeller/toolkit/egl/context.h"
 #include "flutter/impeller/toolkit/egl/surface.h"
+#include "impeller/entity/gles/entity_es3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 
@@ -72,9 +74,17 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
           impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
 #endif  // IMPELLER_ENABLE_3D
   };
+  if (proc_table->GetCapabilities()->SupportsES3ShaderLibraries()) {
+    // Replaces the GLSL ES 100 entity shaders, so it must come after them.
+    shader_mappings.push_back(std::make_shared<fml::NonOwnedMapping>(
+        impeller_entity_es3_shaders_gles_data,
+        impeller_entity_es3_shaders_gles_length));
+  }
 
   auto context = impeller::ContextGLES::Create(
-      std::move(proc_table), shader_mappings, enable_gpu_tracing);
+      std::move(proc_table), shader_mappings, enable_gpu_tracing,
+      PersistentCache::MakeImpellerCacheDirectory("gles"),
+      PersistentCache::gIsReadOnly);
   if (!context) {
     FML_LOG(ERROR) << "Could not create OpenGLES Impeller Context.";
     return nullptr;
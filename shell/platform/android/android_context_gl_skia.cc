@@ -116,6 +116,9 @@ AndroidContextGLSkia::~AndroidContextGLSkia() {
   // This context needs to be deallocated from the raster thread in order to
   // keep a coherent usage of egl from a single thread.
   fml::TaskRunner::RunNowOrPostTask(task_runners_.GetRasterTaskRunner(), [&] {
+    // The warm-up holds the main context and must not precompile in it once
+    // it is abandoned.
+    sksl_warm_up_.reset();
     if (main_context) {
       std::unique_ptr<AndroidEGLSurface> pbuffer_surface =
           CreatePbufferSurface();
@@ -190,6 +193,35 @@ bool AndroidContextGLSkia::IsValid() const {
   return valid_;
 }
 
+void AndroidContextGLSkia::WarmUpKnownSkSLs() {
+  if (!task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread()) {
+    return;
+  }
+  sk_sp<GrDirectContext> main_context = GetMainSkiaContext();
+  if (!main_context || sksl_warm_up_) {
+    return;
+  }
+  std::shared_ptr<AndroidEGLSurface> pbuffer_surface = CreatePbufferSurface();
+  sksl_warm_up_ = PersistentCache::StartSkSLWarmUp(
+      task_runners_.GetRasterTaskRunner(),
+      [context = context_, main_context = std::move(main_context),
+       pbuffer_surface](const PersistentCache::SkSLCache& sksl) {
+        // Frames bind the context to their onscreen surface. Between frames,
+        // it is bound to a pbuffer surface unless it is still current.
+        if (eglGetCurrentContext() != context &&
+            pbuffer_surface->MakeCurrent() ==
+                AndroidEGLSurfaceMakeCurrentStatus::kFailure) {
+          return false;
+        }
+        return main_context->precompileShader(*sksl.key, *sksl.value);
+      });
+}
+
+std::weak_ptr<PersistentCache::SkSLWarmUp> AndroidContextGLSkia::GetSkSLWarmUp()
+    const {
+  return sksl_warm_up_;
+}
+
 bool AndroidContextGLSkia::ClearCurrent() const {
   if (eglGetCurrentContext() != context_) {
     return true;
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_SKIA_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_SKIA_H_
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
@@ -101,6 +102,22 @@ class AndroidContextGLSkia : public AndroidContext {
   ///
   EGLConfig Config() const { return config_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts precompiling the known SkSLs in the main Skia context
+  ///             on the raster thread, between frames. The warm-up is owned
+  ///             by this context, so it goes on across the surfaces that
+  ///             share the main Skia context.
+  ///
+  ///             This does nothing unless it is called on the raster thread
+  ///             once the main Skia context is set. Later calls do nothing.
+  ///
+  void WarmUpKnownSkSLs();
+
+  //----------------------------------------------------------------------------
+  /// @return     The warm-up started by |WarmUpKnownSkSLs|, if any.
+  ///
+  std::weak_ptr<PersistentCache::SkSLWarmUp> GetSkSLWarmUp() const;
+
  private:
   fml::RefPtr<AndroidEnvironmentGL> environment_;
   EGLConfig config_;
@@ -108,6 +125,8 @@ class AndroidContextGLSkia : public AndroidContext {
   EGLContext resource_context_;
   bool valid_ = false;
   TaskRunners task_runners_;
+  // Only accessed on the raster thread.
+  std::shared_ptr<PersistentCache::SkSLWarmUp> sksl_warm_up_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextGLSkia);
 };
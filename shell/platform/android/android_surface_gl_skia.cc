@@ -58,8 +58,12 @@ std::unique_ptr<Surface> AndroidSurfaceGLSkia::CreateGPUSurface(
     if (!main_skia_context) {
       main_skia_context = GPUSurfaceGLSkia::MakeGLContext(this);
       android_context_->SetMainSkiaContext(main_skia_context);
+      android_context_->WarmUpKnownSkSLs();
     }
-    return std::make_unique<GPUSurfaceGLSkia>(main_skia_context, this, true);
+    auto surface =
+        std::make_unique<GPUSurfaceGLSkia>(main_skia_context, this, true);
+    surface->SetSkSLWarmUp(android_context_->GetSkSLWarmUp());
+    return surface;
   }
 }
 
@@ -209,11 +213,13 @@ std::unique_ptr<Surface> AndroidSurfaceGLSkia::CreateSnapshotSurface() {
   }
   sk_sp<GrDirectContext> main_skia_context =
       android_context_->GetMainSkiaContext();
-  if (!main_skia_context) {
-    main_skia_context = GPUSurfaceGLSkia::MakeGLContext(this);
-    android_context_->SetMainSkiaContext(main_skia_context);
+  if (main_skia_context) {
+    return std::make_unique<GPUSurfaceGLSkia>(main_skia_context, this, true);
   }
-
+  main_skia_context = GPUSurfaceGLSkia::MakeGLContext(this);
+  android_context_->SetMainSkiaContext(main_skia_context);
+  // Later onscreen surfaces reuse the context, so it is warmed up now.
+  android_context_->WarmUpKnownSkSLs();
   return std::make_unique<GPUSurfaceGLSkia>(main_skia_context, this, true);
 }
 
@@ -84,7 +84,7 @@ public class AndroidTouchProcessor {
 
   // This value must match kPointerDataFieldCount in pointer_data.cc. (The
   // pointer_data.cc also lists other locations that must be kept consistent.)
-  private static final int POINTER_DATA_FIELD_COUNT = 36;
+  private static final int POINTER_DATA_FIELD_COUNT = 39;
   @VisibleForTesting static final int BYTES_PER_FIELD = 8;
 
   // Default if context is null, chosen to ensure reasonable speed scrolling.
@@ -422,6 +422,9 @@ public class AndroidTouchProcessor {
     packet.putDouble(1.0); // scale
     packet.putDouble(0.0); // rotation
     packet.putLong(viewId); // view_id
+    packet.putDouble(0.0); // predicted_physical_delta_x
+    packet.putDouble(0.0); // predicted_physical_delta_y
+    packet.putLong(0); // historical_sample_count
 
     if (isTrackpadPan && (panZoomType == PointerChange.PAN_ZOOM_END)) {
       ongoingPans.remove(pointerId);
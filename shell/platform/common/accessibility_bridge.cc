@@ -4,7 +4,11 @@
 
 #include "accessibility_bridge.h"
 
+#include <algorithm>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/third_party/accessibility/ax/ax_tree_manager_map.h"
@@ -19,6 +23,270 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+namespace {
+
+bool RectEquals(const FlutterRect& a, const FlutterRect& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+bool TransformationEquals(const FlutterTransformation& a,
+                          const FlutterTransformation& b) {
+  return a.scaleX == b.scaleX && a.skewX == b.skewX && a.transX == b.transX &&
+         a.skewY == b.skewY && a.scaleY == b.scaleY && a.transY == b.transY &&
+         a.pers0 == b.pers0 && a.pers1 == b.pers1 && a.pers2 == b.pers2;
+}
+
+}  // namespace
+
+struct AccessibilityBridge::PreparedUpdate {
+  // The nodes to remove from their current parents before applying |update|.
+  std::vector<int32_t> reparented_node_ids;
+  ui::AXTreeUpdate update;
+};
+
+// Converts batches of semantics updates into ui::AXTreeUpdates, in the order
+// they were committed.
+//
+// Preparing an update only reads the semantics of the nodes that previous
+// updates left in the tree, which the queue keeps a copy of, so it can run on
+// any thread while the platform thread uses the ui::AXTree.
+class AccessibilityBridge::UpdateQueue {
+ public:
+  struct Batch {
+    std::unordered_map<int32_t, SemanticsNode> nodes;
+    std::unordered_map<int32_t, SemanticsCustomAction> custom_actions;
+  };
+
+  explicit UpdateQueue(const ui::AXTreeData& tree_data)
+      : tree_data_(tree_data) {}
+
+  void Enqueue(Batch batch) {
+    std::scoped_lock lock(mutex_);
+    queued_.push_back(std::move(batch));
+  }
+
+  // Prepares every queued batch.
+  void PrepareQueuedUpdates() {
+    std::scoped_lock prepare_lock(prepare_mutex_);
+    while (true) {
+      Batch batch;
+      {
+        std::scoped_lock lock(mutex_);
+        if (queued_.empty()) {
+          return;
+        }
+        batch = std::move(queued_.front());
+        queued_.pop_front();
+      }
+      PreparedUpdate prepared = Prepare(batch);
+      {
+        std::scoped_lock lock(mutex_);
+        prepared_.push_back(std::move(prepared));
+      }
+    }
+  }
+
+  std::deque<PreparedUpdate> TakePreparedUpdates() {
+    std::scoped_lock lock(mutex_);
+    return std::exchange(prepared_, {});
+  }
+
+  // Makes the queue describe |tree| again after a prepared update could not
+  // be applied to it. The semantics of the resynced nodes are unknown, so the
+  // next update of each node is never skipped. Updates that were prepared
+  // before the resync may fail as well, and resync the queue again.
+  void ResyncFromTree(const ui::AXTree& tree);
+
+ private:
+  // Guards |queued_| and |prepared_|.
+  std::mutex mutex_;
+  std::deque<Batch> queued_;
+  std::deque<PreparedUpdate> prepared_;
+
+  // Serializes the preparation of batches and guards the members below, which
+  // describe the tree once every prepared update is applied.
+  std::mutex prepare_mutex_;
+  std::unordered_map<int32_t, SemanticsNode> nodes_;
+  std::unordered_map<int32_t, int32_t> parent_ids_;
+  std::unordered_set<int32_t> stale_ids_;
+  ui::AXTreeData tree_data_;
+  AccessibilityNodeId root_id_ = ui::AXNode::kInvalidAXID;
+
+  PreparedUpdate Prepare(Batch& batch);
+
+  // Whether the node is already in the tree exactly as in the given update.
+  bool IsCommitted(const SemanticsNode& node) const;
+
+  // Forgets the node and its descendants, which ui::AXTree deletes when the
+  // node is removed from its parent.
+  void RemoveSubtree(int32_t id);
+};
+
+AccessibilityBridge::PreparedUpdate AccessibilityBridge::UpdateQueue::Prepare(
+    Batch& batch) {
+  PreparedUpdate prepared;
+
+  // Find the nodes that the batch moves to a new parent. ui::AXTree deletes
+  // them along with their subtrees when they are removed from their old
+  // parents.
+  for (const auto& node_update : batch.nodes) {
+    for (int32_t child_id : node_update.second.children_in_traversal_order) {
+      // Skip nodes that don't exist or whose parents are unchanged. Flutter's
+      // root node has no parent and is never reparented.
+      auto parent = parent_ids_.find(child_id);
+      if (parent == parent_ids_.end() ||
+          parent->second == node_update.second.id) {
+        continue;
+      }
+
+      // This pending update moves the current child node.
+      // That new child must have a corresponding pending update.
+      assert(batch.nodes.find(child_id) != batch.nodes.end());
+
+      prepared.reparented_node_ids.push_back(child_id);
+    }
+  }
+  for (int32_t child_id : prepared.reparented_node_ids) {
+    auto parent = parent_ids_.find(child_id);
+    if (parent == parent_ids_.end()) {
+      // An ancestor was reparented as well.
+      continue;
+    }
+    std::vector<int32_t>& siblings =
+        nodes_[parent->second].children_in_traversal_order;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), child_id),
+                   siblings.end());
+    // The old parent keeps the rest of its data, which no longer matches its
+    // semantics, until it is updated again.
+    stale_ids_.insert(parent->second);
+    RemoveSubtree(child_id);
+  }
+
+  // Nodes that are unchanged since they were last committed need not be
+  // converted nor compared again by ui::AXTree. Reparented nodes were removed
+  // above and are never skipped.
+  for (auto iter = batch.nodes.begin(); iter != batch.nodes.end();) {
+    if (IsCommitted(iter->second)) {
+      iter = batch.nodes.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+
+  // Children that are no longer listed by their parent are deleted.
+  for (const auto& node_update : batch.nodes) {
+    const SemanticsNode& node = node_update.second;
+    auto committed = nodes_.find(node.id);
+    if (committed == nodes_.end() ||
+        committed->second.children_in_traversal_order ==
+            node.children_in_traversal_order) {
+      continue;
+    }
+    std::unordered_set<int32_t> children(
+        node.children_in_traversal_order.begin(),
+        node.children_in_traversal_order.end());
+    for (int32_t child_id : committed->second.children_in_traversal_order) {
+      if (children.find(child_id) == children.end()) {
+        RemoveSubtree(child_id);
+      }
+    }
+  }
+
+  // Figure out update order, ui::AXTree only accepts update in tree order,
+  // where parent node must come before the child node in
+  // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
+  // entire subtree into a list. We pick another node from the remaining update,
+  // and keep doing so until the update map is empty. We then concatenate the
+  // lists in the reversed order, this guarantees parent updates always come
+  // before child updates. If the root is in the update, it is guaranteed to
+  // be the first node of the last list.
+  std::vector<std::vector<SemanticsNode>> results;
+  while (!batch.nodes.empty()) {
+    auto begin = batch.nodes.begin();
+    SemanticsNode target = begin->second;
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(target, batch.nodes, sub_tree_list);
+    results.push_back(sub_tree_list);
+    batch.nodes.erase(begin);
+  }
+
+  prepared.update.tree_data = tree_data_;
+  for (size_t i = results.size(); i > 0; i--) {
+    for (const SemanticsNode& node : results[i - 1]) {
+      ConvertFlutterUpdate(node, batch.custom_actions, prepared.update);
+    }
+  }
+  tree_data_ = prepared.update.tree_data;
+
+  // The first update must set the tree's root, which is guaranteed to be the
+  // last list's first node. A tree's root node never changes, though it can be
+  // modified.
+  if (!results.empty() && root_id_ == ui::AXNode::kInvalidAXID) {
+    FML_DCHECK(!results.back().empty());
+
+    root_id_ = results.back().front().id;
+    prepared.update.root_id = root_id_;
+  }
+
+  for (auto& sub_tree_list : results) {
+    for (SemanticsNode& node : sub_tree_list) {
+      for (int32_t child_id : node.children_in_traversal_order) {
+        parent_ids_[child_id] = node.id;
+      }
+      int32_t id = node.id;
+      stale_ids_.erase(id);
+      nodes_[id] = std::move(node);
+    }
+  }
+  return prepared;
+}
+
+void AccessibilityBridge::UpdateQueue::ResyncFromTree(const ui::AXTree& tree) {
+  std::scoped_lock lock(prepare_mutex_);
+  nodes_.clear();
+  parent_ids_.clear();
+  stale_ids_.clear();
+  tree_data_ = tree.data();
+  root_id_ = tree.root() ? tree.root()->id() : ui::AXNode::kInvalidAXID;
+  if (!tree.root()) {
+    return;
+  }
+
+  std::vector<const ui::AXNode*> pending = {tree.root()};
+  while (!pending.empty()) {
+    const ui::AXNode* node = pending.back();
+    pending.pop_back();
+    SemanticsNode& shadow = nodes_[node->id()];
+    shadow.id = node->id();
+    shadow.children_in_traversal_order = node->data().child_ids;
+    for (int32_t child_id : node->data().child_ids) {
+      parent_ids_[child_id] = node->id();
+    }
+    stale_ids_.insert(node->id());
+    for (const ui::AXNode* child : node->children()) {
+      pending.push_back(child);
+    }
+  }
+}
+
+void AccessibilityBridge::UpdateQueue::RemoveSubtree(int32_t id) {
+  std::vector<int32_t> ids = {id};
+  while (!ids.empty()) {
+    int32_t next = ids.back();
+    ids.pop_back();
+    parent_ids_.erase(next);
+    stale_ids_.erase(next);
+    auto node = nodes_.find(next);
+    if (node == nodes_.end()) {
+      continue;
+    }
+    ids.insert(ids.end(), node->second.children_in_traversal_order.begin(),
+               node->second.children_in_traversal_order.end());
+    nodes_.erase(node);
+  }
+}
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -27,6 +295,7 @@ AccessibilityBridge::AccessibilityBridge()
   ui::AXTreeData data = tree_->data();
   data.tree_id = ui::AXTreeID::CreateNewAXTreeID();
   tree_->UpdateData(data);
+  update_queue_ = std::make_shared<UpdateQueue>(tree_->data());
   ui::AXTreeManagerMap::GetInstance().AddTreeManager(tree_->GetAXTreeID(),
                                                      this);
 }
@@ -48,6 +317,45 @@ void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
 }
 
 void AccessibilityBridge::CommitUpdates() {
+  EnqueuePendingUpdates();
+  update_queue_->PrepareQueuedUpdates();
+  ApplyPreparedUpdates();
+}
+
+void AccessibilityBridge::CommitUpdatesAsync(
+    const PostTaskCallback& post_background_task,
+    const PostTaskCallback& post_platform_task) {
+  EnqueuePendingUpdates();
+  // The background task only holds on to the queue so that the bridge is
+  // never destroyed off the platform thread.
+  post_background_task([update_queue = update_queue_,
+                        weak_bridge = weak_from_this(), post_platform_task]() {
+    update_queue->PrepareQueuedUpdates();
+    post_platform_task([weak_bridge]() {
+      if (auto bridge = weak_bridge.lock()) {
+        bridge->ApplyPreparedUpdates();
+      }
+    });
+  });
+}
+
+void AccessibilityBridge::EnqueuePendingUpdates() {
+  UpdateQueue::Batch batch{
+      .nodes = std::move(pending_semantics_node_updates_),
+      .custom_actions = std::move(pending_semantics_custom_action_updates_),
+  };
+  pending_semantics_node_updates_.clear();
+  pending_semantics_custom_action_updates_.clear();
+  update_queue_->Enqueue(std::move(batch));
+}
+
+void AccessibilityBridge::ApplyPreparedUpdates() {
+  for (PreparedUpdate& prepared : update_queue_->TakePreparedUpdates()) {
+    ApplyPreparedUpdate(prepared);
+  }
+}
+
+void AccessibilityBridge::ApplyPreparedUpdate(PreparedUpdate& prepared) {
   // AXTree cannot move a node in a single update.
   // This must be split across two updates:
   //
@@ -56,62 +364,24 @@ void AccessibilityBridge::CommitUpdates() {
   //
   // First, start by removing nodes if necessary.
   std::optional<ui::AXTreeUpdate> remove_reparented =
-      CreateRemoveReparentedNodesUpdate();
+      CreateRemoveReparentedNodesUpdate(prepared.reparented_node_ids);
+  // ui::AXTree::error() is never cleared, so only the result of Unserialize
+  // tells whether this update failed.
   if (remove_reparented.has_value()) {
-    tree_->Unserialize(remove_reparented.value());
-
-    std::string error = tree_->error();
-    if (!error.empty()) {
-      FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    if (!tree_->Unserialize(remove_reparented.value())) {
+      FML_LOG(ERROR) << "Failed to update ui::AXTree, error: "
+                     << tree_->error();
       assert(false);
+      update_queue_->ResyncFromTree(*tree_);
       return;
     }
   }
 
   // Second, apply the pending node updates. This also moves reparented nodes to
   // their new parents if needed.
-  ui::AXTreeUpdate update{.tree_data = tree_->data()};
-
-  // Figure out update order, ui::AXTree only accepts update in tree order,
-  // where parent node must come before the child node in
-  // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
-  // entire subtree into a list. We pick another node from the remaining update,
-  // and keep doing so until the update map is empty. We then concatenate the
-  // lists in the reversed order, this guarantees parent updates always come
-  // before child updates. If the root is in the update, it is guaranteed to
-  // be the first node of the last list.
-  std::vector<std::vector<SemanticsNode>> results;
-  while (!pending_semantics_node_updates_.empty()) {
-    auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
-  }
-
-  for (size_t i = results.size(); i > 0; i--) {
-    for (const SemanticsNode& node : results[i - 1]) {
-      ConvertFlutterUpdate(node, update);
-    }
-  }
-
-  // The first update must set the tree's root, which is guaranteed to be the
-  // last list's first node. A tree's root node never changes, though it can be
-  // modified.
-  if (!results.empty() && GetRootAsAXNode()->id() == ui::AXNode::kInvalidAXID) {
-    FML_DCHECK(!results.back().empty());
-
-    update.root_id = results.back().front().id;
-  }
-
-  tree_->Unserialize(update);
-  pending_semantics_node_updates_.clear();
-  pending_semantics_custom_action_updates_.clear();
-
-  std::string error = tree_->error();
-  if (!error.empty()) {
-    FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+  if (!tree_->Unserialize(prepared.update)) {
+    FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << tree_->error();
+    update_queue_->ResyncFromTree(*tree_);
     return;
   }
   // Handles accessibility events as the result of the semantics update.
@@ -200,43 +470,31 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 }
 
 std::optional<ui::AXTreeUpdate>
-AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
+AccessibilityBridge::CreateRemoveReparentedNodesUpdate(
+    const std::vector<int32_t>& reparented_node_ids) {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
-  for (const auto& node_update : pending_semantics_node_updates_) {
-    for (int32_t child_id : node_update.second.children_in_traversal_order) {
-      // Skip nodes that don't exist or have a parent in the current tree.
-      ui::AXNode* child = tree_->GetFromId(child_id);
-      if (!child) {
-        continue;
-      }
-
-      // Flutter's root node should never be reparented.
-      assert(child->parent());
-
-      // Skip nodes whose parents are unchanged.
-      if (child->parent()->id() == node_update.second.id) {
-        continue;
-      }
+  for (int32_t child_id : reparented_node_ids) {
+    ui::AXNode* child = tree_->GetFromId(child_id);
+    if (!child) {
+      continue;
+    }
 
-      // This pending update moves the current child node.
-      // That new child must have a corresponding pending update.
-      assert(pending_semantics_node_updates_.find(child_id) !=
-             pending_semantics_node_updates_.end());
+    // Flutter's root node should never be reparented.
+    assert(child->parent());
 
-      // Create an update to remove the child from its previous parent.
-      int32_t parent_id = child->parent()->id();
-      if (updates.find(parent_id) == updates.end()) {
-        updates[parent_id] = tree_->GetFromId(parent_id)->data();
-      }
+    // Create an update to remove the child from its previous parent.
+    int32_t parent_id = child->parent()->id();
+    if (updates.find(parent_id) == updates.end()) {
+      updates[parent_id] = tree_->GetFromId(parent_id)->data();
+    }
 
-      ui::AXNodeData* parent = &updates[parent_id];
-      auto iter = std::find(parent->child_ids.begin(), parent->child_ids.end(),
-                            child_id);
+    ui::AXNodeData* parent = &updates[parent_id];
+    auto iter = std::find(parent->child_ids.begin(), parent->child_ids.end(),
+                          child_id);
 
-      assert(iter != parent->child_ids.end());
-      parent->child_ids.erase(iter);
-    }
+    assert(iter != parent->child_ids.end());
+    parent->child_ids.erase(iter);
   }
 
   if (updates.empty()) {
@@ -255,22 +513,60 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   return update;
 }
 
+bool AccessibilityBridge::UpdateQueue::IsCommitted(
+    const SemanticsNode& node) const {
+  auto iter = nodes_.find(node.id);
+  if (iter == nodes_.end() || stale_ids_.count(node.id) > 0) {
+    return false;
+  }
+  // The descriptions of custom actions come from the custom action updates,
+  // which are not tracked.
+  if (!node.custom_accessibility_actions.empty()) {
+    return false;
+  }
+  const SemanticsNode& committed = iter->second;
+  return node.flags == committed.flags && node.actions == committed.actions &&
+         node.text_selection_base == committed.text_selection_base &&
+         node.text_selection_extent == committed.text_selection_extent &&
+         node.scroll_child_count == committed.scroll_child_count &&
+         node.scroll_index == committed.scroll_index &&
+         node.scroll_position == committed.scroll_position &&
+         node.scroll_extent_max == committed.scroll_extent_max &&
+         node.scroll_extent_min == committed.scroll_extent_min &&
+         node.elevation == committed.elevation &&
+         node.thickness == committed.thickness &&
+         node.text_direction == committed.text_direction &&
+         RectEquals(node.rect, committed.rect) &&
+         TransformationEquals(node.transform, committed.transform) &&
+         node.children_in_traversal_order ==
+             committed.children_in_traversal_order &&
+         node.label == committed.label && node.hint == committed.hint &&
+         node.value == committed.value &&
+         node.increased_value == committed.increased_value &&
+         node.decreased_value == committed.decreased_value &&
+         node.tooltip == committed.tooltip;
+}
+
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
-                                         std::vector<SemanticsNode>& result) {
+void AccessibilityBridge::GetSubTreeList(
+    const SemanticsNode& target,
+    std::unordered_map<int32_t, SemanticsNode>& nodes,
+    std::vector<SemanticsNode>& result) {
   result.push_back(target);
   for (int32_t child : target.children_in_traversal_order) {
-    auto iter = pending_semantics_node_updates_.find(child);
-    if (iter != pending_semantics_node_updates_.end()) {
+    auto iter = nodes.find(child);
+    if (iter != nodes.end()) {
       SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
-      pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(node, nodes, result);
+      nodes.erase(iter);
     }
   }
 }
 
-void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
-                                               ui::AXTreeUpdate& tree_update) {
+void AccessibilityBridge::ConvertFlutterUpdate(
+    const SemanticsNode& node,
+    const std::unordered_map<int32_t, SemanticsCustomAction>& custom_actions,
+    ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
   node_data.id = node.id;
   SetRoleFromFlutterUpdate(node_data, node);
@@ -279,7 +575,7 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
   SetBooleanAttributesFromFlutterUpdate(node_data, node);
   SetIntAttributesFromFlutterUpdate(node_data, node);
   SetIntListAttributesFromFlutterUpdate(node_data, node);
-  SetStringListAttributesFromFlutterUpdate(node_data, node);
+  SetStringListAttributesFromFlutterUpdate(node_data, node, custom_actions);
   SetNameFromFlutterUpdate(node_data, node);
   SetValueFromFlutterUpdate(node_data, node);
   SetTooltipFromFlutterUpdate(node_data, node);
@@ -503,14 +799,14 @@ void AccessibilityBridge::SetIntListAttributesFromFlutterUpdate(
 
 void AccessibilityBridge::SetStringListAttributesFromFlutterUpdate(
     ui::AXNodeData& node_data,
-    const SemanticsNode& node) {
+    const SemanticsNode& node,
+    const std::unordered_map<int32_t, SemanticsCustomAction>& custom_actions) {
   FlutterSemanticsAction actions = node.actions;
   if (actions & FlutterSemanticsAction::kFlutterSemanticsActionCustomAction) {
     std::vector<std::string> custom_action_description;
     for (size_t i = 0; i < node.custom_accessibility_actions.size(); i++) {
-      auto iter = pending_semantics_custom_action_updates_.find(
-          node.custom_accessibility_actions[i]);
-      BASE_DCHECK(iter != pending_semantics_custom_action_updates_.end());
+      auto iter = custom_actions.find(node.custom_accessibility_actions[i]);
+      BASE_DCHECK(iter != custom_actions.end());
       custom_action_description.push_back(iter->second.label);
     }
     node_data.AddStringListAttribute(
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_SHELL_PLATFORM_COMMON_ACCESSIBILITY_BRIDGE_H_
 #define FLUTTER_SHELL_PLATFORM_COMMON_ACCESSIBILITY_BRIDGE_H_
 
+#include <functional>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -75,8 +78,36 @@ class AccessibilityBridge
   ///             state. For example if a node reparents from A to B, callers
   ///             should only call this method when both removal from A and
   ///             addition to B are in the pending updates.
+  ///
+  ///             Pending nodes that are identical to the node already in the
+  ///             tree are not sent to the AXTree, so frameworks that resend
+  ///             whole subtrees only pay for the nodes that changed.
   void CommitUpdates();
 
+  /// Posts a task to run on another thread.
+  using PostTaskCallback = std::function<void(std::function<void()> task)>;
+
+  //------------------------------------------------------------------------------
+  /// @brief      Flushes the pending updates like CommitUpdates(), but
+  ///             converts them into an update of the accessibility tree on a
+  ///             background thread. The platform thread is then only
+  ///             blocked while the prepared update is applied to the tree and
+  ///             its accessibility events are dispatched.
+  ///
+  ///             Updates are applied in the order they were committed, with
+  ///             either method, and the events of an update are dispatched
+  ///             before the next update is applied.
+  ///
+  ///             To prepare updates off the platform thread, the bridge keeps
+  ///             a second copy of the semantics of every node, which roughly
+  ///             doubles the memory held for the semantics tree.
+  ///
+  /// @param[in]  post_background_task  Posts a task to a background thread.
+  /// @param[in]  post_platform_task    Posts a task to the platform thread.
+  ///                                   It is called on the background thread.
+  void CommitUpdatesAsync(const PostTaskCallback& post_background_task,
+                          const PostTaskCallback& post_platform_task);
+
   //------------------------------------------------------------------------------
   /// @brief      Get the flutter platform node delegate with the given id from
   ///             this accessibility bridge. Returns expired weak_ptr if the
@@ -193,6 +224,9 @@ class AccessibilityBridge
     std::string hint;
   } SemanticsCustomAction;
 
+  struct PreparedUpdate;
+  class UpdateQueue;
+
   std::unordered_map<AccessibilityNodeId,
                      std::shared_ptr<FlutterPlatformNodeDelegate>>
       id_wrapper_map_;
@@ -201,39 +235,65 @@ class AccessibilityBridge
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // Shared with the tasks of CommitUpdatesAsync(), which may outlive the
+  // bridge.
+  //
+  // Updates are prepared without reading |tree_|, which belongs to the
+  // platform thread. Instead, the queue keeps its own copy of the semantics
+  // of every node in the tree, including labels, values and children, to
+  // diff and order updates against. This roughly doubles the memory the
+  // bridge holds for the semantics tree, on every platform and whether
+  // updates are committed with CommitUpdates() or CommitUpdatesAsync().
+  std::shared_ptr<UpdateQueue> update_queue_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
 
-  // Create an update that removes any nodes that will be reparented by
-  // pending_semantics_updates_. Returns std::nullopt if none are reparented.
-  std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
-
-  void GetSubTreeList(const SemanticsNode& target,
-                      std::vector<SemanticsNode>& result);
-  void ConvertFlutterUpdate(const SemanticsNode& node,
-                            ui::AXTreeUpdate& tree_update);
-  void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
-                                const SemanticsNode& node);
-  void SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
-                                 const SemanticsNode& node);
-  void SetActionsFromFlutterUpdate(ui::AXNodeData& node_data,
-                                   const SemanticsNode& node);
-  void SetBooleanAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
-                                             const SemanticsNode& node);
-  void SetIntAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
-                                         const SemanticsNode& node);
-  void SetIntListAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
-                                             const SemanticsNode& node);
-  void SetStringListAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
+  // Moves the pending updates to the update queue.
+  void EnqueuePendingUpdates();
+
+  // Applies the updates that the update queue has prepared so far.
+  void ApplyPreparedUpdates();
+
+  void ApplyPreparedUpdate(PreparedUpdate& prepared);
+
+  // Create an update that removes the given nodes, which will be reparented
+  // by a prepared update, from their current parents. Returns std::nullopt if
+  // none are in the tree.
+  std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate(
+      const std::vector<int32_t>& reparented_node_ids);
+
+  static void GetSubTreeList(const SemanticsNode& target,
+                             std::unordered_map<int32_t, SemanticsNode>& nodes,
+                             std::vector<SemanticsNode>& result);
+  static void ConvertFlutterUpdate(
+      const SemanticsNode& node,
+      const std::unordered_map<int32_t, SemanticsCustomAction>& custom_actions,
+      ui::AXTreeUpdate& tree_update);
+  static void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
+                                       const SemanticsNode& node);
+  static void SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
+                                        const SemanticsNode& node);
+  static void SetActionsFromFlutterUpdate(ui::AXNodeData& node_data,
+                                          const SemanticsNode& node);
+  static void SetBooleanAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
+                                                    const SemanticsNode& node);
+  static void SetIntAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
                                                 const SemanticsNode& node);
-  void SetNameFromFlutterUpdate(ui::AXNodeData& node_data,
-                                const SemanticsNode& node);
-  void SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
-                                 const SemanticsNode& node);
-  void SetTooltipFromFlutterUpdate(ui::AXNodeData& node_data,
-                                   const SemanticsNode& node);
-  void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
+  static void SetIntListAttributesFromFlutterUpdate(ui::AXNodeData& node_data,
+                                                    const SemanticsNode& node);
+  static void SetStringListAttributesFromFlutterUpdate(
+      ui::AXNodeData& node_data,
+      const SemanticsNode& node,
+      const std::unordered_map<int32_t, SemanticsCustomAction>& custom_actions);
+  static void SetNameFromFlutterUpdate(ui::AXNodeData& node_data,
+                                       const SemanticsNode& node);
+  static void SetValueFromFlutterUpdate(ui::AXNodeData& node_data,
+                                        const SemanticsNode& node);
+  static void SetTooltipFromFlutterUpdate(ui::AXNodeData& node_data,
+                                          const SemanticsNode& node);
+  static void SetTreeData(const SemanticsNode& node,
+                          ui::AXTreeUpdate& tree_update);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode2& flutter_node);
   SemanticsCustomAction FromFlutterSemanticsCustomAction(
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <functional>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int32_t kFanOut = 100;
+constexpr int32_t kNodeCount = kFanOut * kFanOut;
+constexpr int32_t kLeafCount = kNodeCount - kFanOut;
+
+// A semantics tree of 10000 nodes: the root, |kFanOut| - 1 groups below it
+// and |kFanOut| leaves in each group. Group |g| holds the leaves with ids
+// |g| * |kFanOut| to |g| * |kFanOut| + |kFanOut| - 1.
+class SemanticsTree {
+ public:
+  SemanticsTree() : labels_(kNodeCount), children_(kFanOut) {
+    for (int32_t id = 0; id < kNodeCount; id++) {
+      labels_[id] = "node " + std::to_string(id);
+    }
+    for (int32_t group = 1; group < kFanOut; group++) {
+      children_[0].push_back(group);
+      for (int32_t leaf = 0; leaf < kFanOut; leaf++) {
+        children_[group].push_back(group * kFanOut + leaf);
+      }
+    }
+  }
+
+  // Sends every node of the tree to the bridge, as the framework does when a
+  // whole subtree is marked dirty.
+  void AddUpdates(AccessibilityBridge& bridge) const {
+    for (int32_t id = 0; id < kNodeCount; id++) {
+      bridge.AddFlutterSemanticsNodeUpdate(CreateNode(id));
+    }
+  }
+
+  void SetLabel(int32_t id, std::string label) {
+    labels_[id] = std::move(label);
+  }
+
+ private:
+  std::vector<std::string> labels_;
+  std::vector<std::vector<int32_t>> children_;
+
+  FlutterSemanticsNode2 CreateNode(int32_t id) const {
+    const std::vector<int32_t>* children =
+        id < kFanOut ? &children_[id] : nullptr;
+    return {
+        .id = id,
+        .flags = static_cast<FlutterSemanticsFlag>(0),
+        .actions = static_cast<FlutterSemanticsAction>(0),
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = labels_[id].c_str(),
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .rect = {0, 0, 100, 100},
+        .transform = {1, 0, 0, 0, 1, 0, 0, 0, 1},
+        .child_count = children ? children->size() : 0,
+        .children_in_traversal_order = children ? children->data() : nullptr,
+        .custom_accessibility_actions_count = 0,
+        .tooltip = "",
+    };
+  }
+};
+
+}  // namespace
+
+// Commits the whole tree after the labels of |state.range(0)| leaves changed.
+static void BM_CommitSemanticsTree(benchmark::State& state) {  // NOLINT
+  SemanticsTree tree;
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  tree.AddUpdates(*bridge);
+  bridge->CommitUpdates();
+
+  const int32_t changed_count = state.range(0);
+  int64_t generation = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    generation++;
+    for (int32_t i = 0; i < changed_count; i++) {
+      int32_t id = kFanOut + i * (kLeafCount / changed_count);
+      tree.SetLabel(id, "node " + std::to_string(id) + " " +
+                            std::to_string(generation));
+    }
+    tree.AddUpdates(*bridge);
+    bridge->accessibility_events.clear();
+    state.ResumeTiming();
+
+    bridge->CommitUpdates();
+  }
+}
+
+BENCHMARK(BM_CommitSemanticsTree)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(kLeafCount)
+    ->Unit(benchmark::kMicrosecond);
+
+// The time the platform thread is blocked by BM_CommitSemanticsTree when the
+// updates are prepared on a background thread.
+static void BM_CommitSemanticsTreeAsync(benchmark::State& state) {  // NOLINT
+  SemanticsTree tree;
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  tree.AddUpdates(*bridge);
+  bridge->CommitUpdates();
+
+  std::vector<std::function<void()>> background_tasks;
+  std::vector<std::function<void()>> platform_tasks;
+  auto post_background_task = [&](std::function<void()> task) {
+    background_tasks.push_back(std::move(task));
+  };
+  auto post_platform_task = [&](std::function<void()> task) {
+    platform_tasks.push_back(std::move(task));
+  };
+
+  const int32_t changed_count = state.range(0);
+  int64_t generation = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    generation++;
+    for (int32_t i = 0; i < changed_count; i++) {
+      int32_t id = kFanOut + i * (kLeafCount / changed_count);
+      tree.SetLabel(id, "node " + std::to_string(id) + " " +
+                            std::to_string(generation));
+    }
+    tree.AddUpdates(*bridge);
+    bridge->accessibility_events.clear();
+    state.ResumeTiming();
+
+    bridge->CommitUpdatesAsync(post_background_task, post_platform_task);
+
+    state.PauseTiming();
+    for (auto& task : background_tasks) {
+      task();
+    }
+    background_tasks.clear();
+    state.ResumeTiming();
+
+    for (auto& task : platform_tasks) {
+      task();
+    }
+    platform_tasks.clear();
+  }
+}
+
+BENCHMARK(BM_CommitSemanticsTreeAsync)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(kLeafCount)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -543,6 +543,193 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+// Verify that nodes whose semantics did not change are not sent to the tree.
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodes) {
+  class ChangedNodesObserver : public ui::AXTreeObserver {
+   public:
+    void OnNodeChanged(ui::AXTree* tree, ui::AXNode* node) override {
+      changed_ids.push_back(node->id());
+    }
+
+    std::vector<int32_t> changed_ids;
+  };
+
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  ChangedNodesObserver observer;
+  bridge->GetTree()->AddObserver(&observer);
+
+  // Resend the whole tree with only the label of child2 changed.
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(observer.changed_ids, std::vector<int32_t>{2});
+  EXPECT_THAT(bridge->accessibility_events,
+              Contains(ui::AXEventGenerator::Event::NAME_CHANGED).Times(1));
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(child2_node->GetName(), "new child 2");
+
+  // Nodes that are removed and added back are sent again.
+  observer.changed_ids.clear();
+  root.child_count = 1;
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->CommitUpdates();
+  root.child_count = 2;
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  EXPECT_THAT(observer.changed_ids, Contains(2));
+  EXPECT_FALSE(bridge->GetFlutterPlatformNodeDelegateFromID(2).expired());
+
+  bridge->GetTree()->RemoveObserver(&observer);
+}
+
+// Verify that a node of an update that the tree rejected is not mistaken for
+// a committed node by later updates.
+TEST(AccessibilityBridgeTest, ResendsNodesOfFailedUpdates) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  // Child 2 is not attached to the tree, so the update is rejected.
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(2).expired());
+
+  // Attaching child 2 must send it again.
+  children = {1, 2};
+  root = CreateSemanticsNode(0, "root", &children);
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  ASSERT_TRUE(root_node);
+  ASSERT_TRUE(child2_node);
+  EXPECT_EQ(root_node->GetChildCount(), 2);
+  EXPECT_EQ(child2_node->GetName(), "child 2");
+}
+
+// Verify that updates committed asynchronously are applied on the platform
+// task, in the order they were committed.
+TEST(AccessibilityBridgeTest, CommitUpdatesAsyncPreservesEventOrder) {
+  std::vector<std::function<void()>> background_tasks;
+  std::vector<std::function<void()>> platform_tasks;
+  auto post_background_task = [&](std::function<void()> task) {
+    background_tasks.push_back(std::move(task));
+  };
+  auto post_platform_task = [&](std::function<void()> task) {
+    platform_tasks.push_back(std::move(task));
+  };
+
+  std::vector<int32_t> children{1};
+  std::vector<int32_t> new_children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 renamed_child1 = CreateSemanticsNode(1, "renamed");
+  FlutterSemanticsNode2 new_root =
+      CreateSemanticsNode(0, "root", &new_children);
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  auto add_updates = [&](TestAccessibilityBridge& bridge, int update) {
+    switch (update) {
+      case 0:
+        bridge.AddFlutterSemanticsNodeUpdate(root);
+        bridge.AddFlutterSemanticsNodeUpdate(child1);
+        break;
+      case 1:
+        bridge.AddFlutterSemanticsNodeUpdate(renamed_child1);
+        break;
+      case 2:
+        bridge.AddFlutterSemanticsNodeUpdate(new_root);
+        bridge.AddFlutterSemanticsNodeUpdate(child2);
+        break;
+    }
+  };
+
+  std::shared_ptr<TestAccessibilityBridge> expected_bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  for (int update = 0; update < 3; update++) {
+    add_updates(*expected_bridge, update);
+    expected_bridge->CommitUpdates();
+  }
+
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  add_updates(*bridge, 0);
+  bridge->CommitUpdates();
+  add_updates(*bridge, 1);
+  bridge->CommitUpdatesAsync(post_background_task, post_platform_task);
+  add_updates(*bridge, 2);
+  bridge->CommitUpdatesAsync(post_background_task, post_platform_task);
+
+  // Nothing is applied until the platform tasks run, and the background tasks
+  // prepare the updates in order whichever of them runs first.
+  ASSERT_EQ(background_tasks.size(), size_t{2});
+  background_tasks[1]();
+  background_tasks[0]();
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetName(),
+            "child 1");
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(2).expired());
+
+  ASSERT_EQ(platform_tasks.size(), size_t{2});
+  for (auto& task : platform_tasks) {
+    task();
+  }
+  EXPECT_EQ(bridge->GetFlutterPlatformNodeDelegateFromID(1).lock()->GetName(),
+            "renamed");
+  EXPECT_FALSE(bridge->GetFlutterPlatformNodeDelegateFromID(2).expired());
+  EXPECT_EQ(bridge->accessibility_events,
+            expected_bridge->accessibility_events);
+}
+
+TEST(AccessibilityBridgeTest, CommitUpdatesAsyncOutlivesBridge) {
+  std::vector<std::function<void()>> background_tasks;
+  std::vector<std::function<void()>> platform_tasks;
+
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+  bridge->AddFlutterSemanticsNodeUpdate(CreateSemanticsNode(0, "root"));
+  bridge->CommitUpdatesAsync(
+      [&](std::function<void()> task) {
+        background_tasks.push_back(std::move(task));
+      },
+      [&](std::function<void()> task) {
+        platform_tasks.push_back(std::move(task));
+      });
+  bridge.reset();
+
+  ASSERT_EQ(background_tasks.size(), size_t{1});
+  background_tasks[0]();
+  ASSERT_EQ(platform_tasks.size(), size_t{1});
+  platform_tasks[0]();
+}
+
 TEST(AccessibilityBridgeTest, AXTreeManagerTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -49,6 +49,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -57,6 +58,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_skia.h"
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
 #include "flutter/shell/platform/embedder/embedder_semantics_update.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 #include "flutter/shell/platform/embedder/embedder_task_runner.h"
@@ -3182,6 +3184,167 @@ FlutterEngineResult FlutterEnginePostDartObject(
   return kSuccess;
 }
 
+struct _FlutterEngineRingBuffer {
+  std::shared_ptr<flutter::EmbedderRingBuffer> ring_buffer;
+  FlutterEngineDartPort port = ILLEGAL_PORT;
+};
+
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterEngineRingBufferCreateInfo* info,
+    FlutterEngineRingBuffer* ring_buffer_out) {
+  if (engine == nullptr ||
+      !reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (info == nullptr || ring_buffer_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Ring buffer info or out parameter was null.");
+  }
+
+  const auto port = SAFE_ACCESS(info, port, ILLEGAL_PORT);
+  if (port == ILLEGAL_PORT) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Attempted to use an illegal port.");
+  }
+
+  auto ring_buffer =
+      flutter::EmbedderRingBuffer::Create(SAFE_ACCESS(info, capacity, 0));
+  if (!ring_buffer) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Ring buffer capacity must be a non-zero power of two no larger than "
+        "2^31.");
+  }
+
+  // The isolate holds its own reference to the storage which is dropped when
+  // the external typed data is finalized.
+  auto peer = new std::shared_ptr<flutter::EmbedderRingBuffer>(ring_buffer);
+
+  Dart_CObject dart_object = {};
+  dart_object.type = Dart_CObject_kExternalTypedData;
+  dart_object.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  dart_object.value.as_external_typed_data.length =
+      ring_buffer->GetStorageSize();
+  dart_object.value.as_external_typed_data.data = ring_buffer->GetStorage();
+  dart_object.value.as_external_typed_data.peer = peer;
+  dart_object.value.as_external_typed_data.callback =
+      +[](void* unused_isolate_callback_data, void* peer) {
+        delete reinterpret_cast<std::shared_ptr<flutter::EmbedderRingBuffer>*>(
+            peer);
+      };
+
+  if (!Dart_PostCObject(port, &dart_object)) {
+    delete peer;
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not post the ring buffer to the Dart VM.");
+  }
+
+  auto handle = std::make_unique<_FlutterEngineRingBuffer>();
+  handle->ring_buffer = std::move(ring_buffer);
+  handle->port = port;
+  *ring_buffer_out = handle.release();
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written) {
+  if (engine == nullptr ||
+      !reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (ring_buffer == nullptr || (data == nullptr && size > 0) ||
+      written == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid ring buffer, data or out parameter.");
+  }
+
+  bool needs_notification = false;
+  *written =
+      ring_buffer->ring_buffer->Write(data, size, &needs_notification);
+  if (!*written) {
+    // Producers are expected to retry once the isolate has caught up.
+    return kSuccess;
+  }
+
+  if (needs_notification) {
+    Dart_CObject dart_object = {};
+    dart_object.type = Dart_CObject_kInt64;
+    dart_object.value.as_int64 = static_cast<int64_t>(
+        ring_buffer->ring_buffer->GetReadableSize());
+    if (!Dart_PostCObject(ring_buffer->port, &dart_object)) {
+      return LOG_EMBEDDER_ERROR(
+          kInternalInconsistency,
+          "Could not post the ring buffer wakeup to the Dart VM.");
+    }
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer) {
+  // Created in a unique pointer in `FlutterEngineCreateRingBuffer`. Deleting
+  // a null object is a no-op.
+  delete ring_buffer;
+  return kSuccess;
+}
+
+static FlutterFrameStatisticsHistogram ToFlutterFrameStatisticsHistogram(
+    const flutter::FrameStatisticsHistogram::Summary& summary) {
+  FlutterFrameStatisticsHistogram histogram = {};
+  histogram.count = summary.count;
+  histogram.max = summary.max;
+  histogram.mean = summary.mean;
+  histogram.p50 = summary.p50;
+  histogram.p90 = summary.p90;
+  histogram.p99 = summary.p99;
+  return histogram;
+}
+
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics) {
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (embedder_engine == nullptr || !embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (statistics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Frame statistics out parameter was null.");
+  }
+
+  using Histogram = flutter::FrameStatistics::Histogram;
+  const auto summary =
+      embedder_engine->GetShell().GetFrameStatistics()->GetSummary();
+  auto histogram = [&summary](Histogram histogram) {
+    return ToFlutterFrameStatisticsHistogram(summary.Get(histogram));
+  };
+
+#define SET_MEMBER(member, value)               \
+  if (STRUCT_HAS_MEMBER(statistics, member)) { \
+    statistics->member = (value);              \
+  }
+  SET_MEMBER(frame_count, summary.frame_count);
+  SET_MEMBER(janky_frame_count, summary.janky_frame_count);
+  SET_MEMBER(vsync_overhead_micros, histogram(Histogram::kVsyncOverhead));
+  SET_MEMBER(build_micros, histogram(Histogram::kBuild));
+  SET_MEMBER(raster_micros, histogram(Histogram::kRaster));
+  SET_MEMBER(total_micros, histogram(Histogram::kTotal));
+  SET_MEMBER(raster_cache_bytes, histogram(Histogram::kRasterCacheBytes));
+  SET_MEMBER(gpu_micros, histogram(Histogram::kGpu));
+#undef SET_MEMBER
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
@@ -3380,6 +3543,10 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
+  SET_PROC(CreateRingBuffer, FlutterEngineCreateRingBuffer);
+  SET_PROC(RingBufferWrite, FlutterEngineRingBufferWrite);
+  SET_PROC(CollectRingBuffer, FlutterEngineCollectRingBuffer);
+  SET_PROC(GetFrameStatistics, FlutterEngineGetFrameStatistics);
 #undef SET_PROC
 
   return kSuccess;
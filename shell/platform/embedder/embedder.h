@@ -2078,6 +2078,67 @@ typedef struct {
   };
 } FlutterEngineDartObject;
 
+/// An opaque handle to a single-producer/single-consumer ring buffer shared
+/// between the embedder and a Dart isolate. Created with
+/// `FlutterEngineCreateRingBuffer`.
+typedef struct _FlutterEngineRingBuffer* FlutterEngineRingBuffer;
+
+typedef struct {
+  /// The size of this struct. Must be
+  /// sizeof(FlutterEngineRingBufferCreateInfo).
+  size_t struct_size;
+  /// The payload capacity of the ring buffer in bytes. Must be a non-zero
+  /// power of two no larger than 2^31.
+  size_t capacity;
+  /// The send port of the consuming isolate. The shared storage is posted to
+  /// this port once as a `Uint8List` when the ring buffer is created, and
+  /// wakeups are posted to it as integers holding the number of readable
+  /// bytes at the time of the wakeup.
+  FlutterEngineDartPort port;
+} FlutterEngineRingBufferCreateInfo;
+
+/// The distribution of one frame metric, aggregated by the engine.
+typedef struct {
+  /// The number of recorded values.
+  uint64_t count;
+  /// The largest recorded value.
+  uint64_t max;
+  /// The mean of the recorded values.
+  double mean;
+  /// The 50th, 90th and 99th percentile values. These have a relative error of
+  /// at most 1/16 for values of 16 and above.
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+} FlutterFrameStatisticsHistogram;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameStatistics).
+  size_t struct_size;
+  /// The number of frames rasterized.
+  uint64_t frame_count;
+  /// The number of frames whose build or rasterization took longer than the
+  /// time between their vsync and vsync target times.
+  uint64_t janky_frame_count;
+  /// The time from the vsync signal to the start of each build, in
+  /// microseconds.
+  FlutterFrameStatisticsHistogram vsync_overhead_micros;
+  /// The time spent building each frame on the UI thread, in microseconds.
+  FlutterFrameStatisticsHistogram build_micros;
+  /// The time spent rasterizing each frame on the raster thread, in
+  /// microseconds.
+  FlutterFrameStatisticsHistogram raster_micros;
+  /// The time from the vsync signal to the end of rasterization of each frame,
+  /// in microseconds.
+  FlutterFrameStatisticsHistogram total_micros;
+  /// The size of the layer and picture raster caches after each frame, in
+  /// bytes.
+  FlutterFrameStatisticsHistogram raster_cache_bytes;
+  /// The time the GPU spent on each frame, in microseconds. Only recorded
+  /// while the GPU tracer of the Impeller backend is enabled.
+  FlutterFrameStatisticsHistogram gpu_micros;
+} FlutterFrameStatistics;
+
 /// This enum allows embedders to determine the type of the engine thread in the
 /// FlutterNativeThreadCallback. Based on the thread type, the embedder may be
 /// able to tweak the thread priorities for optimum performance.
@@ -3076,6 +3137,102 @@ FlutterEngineResult FlutterEnginePostDartObject(
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
 
+//------------------------------------------------------------------------------
+/// @brief      Creates a single-producer/single-consumer ring buffer whose
+///             storage is shared with the isolate listening on the specified
+///             port. The storage is posted to that port as an external
+///             `Uint8List` exactly once, so the isolate reads payload bytes in
+///             place instead of receiving a copy per message.
+///
+///             On the Dart side, `RingBufferReader` in dart:ui reads from the
+///             storage with the required memory ordering.
+///
+///             The first 128 bytes of the storage hold the control block,
+///             using host endianness:
+///               - Byte offset 0: Uint64 total bytes written by the embedder.
+///               - Byte offset 8: Uint32 non-zero while a wakeup is pending.
+///               - Byte offset 12: Uint32 payload capacity.
+///               - Byte offset 64: Uint64 total bytes read by the isolate.
+///             The payload follows at byte offset 128. Positions are byte
+///             counts; the payload offset is the position modulo capacity.
+///
+///             Wakeups are coalesced. After a write, the isolate is only
+///             notified if it has cleared the pending flag since the previous
+///             wakeup. On a wakeup, the isolate should consume all available
+///             bytes, store its new read position, clear the pending flag and
+///             then check the write position once more.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  info         The ring buffer configuration.
+/// @param[out] ring_buffer  The created ring buffer. Must be collected with
+///                          `FlutterEngineCollectRingBuffer`.
+///
+/// @return     If the ring buffer was created and posted to the isolate.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterEngineRingBufferCreateInfo* info,
+    FlutterEngineRingBuffer* ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Writes bytes into a ring buffer created with
+///             `FlutterEngineCreateRingBuffer`. Either all bytes are written or
+///             none are. Writes to the same ring buffer must not be made
+///             concurrently but may be made from any thread. Unlike platform
+///             messages, no engine task is scheduled for the write.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  ring_buffer  The ring buffer to write to.
+/// @param[in]  data         The bytes to write.
+/// @param[in]  size         The number of bytes to write.
+/// @param[out] written      Set to true if the bytes were written, or to false
+///                          if the ring buffer did not have enough free space.
+///                          A full ring buffer is not an error, and the write
+///                          may be retried once the isolate has read from it.
+///
+/// @return     kSuccess if the arguments were valid, whether or not the bytes
+///             fit into the ring buffer.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written);
+
+//------------------------------------------------------------------------------
+/// @brief      Releases the embedder's reference to a ring buffer. The shared
+///             storage is kept alive until the isolate has also let go of its
+///             `Uint8List` view.
+///
+/// @param[in]  ring_buffer  The ring buffer to collect.
+///
+/// @return     If the ring buffer was collected.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the frame timings aggregated by the engine since it was
+///             launched. The timings are aggregated on the engine threads that
+///             produce them, so this call is cheap enough to be polled
+///             periodically for telemetry. It may be made from any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics to fill. The struct_size must be
+///                         set. Members that do not fit within struct_size
+///                         are left untouched.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics);
+
 //------------------------------------------------------------------------------
 /// @brief      Posts a low memory notification to a running engine instance.
 ///             The engine will do its best to release non-critical resources in
@@ -3289,6 +3446,21 @@ typedef FlutterEngineResult (*FlutterEnginePostDartObjectFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterEngineDartPort port,
     const FlutterEngineDartObject* object);
+typedef FlutterEngineResult (*FlutterEngineCreateRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterEngineRingBufferCreateInfo* info,
+    FlutterEngineRingBuffer* ring_buffer);
+typedef FlutterEngineResult (*FlutterEngineRingBufferWriteFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written);
+typedef FlutterEngineResult (*FlutterEngineCollectRingBufferFnPtr)(
+    FlutterEngineRingBuffer ring_buffer);
+typedef FlutterEngineResult (*FlutterEngineGetFrameStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics);
 typedef FlutterEngineResult (*FlutterEngineNotifyLowMemoryWarningFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 typedef FlutterEngineResult (*FlutterEnginePostCallbackOnAllNativeThreadsFnPtr)(
@@ -3360,6 +3532,10 @@ typedef struct {
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
   FlutterEngineAddViewFnPtr AddView;
   FlutterEngineRemoveViewFnPtr RemoveView;
+  FlutterEngineCreateRingBufferFnPtr CreateRingBuffer;
+  FlutterEngineRingBufferWriteFnPtr RingBufferWrite;
+  FlutterEngineCollectRingBufferFnPtr CollectRingBuffer;
+  FlutterEngineGetFrameStatisticsFnPtr GetFrameStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace flutter {
+
+static_assert(offsetof(EmbedderRingBuffer::Header, write_position) == 0);
+static_assert(offsetof(EmbedderRingBuffer::Header, notification_pending) == 8);
+static_assert(offsetof(EmbedderRingBuffer::Header, capacity) == 12);
+static_assert(offsetof(EmbedderRingBuffer::Header, read_position) == 64);
+static_assert(EmbedderRingBuffer::kHeaderSize == 128);
+// The Dart consumer accesses these fields through a ByteData view which
+// assumes the atomics are plain, address-free integers.
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+std::shared_ptr<EmbedderRingBuffer> EmbedderRingBuffer::Create(
+    size_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+      capacity > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+  return std::shared_ptr<EmbedderRingBuffer>(new EmbedderRingBuffer(capacity));
+}
+
+EmbedderRingBuffer::EmbedderRingBuffer(size_t capacity)
+    : storage_(new uint8_t[kHeaderSize + capacity]()) {
+  header_ = new (storage_.get()) Header();
+  header_->capacity = static_cast<uint32_t>(capacity);
+  payload_ = storage_.get() + kHeaderSize;
+}
+
+EmbedderRingBuffer::~EmbedderRingBuffer() {
+  header_->~Header();
+}
+
+size_t EmbedderRingBuffer::GetCapacity() const {
+  return header_->capacity;
+}
+
+size_t EmbedderRingBuffer::GetReadableSize() const {
+  return header_->write_position.load(std::memory_order_acquire) -
+         header_->read_position.load(std::memory_order_acquire);
+}
+
+bool EmbedderRingBuffer::Write(const uint8_t* data,
+                               size_t size,
+                               bool* needs_notification) {
+  *needs_notification = false;
+  const uint64_t capacity = header_->capacity;
+  const uint64_t write =
+      header_->write_position.load(std::memory_order_relaxed);
+  const uint64_t read = header_->read_position.load(std::memory_order_acquire);
+  if (size > capacity - (write - read)) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  const size_t offset = write & (capacity - 1);
+  const size_t first = std::min<size_t>(size, capacity - offset);
+  ::memcpy(payload_ + offset, data, first);
+  ::memcpy(payload_, data + first, size - first);
+  header_->write_position.store(write + size, std::memory_order_release);
+
+  uint32_t expected = 0;
+  *needs_notification = header_->notification_pending.compare_exchange_strong(
+      expected, 1u, std::memory_order_acq_rel);
+  return true;
+}
+
+size_t EmbedderRingBuffer::Read(uint8_t* data, size_t size) {
+  const uint64_t capacity = header_->capacity;
+  const uint64_t read = header_->read_position.load(std::memory_order_relaxed);
+  const uint64_t write =
+      header_->write_position.load(std::memory_order_acquire);
+  const size_t count = std::min<uint64_t>(size, write - read);
+
+  const size_t offset = read & (capacity - 1);
+  const size_t first = std::min<size_t>(count, capacity - offset);
+  ::memcpy(data, payload_ + offset, first);
+  ::memcpy(data + first, payload_, count - first);
+  header_->read_position.store(read + count, std::memory_order_release);
+
+  if (read + count == write) {
+    // A write that lands after this point will request a new wakeup. Writes
+    // that landed before it did not, so consumers must check
+    // |GetReadableSize| again after the flag is cleared.
+    header_->notification_pending.store(0u, std::memory_order_release);
+  }
+  return count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A single-producer/single-consumer byte ring buffer whose
+///             storage (control block and payload) is one contiguous
+///             allocation. The same storage is handed to a Dart isolate as an
+///             external `Uint8List` so that the consumer can read payload
+///             bytes in place without any copies or task hops.
+///
+///             The storage starts with a `Header` of `kHeaderSize` bytes,
+///             followed by `capacity` payload bytes. All positions are
+///             monotonically increasing byte counts; the offset into the
+///             payload is the position modulo the capacity (which must be a
+///             power of two). The producer only ever writes `write_position`
+///             and the consumer only ever writes `read_position`.
+///
+///             Wakeups are coalesced: a write only requests a notification
+///             if the consumer has cleared `notification_pending` since the
+///             last one. A consumer is expected to drain the buffer, publish
+///             its new `read_position`, clear the flag and then check
+///             `write_position` once more, since writes that raced with the
+///             drain did not request a wakeup of their own.
+///
+class EmbedderRingBuffer {
+ public:
+  struct Header {
+    /// Total number of bytes ever written by the producer. Byte offset 0.
+    std::atomic<uint64_t> write_position;
+    /// Non-zero while a wakeup has been sent that the consumer has not yet
+    /// acknowledged. Byte offset 8.
+    std::atomic<uint32_t> notification_pending;
+    /// The payload capacity in bytes. Byte offset 12.
+    uint32_t capacity;
+    uint8_t producer_padding[48];
+    /// Total number of bytes ever consumed. Byte offset 64.
+    std::atomic<uint64_t> read_position;
+    uint8_t consumer_padding[56];
+  };
+
+  static constexpr size_t kHeaderSize = sizeof(Header);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a ring buffer with the given payload capacity.
+  ///
+  /// @param[in]  capacity  The payload capacity in bytes. Must be a non-zero
+  ///                       power of two that fits in 32 bits.
+  ///
+  /// @return     The ring buffer or nullptr if the capacity was invalid.
+  ///
+  static std::shared_ptr<EmbedderRingBuffer> Create(size_t capacity);
+
+  ~EmbedderRingBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes all of `size` bytes or nothing. May only be called by
+  ///             the single producer.
+  ///
+  /// @param[in]  data                 The bytes to write.
+  /// @param[in]  size                 The number of bytes to write.
+  /// @param[out] needs_notification   Set to true if the consumer should be
+  ///                                  woken up after this write.
+  ///
+  /// @return     If there was enough free space for the write.
+  ///
+  bool Write(const uint8_t* data, size_t size, bool* needs_notification);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads up to `size` bytes into `data` and clears the pending
+  ///             notification flag once the buffer has been drained. May only
+  ///             be called by the single consumer. `RingBufferReader` in
+  ///             dart:ui performs the equivalent steps on the shared storage.
+  ///
+  /// @return     The number of bytes read.
+  ///
+  size_t Read(uint8_t* data, size_t size);
+
+  size_t GetCapacity() const;
+
+  size_t GetReadableSize() const;
+
+  uint8_t* GetStorage() const { return storage_.get(); }
+
+  size_t GetStorageSize() const { return kHeaderSize + GetCapacity(); }
+
+ private:
+  std::unique_ptr<uint8_t[]> storage_;
+  Header* header_ = nullptr;
+  uint8_t* payload_ = nullptr;
+
+  explicit EmbedderRingBuffer(size_t capacity);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRingBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RING_BUFFER_H_
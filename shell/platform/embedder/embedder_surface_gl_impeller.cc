@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "impeller/entity/gles/entity_es3_shaders_gles.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
 #include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/entity/gles/modern_shaders_gles.h"
@@ -86,6 +87,12 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
   if (!gl->IsValid()) {
     return;
   }
+  if (gl->GetCapabilities()->SupportsES3ShaderLibraries()) {
+    // Replaces the GLSL ES 100 entity shaders, so it must come after them.
+    shader_mappings.push_back(std::make_shared<fml::NonOwnedMapping>(
+        impeller_entity_es3_shaders_gles_data,
+        impeller_entity_es3_shaders_gles_length));
+  }
 
   impeller_context_ = impeller::ContextGLES::Create(
       std::move(gl), shader_mappings, /*enable_gpu_tracing=*/false);
@@ -1495,3 +1495,36 @@ void render_impeller_gl_test() {
   };
   PlatformDispatcher.instance.scheduleFrame();
 }
+
+@pragma('vm:entry-point')
+void ring_buffer_can_be_read() {
+  const int expectedLength = 1000;
+  RingBufferReader? reader;
+  final Uint8List chunk = Uint8List(16);
+  int received = 0;
+  final ReceivePort port = ReceivePort();
+  port.listen((dynamic message) {
+    if (message is Uint8List) {
+      reader = RingBufferReader(message);
+      return;
+    }
+    // Drain the buffer, then check once more for writes that raced with the
+    // drain and did not send a wakeup of their own.
+    do {
+      final int count = reader!.read(chunk);
+      for (int i = 0; i < count; i++) {
+        if (chunk[i] != (received + i) % 256) {
+          signalNativeMessage('Unexpected byte at ${received + i}');
+          port.close();
+          return;
+        }
+      }
+      received += count;
+    } while (reader!.readableLength > 0);
+    if (received == expectedLength) {
+      signalNativeMessage('Received $received bytes');
+      port.close();
+    }
+  });
+  signalNativeCount(port.sendPort.nativePort);
+}
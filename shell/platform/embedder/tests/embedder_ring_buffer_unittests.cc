@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_ring_buffer.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(EmbedderRingBufferTest, RejectsInvalidCapacity) {
+  EXPECT_EQ(EmbedderRingBuffer::Create(0), nullptr);
+  EXPECT_EQ(EmbedderRingBuffer::Create(100), nullptr);
+  EXPECT_NE(EmbedderRingBuffer::Create(128), nullptr);
+}
+
+TEST(EmbedderRingBufferTest, StorageStartsWithControlBlock) {
+  auto ring_buffer = EmbedderRingBuffer::Create(64);
+  ASSERT_NE(ring_buffer, nullptr);
+  EXPECT_EQ(ring_buffer->GetStorageSize(),
+            EmbedderRingBuffer::kHeaderSize + 64u);
+
+  uint32_t capacity = 0;
+  memcpy(&capacity, ring_buffer->GetStorage() + 12, sizeof(capacity));
+  EXPECT_EQ(capacity, 64u);
+}
+
+TEST(EmbedderRingBufferTest, WritesAreAllOrNothing) {
+  auto ring_buffer = EmbedderRingBuffer::Create(8);
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  bool notify = false;
+  ASSERT_TRUE(ring_buffer->Write(data, 6, &notify));
+  EXPECT_FALSE(ring_buffer->Write(data, 3, &notify));
+  EXPECT_FALSE(notify);
+  EXPECT_EQ(ring_buffer->GetReadableSize(), 6u);
+}
+
+TEST(EmbedderRingBufferTest, WrapsAround) {
+  auto ring_buffer = EmbedderRingBuffer::Create(8);
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  uint8_t out[6] = {};
+  bool notify = false;
+  ASSERT_TRUE(ring_buffer->Write(data, 6, &notify));
+  ASSERT_EQ(ring_buffer->Read(out, 6), 6u);
+  ASSERT_TRUE(ring_buffer->Write(data, 6, &notify));
+  ASSERT_EQ(ring_buffer->Read(out, 6), 6u);
+  for (size_t i = 0; i < 6; i++) {
+    EXPECT_EQ(out[i], data[i]);
+  }
+}
+
+TEST(EmbedderRingBufferTest, CoalescesNotificationsUntilDrained) {
+  auto ring_buffer = EmbedderRingBuffer::Create(16);
+  const uint8_t data[] = {1, 2};
+  uint8_t out[16] = {};
+  bool notify = false;
+
+  ASSERT_TRUE(ring_buffer->Write(data, 2, &notify));
+  EXPECT_TRUE(notify);
+  ASSERT_TRUE(ring_buffer->Write(data, 2, &notify));
+  EXPECT_FALSE(notify);
+
+  // A partial read does not acknowledge the wakeup.
+  ASSERT_EQ(ring_buffer->Read(out, 1), 1u);
+  ASSERT_TRUE(ring_buffer->Write(data, 2, &notify));
+  EXPECT_FALSE(notify);
+
+  ASSERT_EQ(ring_buffer->Read(out, 16), 5u);
+  ASSERT_TRUE(ring_buffer->Write(data, 2, &notify));
+  EXPECT_TRUE(notify);
+}
+
+TEST(EmbedderRingBufferTest, TransfersBytesAcrossThreads) {
+  auto ring_buffer = EmbedderRingBuffer::Create(64);
+  constexpr size_t kCount = 10000;
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i < kCount;) {
+      const uint8_t value = static_cast<uint8_t>(i);
+      bool notify = false;
+      if (ring_buffer->Write(&value, 1, &notify)) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<uint8_t> received;
+  received.reserve(kCount);
+  uint8_t out[32];
+  while (received.size() < kCount) {
+    const size_t count = ring_buffer->Read(out, sizeof(out));
+    received.insert(received.end(), out, out + count);
+  }
+  producer.join();
+
+  for (size_t i = 0; i < kCount; i++) {
+    ASSERT_EQ(received[i], static_cast<uint8_t>(i));
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,7 +4,9 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -3696,6 +3698,69 @@ TEST_F(EmbedderTest, RegisterChannelListener) {
   ASSERT_TRUE(listening);
 }
 
+TEST_F(EmbedderTest, RingBufferCanBeReadFromDart) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  FlutterEngineDartPort port = 0;
+  fml::AutoResetWaitableEvent port_latch;
+  context.AddNativeCallback("SignalNativeCount",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              port = tonic::DartConverter<int64_t>::FromDart(
+                                  Dart_GetNativeArgument(args, 0));
+                              port_latch.Signal();
+                            }));
+  std::string message;
+  fml::AutoResetWaitableEvent message_latch;
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        message = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        message_latch.Signal();
+      }));
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("ring_buffer_can_be_read");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  port_latch.Wait();
+  ASSERT_NE(port, 0);
+
+  FlutterEngineRingBufferCreateInfo info = {};
+  info.struct_size = sizeof(info);
+  info.capacity = 64;
+  info.port = port;
+  FlutterEngineRingBuffer ring_buffer = nullptr;
+  ASSERT_EQ(FlutterEngineCreateRingBuffer(engine.get(), &info, &ring_buffer),
+            kSuccess);
+
+  // Write more than the capacity in chunks that do not divide it, retrying
+  // whenever the ring buffer is full.
+  constexpr size_t kLength = 1000;
+  constexpr size_t kChunkSize = 7;
+  for (size_t offset = 0; offset < kLength;) {
+    uint8_t chunk[kChunkSize];
+    const size_t size = std::min(kChunkSize, kLength - offset);
+    for (size_t i = 0; i < size; i++) {
+      chunk[i] = static_cast<uint8_t>(offset + i);
+    }
+    bool written = false;
+    ASSERT_EQ(FlutterEngineRingBufferWrite(engine.get(), ring_buffer, chunk,
+                                           size, &written),
+              kSuccess);
+    if (written) {
+      offset += size;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  message_latch.Wait();
+  EXPECT_EQ(message, "Received 1000 bytes");
+  ASSERT_EQ(FlutterEngineCollectRingBuffer(ring_buffer), kSuccess);
+}
+
 TEST_F(EmbedderTest, PlatformThreadIsolatesWithCustomPlatformTaskRunner) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   static fml::AutoResetWaitableEvent latch;
@@ -9,6 +9,7 @@
 #include <filesystem>
 #include <sstream>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/platform/win/wstring_conversion.h"
@@ -362,7 +363,18 @@ bool FlutterWindowsEngine::Run(std::string_view entrypoint) {
       accessibility_bridge->AddFlutterSemanticsCustomActionUpdate(*action);
     }
 
-    accessibility_bridge->CommitUpdates();
+    // Converting the update runs on a background thread, so that the platform
+    // thread only applies it to the accessibility tree. Applying it must stay
+    // on the platform thread, as it creates and notifies the platform nodes.
+    if (!host->semantics_loop_) {
+      host->semantics_loop_ = fml::ConcurrentMessageLoop::Create(1);
+    }
+    accessibility_bridge->CommitUpdatesAsync(
+        [runner = host->semantics_loop_->GetTaskRunner()](
+            std::function<void()> task) { runner->PostTask(task); },
+        [runner = host->task_runner_.get()](std::function<void()> task) {
+          runner->PostTask(std::move(task));
+        });
   };
   args.root_isolate_create_callback = [](void* user_data) {
     auto host = static_cast<FlutterWindowsEngine*>(user_data);
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
 #include "flutter/shell/platform/common/accessibility_bridge.h"
@@ -389,6 +390,11 @@ class FlutterWindowsEngine {
   // Task runner for tasks posted from the engine.
   std::unique_ptr<TaskRunner> task_runner_;
 
+  // Converts semantics updates before they are applied on the platform thread.
+  // Created on the first update. Declared after |task_runner_| so that its
+  // worker is joined before the task runner it posts to is destroyed.
+  std::shared_ptr<fml::ConcurrentMessageLoop> semantics_loop_;
+
   // The plugin messenger handle given to API clients.
   fml::RefPtr<flutter::FlutterDesktopMessenger> messenger_;
 
@@ -746,6 +746,99 @@ TEST_F(FlutterWindowsEngineTest, AccessibilityTooltip) {
   EXPECT_EQ(log_capture.str().find("tooltip"), std::string::npos);
 }
 
+// Verify semantics updates are only applied to the accessibility tree once the
+// platform thread processes the update prepared on the background thread,
+// never while the engine's update callback runs.
+TEST_F(FlutterWindowsEngineTest, CommitsSemanticsUpdatesAsynchronously) {
+  FlutterWindowsEngineBuilder builder{GetContext()};
+  std::unique_ptr<FlutterWindowsEngine> engine = builder.Build();
+  EngineModifier modifier(engine.get());
+
+  FlutterUpdateSemanticsCallback2 update_semantics = nullptr;
+  modifier.embedder_api().Run = MOCK_ENGINE_PROC(
+      Run, ([&update_semantics](size_t version,
+                                const FlutterRendererConfig* config,
+                                const FlutterProjectArgs* args, void* user_data,
+                                FLUTTER_API_SYMBOL(FlutterEngine) *
+                                    engine_out) {
+        update_semantics = args->update_semantics_callback2;
+        *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(1);
+        return kSuccess;
+      }));
+  modifier.embedder_api().NotifyDisplayUpdate =
+      MOCK_ENGINE_PROC(NotifyDisplayUpdate,
+                       ([](FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+                           const FlutterEngineDisplaysUpdateType update_type,
+                           const FlutterEngineDisplay* embedder_displays,
+                           size_t display_count) { return kSuccess; }));
+  modifier.embedder_api().UpdateAccessibilityFeatures = MOCK_ENGINE_PROC(
+      UpdateAccessibilityFeatures,
+      [](FLUTTER_API_SYMBOL(FlutterEngine) engine,
+         FlutterAccessibilityFeature flags) { return kSuccess; });
+  modifier.embedder_api().UpdateLocales = MOCK_ENGINE_PROC(
+      UpdateLocales, ([](auto engine, const FlutterLocale** locales,
+                         size_t locales_count) { return kSuccess; }));
+  modifier.embedder_api().SendPlatformMessage =
+      MOCK_ENGINE_PROC(SendPlatformMessage,
+                       ([](auto engine, auto message) { return kSuccess; }));
+  modifier.embedder_api().UpdateSemanticsEnabled =
+      [](FLUTTER_API_SYMBOL(FlutterEngine) engine, bool enabled) {
+        return kSuccess;
+      };
+  modifier.SetEGLManager(nullptr);
+
+  ASSERT_TRUE(engine->Run());
+  ASSERT_NE(update_semantics, nullptr);
+
+  MockFlutterWindowsView view{
+      engine.get(), std::make_unique<NiceMock<MockWindowBindingHandler>>()};
+  modifier.SetImplicitView(&view);
+  engine->UpdateSemanticsEnabled(true);
+
+  auto bridge = view.accessibility_bridge().lock();
+  ASSERT_TRUE(bridge);
+  auto root_label = [&bridge]() -> std::string {
+    auto root = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+    if (!root) {
+      return "";
+    }
+    return root->GetData().GetStringAttribute(
+        ax::mojom::StringAttribute::kName);
+  };
+
+  FlutterSemanticsNode2 root{
+      .struct_size = sizeof(FlutterSemanticsNode2),
+      .id = 0,
+      .text_selection_base = -1,
+      .text_selection_extent = -1,
+      .label = "root",
+      .hint = "",
+      .value = "",
+      .increased_value = "",
+      .decreased_value = "",
+      .tooltip = "",
+  };
+  FlutterSemanticsNode2* nodes[] = {&root};
+  FlutterSemanticsUpdate2 update{
+      .struct_size = sizeof(FlutterSemanticsUpdate2),
+      .node_count = 1,
+      .nodes = nodes,
+  };
+  update_semantics(&update, engine.get());
+
+  // The platform thread has not processed any tasks yet.
+  EXPECT_EQ(root_label(), "");
+
+  // Rely on timeout mechanism in CI.
+  while (root_label() != "root") {
+    engine->task_runner()->ProcessTasks();
+  }
+
+  // Ensure that deallocation doesn't call the actual Shutdown with the bogus
+  // engine pointer that the overridden Run returned.
+  modifier.embedder_api().Shutdown = [](auto engine) { return kSuccess; };
+}
+
 class MockWindowsLifecycleManager : public WindowsLifecycleManager {
  public:
   MockWindowsLifecycleManager(FlutterWindowsEngine* engine)
@@ -584,6 +584,9 @@ def run_engine_benchmarks(build_dir, executable_filter):
   if is_linux():
     run_engine_executable(build_dir, 'txt_benchmarks', executable_filter, icu_flags)
 
+  if is_mac():
+    run_engine_executable(build_dir, 'accessibility_bridge_benchmarks', executable_filter, icu_flags)
+
 
 class FlutterTesterOptions():
 
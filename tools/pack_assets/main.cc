@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <iostream>
+#include <string>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/file.h"
+
+void Usage() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "pack-assets <asset directory>" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Packs every file below the asset directory into "
+            << flutter::PackedAssetBundle::kFileName
+            << " in that directory. An existing bundle is replaced, and is "
+               "not packed into the new one."
+            << std::endl;
+  std::cout << "The engine only reads the bundle when it runs precompiled "
+               "code, and looks up assets that are missing from it in the "
+               "directory, so the bundle should be packed after the asset "
+               "directory is complete."
+            << std::endl;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    Usage();
+    return -1;
+  }
+  std::string directory_path(argv[1]);
+  fml::UniqueFD directory = fml::OpenDirectory(
+      directory_path.c_str(), false, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    std::cerr << "Failed to open asset directory '" << directory_path
+              << "'; aborting." << std::endl;
+    return -1;
+  }
+  if (!flutter::PackedAssetBundle::PackDirectory(directory)) {
+    std::cerr << "Failed to pack asset directory '" << directory_path
+              << "'; aborting." << std::endl;
+    return -1;
+  }
+  std::cout << "Wrote " << directory_path << "/"
+            << flutter::PackedAssetBundle::kFileName << std::endl;
+  return 0;
+}